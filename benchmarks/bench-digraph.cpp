@@ -301,6 +301,40 @@ namespace libsemigroups {
     };
   }
 
+  TEST_CASE("visit_paths", "[quick][008]") {
+    using node_type = size_t;
+    auto   ad       = test_digraph();
+    size_t N        = 24;
+
+    BENCHMARK("visit_paths (source)") {
+      size_t count = 0;
+      ad.visit_paths(0, 0, N, [&count](word_type const&, node_type) {
+        ++count;
+        return true;
+      });
+      REQUIRE(count == 16777215);
+    };
+
+    BENCHMARK("const_panilo_iterator for comparison with visit_paths") {
+      REQUIRE(std::distance(ad.cbegin_panilo(0, 0, N), ad.cend_panilo())
+              == 16777215);
+    };
+
+    BENCHMARK("visit_paths (source and target)") {
+      size_t count = 0;
+      ad.visit_paths(0, 4, 0, N, [&count](word_type const&, node_type) {
+        ++count;
+        return true;
+      });
+      REQUIRE(count == 8388595);
+    };
+
+    BENCHMARK("const_pstilo_iterator for comparison with visit_paths") {
+      REQUIRE(std::distance(ad.cbegin_pstilo(0, 4, 0, N), ad.cend_pstilo())
+              == 8388595);
+    };
+  }
+
   // Best with a sample size of 1
   TEST_CASE("number_of_paths matrix vs dfs", "[standard][007]") {
     using algorithm = ActionDigraph<size_t>::algorithm;
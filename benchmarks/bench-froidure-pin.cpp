@@ -21,6 +21,7 @@
 #include "bench-main.hpp"  // for CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "catch.hpp"       // for REQUIRE
 
+#include "libsemigroups/allocator.hpp"
 #include "libsemigroups/froidure-pin-base.hpp"
 #include "libsemigroups/froidure-pin.hpp"
 #include "libsemigroups/transf.hpp"
@@ -74,4 +75,24 @@ namespace libsemigroups {
                           after_bench<LeastTransf<16>>,
                           {transf_examples(0x9806816B9D761476)});
 
+  TEST_CASE("memory policies", "[FroidurePin][003]") {
+    auto rg = ReportGuard(false);
+    using Transf = LeastTransf<7>;
+    std::vector<Transf> gens = {Transf({1, 0, 2, 3, 4, 5, 6}),
+                                Transf({1, 2, 3, 4, 5, 6, 0}),
+                                Transf({0, 0, 2, 3, 4, 5, 6})};
+    std::vector<std::pair<std::string, memory_policy>> policies
+        = {{"standard", memory_policy::standard},
+           {"huge_pages", memory_policy::huge_pages},
+           {"interleave", memory_policy::interleave},
+           {"huge_pages_and_interleave",
+            memory_policy::huge_pages_and_interleave}};
+    for (auto const& p : policies) {
+      BENCHMARK("full transformation monoid of degree 7, " + p.first) {
+        FroidurePin<Transf> S(gens);
+        S.memory_policy(p.second);
+        REQUIRE(S.size() == 823543);
+      };
+    }
+  }
 }  // namespace libsemigroups
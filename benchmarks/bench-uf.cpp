@@ -16,6 +16,9 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <utility>  // for pair
+#include <vector>   // for vector
+
 #include "bench-main.hpp"  // for LIBSEMIGROUPS_BENCHMARK
 #include "catch.hpp"       // for REQUIRE, REQUIRE_NOTHROW, REQUIRE_THROWS_AS
 
@@ -52,6 +55,36 @@ namespace libsemigroups {
         }
       };
 
+      std::vector<std::pair<size_t, size_t>> pairs;
+      for (size_t i = 0; i < N / 5; ++i) {
+        pairs.emplace_back(dist(gen), dist(gen));
+      }
+
+      BENCHMARK("Duf (batched, 1 thread)" + to_string(M)) {
+        for (size_t j = 0; j < 10; ++j) {
+          Duf<> uf(N);
+          uf.unite_pairs(pairs.cbegin(), pairs.cend());
+          REQUIRE(uf.number_of_blocks() > 1);
+        }
+      };
+
+      BENCHMARK("Duf (batched, 4 threads)" + to_string(M)) {
+        for (size_t j = 0; j < 10; ++j) {
+          Duf<> uf(N);
+          uf.unite_pairs(pairs.cbegin(), pairs.cend(), 4);
+          REQUIRE(uf.number_of_blocks() > 1);
+        }
+      };
+
+      BENCHMARK("Duf normalize" + to_string(M)) {
+        for (size_t j = 0; j < 10; ++j) {
+          Duf<> uf(N);
+          uf.unite_pairs(pairs.cbegin(), pairs.cend());
+          uf.normalize();
+          REQUIRE(uf.number_of_blocks() > 1);
+        }
+      };
+
       BENCHMARK("UFOld" + to_string(M)) {
         for (size_t j = 0; j < 10; ++j) {
           UFOld uf(N);
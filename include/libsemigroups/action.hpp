@@ -22,18 +22,22 @@
 #ifndef LIBSEMIGROUPS_ACTION_HPP_
 #define LIBSEMIGROUPS_ACTION_HPP_
 
-#include <cstddef>        // for size_t
-#include <type_traits>    // for is_trivially_default_construc...
-#include <unordered_map>  // for unordered_map
-#include <vector>         // for vector
+#include <algorithm>    // for equal, max, min
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint8_t, uint64_t
+#include <type_traits>  // for is_trivially_default_construc...
+#include <utility>      // for move
+#include <vector>       // for vector
 
 #include "adapters.hpp"          // for One
 #include "bruidhinn-traits.hpp"  // for detail::BruidhinnTraits
+#include "constants.hpp"         // for UNDEFINED
 #include "debug.hpp"             // for LIBSEMIGROUPS_ASSERT
 #include "digraph.hpp"           // for ActionDigraph
 #include "exception.hpp"         // for LIBSEMIGROUPS_EXCEPTION
 #include "report.hpp"            // for REPORT_DEFAULT
 #include "runner.hpp"            // for Runner
+#include "types.hpp"             // for word_type
 
 namespace libsemigroups {
   //! The values in this enum can be used as a template parameter for the Action
@@ -48,6 +52,199 @@ namespace libsemigroups {
     right
   };
 
+  namespace detail {
+    // An open addressing hash table (with linear probing) of the indices of
+    // the points in an Action. Only the indices and the hash values of the
+    // points are stored, not the points themselves, and so every slot
+    // occupies 2 words, and the points are compared using a function
+    // provided by the caller. The hash values are multiplied by a constant
+    // (Fibonacci hashing) before being used to find a slot, so that hash
+    // functions whose values differ only in the high bits are not too bad.
+    class IndexHashTable {
+     public:
+      IndexHashTable() : _shift(64), _size(0), _slots() {}
+
+      IndexHashTable(IndexHashTable const&) = default;
+      IndexHashTable(IndexHashTable&&)      = default;
+      IndexHashTable& operator=(IndexHashTable const&) = default;
+      IndexHashTable& operator=(IndexHashTable&&) = default;
+
+      size_t size() const noexcept {
+        return _size;
+      }
+
+      // Ensures that at least n indices can be inserted without a rehash.
+      void reserve(size_t n) {
+        if (4 * n > 3 * _slots.size()) {
+          size_t capacity = 16;
+          while (4 * n > 3 * capacity) {
+            capacity *= 2;
+          }
+          rehash(capacity);
+        }
+      }
+
+      // Returns the index i with hash value hash such that equal_to(i) is
+      // true, or UNDEFINED if there is no such index.
+      template <typename TEqualTo>
+      size_t find(size_t hash, TEqualTo&& equal_to) const {
+        if (_size == 0) {
+          return UNDEFINED;
+        }
+        size_t const mask = _slots.size() - 1;
+        for (size_t s = slot(hash);; s = (s + 1) & mask) {
+          Slot const& x = _slots[s];
+          if (x.index == UNDEFINED) {
+            return UNDEFINED;
+          } else if (x.hash == hash && equal_to(x.index)) {
+            return x.index;
+          }
+        }
+      }
+
+      // Inserts the index i with hash value hash, which must not already
+      // belong to the table.
+      void insert(size_t hash, size_t i) {
+        reserve(_size + 1);
+        place(hash, i);
+        _size++;
+      }
+
+      // Hints that the slot where a search for hash starts will be used soon.
+      void prefetch(size_t hash) const noexcept {
+#ifdef __GNUC__
+        if (!_slots.empty()) {
+          __builtin_prefetch(&_slots[slot(hash)]);
+        }
+#else
+        (void) hash;
+#endif
+      }
+
+     private:
+      struct Slot {
+        size_t hash;
+        size_t index;
+      };
+
+      size_t slot(size_t hash) const noexcept {
+        return static_cast<size_t>(
+            (static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15) >> _shift);
+      }
+
+      void place(size_t hash, size_t i) noexcept {
+        size_t const mask = _slots.size() - 1;
+        size_t       s    = slot(hash);
+        while (_slots[s].index != UNDEFINED) {
+          s = (s + 1) & mask;
+        }
+        _slots[s] = {hash, i};
+      }
+
+      // capacity must be a power of 2
+      void rehash(size_t capacity) {
+        std::vector<Slot> old(capacity, {0, UNDEFINED});
+        std::swap(old, _slots);
+        _shift = 64;
+        while (capacity > 1) {
+          capacity >>= 1;
+          _shift--;
+        }
+        for (Slot const& x : old) {
+          if (x.index != UNDEFINED) {
+            place(x.hash, x.index);
+          }
+        }
+      }
+
+      size_t            _shift;
+      size_t            _size;
+      std::vector<Slot> _slots;
+    };
+
+    // The points of type std::vector<T>, where T is an integral type other
+    // than bool, can be stored in a FixedStrideArena. This is the case, for
+    // example, for the points acted on by OnSets and OnTuples.
+    template <typename T>
+    struct IsFixedDegreeContainer : std::false_type {
+      using value_type = uint8_t;
+    };
+
+    template <typename T>
+    struct IsFixedDegreeContainer<std::vector<T>>
+        : std::integral_constant<bool,
+                                 std::is_integral<T>::value
+                                     && !std::is_same<T, bool>::value> {
+      using value_type = T;
+    };
+
+    // A flat array containing the entries of containers of the same fixed
+    // size (the stride), the entries of the i-th container are in positions
+    // [i * stride, (i + 1) * stride). This is used by Action to compare the
+    // points found by the hash table with a single contiguous comparison,
+    // rather than by following the pointers to the points in the orbit. The
+    // stride is the size of the first container added. If a container of
+    // another size is added, then the arena is disabled and cleared.
+    template <typename T>
+    class FixedStrideArena {
+     public:
+      FixedStrideArena()
+          : _data(), _enabled(true), _size(0), _stride(UNDEFINED) {}
+
+      FixedStrideArena(FixedStrideArena const&) = default;
+      FixedStrideArena(FixedStrideArena&&)      = default;
+      FixedStrideArena& operator=(FixedStrideArena const&) = default;
+      FixedStrideArena& operator=(FixedStrideArena&&) = default;
+
+      bool enabled() const noexcept {
+        return _enabled;
+      }
+
+      size_t size() const noexcept {
+        return _size;
+      }
+
+      // Returns UNDEFINED if no containers have been added yet.
+      size_t stride() const noexcept {
+        return _stride;
+      }
+
+      void reserve(size_t n) {
+        if (_enabled && _stride != UNDEFINED) {
+          _data.reserve(n * _stride);
+        }
+      }
+
+      void push_back(T const* first, size_t n) {
+        if (!_enabled) {
+          return;
+        } else if (_stride == UNDEFINED) {
+          _stride = n;
+        } else if (n != _stride) {
+          _enabled = false;
+          _size    = 0;
+          std::vector<T>().swap(_data);
+          return;
+        }
+        _data.insert(_data.end(), first, first + n);
+        _size++;
+      }
+
+      // Returns true if the i-th container equals [first, first + stride).
+      bool equal(size_t i, T const* first) const noexcept {
+        LIBSEMIGROUPS_ASSERT(_enabled);
+        LIBSEMIGROUPS_ASSERT(i < _size);
+        return std::equal(first, first + _stride, _data.data() + i * _stride);
+      }
+
+     private:
+      std::vector<T> _data;
+      bool           _enabled;
+      size_t         _size;
+      size_t         _stride;
+    };
+  }  // namespace detail
+
   //! Defined in ``action.hpp``.
   //!
   //! This page contains details of the Action class in ``libsemigroups`` for
@@ -110,6 +307,17 @@ namespace libsemigroups {
   //! o.digraph().number_of_scc(); // 17
   //! \endcode
   //!
+  //! The points are found in batches: every generator is applied to all of
+  //! the points in a batch before the next generator is applied, and then the
+  //! images are looked up in the orbit. The orbit is indexed by an open
+  //! addressing hash table that contains only the hash values and positions
+  //! of the points, and not copies of the points. The points in the orbit are
+  //! numbered in the same order as if they were found one at a time. If the
+  //! points are vectors of integers of the same size, such as those acted on
+  //! by OnSets and OnTuples, then their entries are also stored one after
+  //! another in a single flat array, and the points found in the hash table
+  //! are compared with the entries in this array.
+  //!
   //! \complexity
   //! The time complexity is \f$O(mn)\f$ where \f$m\f$ is the total
   //! number of points in the orbit and \f$n\f$ is the number of generators.
@@ -152,6 +360,16 @@ namespace libsemigroups {
                 internal_const_point_type>::type>::value,
         "internal_const_element_type must be const or pointer to const");
 
+    // Points that are vectors of integers, compared using the default
+    // EqualTo, are also stored in _arena, see add_to_arena and find.
+    static constexpr bool USE_ARENA
+        = detail::IsFixedDegreeContainer<TPointType>::value
+          && std::is_same<typename TTraits::EqualTo,
+                          ::libsemigroups::EqualTo<TPointType>>::value;
+
+    using arena_value_type =
+        typename detail::IsFixedDegreeContainer<TPointType>::value_type;
+
    public:
     ////////////////////////////////////////////////////////////////////////
     // Action - typedefs - public
@@ -264,7 +482,10 @@ namespace libsemigroups {
     //! \par Parameters
     //! (None)
     Action()
-        : _gens(),
+        : _arena(),
+          _batch(),
+          _batch_hashes(),
+          _gens(),
           _graph(),
           _map(),
           _options(),
@@ -273,17 +494,65 @@ namespace libsemigroups {
           _tmp_point(),
           _tmp_point_init(false) {}
 
-    //! Default copy constructor.
-    Action(Action const&) = default;
+    //! Copy constructor.
+    //!
+    //! The points in the orbit are copied, and so the copy and the original
+    //! are independent.
+    Action(Action const& that)
+        : Runner(that),
+          _arena(that._arena),
+          _batch(),
+          _batch_hashes(),
+          _gens(that._gens),
+          _graph(that._graph),
+          _map(that._map),
+          _options(that._options),
+          _orb(),
+          _multipliers_from_scc_root(that._multipliers_from_scc_root),
+          _multipliers_to_scc_root(that._multipliers_to_scc_root),
+          _pos(that._pos),
+          _tmp_point(),
+          _tmp_point_init(that._tmp_point_init) {
+      if (_tmp_point_init) {
+        _tmp_point = this->internal_copy(that._tmp_point);
+      }
+      _orb.reserve(that._orb.size());
+      for (auto pt : that._orb) {
+        _orb.push_back(this->internal_copy(pt));
+      }
+      // _batch is only used as scratch space within run_impl, and it is
+      // recreated by init_batch, so there is no need to copy it.
+    }
 
-    //! Default move constructor.
-    Action(Action&&) = default;
+    //! Move constructor.
+    Action(Action&& that)
+        : Runner(std::move(that)),
+          _arena(std::move(that._arena)),
+          _batch(std::move(that._batch)),
+          _batch_hashes(std::move(that._batch_hashes)),
+          _gens(std::move(that._gens)),
+          _graph(std::move(that._graph)),
+          _map(std::move(that._map)),
+          _options(std::move(that._options)),
+          _orb(std::move(that._orb)),
+          _multipliers_from_scc_root(
+              std::move(that._multipliers_from_scc_root)),
+          _multipliers_to_scc_root(std::move(that._multipliers_to_scc_root)),
+          _pos(that._pos),
+          _tmp_point(that._tmp_point),
+          _tmp_point_init(that._tmp_point_init) {
+      // The points now belong to this, and so must not be freed by that.
+      that._batch.clear();
+      that._orb.clear();
+      that._pos            = 0;
+      that._tmp_point_init = false;
+    }
 
-    //! Default copy assignment operator.
-    Action& operator=(Action const&) = default;
+    //! Deleted.
+    Action& operator=(Action const&) = delete;
 
-    //! Default move assignment operator.
-    Action& operator=(Action&&) = default;
+    //! Deleted.
+    Action& operator=(Action&&) = delete;
 
     ~Action() {
       if (_tmp_point_init) {
@@ -292,6 +561,9 @@ namespace libsemigroups {
       for (auto pt : _orb) {
         this->internal_free(pt);
       }
+      for (auto pt : _batch) {
+        this->internal_free(pt);
+      }
     }
 
     ////////////////////////////////////////////////////////////////////////
@@ -312,6 +584,7 @@ namespace libsemigroups {
     //! \complexity
     //! At most linear in the size() of the Action.
     void reserve(size_t val) {
+      _arena.reserve(val);
       _graph.reserve(val, _gens.size());
       _map.reserve(val);
       _orb.reserve(val);
@@ -338,8 +611,12 @@ namespace libsemigroups {
         _tmp_point_init = true;
         _tmp_point      = this->internal_copy(internal_seed);
       }
-      _map.emplace(internal_seed, _orb.size());
+      size_t const hash = InternalHash()(internal_seed);
+      if (find(hash, internal_seed) == UNDEFINED) {
+        _map.insert(hash, _orb.size());
+      }
       _orb.push_back(internal_seed);
+      add_to_arena(internal_seed);
       _graph.add_nodes(1);
     }
 
@@ -377,12 +654,8 @@ namespace libsemigroups {
     //! \complexity
     //! Constant.
     index_type position(const_reference_point_type pt) const {
-      auto it = _map.find(this->to_internal_const(pt));
-      if (it != _map.end()) {
-        return (*it).second;
-      } else {
-        return UNDEFINED;
-      }
+      internal_const_point_type x = this->to_internal_const(pt);
+      return find(InternalHash()(x), x);
     }
 
     //! Checks if the Action contains any points.
@@ -609,11 +882,11 @@ namespace libsemigroups {
       } else {
         element_type out = One()(_gens[0]);
         element_type tmp = One()(_gens[0]);
-        while (_graph.spanning_forest().parent(pos) != UNDEFINED) {
+        word_type    w;
+        _graph.spanning_forest().path_to_root(w, pos);
+        for (auto const& a : w) {
           Swap()(tmp, out);
-          internal_product(
-              out, _gens[_graph.spanning_forest().label(pos)], tmp);
-          pos = _graph.spanning_forest().parent(pos);
+          internal_product(out, _gens[a], tmp);
         }
         return out;
       }
@@ -673,11 +946,11 @@ namespace libsemigroups {
       } else {
         element_type out = One()(_gens[0]);
         element_type tmp = One()(_gens[0]);
-        while (_graph.reverse_spanning_forest().parent(pos) != UNDEFINED) {
+        word_type    w;
+        _graph.reverse_spanning_forest().path_to_root(w, pos);
+        for (auto const& a : w) {
           Swap()(tmp, out);
-          internal_product(
-              out, tmp, _gens[_graph.reverse_spanning_forest().label(pos)]);
-          pos = _graph.reverse_spanning_forest().parent(pos);
+          internal_product(out, tmp, _gens[a]);
         }
         return out;
       }
@@ -757,34 +1030,46 @@ namespace libsemigroups {
             ActionOp()(this->to_external(_tmp_point),
                        this->to_external_const(_orb[i]),
                        _gens[j]);
-            auto it = _map.find(_tmp_point);
-            if (it == _map.end()) {
-              _graph.add_nodes(1);
-              _graph.add_edge(i, _orb.size(), j);
-              _orb.push_back(this->internal_copy(_tmp_point));
-              _map.emplace(_orb.back(), _orb.size() - 1);
-            } else {
-              _graph.add_edge(i, (*it).second, j);
-            }
+            add_edge(i, j, _tmp_point, InternalHash()(_tmp_point));
           }
         }
       }
 
-      for (; _pos < _orb.size() && !stopped(); ++_pos) {
-        for (size_t j = 0; j < _gens.size(); ++j) {
-          ActionOp()(this->to_external(_tmp_point),
-                     this->to_external_const(_orb[_pos]),
-                     _gens[j]);
-          auto it = _map.find(_tmp_point);
-          if (it == _map.end()) {
-            _graph.add_nodes(1);
-            _graph.add_edge(_pos, _orb.size(), j);
-            _orb.push_back(this->internal_copy(_tmp_point));
-            _map.emplace(_orb.back(), _orb.size() - 1);
-          } else {
-            _graph.add_edge(_pos, (*it).second, j);
+      size_t const nr_gens = _gens.size();
+      if (nr_gens == 0) {
+        _pos = _orb.size();
+      } else if (_pos < _orb.size()) {
+        init_batch(std::max(size_t(1), BATCH_SIZE / nr_gens) * nr_gens);
+      }
+
+      while (_pos < _orb.size() && !stopped()) {
+        size_t const first = _pos;
+        size_t const last
+            = std::min(_orb.size(), first + _batch.size() / nr_gens);
+        // Apply every generator to every point in [first, last), one
+        // generator at a time, so that the data of each generator is only
+        // loaded once per batch, and find the slots in the hash table that
+        // will be required below.
+        for (size_t j = 0; j < nr_gens; ++j) {
+          for (size_t i = first; i < last; ++i) {
+            size_t const k = (i - first) * nr_gens + j;
+            ActionOp()(this->to_external(_batch[k]),
+                       this->to_external_const(_orb[i]),
+                       _gens[j]);
+            _batch_hashes[k] = InternalHash()(_batch[k]);
+            _map.prefetch(_batch_hashes[k]);
           }
         }
+        // Add the images in the same order as if every point were processed
+        // one at a time.
+        for (size_t i = first; i < last; ++i) {
+          for (size_t j = 0; j < nr_gens; ++j) {
+            size_t const k = (i - first) * nr_gens + j;
+            add_edge(i, j, _batch[k], _batch_hashes[k]);
+          }
+        }
+        _pos = last;
+        update_progress(static_cast<double>(_pos) / _orb.size());
         if (report()) {
           REPORT_DEFAULT("found %d points, so far\n", _orb.size());
         }
@@ -792,6 +1077,78 @@ namespace libsemigroups {
       report_why_we_stopped();
     }
 
+    // The number of images of points computed in every batch in run_impl, if
+    // this is at least the number of generators.
+    static constexpr size_t BATCH_SIZE = 256;
+
+    // Ensures that _batch contains at least n points, which are overwritten
+    // by ActionOp.
+    void init_batch(size_t n) {
+      LIBSEMIGROUPS_ASSERT(_tmp_point_init);
+      while (_batch.size() < n) {
+        _batch.push_back(this->internal_copy(_tmp_point));
+      }
+      _batch_hashes.resize(_batch.size());
+    }
+
+    // Returns the position of the point x with hash value hash, or UNDEFINED
+    // if x does not belong to the orbit.
+    template <typename TSfinae = index_type>
+    auto find(size_t hash, internal_const_point_type x) const
+        -> std::enable_if_t<!USE_ARENA, TSfinae> {
+      return _map.find(hash, [this, &x](size_t i) {
+        return InternalEqualTo()(_orb[i], x);
+      });
+    }
+
+    // As above, but the points found in the hash table are compared with x
+    // in _arena, unless the points do not all have the same size.
+    template <typename TSfinae = index_type>
+    auto find(size_t hash, internal_const_point_type x) const
+        -> std::enable_if_t<USE_ARENA, TSfinae> {
+      if (!_arena.enabled()) {
+        return _map.find(hash, [this, &x](size_t i) {
+          return InternalEqualTo()(_orb[i], x);
+        });
+      }
+      point_type const& y = this->to_external_const(x);
+      if (y.size() != _arena.stride()) {
+        // Every point in the orbit has size _arena.stride()
+        return UNDEFINED;
+      }
+      return _map.find(hash, [this, &y](size_t i) {
+        return _arena.equal(i, y.data());
+      });
+    }
+
+    // Adds the point x, which was just added to the orbit, to the arena.
+    template <typename TSfinae = void>
+    auto add_to_arena(internal_const_point_type) noexcept
+        -> std::enable_if_t<!USE_ARENA, TSfinae> {}
+
+    template <typename TSfinae = void>
+    auto add_to_arena(internal_const_point_type x)
+        -> std::enable_if_t<USE_ARENA, TSfinae> {
+      point_type const& y = this->to_external_const(x);
+      _arena.push_back(y.data(), y.size());
+    }
+
+    // Adds the edge from the point in position i labelled by j to the point
+    // x, which is the image of the point in position i under the j-th
+    // generator, and has hash value hash. If x is not already in the orbit,
+    // then a copy of x is added.
+    void add_edge(size_t i, size_t j, internal_point_type x, size_t hash) {
+      index_type pos = find(hash, x);
+      if (pos == UNDEFINED) {
+        pos = _orb.size();
+        _graph.add_nodes(1);
+        _orb.push_back(this->internal_copy(x));
+        add_to_arena(x);
+        _map.insert(hash, pos);
+      }
+      _graph.add_edge(i, pos, j);
+    }
+
     ////////////////////////////////////////////////////////////////////////
     // Action - member functions - private
     ////////////////////////////////////////////////////////////////////////
@@ -840,13 +1197,12 @@ namespace libsemigroups {
     // Action - data members - private
     ////////////////////////////////////////////////////////////////////////
 
-    std::vector<element_type> _gens;
-    ActionDigraph<size_t>     _graph;
-    std::unordered_map<internal_const_point_type,
-                       size_t,
-                       InternalHash,
-                       InternalEqualTo>
-        _map;
+    detail::FixedStrideArena<arena_value_type> _arena;
+    std::vector<internal_point_type>           _batch;
+    std::vector<size_t>                        _batch_hashes;
+    std::vector<element_type>                  _gens;
+    ActionDigraph<size_t>                      _graph;
+    detail::IndexHashTable                     _map;
     struct Options {
       Options() : _cache_scc_multipliers(false) {}
       Options(Options const&) = default;
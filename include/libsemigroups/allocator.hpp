@@ -0,0 +1,120 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration of an allocator, used by the large
+// tables in FroidurePin and ToddCoxeter, that can be asked to back large
+// allocations with transparent huge pages, or to interleave them over the
+// NUMA nodes of the machine.
+
+#ifndef LIBSEMIGROUPS_ALLOCATOR_HPP_
+#define LIBSEMIGROUPS_ALLOCATOR_HPP_
+
+#include <cstddef>      // for size_t
+#include <limits>       // for numeric_limits
+#include <new>          // for bad_alloc
+#include <type_traits>  // for true_type
+
+namespace libsemigroups {
+  //! Defined in ``allocator.hpp``.
+  //!
+  //! The values in this enum specify how the memory for the large tables in
+  //! FroidurePin and ToddCoxeter is allocated (see
+  //! FroidurePinBase::memory_policy and
+  //! congruence::ToddCoxeter::memory_policy).
+  //!
+  //! The policies other than \c standard only apply to allocations of at
+  //! least 2MB, which are made directly using \c mmap, and are only
+  //! hints: they are ignored on systems other than Linux, and if the system
+  //! does not support them.
+  enum class memory_policy {
+    //! Allocate memory using \c operator \c new, the default.
+    standard = 0,
+    //! Ask for large allocations to be backed by transparent huge pages,
+    //! using \c madvise(MADV_HUGEPAGE). This reduces the number of TLB misses
+    //! when accessing a large table at random.
+    huge_pages = 1,
+    //! Interleave the pages of large allocations over all of the NUMA nodes
+    //! available, using \c mbind(MPOL_INTERLEAVE). This balances the
+    //! memory bandwidth used by threads running on different nodes.
+    interleave = 2,
+    //! Both \c huge_pages and \c interleave.
+    huge_pages_and_interleave = 3
+  };
+
+  namespace detail {
+    // Allocate and deallocate n bytes according to the policy p. Memory
+    // allocated with a given policy and number of bytes must be deallocated
+    // with the same policy and number of bytes.
+    void* policy_allocate(size_t n, memory_policy p);
+    void  policy_deallocate(void* ptr, size_t n, memory_policy p) noexcept;
+
+    // An allocator whose memory policy is chosen at run time. The policy is
+    // propagated with the contents of a container on copy assignment, move
+    // assignment, and swap, and so the policy of a container only changes
+    // when explicitly requested (for example, by DynamicArray2::set_allocator).
+    template <typename T>
+    class PolicyAllocator {
+     public:
+      using value_type = T;
+
+      using propagate_on_container_copy_assignment = std::true_type;
+      using propagate_on_container_move_assignment = std::true_type;
+      using propagate_on_container_swap            = std::true_type;
+
+      PolicyAllocator() noexcept : _policy(memory_policy::standard) {}
+
+      explicit PolicyAllocator(memory_policy p) noexcept : _policy(p) {}
+
+      template <typename S>
+      PolicyAllocator(PolicyAllocator<S> const& that) noexcept
+          : _policy(that.policy()) {}
+
+      T* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+          throw std::bad_alloc();
+        }
+        return static_cast<T*>(policy_allocate(n * sizeof(T), _policy));
+      }
+
+      void deallocate(T* ptr, size_t n) noexcept {
+        policy_deallocate(ptr, n * sizeof(T), _policy);
+      }
+
+      memory_policy policy() const noexcept {
+        return _policy;
+      }
+
+     private:
+      memory_policy _policy;
+    };
+
+    template <typename T, typename S>
+    bool operator==(PolicyAllocator<T> const& x,
+                    PolicyAllocator<S> const& y) noexcept {
+      return x.policy() == y.policy();
+    }
+
+    template <typename T, typename S>
+    bool operator!=(PolicyAllocator<T> const& x,
+                    PolicyAllocator<S> const& y) noexcept {
+      return !(x == y);
+    }
+  }  // namespace detail
+}  // namespace libsemigroups
+
+#endif  // LIBSEMIGROUPS_ALLOCATOR_HPP_
@@ -0,0 +1,404 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains a class AutomaticGroup for computing shortlex automatic
+// structures of finitely presented groups, in the style of the program
+// autgroup in kbmag.
+
+#ifndef LIBSEMIGROUPS_AUTOMATIC_HPP_
+#define LIBSEMIGROUPS_AUTOMATIC_HPP_
+
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint64_t
+#include <memory>         // for unique_ptr, shared_ptr
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include "adapters.hpp"      // for Hash
+#include "digraph.hpp"       // for ActionDigraph
+#include "fpsemi-intf.hpp"   // for FpSemigroupInterface
+#include "knuth-bendix.hpp"  // for KnuthBendix
+#include "types.hpp"         // for word_type, letter_type
+
+namespace libsemigroups {
+  namespace fpsemigroup {
+    //! Defined in ``automatic.hpp``.
+    //!
+    //! This class can be used to compute a shortlex automatic structure for a
+    //! finitely presented group, consisting of a word acceptor, and the
+    //! multiplier automata, using the procedure described in Chapter 13 of
+    //! the Handbook of Computational Group Theory, and implemented in the
+    //! program ``autgroup`` in kbmag.
+    //!
+    //! The rules of an AutomaticGroup are passed to an underlying
+    //! KnuthBendix instance, which is run until it has a certain number of
+    //! active rules. The word differences of the (possibly non-confluent)
+    //! active rules are then used to construct a word difference machine, and
+    //! from this a candidate word acceptor and general multiplier are built.
+    //! These candidates are then checked for correctness; if they are not
+    //! correct, then further word differences are added, or the underlying
+    //! KnuthBendix is run for longer, and the process is repeated.
+    //!
+    //! Once an automatic structure has been found (and so finished() returns
+    //! \c true), normal_form() and equal_to() use the multipliers and so run
+    //! in time linear in the length of the output normal form for every
+    //! letter of the input, and number_of_normal_forms() and size() count
+    //! paths in the word acceptor, even if the group is infinite.
+    //!
+    //! The identity of an AutomaticGroup must be the empty word, and the
+    //! inverses of all letters must be set using set_inverses() before
+    //! running.
+    //!
+    //! \sa fpsemigroup::KnuthBendix.
+    //!
+    //! \par Example
+    //! \code
+    //! AutomaticGroup ag;
+    //! ag.set_alphabet("aAbB");
+    //! ag.set_identity("");
+    //! ag.set_inverses("AaBb");
+    //! ag.add_rule("ba", "ab");
+    //! ag.run();
+    //! ag.size();                           // POSITIVE_INFINITY
+    //! ag.number_of_normal_forms(0, 3);     // 13
+    //! ag.normal_form("bAbaB");             // "b"
+    //! \endcode
+    class AutomaticGroup final : public FpSemigroupInterface {
+     public:
+      //////////////////////////////////////////////////////////////////////////
+      // AutomaticGroup - types - public
+      //////////////////////////////////////////////////////////////////////////
+
+      //! The type of the digraphs representing the automata.
+      using digraph_type = ActionDigraph<size_t>;
+
+      //! The type of the nodes in the digraphs representing the automata.
+      using node_type = typename digraph_type::node_type;
+
+      //////////////////////////////////////////////////////////////////////////
+      // AutomaticGroup - constructors and destructor - public
+      //////////////////////////////////////////////////////////////////////////
+
+      //! Default constructor.
+      //!
+      //! Constructs an AutomaticGroup instance with no rules.
+      //!
+      //! \parameters
+      //! (None)
+      //!
+      //! \complexity
+      //! Constant.
+      AutomaticGroup();
+
+      //! Deleted.
+      AutomaticGroup(AutomaticGroup const&) = delete;
+
+      //! Deleted.
+      AutomaticGroup(AutomaticGroup&&) = delete;
+
+      //! Deleted.
+      AutomaticGroup& operator=(AutomaticGroup const&) = delete;
+
+      //! Deleted.
+      AutomaticGroup& operator=(AutomaticGroup&&) = delete;
+
+      ~AutomaticGroup();
+
+      //////////////////////////////////////////////////////////////////////////
+      // AutomaticGroup - settings - public
+      //////////////////////////////////////////////////////////////////////////
+
+      //! Set the number of rules before the first attempt.
+      //!
+      //! The underlying KnuthBendix is run until it has (approximately) \p val
+      //! active rules before the first attempt to construct an automatic
+      //! structure is made. This number is doubled every time that an attempt
+      //! fails, and no further word differences can be found.
+      //!
+      //! The default value is \c 64.
+      //!
+      //! \param val the number of rules.
+      //!
+      //! \returns
+      //! A reference to \c *this.
+      //!
+      //! \throws LibsemigroupsException if \p val is \c 0.
+      //!
+      //! \complexity
+      //! Constant.
+      AutomaticGroup& max_rules(size_t val);
+
+      //! Returns the underlying KnuthBendix.
+      //!
+      //! This can be used to change the settings of the underlying
+      //! KnuthBendix instance, such as the overlap policy.
+      //!
+      //! \returns A reference to a fpsemigroup::KnuthBendix.
+      //!
+      //! \exceptions
+      //! \noexcept
+      //!
+      //! \complexity
+      //! Constant.
+      //!
+      //! \parameters
+      //! (None)
+      KnuthBendix& knuth_bendix() noexcept {
+        return *_kb;
+      }
+
+      //////////////////////////////////////////////////////////////////////////
+      // AutomaticGroup - automata - public
+      //////////////////////////////////////////////////////////////////////////
+
+      //! Returns the word difference machine.
+      //!
+      //! The nodes of the returned digraph are the word differences, the node
+      //! \c 0 is the identity, and the edges are labelled by pairs of letters,
+      //! see pair_label().
+      //!
+      //! \returns A const reference to a \ref digraph_type.
+      //!
+      //! \complexity
+      //! See warning.
+      //!
+      //! \warning This function triggers a full enumeration of \c this, which
+      //! may never terminate.
+      //!
+      //! \parameters
+      //! (None)
+      digraph_type const& word_difference_machine();
+
+      //! Returns the word acceptor.
+      //!
+      //! The word acceptor is a digraph where every node is accepting, the
+      //! initial node is \c 0, and the edge labels are the indices of the
+      //! letters in alphabet(). A word belongs to the language of the word
+      //! acceptor if and only if it labels a path starting at \c 0, if and
+      //! only if it is the short-lex least word representing an element of the
+      //! group.
+      //!
+      //! \returns A const reference to a \ref digraph_type.
+      //!
+      //! \complexity
+      //! See warning.
+      //!
+      //! \warning This function triggers a full enumeration of \c this, which
+      //! may never terminate.
+      //!
+      //! \parameters
+      //! (None)
+      digraph_type const& word_acceptor();
+
+      //! Returns the general multiplier.
+      //!
+      //! The general multiplier is a digraph with initial node \c 0, whose
+      //! edges are labelled by padded pairs of letters, see pair_label(). A
+      //! pair of normal forms \f$(u, v)\f$ labels a path from \c 0 to a node
+      //! that accepts the letter \f$x\f$ (see multiplier_accepts()) if and only
+      //! if \f$ux = v\f$ in the group.
+      //!
+      //! \returns A const reference to a \ref digraph_type.
+      //!
+      //! \complexity
+      //! See warning.
+      //!
+      //! \warning This function triggers a full enumeration of \c this, which
+      //! may never terminate.
+      //!
+      //! \parameters
+      //! (None)
+      digraph_type const& general_multiplier();
+
+      //! Check if a pair of words is accepted by a multiplier.
+      //!
+      //! \param u a string over alphabet()
+      //! \param v a string over alphabet()
+      //! \param x a string of length at most \c 1 over alphabet()
+      //!
+      //! \returns \c true if \p u and \p v are normal forms and \f$ux = v\f$,
+      //! and \c false if not.
+      //!
+      //! \throws LibsemigroupsException if \p u, \p v, or \p x contain a
+      //! letter not in alphabet(), or \p x has length greater than \c 1.
+      //!
+      //! \complexity
+      //! Linear in the length of \p u and \p v.
+      bool multiplier_accepts(std::string const& u,
+                              std::string const& v,
+                              std::string const& x);
+
+      //! Returns the label of an edge for a pair of letters.
+      //!
+      //! The labels of the edges in word_difference_machine() and
+      //! general_multiplier() are the padded pairs of letters \f$(a, b)\f$
+      //! where \f$a\f$ and \f$b\f$ belong to the alphabet or equal the padding
+      //! symbol (but not both are the padding symbol). The pair \f$(a, b)\f$
+      //! corresponds to the label \f$a(n + 1) + b\f$ where \f$n\f$ is the
+      //! size of the alphabet, and the padding symbol is \f$n\f$.
+      //!
+      //! \param a the index of the first letter, or \ref UNDEFINED for padding
+      //! \param b the index of the second letter, or \ref UNDEFINED for padding
+      //!
+      //! \returns A value of type \ref node_type.
+      //!
+      //! \exceptions
+      //! \noexcept
+      //!
+      //! \complexity
+      //! Constant.
+      node_type pair_label(letter_type a, letter_type b) const noexcept;
+
+      //! Returns the number of word differences.
+      //!
+      //! \returns A value of type `size_t`.
+      //!
+      //! \exceptions
+      //! \noexcept
+      //!
+      //! \complexity
+      //! Constant.
+      //!
+      //! \parameters
+      //! (None)
+      size_t number_of_word_differences() const noexcept {
+        return _diffs.size();
+      }
+
+      //! Returns the number of normal forms with length in a given range.
+      //!
+      //! \param min the minimum length of a normal form to count
+      //! \param max one larger than the maximum length of a normal form to
+      //! count.
+      //!
+      //! \returns
+      //! A value of type `uint64_t`.
+      //!
+      //! \complexity
+      //! Assuming that \c this has been run until finished, the complexity of
+      //! this function is at worst \f$O(mn)\f$ where \f$m\f$ is the number of
+      //! letters in the alphabet, and \f$n\f$ is the number of nodes in the
+      //! \ref word_acceptor.
+      uint64_t number_of_normal_forms(size_t min, size_t max);
+
+      //////////////////////////////////////////////////////////////////////////
+      // FpSemigroupInterface - pure virtual member functions - public
+      //////////////////////////////////////////////////////////////////////////
+
+      uint64_t size() override;
+
+      bool equal_to(std::string const&, std::string const&) override;
+
+      std::string normal_form(std::string const& w) override;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+      using FpSemigroupInterface::equal_to;
+      using FpSemigroupInterface::normal_form;
+#endif
+
+     private:
+      //////////////////////////////////////////////////////////////////////////
+      // AutomaticGroup - types - private
+      //////////////////////////////////////////////////////////////////////////
+
+      // A deterministic 2-tape automaton and its accept states.
+      struct Multiplier {
+        digraph_type      graph;
+        std::vector<bool> accept;
+      };
+
+      //////////////////////////////////////////////////////////////////////////
+      // AutomaticGroup - member functions - private
+      //////////////////////////////////////////////////////////////////////////
+
+      word_type inverse(word_type const&) const;
+      word_type reduce(word_type const&) const;
+      size_t    padding() const noexcept {
+        return alphabet().size();
+      }
+
+      bool add_word_difference(word_type const&);
+      bool add_word_differences(word_type const&, word_type const&);
+      void init_word_differences();
+
+      void make_word_difference_machine();
+      void make_word_acceptor();
+      void make_general_multiplier();
+
+      bool check_multipliers();
+      bool check_axioms();
+
+      Multiplier multiplier(word_type const&) const;
+      Multiplier compose(Multiplier const&, Multiplier const&) const;
+      bool       equal_languages(Multiplier const&, Multiplier const&) const;
+
+      word_type multiply(word_type const&, letter_type) const;
+
+      //////////////////////////////////////////////////////////////////////////
+      // FpSemigroupInterface - pure virtual member functions - private
+      //////////////////////////////////////////////////////////////////////////
+
+      void add_rule_impl(std::string const&, std::string const&) override;
+      std::shared_ptr<FroidurePinBase> froidure_pin_impl() override;
+
+      void before_run() override;
+      void run_impl() override;
+
+      bool finished_impl() const override {
+        return _verified;
+      }
+
+      bool is_obviously_infinite_impl() override;
+      bool is_obviously_finite_impl() override;
+
+      //////////////////////////////////////////////////////////////////////////
+      // FpSemigroupInterface - non-pure virtual member functions - private
+      //////////////////////////////////////////////////////////////////////////
+
+      void set_alphabet_impl(std::string const&) override;
+      void set_alphabet_impl(size_t) override;
+
+      void validate_word_impl(std::string const&) const override {
+        // do nothing, the empty string is allowed!
+      }
+
+      void validate_word_impl(word_type const&) const override {
+        // do nothing, the empty word is allowed!
+      }
+
+      bool validate_identity_impl(std::string const&) const override;
+
+      //////////////////////////////////////////////////////////////////////////
+      // AutomaticGroup - data - private
+      //////////////////////////////////////////////////////////////////////////
+
+      std::vector<word_type>                                _diffs;
+      std::unordered_map<word_type, size_t, Hash<word_type>> _diffs_map;
+      std::vector<size_t>                                   _gm_diffs;
+      digraph_type                                          _gm;
+      std::vector<letter_type>                              _inverses;
+      std::unique_ptr<KnuthBendix>                          _kb;
+      size_t                                                _max_rules;
+      bool                                                  _verified;
+      digraph_type                                          _wa;
+      digraph_type                                          _wd;
+    };
+  }  // namespace fpsemigroup
+}  // namespace libsemigroups
+#endif  // LIBSEMIGROUPS_AUTOMATIC_HPP_
@@ -0,0 +1,614 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains declarations of functions for writing ActionDigraphs,
+// DynamicArray2s (such as coset tables and Cayley graphs), Forests, and
+// arrays of points (such as the points in the orbit of an Action) to a
+// binary file, and for reading them back again, either by copying or without
+// copying, using a memory mapped file.
+
+#ifndef LIBSEMIGROUPS_BINARY_HPP_
+#define LIBSEMIGROUPS_BINARY_HPP_
+
+#include <algorithm>    // for copy
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, uint64_t
+#include <fstream>      // for ofstream
+#include <iterator>     // for iterator_traits
+#include <ostream>      // for ostream
+#include <string>       // for string
+#include <type_traits>  // for is_trivially_copyable
+#include <vector>       // for vector
+
+#include "constants.hpp"   // for UNDEFINED
+#include "containers.hpp"  // for DynamicArray2
+#include "digraph.hpp"     // for ActionDigraph
+#include "exception.hpp"   // for LIBSEMIGROUPS_EXCEPTION
+#include "forest.hpp"      // for Forest
+
+namespace libsemigroups {
+  namespace binary {
+    //! The kinds of object that can be stored in a binary file.
+    enum class kind : uint32_t {
+      //! A detail::DynamicArray2, such as a coset table or a Cayley graph.
+      table = 1,
+      //! An ActionDigraph.
+      digraph = 2,
+      //! A Forest.
+      forest = 3,
+      //! An array of points, such as the points in the orbit of an Action.
+      points = 4
+    };
+
+    //! The version of the binary format written by this version of
+    //! ``libsemigroups``.
+    constexpr uint32_t VERSION = 1;
+  }  // namespace binary
+
+  namespace detail {
+    // Every binary file consists of this header followed by the payload,
+    // which is number_of_rows * number_of_cols values of size value_size
+    // stored row by row. The header is 64 bytes long, and so the payload of a
+    // memory mapped file is suitably aligned for any value type.
+    struct BinaryHeader {
+      char     magic[8];
+      uint32_t version;
+      uint32_t kind;
+      uint32_t value_size;
+      uint32_t byte_order;
+      uint64_t number_of_rows;
+      uint64_t number_of_cols;
+      uint64_t payload_size;
+      uint64_t checksum;
+      uint64_t reserved;
+    };
+
+    static_assert(sizeof(BinaryHeader) == 64,
+                  "the binary header must be 64 bytes long");
+
+    // A non-cryptographic checksum used to detect corrupt or truncated
+    // files. The checksum of a sequence of bytes does not depend on how the
+    // sequence is split into calls to update.
+    class BinaryChecksum final {
+     public:
+      BinaryChecksum() noexcept;
+
+      void     update(void const* data, size_t n) noexcept;
+      uint64_t get() const noexcept;
+
+     private:
+      unsigned char _buf[8];
+      size_t        _fill;
+      uint64_t      _hash;
+      uint64_t      _length;
+    };
+
+    BinaryHeader make_binary_header(binary::kind k,
+                                    size_t       value_size,
+                                    size_t       number_of_rows,
+                                    size_t       number_of_cols,
+                                    uint64_t     checksum);
+
+    // The argument for_each_chunk must call its argument, which is a function
+    // taking a pointer and a number of bytes, on the consecutive chunks of
+    // the payload. It is called twice, once to find the checksum, and once to
+    // write the payload.
+    template <typename T, typename F>
+    void write_binary(std::ostream& os,
+                      binary::kind  k,
+                      size_t        number_of_rows,
+                      size_t        number_of_cols,
+                      F&&           for_each_chunk) {
+      static_assert(std::is_trivially_copyable<T>::value,
+                    "the value type must be trivially copyable");
+      BinaryChecksum cs;
+      for_each_chunk(
+          [&cs](void const* data, size_t n) { cs.update(data, n); });
+      BinaryHeader const header = make_binary_header(
+          k, sizeof(T), number_of_rows, number_of_cols, cs.get());
+      os.write(reinterpret_cast<char const*>(&header), sizeof(header));
+      for_each_chunk([&os](void const* data, size_t n) {
+        os.write(static_cast<char const*>(data), n);
+      });
+      if (!os) {
+        LIBSEMIGROUPS_EXCEPTION("failed to write to the stream");
+      }
+    }
+  }  // namespace detail
+
+  namespace binary {
+    //! Defined in ``binary.hpp``.
+    //!
+    //! This class represents a binary file written by one of the \c write
+    //! functions in this namespace, which is mapped into memory using \c
+    //! mmap. Nothing is copied into memory until it is accessed, and the
+    //! pages of the file are shared between all the processes that map the
+    //! file. The contents of the file can be accessed without copying
+    //! using TableView and PointsView, or copied into a new object using
+    //! read_table, read_action_digraph, read_forest, and read_points.
+    //!
+    //! The file must have been written on a machine with the same byte order
+    //! and the same size of value type as the machine reading it.
+    class MappedFile final {
+     public:
+      //! Map a binary file into memory.
+      //!
+      //! \param filename the name of the file.
+      //! \param verify whether or not to verify the checksum of the file
+      //! (defaults to \c true). Verifying the checksum reads the whole file.
+      //!
+      //! \throws LibsemigroupsException if the file cannot be opened or
+      //! mapped, if it is not a binary file written by ``libsemigroups``, if
+      //! it was written with a different version of the format or a
+      //! different byte order, if it is truncated, or if \p verify is \c true
+      //! and the checksum of the file is incorrect.
+      explicit MappedFile(std::string const& filename, bool verify = true);
+
+      //! Deleted.
+      MappedFile(MappedFile const&) = delete;
+
+      //! Move constructor.
+      MappedFile(MappedFile&&) noexcept;
+
+      //! Deleted.
+      MappedFile& operator=(MappedFile const&) = delete;
+
+      //! Move assignment operator.
+      MappedFile& operator=(MappedFile&&) noexcept;
+
+      ~MappedFile();
+
+      //! Returns the kind of object stored in the file.
+      //!
+      //! \exceptions
+      //! \noexcept
+      binary::kind kind() const noexcept {
+        return static_cast<binary::kind>(header().kind);
+      }
+
+      //! Returns the size in bytes of the values stored in the file.
+      //!
+      //! \exceptions
+      //! \noexcept
+      size_t value_size() const noexcept {
+        return header().value_size;
+      }
+
+      //! Returns the number of rows stored in the file.
+      //!
+      //! For a Forest this is the number of nodes, and for an array of points
+      //! this is the number of points.
+      //!
+      //! \exceptions
+      //! \noexcept
+      size_t number_of_rows() const noexcept {
+        return header().number_of_rows;
+      }
+
+      //! Returns the number of columns stored in the file.
+      //!
+      //! For an ActionDigraph this is the out-degree, for a Forest it is \c
+      //! 2, and for an array of points it is \c 1.
+      //!
+      //! \exceptions
+      //! \noexcept
+      size_t number_of_cols() const noexcept {
+        return header().number_of_cols;
+      }
+
+      //! Returns a pointer to the first value stored in the file.
+      //!
+      //! \exceptions
+      //! \noexcept
+      void const* data() const noexcept {
+        return static_cast<char const*>(_addr) + sizeof(detail::BinaryHeader);
+      }
+
+      //! Check that the checksum of the file is correct.
+      //!
+      //! \returns \c true if the checksum stored in the file equals the
+      //! checksum of the values stored in the file, and \c false if not.
+      //!
+      //! \exceptions
+      //! \noexcept
+      bool verify_checksum() const noexcept;
+
+      //! Check that the file contains an object of a given kind with values
+      //! of a given size.
+      //!
+      //! \param k the kind.
+      //! \param value_size the size of the values.
+      //!
+      //! \throws LibsemigroupsException if kind() is not \p k or
+      //! value_size() is not \p value_size.
+      void validate(binary::kind k, size_t value_size) const;
+
+     private:
+      detail::BinaryHeader const& header() const noexcept {
+        return *static_cast<detail::BinaryHeader const*>(_addr);
+      }
+
+      void*  _addr;
+      size_t _length;
+    };
+
+    //! Defined in ``binary.hpp``.
+    //!
+    //! This class provides read only access, without copying, to a table
+    //! stored in a MappedFile, i.e. a detail::DynamicArray2 written using
+    //! write(std::ostream&, detail::DynamicArray2<T, A> const&), or the
+    //! table of targets of an ActionDigraph written using
+    //! write(std::ostream&, ActionDigraph<T> const&).
+    //!
+    //! A TableView is only valid while the MappedFile it views exists.
+    //!
+    //! \tparam T the type of the values in the table.
+    template <typename T>
+    class TableView final {
+     public:
+      //! Construct from a MappedFile.
+      //!
+      //! \param file the file.
+      //!
+      //! \throws LibsemigroupsException if \p file does not contain a table
+      //! or an ActionDigraph, or if the size of its values is not \c
+      //! sizeof(T).
+      explicit TableView(MappedFile const& file)
+          : _data(static_cast<T const*>(file.data())),
+            _nr_cols(file.number_of_cols()),
+            _nr_rows(file.number_of_rows()) {
+        if (file.kind() == kind::digraph) {
+          file.validate(kind::digraph, sizeof(T));
+        } else {
+          file.validate(kind::table, sizeof(T));
+        }
+      }
+
+      //! Returns the number of rows in the table.
+      //!
+      //! \exceptions
+      //! \noexcept
+      size_t number_of_rows() const noexcept {
+        return _nr_rows;
+      }
+
+      //! Returns the number of columns in the table.
+      //!
+      //! \exceptions
+      //! \noexcept
+      size_t number_of_cols() const noexcept {
+        return _nr_cols;
+      }
+
+      //! Returns the value in row \p i and column \p j.
+      //!
+      //! \warning No checks are performed on the arguments.
+      //!
+      //! \exceptions
+      //! \noexcept
+      T get(size_t i, size_t j) const noexcept {
+        return _data[i * _nr_cols + j];
+      }
+
+      //! Returns a pointer to the first value in row \p i.
+      //!
+      //! \exceptions
+      //! \noexcept
+      T const* cbegin_row(size_t i) const noexcept {
+        return _data + i * _nr_cols;
+      }
+
+      //! Returns a pointer one past the last value in row \p i.
+      //!
+      //! \exceptions
+      //! \noexcept
+      T const* cend_row(size_t i) const noexcept {
+        return _data + (i + 1) * _nr_cols;
+      }
+
+     private:
+      T const* _data;
+      size_t   _nr_cols;
+      size_t   _nr_rows;
+    };
+
+    //! Defined in ``binary.hpp``.
+    //!
+    //! This class provides read only access, without copying, to an array of
+    //! points stored in a MappedFile by write(std::ostream&, std::vector<T>
+    //! const&) or write_points.
+    //!
+    //! A PointsView is only valid while the MappedFile it views exists.
+    //!
+    //! \tparam T the type of the points, which must be trivially copyable.
+    template <typename T>
+    class PointsView final {
+      static_assert(std::is_trivially_copyable<T>::value,
+                    "the template parameter T must be trivially copyable");
+
+     public:
+      //! Type of const iterators.
+      using const_iterator = T const*;
+
+      //! Construct from a MappedFile.
+      //!
+      //! \param file the file.
+      //!
+      //! \throws LibsemigroupsException if \p file does not contain an array
+      //! of points, or if the size of its points is not \c sizeof(T).
+      explicit PointsView(MappedFile const& file)
+          : _data(static_cast<T const*>(file.data())),
+            _size(file.number_of_rows()) {
+        file.validate(kind::points, sizeof(T));
+      }
+
+      //! Returns the number of points.
+      //!
+      //! \exceptions
+      //! \noexcept
+      size_t size() const noexcept {
+        return _size;
+      }
+
+      //! Returns the point in position \p i.
+      //!
+      //! \warning No checks are performed on the argument.
+      //!
+      //! \exceptions
+      //! \noexcept
+      T const& operator[](size_t i) const noexcept {
+        return _data[i];
+      }
+
+      //! Returns a const_iterator pointing to the first point.
+      //!
+      //! \exceptions
+      //! \noexcept
+      const_iterator cbegin() const noexcept {
+        return _data;
+      }
+
+      //! Returns a const_iterator pointing one past the last point.
+      //!
+      //! \exceptions
+      //! \noexcept
+      const_iterator cend() const noexcept {
+        return _data + _size;
+      }
+
+     private:
+      T const* _data;
+      size_t   _size;
+    };
+
+    ////////////////////////////////////////////////////////////////////////
+    // Writing
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Write a table to a stream in binary format.
+    //!
+    //! Only the columns of \p table in use are written. This can be used to
+    //! save a Cayley graph of a FroidurePin instance, which can be read
+    //! back using read_table and used to prefill a ToddCoxeter instance.
+    //!
+    //! \param os the stream, which should be opened in binary mode.
+    //! \param table the table.
+    //!
+    //! \throws LibsemigroupsException if writing to \p os fails.
+    template <typename T, typename A>
+    void write(std::ostream& os, detail::DynamicArray2<T, A> const& table) {
+      detail::write_binary<T>(
+          os,
+          kind::table,
+          table.number_of_rows(),
+          table.number_of_cols(),
+          [&table](auto&& sink) {
+            std::vector<T> row(table.number_of_cols());
+            for (size_t i = 0; i < table.number_of_rows(); ++i) {
+              for (size_t j = 0; j < row.size(); ++j) {
+                row[j] = table.get(i, j);
+              }
+              sink(row.data(), row.size() * sizeof(T));
+            }
+          });
+    }
+
+    //! Write an ActionDigraph to a stream in binary format.
+    //!
+    //! \param os the stream, which should be opened in binary mode.
+    //! \param ad the digraph.
+    //!
+    //! \throws LibsemigroupsException if writing to \p os fails.
+    template <typename T>
+    void write(std::ostream& os, ActionDigraph<T> const& ad) {
+      detail::write_binary<T>(
+          os,
+          kind::digraph,
+          ad.number_of_nodes(),
+          ad.out_degree(),
+          [&ad](auto&& sink) {
+            std::vector<T> row(ad.out_degree());
+            for (T i = 0; i < ad.number_of_nodes(); ++i) {
+              for (T j = 0; j < ad.out_degree(); ++j) {
+                row[j] = ad.unsafe_neighbor(i, j);
+              }
+              sink(row.data(), row.size() * sizeof(T));
+            }
+          });
+    }
+
+    //! Write a Forest to a stream in binary format.
+    //!
+    //! \param os the stream, which should be opened in binary mode.
+    //! \param f the forest.
+    //!
+    //! \throws LibsemigroupsException if writing to \p os fails.
+    void write(std::ostream& os, Forest const& f);
+
+    //! Write the points in the range [\p first, \p last) to a stream in
+    //! binary format.
+    //!
+    //! For example, the points in the orbit of an Action \c o can be written
+    //! using `write_points(os, o.cbegin(), o.cend())`. The range is
+    //! traversed twice, and so \p first and \p last must be forward
+    //! iterators.
+    //!
+    //! \param os the stream, which should be opened in binary mode.
+    //! \param first iterator pointing to the first point.
+    //! \param last iterator pointing one past the last point.
+    //!
+    //! \throws LibsemigroupsException if writing to \p os fails.
+    template <typename TIteratorType>
+    void write_points(std::ostream& os,
+                      TIteratorType first,
+                      TIteratorType last) {
+      using point_type =
+          typename std::iterator_traits<TIteratorType>::value_type;
+      detail::write_binary<point_type>(
+          os,
+          kind::points,
+          std::distance(first, last),
+          1,
+          [&first, &last](auto&& sink) {
+            std::vector<point_type> buf;
+            buf.reserve(1024);
+            for (auto it = first; it != last; ++it) {
+              buf.push_back(*it);
+              if (buf.size() == 1024) {
+                sink(buf.data(), buf.size() * sizeof(point_type));
+                buf.clear();
+              }
+            }
+            sink(buf.data(), buf.size() * sizeof(point_type));
+          });
+    }
+
+    //! Write a vector of points to a stream in binary format.
+    //!
+    //! \param os the stream, which should be opened in binary mode.
+    //! \param points the points.
+    //!
+    //! \throws LibsemigroupsException if writing to \p os fails.
+    template <typename T>
+    void write(std::ostream& os, std::vector<T> const& points) {
+      detail::write_binary<T>(
+          os, kind::points, points.size(), 1, [&points](auto&& sink) {
+            sink(points.data(), points.size() * sizeof(T));
+          });
+    }
+
+    //! Write an object to a file in binary format.
+    //!
+    //! \param filename the name of the file, which is overwritten if it
+    //! already exists.
+    //! \param x the object, which can be of any type supported by write.
+    //!
+    //! \throws LibsemigroupsException if the file cannot be opened or
+    //! written.
+    template <typename T>
+    void write_file(std::string const& filename, T const& x) {
+      std::ofstream file(filename, std::ios::out | std::ios::binary);
+      if (!file) {
+        LIBSEMIGROUPS_EXCEPTION("cannot open the file %s for writing",
+                                filename.c_str());
+      }
+      write(file, x);
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Reading
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Copy a table stored in a MappedFile into a detail::DynamicArray2.
+    //!
+    //! The file can contain either a table or an ActionDigraph. The returned
+    //! value can, for example, be used to prefill a ToddCoxeter instance.
+    //!
+    //! \param file the file.
+    //!
+    //! \returns A value of type `detail::DynamicArray2<T>`.
+    //!
+    //! \throws LibsemigroupsException if the file does not contain a table or
+    //! an ActionDigraph, or if the size of its values is not \c sizeof(T).
+    template <typename T>
+    detail::DynamicArray2<T> read_table(MappedFile const& file) {
+      TableView<T>             view(file);
+      detail::DynamicArray2<T> table(view.number_of_cols(),
+                                     view.number_of_rows());
+      for (size_t i = 0; i < view.number_of_rows(); ++i) {
+        for (size_t j = 0; j < view.number_of_cols(); ++j) {
+          table.set(i, j, view.get(i, j));
+        }
+      }
+      return table;
+    }
+
+    //! Copy an ActionDigraph stored in a MappedFile.
+    //!
+    //! The file can contain either an ActionDigraph or a table.
+    //!
+    //! \param file the file.
+    //!
+    //! \returns A value of type `ActionDigraph<T>`.
+    //!
+    //! \throws LibsemigroupsException if the file does not contain an
+    //! ActionDigraph or a table, if the size of its values is not \c
+    //! sizeof(T), or if any of the targets is out of bounds.
+    template <typename T>
+    ActionDigraph<T> read_action_digraph(MappedFile const& file) {
+      TableView<T>     view(file);
+      ActionDigraph<T> ad(view.number_of_rows(), view.number_of_cols());
+      for (T i = 0; i < view.number_of_rows(); ++i) {
+        for (T j = 0; j < view.number_of_cols(); ++j) {
+          T const k = view.get(i, j);
+          if (k != UNDEFINED) {
+            ad.add_edge(i, k, j);
+          }
+        }
+      }
+      return ad;
+    }
+
+    //! Copy a Forest stored in a MappedFile.
+    //!
+    //! \param file the file.
+    //!
+    //! \returns A value of type Forest.
+    //!
+    //! \throws LibsemigroupsException if the file does not contain a Forest,
+    //! if it was written on a machine with a different size of \c size_t, or
+    //! if any of the parents is out of bounds.
+    Forest read_forest(MappedFile const& file);
+
+    //! Copy an array of points stored in a MappedFile.
+    //!
+    //! \param file the file.
+    //!
+    //! \returns A value of type `std::vector<T>`.
+    //!
+    //! \throws LibsemigroupsException if the file does not contain an array
+    //! of points, or if the size of its points is not \c sizeof(T).
+    template <typename T>
+    std::vector<T> read_points(MappedFile const& file) {
+      PointsView<T> view(file);
+      return std::vector<T>(view.cbegin(), view.cend());
+    }
+  }  // namespace binary
+}  // namespace libsemigroups
+
+#endif  // LIBSEMIGROUPS_BINARY_HPP_
@@ -22,11 +22,15 @@
 #ifndef LIBSEMIGROUPS_BITSET_HPP_
 #define LIBSEMIGROUPS_BITSET_HPP_
 
+#include <algorithm>    // for max, min
 #include <array>        // for array
 #include <bitset>       // for bitset
 #include <climits>      // for CHAR_BIT
 #include <cstddef>      // for size_t
+#include <cstdint>      // for uint64_t
+#include <functional>   // for hash
 #include <iosfwd>       // for operator<<, ostringstream
+#include <iterator>     // for distance
 #include <type_traits>  // for false_type
 #include <utility>      // for hash
 
@@ -101,14 +105,18 @@ namespace libsemigroups {
   }
 #endif
 
+  // A BitSet<N> with at most BitSet<1>::max_size() entries is stored in a
+  // single block, and one with more entries (at most 1024) is stored in an
+  // array of blocks. Every loop over the blocks has a number of iterations
+  // known at compile time, so that it is removed entirely for a single block,
+  // and can be unrolled and vectorised by the compiler for several blocks.
+  // The bits in the last block that do not correspond to entries can be set,
+  // and are cleared before they could affect the result of any member
+  // function.
   template <size_t N>
   class BitSet {
     static_assert(N > 0, "BitSet does not support 0 entries");
-#if LIBSEMIGROUPS_SIZEOF_VOID_P == 8
-    static_assert(N <= 64, "BitSet does not support more than 64 entries");
-#else
-    static_assert(N <= 32, "BitSet does not support more than 32 entries");
-#endif
+    static_assert(N <= 1024, "BitSet does not support more than 1024 entries");
 
    public:
     using block_type = std::conditional_t<
@@ -117,9 +125,20 @@ namespace libsemigroups {
         std::conditional_t<
             N <= 16,
             uint_fast16_t,
-            std::conditional_t<N <= 32, uint_fast32_t, uint64_t>>>;
+            std::conditional_t<
+                N <= 32,
+                uint_fast32_t,
+                std::conditional_t<LIBSEMIGROUPS_SIZEOF_VOID_P == 8,
+                                   uint64_t,
+                                   uint_fast32_t>>>>;
 
-    explicit constexpr BitSet(block_type block) noexcept : _block(block) {}
+   private:
+    static constexpr size_t BLOCK_SIZE = sizeof(block_type) * CHAR_BIT;
+    static constexpr size_t NR_BLOCKS  = (N + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+   public:
+    // Sets the first block, any other blocks are 0
+    explicit constexpr BitSet(block_type block) noexcept : _blocks{{block}} {}
     constexpr BitSet() noexcept : BitSet(0) {}
     constexpr BitSet(BitSet const&) noexcept = default;
     constexpr BitSet(BitSet&&) noexcept      = default;
@@ -150,24 +169,33 @@ namespace libsemigroups {
       return N;
     }
 
+    // The largest N such that BitSet<N> has a single block if this BitSet
+    // has a single block, and 1024 if it does not.
     static constexpr size_t max_size() noexcept {
 #if LIBSEMIGROUPS_SIZEOF_VOID_P == 8
-      return 64;
+      return N <= 64 ? 64 : 1024;
 #else
-      return 32;
+      return N <= 32 ? 32 : 1024;
 #endif
     }
 
+    // Compares the blocks as the digits of an integer, most significant
+    // first.
     bool operator<(BitSet const& that) const noexcept {
       clear_hi_bits();
       that.clear_hi_bits();
-      return _block < that._block;
+      for (size_t i = NR_BLOCKS; i-- > 1;) {
+        if (_blocks[i] != that._blocks[i]) {
+          return _blocks[i] < that._blocks[i];
+        }
+      }
+      return _blocks[0] < that._blocks[0];
     }
 
     bool operator==(BitSet const& that) const noexcept {
       clear_hi_bits();
       that.clear_hi_bits();
-      return _block == that._block;
+      return _blocks == that._blocks;
     }
 
     bool operator!=(BitSet const& that) const noexcept {
@@ -175,20 +203,32 @@ namespace libsemigroups {
     }
 
     void operator&=(BitSet const& that) const noexcept {
-      _block &= that._block;
+      for (size_t i = 0; i < NR_BLOCKS; ++i) {
+        _blocks[i] &= that._blocks[i];
+      }
     }
 
     BitSet<N> operator&(BitSet const& that) const noexcept {
-      return BitSet(_block & that._block);
+      BitSet result(*this);
+      result &= that;
+      return result;
     }
 
     void operator|=(BitSet const& that) const noexcept {
-      _block |= that._block;
+      for (size_t i = 0; i < NR_BLOCKS; ++i) {
+        _blocks[i] |= that._blocks[i];
+      }
+    }
+
+    BitSet<N> operator|(BitSet const& that) const noexcept {
+      BitSet result(*this);
+      result |= that;
+      return result;
     }
 
     bool test(size_t pos) const noexcept {
       LIBSEMIGROUPS_ASSERT(pos < N);
-      return _block & mask(pos);
+      return _blocks[pos / BLOCK_SIZE] & mask(pos % BLOCK_SIZE);
     }
 
     bool operator[](size_t pos) const noexcept {
@@ -196,16 +236,16 @@ namespace libsemigroups {
     }
 
     BitSet& set() noexcept {
-      _block = ~0;
+      _blocks.fill(~0);
       return *this;
     }
 
     BitSet& set(size_t pos, bool value = true) noexcept {
       LIBSEMIGROUPS_ASSERT(pos < N);
       if (value) {
-        _block |= mask(pos);
+        _blocks[pos / BLOCK_SIZE] |= mask(pos % BLOCK_SIZE);
       } else {
-        _block &= ~mask(pos);
+        _blocks[pos / BLOCK_SIZE] &= ~mask(pos % BLOCK_SIZE);
       }
       return *this;
     }
@@ -214,26 +254,31 @@ namespace libsemigroups {
       LIBSEMIGROUPS_ASSERT(first < N);
       LIBSEMIGROUPS_ASSERT(last <= N);
       LIBSEMIGROUPS_ASSERT(first < last);
-      block_type m = ~0;
-      m            = (m >> first);
-      m            = (m << (first + (block_count() - last)));
-      m            = (m >> (block_count() - last));
-      if (value) {
-        _block |= m;
-      } else {
-        _block &= ~m;
+      for (size_t i = first / BLOCK_SIZE; i <= (last - 1) / BLOCK_SIZE; ++i) {
+        // The bits in [lo, hi) of the i-th block are modified
+        size_t const lo = std::max(first, i * BLOCK_SIZE) - i * BLOCK_SIZE;
+        size_t const hi
+            = std::min(last, (i + 1) * BLOCK_SIZE) - i * BLOCK_SIZE;
+        block_type m = ~0;
+        m            = (m >> (BLOCK_SIZE - (hi - lo)));
+        m            = (m << lo);
+        if (value) {
+          _blocks[i] |= m;
+        } else {
+          _blocks[i] &= ~m;
+        }
       }
       return *this;
     }
 
     BitSet& reset() noexcept {
-      _block = 0;
+      _blocks.fill(0);
       return *this;
     }
 
     BitSet& reset(size_t pos) noexcept {
       LIBSEMIGROUPS_ASSERT(pos < N);
-      _block &= ~mask(pos);
+      _blocks[pos / BLOCK_SIZE] &= ~mask(pos % BLOCK_SIZE);
       return *this;
     }
 
@@ -246,21 +291,28 @@ namespace libsemigroups {
 
     size_t count() const noexcept {
       clear_hi_bits();
-      return COUNT_TRUES_BLOCK(_block);
+      size_t result = 0;
+      for (size_t i = 0; i < NR_BLOCKS; ++i) {
+        result += COUNT_TRUES_BLOCK(_blocks[i]);
+      }
+      return result;
     }
 
     template <typename S>
     void apply(S&& func) const {
 #if LIBSEMIGROUPS_USE_CLZLL && defined(LIBSEMIGROUPS_HAVE___BUILTIN_CLZLL)
-      block_type block = _block;
-      while (block != 0) {
-        block_type t = block & -block;
-        size_t     i = static_cast<size_t>(__builtin_ctzll(block));
-        if (i >= size()) {
-          break;
+      for (size_t j = 0; j < NR_BLOCKS; ++j) {
+        block_type block = _blocks[j];
+        while (block != 0) {
+          block_type t = block & -block;
+          size_t     i = j * BLOCK_SIZE
+                     + static_cast<size_t>(__builtin_ctzll(block));
+          if (i >= size()) {
+            break;
+          }
+          func(i);
+          block ^= t;
         }
-        func(i);
-        block ^= t;
       }
 #else
       for (size_t i = 0; i < size(); ++i) {
@@ -272,8 +324,10 @@ namespace libsemigroups {
     }
 
     block_type to_int() const noexcept {
+      static_assert(NR_BLOCKS == 1,
+                    "BitSet::to_int requires N <= BitSet<1>::max_size()");
       clear_hi_bits();
-      return _block;
+      return _blocks[0];
     }
 
     friend std::ostringstream& operator<<(std::ostringstream& os,
@@ -290,18 +344,16 @@ namespace libsemigroups {
     }
 
    private:
-    void clear_hi_bits() const noexcept {
-      size_t s = block_count() - N;
-      _block   = _block << s;
-      _block   = _block >> s;
-    }
+    friend struct std::hash<BitSet<N>>;
 
-    constexpr size_t block_count() const noexcept {
-      return sizeof(block_type) * CHAR_BIT;
+    void clear_hi_bits() const noexcept {
+      size_t s = NR_BLOCKS * BLOCK_SIZE - N;
+      _blocks[NR_BLOCKS - 1] = _blocks[NR_BLOCKS - 1] << s;
+      _blocks[NR_BLOCKS - 1] = _blocks[NR_BLOCKS - 1] >> s;
     }
 
     constexpr block_type mask(size_t i) const noexcept {
-      // LIBSEMIGROUPS_ASSERT(i < size());
+      // LIBSEMIGROUPS_ASSERT(i < BLOCK_SIZE);
       return static_cast<block_type>(MASK[i]);
     }
 
@@ -369,7 +421,7 @@ namespace libsemigroups {
                                           0x2000000000000000,
                                           0x4000000000000000,
                                           0x8000000000000000};
-    mutable block_type        _block;
+    mutable std::array<block_type, NR_BLOCKS> _blocks;
   };
 
   template <size_t N>
@@ -410,7 +462,13 @@ namespace std {
     using block_type = typename libsemigroups::BitSet<N>::block_type;
     size_t operator()(libsemigroups::BitSet<N> const& bs) const noexcept(
         std::is_nothrow_default_constructible<hash<block_type>>::value) {
-      return hash<block_type>()(bs.to_int());
+      bs.clear_hi_bits();
+      size_t seed = hash<block_type>()(bs._blocks[0]);
+      for (size_t i = 1; i < bs._blocks.size(); ++i) {
+        seed ^= hash<block_type>()(bs._blocks[i]) + 0x9e3779b97f4a7c16
+                + (seed << 6) + (seed >> 2);
+      }
+      return seed;
     }
   };
 }  // namespace std
@@ -398,6 +398,39 @@ namespace libsemigroups {
     // noexcept.
     static BMat8 random(size_t dim);
 
+    //! Construct a random BMat8 using a given generator.
+    //!
+    //! This static member function returns a BMat8 chosen at random using
+    //! the pseudo-random number generator \p mt. Unlike random(), which
+    //! uses a generator shared by the whole library and seeded
+    //! non-deterministically, the same BMat8 is returned for the same state
+    //! of \p mt.
+    //!
+    //! \param mt the pseudo-random number generator.
+    //!
+    //! \returns
+    //! A BMat8.
+    //!
+    //! \exceptions
+    //! \no_libsemigroups_except
+    static BMat8 random(std::mt19937& mt);
+
+    //! Construct a random BMat8 of dimension at most \p dim using a given
+    //! generator.
+    //!
+    //! This static member function returns a BMat8 chosen at random using
+    //! the pseudo-random number generator \p mt, where only the top-left
+    //! \p dim x \p dim entries can be non-zero.
+    //!
+    //! \param dim the dimension.
+    //! \param mt the pseudo-random number generator.
+    //!
+    //! \returns
+    //! A BMat8.
+    //!
+    //! \throws LibsemigroupsException if \p dim is \c 0 or greater than \c 8.
+    static BMat8 random(size_t dim, std::mt19937& mt);
+
     //! Swaps \c this with \p that.
     //!
     //! This member function swaps the values of \c this and \p that.
@@ -0,0 +1,269 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration of a class for computing a canonical
+// form of the multiplication table of a finite semigroup, which can be used
+// to decide whether or not two finite semigroups are isomorphic.
+
+#ifndef LIBSEMIGROUPS_CANONICAL_FORM_HPP_
+#define LIBSEMIGROUPS_CANONICAL_FORM_HPP_
+
+#include <cstddef>     // for size_t
+#include <functional>  // for hash
+#include <vector>      // for vector
+
+#include "froidure-pin-base.hpp"  // for FroidurePinBase
+
+namespace libsemigroups {
+  //! Defined in ``canonical-form.hpp``.
+  //!
+  //! This class computes a canonical form of a finite semigroup \f$S\f$
+  //! represented by a FroidurePinBase. The canonical form consists of a
+  //! bijection from \f$S\f$ to \f$\{0, \ldots, |S| - 1\}\f$, the *canonical
+  //! labelling*, and the multiplication table of \f$S\f$ with its elements
+  //! replaced by their labels, the *certificate*. Two finite semigroups are
+  //! isomorphic if and only if their certificates are equal, and so
+  //! comparing, or hashing, CanonicalForm objects can be used to find the
+  //! isomorphism classes in a collection of semigroups.
+  //!
+  //! The multiplication table is computed from the right Cayley graph of
+  //! \f$S\f$. The canonical labelling is found by partition refinement and
+  //! backtracking: the elements are repeatedly partitioned according to the
+  //! parts containing their products with every other element until the
+  //! partition is stable; if some part contains more than one element, then
+  //! each element in the first such part is individualised in turn, and the
+  //! search continues. The least certificate arising from a discrete
+  //! partition is the canonical one. Any two discrete partitions with the
+  //! same certificate give an automorphism of \f$S\f$, and the automorphisms
+  //! found are used to skip parts of the search that cannot produce a new
+  //! certificate. The subtrees below the first individualisation can be
+  //! searched in parallel.
+  //!
+  //! \par Example
+  //! \code
+  //! FroidurePin<Transf<>> S({Transf<>({1, 0, 2}), Transf<>({0, 0, 2})});
+  //! FroidurePin<Transf<>> T({Transf<>({0, 2, 1}), Transf<>({0, 1, 1})});
+  //! CanonicalForm(S) == CanonicalForm(T);  // true
+  //! \endcode
+  class CanonicalForm final {
+   public:
+    ////////////////////////////////////////////////////////////////////////
+    // CanonicalForm - typedefs - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! The type of indices of elements.
+    using element_index_type = FroidurePinBase::element_index_type;
+
+    ////////////////////////////////////////////////////////////////////////
+    // CanonicalForm - constructors - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Construct from a FroidurePinBase.
+    //!
+    //! The FroidurePinBase \p S is fully enumerated, and a canonical form of
+    //! \p S is computed using at most \p number_of_threads threads. \p S is
+    //! not required after the constructor returns.
+    //!
+    //! \param S the semigroup.
+    //! \param number_of_threads the maximum number of threads to use.
+    //!
+    //! \throws LibsemigroupsException if \p number_of_threads is \c 0.
+    //!
+    //! \warning If \p S is infinite, then the constructor never returns.
+    //!
+    //! \complexity
+    //! Exponential in the worst case, but typically polynomial in the size
+    //! of \p S.
+    explicit CanonicalForm(FroidurePinBase& S, size_t number_of_threads = 1);
+
+    //! Default copy constructor.
+    CanonicalForm(CanonicalForm const&) = default;
+
+    //! Default move constructor.
+    CanonicalForm(CanonicalForm&&) = default;
+
+    //! Default copy assignment operator.
+    CanonicalForm& operator=(CanonicalForm const&) = default;
+
+    //! Default move assignment operator.
+    CanonicalForm& operator=(CanonicalForm&&) = default;
+
+    ~CanonicalForm() = default;
+
+    ////////////////////////////////////////////////////////////////////////
+    // CanonicalForm - member functions - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Returns the size of the semigroup.
+    //!
+    //! \parameters
+    //! (None)
+    //!
+    //! \returns A value of type \c size_t.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t size() const noexcept {
+      return _labelling.size();
+    }
+
+    //! Returns the canonical label of an element.
+    //!
+    //! \param pos the position of an element in the FroidurePinBase used to
+    //! construct \c this.
+    //!
+    //! \returns A value of type \ref element_index_type.
+    //!
+    //! \throws LibsemigroupsException if \p pos is not less than size().
+    element_index_type label(element_index_type pos) const;
+
+    //! Returns the canonical labelling.
+    //!
+    //! The value in position \c i is the label of the element in position \c
+    //! i of the FroidurePinBase used to construct \c this. If the semigroup
+    //! has non-trivial automorphisms, then this is one of several labellings
+    //! with the same certificate.
+    //!
+    //! \parameters
+    //! (None)
+    //!
+    //! \returns
+    //! A const reference to a `std::vector<element_index_type>`.
+    //!
+    //! \exceptions
+    //! \noexcept
+    std::vector<element_index_type> const& labelling() const noexcept {
+      return _labelling;
+    }
+
+    //! Returns the product of two labels.
+    //!
+    //! \param i the label of the first element.
+    //! \param j the label of the second element.
+    //!
+    //! \returns
+    //! The label of the product of the elements with labels \p i and \p j.
+    //!
+    //! \throws LibsemigroupsException if \p i or \p j is not less than
+    //! size().
+    element_index_type product(element_index_type i,
+                               element_index_type j) const;
+
+    //! Returns the certificate.
+    //!
+    //! The certificate is the multiplication table of the semigroup, where
+    //! every element is replaced by its label, stored row by row. In other
+    //! words, the value in position \f$i \times |S| + j\f$ is
+    //! `product(i, j)`.
+    //!
+    //! \parameters
+    //! (None)
+    //!
+    //! \returns
+    //! A const reference to a `std::vector<element_index_type>`.
+    //!
+    //! \exceptions
+    //! \noexcept
+    std::vector<element_index_type> const& certificate() const noexcept {
+      return _certificate;
+    }
+
+    //! Returns a hash value of the certificate.
+    //!
+    //! The hash values of the canonical forms of isomorphic semigroups are
+    //! equal.
+    //!
+    //! \parameters
+    //! (None)
+    //!
+    //! \returns A value of type \c size_t.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t hash_value() const noexcept {
+      return _hash_value;
+    }
+
+    //! Returns the automorphisms found in the search.
+    //!
+    //! Every automorphism is given as a permutation of the positions of the
+    //! elements in the FroidurePinBase used to construct \c this. The
+    //! automorphisms found in the search need not generate the automorphism
+    //! group of the semigroup.
+    //!
+    //! \parameters
+    //! (None)
+    //!
+    //! \returns
+    //! A const reference to a `std::vector<std::vector<element_index_type>>`.
+    //!
+    //! \exceptions
+    //! \noexcept
+    std::vector<std::vector<element_index_type>> const&
+    automorphisms() const noexcept {
+      return _automorphisms;
+    }
+
+    //! Check if two canonical forms are equal.
+    //!
+    //! Two canonical forms are equal if and only if the semigroups used to
+    //! construct them are isomorphic.
+    //!
+    //! \param that the canonical form for comparison.
+    //!
+    //! \returns A value of type \c bool.
+    //!
+    //! \exceptions
+    //! \noexcept
+    bool operator==(CanonicalForm const& that) const noexcept {
+      return _hash_value == that._hash_value
+             && _certificate == that._certificate;
+    }
+
+    //! Check if two canonical forms are not equal.
+    //!
+    //! \param that the canonical form for comparison.
+    //!
+    //! \returns A value of type \c bool.
+    //!
+    //! \exceptions
+    //! \noexcept
+    bool operator!=(CanonicalForm const& that) const noexcept {
+      return !(*this == that);
+    }
+
+   private:
+    void validate_label(element_index_type i) const;
+
+    std::vector<std::vector<element_index_type>> _automorphisms;
+    std::vector<element_index_type>              _certificate;
+    size_t                                       _hash_value;
+    std::vector<element_index_type>              _labelling;
+  };
+}  // namespace libsemigroups
+
+namespace std {
+  template <>
+  struct hash<libsemigroups::CanonicalForm> {
+    size_t operator()(libsemigroups::CanonicalForm const& cf) const noexcept {
+      return cf.hash_value();
+    }
+  };
+}  // namespace std
+
+#endif  // LIBSEMIGROUPS_CANONICAL_FORM_HPP_
@@ -21,10 +21,12 @@
 #ifndef LIBSEMIGROUPS_CONG_INTF_HPP_
 #define LIBSEMIGROUPS_CONG_INTF_HPP_
 
-#include <cstddef>  // for size_t
-#include <memory>   // for shared_ptr
-#include <string>   // for string
-#include <vector>   // for vector
+#include <cstddef>   // for size_t, ptrdiff_t
+#include <iterator>  // for forward_iterator_tag
+#include <memory>    // for shared_ptr
+#include <string>    // for string
+#include <utility>   // for move
+#include <vector>    // for vector
 
 #include "exception.hpp"    // for LIBSEMIGROUPS_EXCEPTION
 #include "fpsemi-intf.hpp"  // for FpSemigroupInterface
@@ -39,6 +41,221 @@ namespace libsemigroups {
   //! be 2-sided, left, or right.
   enum class congruence_kind { left = 0, right = 1, twosided = 2 };
 
+  //! Defined in ``cong-intf.hpp``.
+  //!
+  //! This class represents the non-trivial classes of a congruence by the
+  //! indices of their elements in a FroidurePinBase. The indices of the
+  //! elements in every class are stored contiguously and in increasing order,
+  //! and so the memory used is proportional to the number of elements in
+  //! non-trivial classes. Words representing the elements are only produced
+  //! when the iterators returned by cbegin_words and cend_words are
+  //! dereferenced.
+  //!
+  //! \sa CongruenceInterface::non_trivial_class_indices.
+  class NonTrivialClasses {
+   public:
+    //! Type for indices of elements in froidure_pin().
+    using element_index_type = size_t;
+
+    //! Type for a `const_iterator` to the indices of the elements in a class.
+    using const_index_iterator
+        = std::vector<element_index_type>::const_iterator;
+
+    //! Return type of \ref cbegin_words and \ref cend_words.
+    class const_word_iterator {
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+     public:
+      using size_type         = size_t;
+      using difference_type   = std::ptrdiff_t;
+      using const_pointer     = word_type const*;
+      using pointer           = word_type const*;
+      using const_reference   = word_type const&;
+      using reference         = word_type const&;
+      using value_type        = word_type;
+      using iterator_category = std::forward_iterator_tag;
+
+      const_word_iterator()                           = default;
+      const_word_iterator(const_word_iterator const&) = default;
+      const_word_iterator(const_word_iterator&&)      = default;
+      const_word_iterator& operator=(const_word_iterator const&) = default;
+      const_word_iterator& operator=(const_word_iterator&&) = default;
+
+      const_word_iterator(FroidurePinBase const* ptr, const_index_iterator it)
+          : _froidure_pin(ptr), _it(it), _word() {}
+
+      ~const_word_iterator() = default;
+
+      bool operator==(const_word_iterator const& that) const noexcept {
+        return _it == that._it;
+      }
+
+      bool operator!=(const_word_iterator const& that) const noexcept {
+        return _it != that._it;
+      }
+
+      const_reference operator*() const;
+
+      const_pointer operator->() const {
+        return &(**this);
+      }
+
+      const_word_iterator& operator++() noexcept {
+        ++_it;
+        return *this;
+      }
+
+      const_word_iterator operator++(int) noexcept {
+        const_word_iterator copy(*this);
+        ++_it;
+        return copy;
+      }
+
+     private:
+      FroidurePinBase const* _froidure_pin;
+      const_index_iterator   _it;
+      mutable word_type      _word;
+#endif
+    };
+
+    //! Constructs from the classes of the elements of a FroidurePinBase.
+    //!
+    //! \param fp the FroidurePinBase whose elements are partitioned
+    //! \param first the position in \p elements of the first element of
+    //! every class, followed by `elements.size()`
+    //! \param elements the indices of the elements in the classes
+    //!
+    //! \exceptions
+    //! \noexcept
+    NonTrivialClasses(std::shared_ptr<FroidurePinBase>  fp,
+                      std::vector<size_t>&&             first,
+                      std::vector<element_index_type>&& elements) noexcept
+        : _elements(std::move(elements)),
+          _first(std::move(first)),
+          _froidure_pin(fp) {}
+
+    //! Default copy constructor.
+    NonTrivialClasses(NonTrivialClasses const&) = default;
+
+    //! Default move constructor.
+    NonTrivialClasses(NonTrivialClasses&&) = default;
+
+    //! Default copy assignment operator.
+    NonTrivialClasses& operator=(NonTrivialClasses const&) = default;
+
+    //! Default move assignment operator.
+    NonTrivialClasses& operator=(NonTrivialClasses&&) = default;
+
+    ~NonTrivialClasses() = default;
+
+    //! Returns the FroidurePinBase whose elements are indexed.
+    //!
+    //! \exceptions
+    //! \noexcept
+    std::shared_ptr<FroidurePinBase> froidure_pin() const noexcept {
+      return _froidure_pin;
+    }
+
+    //! Returns the number of non-trivial classes.
+    //!
+    //! \exceptions
+    //! \noexcept
+    //!
+    //! \complexity
+    //! Constant.
+    size_t number_of_classes() const noexcept {
+      return _first.size() - 1;
+    }
+
+    //! Returns the number of elements in all of the non-trivial classes.
+    //!
+    //! \exceptions
+    //! \noexcept
+    //!
+    //! \complexity
+    //! Constant.
+    size_t number_of_elements() const noexcept {
+      return _elements.size();
+    }
+
+    //! Returns the number of elements in the class with index \p i.
+    //!
+    //! \param i the index of a class
+    //!
+    //! \throws LibsemigroupsException if \p i is not less than
+    //! number_of_classes().
+    //!
+    //! \complexity
+    //! Constant.
+    size_t size(size_t i) const {
+      validate_class_index(i);
+      return _first[i + 1] - _first[i];
+    }
+
+    //! Returns a const iterator pointing to the index of the first element
+    //! of the class with index \p i.
+    //!
+    //! \param i the index of a class
+    //!
+    //! \throws LibsemigroupsException if \p i is not less than
+    //! number_of_classes().
+    const_index_iterator cbegin(size_t i) const {
+      validate_class_index(i);
+      return _elements.cbegin() + _first[i];
+    }
+
+    //! Returns a const iterator pointing one past the index of the last
+    //! element of the class with index \p i.
+    //!
+    //! \param i the index of a class
+    //!
+    //! \throws LibsemigroupsException if \p i is not less than
+    //! number_of_classes().
+    const_index_iterator cend(size_t i) const {
+      validate_class_index(i);
+      return _elements.cbegin() + _first[i + 1];
+    }
+
+    //! Returns a const iterator pointing to a word representing the first
+    //! element of the class with index \p i.
+    //!
+    //! The words are minimal factorisations in froidure_pin(), and are
+    //! computed when the iterator is dereferenced.
+    //!
+    //! \param i the index of a class
+    //!
+    //! \throws LibsemigroupsException if \p i is not less than
+    //! number_of_classes().
+    const_word_iterator cbegin_words(size_t i) const {
+      return const_word_iterator(_froidure_pin.get(), cbegin(i));
+    }
+
+    //! Returns a const iterator pointing one past a word representing the
+    //! last element of the class with index \p i.
+    //!
+    //! \param i the index of a class
+    //!
+    //! \throws LibsemigroupsException if \p i is not less than
+    //! number_of_classes().
+    const_word_iterator cend_words(size_t i) const {
+      return const_word_iterator(_froidure_pin.get(), cend(i));
+    }
+
+   private:
+    void validate_class_index(size_t i) const {
+      if (i >= number_of_classes()) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "class index out of bounds, expected value in [0, %d), got %d",
+            number_of_classes(),
+            i);
+      }
+    }
+
+    std::vector<element_index_type>  _elements;
+    std::vector<size_t>              _first;
+    std::shared_ptr<FroidurePinBase> _froidure_pin;
+  };
+
   //! Defined in ``cong-intf.hpp``.
   //!
   //! Every class for representing congruences in ``libsemigroups`` is derived
@@ -282,9 +499,10 @@ namespace libsemigroups {
     //! \throws LibsemigroupsException if \p u or \p v contains a letter that
     //! is out of bounds.
     //!
-    //! \throws LibsemigroupsException if started() returns `true` indicating
-    //! that the underlying algorithm has been applied (partially or
-    //! fully) to the data structure.
+    //! \throws LibsemigroupsException if running() returns `true`, or if
+    //! started() returns `true` and the derived class does not support adding
+    //! generating pairs after the underlying algorithm has been applied
+    //! (partially or fully) to the data structure.
     //!
     //! \complexity
     //! Linear in `u.size() + v.size()`.
@@ -391,6 +609,32 @@ namespace libsemigroups {
       return _non_trivial_classes;
     }
 
+    //! Returns the non-trivial classes given by indices of elements.
+    //!
+    //! The returned object contains the non-trivial classes of the
+    //! congruence, each given by the indices of its elements in
+    //! parent_froidure_pin(), in the order of their class indices. The
+    //! classes are found by determining the class of every element of
+    //! parent_froidure_pin() and then grouping the elements by class using a
+    //! counting sort, which is performed in parallel if
+    //! parent_froidure_pin() is large enough. Words representing the elements
+    //! are only produced when they are required.
+    //!
+    //! \returns A \shared_ptr to NonTrivialClasses.
+    //!
+    //! \throws LibsemigroupsException if has_parent_froidure_pin() returns
+    //! `false`.
+    //!
+    //! \complexity
+    //! See warnings.
+    //!
+    //! \warning The problem of determining the return value of this function
+    //! is undecidable in general, and this function may never terminate.
+    //!
+    //! \par Parameters
+    //! (None)
+    std::shared_ptr<NonTrivialClasses const> non_trivial_class_indices();
+
     //! The number of generators.
     //!
     //! This function returns the number of generators of the semigroup of the
@@ -769,6 +1013,11 @@ namespace libsemigroups {
     virtual std::shared_ptr<non_trivial_classes_type const>
     non_trivial_classes_impl();
 
+    // Sets out[i] to be the class index of the element of fp in position i,
+    // fp must be fully enumerated and out must be of size fp.size().
+    virtual void class_indices_impl(FroidurePinBase const&         fp,
+                                    std::vector<class_index_type>& out);
+
     virtual bool is_quotient_obviously_finite_impl() = 0;
     // virtual bool is_quotient_obviously_finite_impl() {
     //   return false;
@@ -778,6 +1027,13 @@ namespace libsemigroups {
       return false;
     }
 
+    // Returns true if generating pairs can be added after this has been
+    // started, i.e. if add_pair_impl can be called when started() and
+    // !running(), and false if not.
+    virtual bool incremental_impl() const noexcept {
+      return false;
+    }
+
     /////////////////////////////////////////////////////////////////////////
     // CongruenceInterface - non-virtual functions - private
     /////////////////////////////////////////////////////////////////////////
@@ -816,6 +1072,8 @@ namespace libsemigroups {
     mutable std::shared_ptr<FroidurePinBase> _quotient;
     mutable std::shared_ptr<non_trivial_classes_type const>
         _non_trivial_classes;
+    mutable std::shared_ptr<NonTrivialClasses const>
+        _non_trivial_class_indices;
 
     /////////////////////////////////////////////////////////////////////////
     // CongruenceInterface - static data members - private
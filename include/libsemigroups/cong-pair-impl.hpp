@@ -132,16 +132,102 @@ namespace libsemigroups {
     return parent_froidure_pin()->size() - _class_lookup.size() + _next_class;
   }
 
-#pragma GCC diagnostic push
-#if (defined(__GNUC__) && !(defined(__clang__) || defined(__INTEL_COMPILER)))
-#pragma GCC diagnostic ignored "-Wsuggest-attribute=noreturn"
-#endif
+  // The quotient is constructed from the right Cayley graph of the parent
+  // and the classes of its elements, without multiplying any elements. The
+  // classes are numbered so that the classes of the generators come first,
+  // which is what the FroidurePin<TCE> of the quotient requires.
   TEMPLATE
   std::shared_ptr<FroidurePinBase> P_CLASS::quotient_impl() {
-    // TODO(later) actually implement this
-    LIBSEMIGROUPS_EXCEPTION("not yet implemented");
+    using detail::TCE;
+    using table_type = TCE::Table;
+    run();
+    if (!finished()) {
+      // If the enumeration was killed, then _nr_non_trivial_classes and
+      // _class_lookup are not defined.
+      LIBSEMIGROUPS_EXCEPTION(
+          "cannot compute the quotient, the enumeration did not finish");
+    }
+    auto&        S     = *parent_froidure_pin();
+    auto const&  right = S.right_cayley_graph();
+    size_t const N     = S.size();
+    auto&        fp    = static_cast<froidure_pin_type&>(S);
+
+    // The class of every element of S, the non-trivial classes are numbered
+    // [0, _nr_non_trivial_classes), and the singleton class of the element in
+    // position i is numbered _nr_non_trivial_classes + i.
+    std::vector<size_t> raw(N);
+    std::iota(raw.begin(), raw.end(), _nr_non_trivial_classes);
+    for (size_t ind = 0; ind < _nr_non_trivial_elemnts; ++ind) {
+      raw[fp.position(this->to_external_const(_reverse_map[ind]))]
+          = _class_lookup[ind];
+    }
+
+    std::vector<size_t> label(_nr_non_trivial_classes + N,
+                              static_cast<size_t>(UNDEFINED));
+    std::vector<size_t> rep;
+    rep.reserve(number_of_classes());
+    auto add_label = [&label, &raw, &rep](size_t pos) {
+      if (label[raw[pos]] == UNDEFINED) {
+        label[raw[pos]] = rep.size();
+        rep.push_back(pos);
+      }
+    };
+    for (letter_type a = 0; a < S.number_of_generators(); ++a) {
+      add_label(S.current_position(a));
+    }
+    // The columns of the table correspond to the distinct classes of
+    // generators, the letters of these are stored in col_to_gen.
+    size_t const             nr_cols = rep.size();
+    std::vector<letter_type> col_to_gen;
+    for (letter_type a = 0; a < S.number_of_generators(); ++a) {
+      if (label[raw[S.current_position(a)]] == col_to_gen.size()) {
+        col_to_gen.push_back(a);
+      }
+    }
+    LIBSEMIGROUPS_ASSERT(col_to_gen.size() == nr_cols);
+    for (size_t pos = 0; pos < N; ++pos) {
+      add_label(pos);
+    }
+    size_t const n = rep.size();
+    LIBSEMIGROUPS_ASSERT(n == number_of_classes());
+
+    // Row 0 of the table corresponds to the identity adjoined by TCE, and row
+    // i + 1 to the class with label i.
+    auto table = std::make_shared<table_type>(nr_cols, n + 1);
+    for (size_t c = 0; c < nr_cols; ++c) {
+      table->set(0, c, c + 1);
+    }
+    auto fill = [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        for (size_t c = 0; c < nr_cols; ++c) {
+          table->set(
+              i + 1, c, label[raw[right.get(rep[i], col_to_gen[c])]] + 1);
+        }
+      }
+    };
+    size_t const nr_threads
+        = (n < S.concurrency_threshold() ? 1 : S.max_threads());
+    if (nr_threads == 1) {
+      fill(0, n);
+    } else {
+      std::vector<std::thread> threads;
+      size_t const             chunk = n / nr_threads;
+      for (size_t t = 0; t < nr_threads; ++t) {
+        threads.emplace_back(
+            fill, t * chunk, (t == nr_threads - 1 ? n : (t + 1) * chunk));
+      }
+      for (auto& t : threads) {
+        t.join();
+      }
+    }
+
+    auto ptr = std::make_shared<
+        FroidurePin<TCE, FroidurePinTraits<TCE, table_type>>>(table);
+    for (letter_type a = 0; a < S.number_of_generators(); ++a) {
+      ptr->add_generator(TCE(label[raw[S.current_position(a)]] + 1));
+    }
+    return ptr;
   }
-#pragma GCC diagnostic pop
 
   VOID P_CLASS::run_impl() {
     detail::Timer t;
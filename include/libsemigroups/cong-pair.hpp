@@ -61,7 +61,9 @@
 
 #include <cstddef>        // for size_t
 #include <memory>         // for shared_ptr
+#include <numeric>        // for iota
 #include <queue>          // for queue
+#include <thread>         // for thread
 #include <unordered_map>  // for unordered_map
 #include <unordered_set>  // for unordered_set
 #include <utility>        // for pair
@@ -74,6 +76,7 @@
 #include "froidure-pin.hpp"      // for FroidurePin
 #include "kbe.hpp"               // for detail::KBE
 #include "knuth-bendix.hpp"      // for fpsemigroup::KnuthBendix
+#include "tce.hpp"               // for detail::TCE
 #include "types.hpp"             // for word_type
 #include "uf.hpp"                // for Duf
 
@@ -206,6 +206,10 @@ namespace libsemigroups {
       return _wrapped_cong->finished();
     }
 
+    size_t memory_usage_impl() const noexcept override {
+      return _wrapped_cong->memory_usage();
+    }
+
     void add_rule_impl(std::string const& u, std::string const& v) override {
       // This is only ever called if u and v are valid
       _wrapped_cong->add_pair(string_to_word(u), string_to_word(v));
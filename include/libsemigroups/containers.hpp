@@ -25,14 +25,16 @@
 #include <type_traits>  // for is_default_constructible
 #include <vector>       // for vector, allocator
 
-#include "debug.hpp"     // for LIBSEMIGROUPS_ASSERT
-#include "iterator.hpp"  // for ConstIteratorStateful, ConstItera...
+#include "allocator.hpp"  // for PolicyAllocator
+#include "debug.hpp"      // for LIBSEMIGROUPS_ASSERT
+#include "iterator.hpp"   // for ConstIteratorStateful, ConstItera...
 
 namespace libsemigroups {
   namespace detail {
 
-    // Template class for 2-dimnensional dynamic arrays.
-    template <typename T, typename A = std::allocator<T>>
+    // Template class for 2-dimnensional dynamic arrays. The default allocator
+    // uses operator new, unless it is replaced using set_allocator.
+    template <typename T, typename A = PolicyAllocator<T>>
     class DynamicArray2 final {
       // So that DynamicArray2<T> can access private data members of
       // DynamicArray2<S> and vice versa.
@@ -240,9 +242,9 @@ namespace libsemigroups {
         if (_nr_rows != 0) {
           _vec.resize(new_nr_cols * _nr_rows, _default_val);
 
-          typename std::vector<T>::iterator old_it(
+          typename std::vector<T, A>::iterator old_it(
               _vec.begin() + (old_nr_cols * _nr_rows) - old_nr_cols);
-          typename std::vector<T>::iterator new_it(
+          typename std::vector<T, A>::iterator new_it(
               _vec.begin() + (new_nr_cols * _nr_rows) - new_nr_cols);
 
           while (old_it != _vec.begin()) {
@@ -297,6 +299,19 @@ namespace libsemigroups {
         }
       }
 
+      allocator_type get_allocator() const noexcept {
+        return _vec.get_allocator();
+      }
+
+      // Replaces the allocator, copying the contents of the array into memory
+      // obtained from alloc if alloc is not equal to the current allocator.
+      // Not noexcept because std::vector::vector can throw.
+      void set_allocator(allocator_type const& alloc) {
+        if (alloc != _vec.get_allocator()) {
+          _vec = std::vector<T, A>(_vec.cbegin(), _vec.cend(), alloc);
+        }
+      }
+
       // Not noexcept
       void reserve(size_t number_of_rows) {
         _vec.reserve(number_of_rows * (_nr_unused_cols + _nr_used_cols));
@@ -18,10 +18,13 @@
 #ifndef LIBSEMIGROUPS_DIGRAPH_HELPER_HPP_
 #define LIBSEMIGROUPS_DIGRAPH_HELPER_HPP_
 
-#include <cstddef>  // for size_t
-#include <stack>    // for stack
-#include <utility>  // for pair
-#include <vector>   // for vector
+#include <algorithm>  // for any_of, max, stable_sort
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint64_t
+#include <numeric>    // for iota
+#include <stack>      // for stack
+#include <utility>    // for pair, swap
+#include <vector>     // for vector
 
 #include "constants.hpp"  // for UNDEFINED
 #include "exception.hpp"  // for LIBSEMIGROUPS_EXCEPTION
@@ -96,6 +99,338 @@ namespace libsemigroups {
       return last;
     }
 
+    //! Find the coarsest partition of the nodes compatible with the edges.
+    //!
+    //! Returns the coarsest partition of the nodes of \p ad that refines the
+    //! initial partition \p initial and is compatible with the edges of \p
+    //! ad; two nodes \c u and \c v belong to the same part if and only if,
+    //! for every word \c w, the nodes reached from \c u and \c v by following
+    //! \c w belong to the same part of \p initial, or both paths contain an
+    //! undefined edge. If \p ad is the transition graph of a deterministic
+    //! automaton, and \p initial separates the accept states from the reject
+    //! states, then the parts are the states of the minimal automaton.
+    //!
+    //! The partition is computed using Hopcroft's algorithm.
+    //!
+    //! \tparam T the type used as the template parameter for the ActionDigraph.
+    //!
+    //! \param ad the ActionDigraph.
+    //! \param initial the initial partition, the value in position \c v is
+    //! the part containing the node \c v (defaults to the partition with a
+    //! single part).
+    //!
+    //! \returns
+    //! A value of type `std::vector<T>`, the value in position \c v is the
+    //! index of the part containing the node \c v. The parts are numbered
+    //! \f$0, 1, \ldots\f$ in order of their least node.
+    //!
+    //! \throws LibsemigroupsException if \p initial is not empty and its size
+    //! is not ActionDigraph::number_of_nodes.
+    //!
+    //! \par Complexity
+    //! \f$O(kn\log n)\f$ where \f$n\f$ is the number of nodes and \f$k\f$ is
+    //! the out-degree of \p ad.
+    //!
+    //! \par Example
+    //! \code
+    //! ActionDigraph<size_t> ad;
+    //! ad.add_nodes(4);
+    //! ad.add_to_out_degree(1);
+    //! ad.add_edge(0, 1, 0);
+    //! ad.add_edge(1, 0, 0);
+    //! ad.add_edge(2, 3, 0);
+    //! ad.add_edge(3, 2, 0);
+    //! // returns {0, 0, 0, 0}
+    //! action_digraph_helper::coarsest_stable_partition(ad);
+    //! // returns {0, 1, 0, 1}
+    //! action_digraph_helper::coarsest_stable_partition(ad, {0, 1, 0, 1});
+    //! \endcode
+    template <typename T>
+    std::vector<T> coarsest_stable_partition(ActionDigraph<T> const& ad,
+                                             std::vector<T> const& initial
+                                             = {}) {
+      size_t const n = ad.number_of_nodes();
+      size_t const k = ad.out_degree();
+      if (!initial.empty() && initial.size() != n) {
+        LIBSEMIGROUPS_EXCEPTION("expected a vector of size %llu, found %llu",
+                                uint64_t(n),
+                                uint64_t(initial.size()));
+      }
+      // The node n is a sink that is the target of every undefined edge, and
+      // that forms a part of its own.
+      size_t const N = n + 1;
+
+      // The sources of the edges with label a and target v are
+      // pred[pred_first[a * (N + 1) + v]], ...,
+      // pred[pred_first[a * (N + 1) + v + 1] - 1].
+      std::vector<size_t> pred_first(k * (N + 1) + 1, 0);
+      std::vector<size_t> pred(k * N);
+      auto target = [&ad, n](size_t v, size_t a) -> size_t {
+        if (v == n) {
+          return n;
+        }
+        node_type<T> const w = ad.unsafe_neighbor(v, a);
+        return (w == UNDEFINED ? n : w);
+      };
+      for (size_t a = 0; a < k; ++a) {
+        for (size_t v = 0; v < N; ++v) {
+          pred_first[a * (N + 1) + target(v, a) + 1]++;
+        }
+      }
+      for (size_t i = 1; i < pred_first.size(); ++i) {
+        pred_first[i] += pred_first[i - 1];
+      }
+      {
+        std::vector<size_t> pos(pred_first.cbegin(), pred_first.cend() - 1);
+        for (size_t a = 0; a < k; ++a) {
+          for (size_t v = 0; v < N; ++v) {
+            pred[pos[a * (N + 1) + target(v, a)]++] = v;
+          }
+        }
+      }
+
+      // The elements of every part are stored contiguously in elems, the part
+      // b consists of elems[first[b]], ..., elems[end[b] - 1], and the marked
+      // elements of b are elems[first[b]], ..., elems[mid[b] - 1].
+      std::vector<size_t> elems(N), loc(N), part(N);
+      std::vector<size_t> first, mid, end;
+      {
+        std::vector<size_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        if (!initial.empty()) {
+          std::stable_sort(
+              order.begin(), order.end(), [&initial](size_t u, size_t v) {
+                return initial[u] < initial[v];
+              });
+        }
+        for (size_t i = 0; i < n; ++i) {
+          if (i == 0
+              || (!initial.empty()
+                  && initial[order[i]] != initial[order[i - 1]])) {
+            first.push_back(i);
+            end.push_back(i);
+          }
+          elems[i] = order[i];
+          end.back()++;
+        }
+        first.push_back(n);
+        end.push_back(N);
+        elems[n] = n;
+        mid = first;
+        for (size_t b = 0; b < first.size(); ++b) {
+          for (size_t i = first[b]; i < end[b]; ++i) {
+            loc[elems[i]] = i;
+            part[elems[i]] = b;
+          }
+        }
+      }
+
+      // Every pair (b, a) in the worklist is a splitter, the part b with
+      // the label a; every pair is in the worklist at most once.
+      std::vector<std::pair<size_t, size_t>> worklist;
+      std::vector<bool>                      in_worklist(N * k, false);
+      auto                                   push = [&](size_t b, size_t a) {
+        worklist.emplace_back(b, a);
+        in_worklist[b * k + a] = true;
+      };
+      {
+        size_t largest = 0;
+        for (size_t b = 1; b < first.size(); ++b) {
+          if (end[b] - first[b] > end[largest] - first[largest]) {
+            largest = b;
+          }
+        }
+        for (size_t b = 0; b < first.size(); ++b) {
+          if (b != largest) {
+            for (size_t a = 0; a < k; ++a) {
+              push(b, a);
+            }
+          }
+        }
+      }
+
+      std::vector<size_t> sources, touched;
+      while (!worklist.empty()) {
+        size_t const b = worklist.back().first;
+        size_t const a = worklist.back().second;
+        worklist.pop_back();
+        in_worklist[b * k + a] = false;
+
+        sources.clear();
+        for (size_t i = first[b]; i < end[b]; ++i) {
+          size_t const v = elems[i];
+          sources.insert(sources.end(),
+                         pred.cbegin() + pred_first[a * (N + 1) + v],
+                         pred.cbegin() + pred_first[a * (N + 1) + v + 1]);
+        }
+        // Mark the sources, moving them to the front of their parts
+        touched.clear();
+        for (auto u : sources) {
+          size_t const c = part[u];
+          if (loc[u] < mid[c]) {
+            continue;  // already marked
+          }
+          if (mid[c] == first[c]) {
+            touched.push_back(c);
+          }
+          size_t const w = elems[mid[c]];
+          std::swap(elems[loc[u]], elems[mid[c]]);
+          std::swap(loc[u], loc[w]);
+          mid[c]++;
+        }
+        // Split the touched parts into their marked and unmarked elements
+        for (auto c : touched) {
+          if (mid[c] == end[c]) {
+            mid[c] = first[c];
+            continue;
+          }
+          size_t const d = first.size();
+          first.push_back(first[c]);
+          mid.push_back(first[c]);
+          end.push_back(mid[c]);
+          first[c] = mid[c];
+          for (size_t i = first[d]; i < end[d]; ++i) {
+            part[elems[i]] = d;
+          }
+          for (size_t e = 0; e < k; ++e) {
+            if (in_worklist[c * k + e]) {
+              push(d, e);
+            } else if (end[d] - first[d] <= end[c] - first[c]) {
+              push(d, e);
+            } else {
+              push(c, e);
+            }
+          }
+        }
+      }
+
+      std::vector<T> result(n);
+      std::vector<T> index(first.size(), static_cast<T>(UNDEFINED));
+      T              next = 0;
+      for (size_t v = 0; v < n; ++v) {
+        if (index[part[v]] == static_cast<T>(UNDEFINED)) {
+          index[part[v]] = next++;
+        }
+        result[v] = index[part[v]];
+      }
+      return result;
+    }
+
+    //! Returns the quotient of an ActionDigraph by a partition of its nodes.
+    //!
+    //! The nodes of the returned ActionDigraph are the parts of the partition
+    //! \p classes of the nodes of \p ad, and there is an edge from the part
+    //! \c b to the part \c c with label \c a if and only if there is such an
+    //! edge from every node in \c b to a node in \c c. Every node in a part
+    //! must have its edge with label \c a leading into the same part, or
+    //! every such edge must be undefined, in which case the edge with label
+    //! \c a from the part is also undefined.
+    //!
+    //! \tparam T the type used as the template parameter for the ActionDigraph.
+    //!
+    //! \param ad the ActionDigraph.
+    //! \param classes the partition, the value in position \c v is the index
+    //! of the part containing the node \c v; the indices of the parts must be
+    //! \f$0, 1, \ldots, m - 1\f$ for some \f$m\f$.
+    //!
+    //! \returns
+    //! A value of type ActionDigraph<T> with \f$m\f$ nodes and the same
+    //! out-degree as \p ad.
+    //!
+    //! \throws LibsemigroupsException if the size of \p classes is not
+    //! ActionDigraph::number_of_nodes, if the indices of the parts are not
+    //! \f$0, 1, \ldots, m - 1\f$, or if the partition is not compatible with
+    //! the edges of \p ad.
+    //!
+    //! \par Complexity
+    //! \f$O(kn)\f$ where \f$n\f$ is the number of nodes and \f$k\f$ is the
+    //! out-degree of \p ad.
+    template <typename T>
+    ActionDigraph<T> quotient(ActionDigraph<T> const& ad,
+                              std::vector<T> const&   classes) {
+      size_t const n = ad.number_of_nodes();
+      size_t const k = ad.out_degree();
+      if (classes.size() != n) {
+        LIBSEMIGROUPS_EXCEPTION("expected a vector of size %llu, found %llu",
+                                uint64_t(n),
+                                uint64_t(classes.size()));
+      }
+      size_t m = 0;
+      for (auto c : classes) {
+        if (c >= n) {
+          LIBSEMIGROUPS_EXCEPTION("expected values in the range [0, %llu), "
+                                  "found %llu",
+                                  uint64_t(n),
+                                  uint64_t(c));
+        }
+        m = std::max(m, size_t(c) + 1);
+      }
+      // rep[c] is the least node in the part c
+      std::vector<T> rep(m, static_cast<T>(UNDEFINED));
+      for (size_t v = 0; v < n; ++v) {
+        if (rep[classes[v]] == static_cast<T>(UNDEFINED)) {
+          rep[classes[v]] = v;
+        }
+      }
+      if (std::any_of(rep.cbegin(), rep.cend(), [](T v) {
+            return v == static_cast<T>(UNDEFINED);
+          })) {
+        LIBSEMIGROUPS_EXCEPTION("expected the values to be 0, 1, ..., %llu",
+                                uint64_t(m - 1));
+      }
+      ActionDigraph<T> result(m, k);
+      for (size_t v = 0; v < n; ++v) {
+        for (size_t a = 0; a < k; ++a) {
+          node_type<T> const w = ad.unsafe_neighbor(v, a);
+          node_type<T> const x = ad.unsafe_neighbor(rep[classes[v]], a);
+          if ((w == UNDEFINED) != (x == UNDEFINED)
+              || (w != UNDEFINED && classes[w] != classes[x])) {
+            LIBSEMIGROUPS_EXCEPTION("the nodes %llu and %llu belong to the "
+                                    "same part, but their edges with label "
+                                    "%llu do not",
+                                    uint64_t(rep[classes[v]]),
+                                    uint64_t(v),
+                                    uint64_t(a));
+          }
+          if (w != UNDEFINED && size_t(rep[classes[v]]) == v) {
+            result.add_edge(classes[v], classes[w], a);
+          }
+        }
+      }
+      return result;
+    }
+
+    //! Returns the minimal quotient of an ActionDigraph.
+    //!
+    //! Returns the quotient of \p ad by coarsest_stable_partition(ad,
+    //! initial). If \p ad is the transition graph of a deterministic
+    //! automaton, and \p initial separates the accept states from the reject
+    //! states, then the returned ActionDigraph is the transition graph of the
+    //! minimal automaton, and the node \c v of \p ad corresponds to the node
+    //! `coarsest_stable_partition(ad, initial)[v]` of the returned
+    //! ActionDigraph.
+    //!
+    //! \tparam T the type used as the template parameter for the ActionDigraph.
+    //!
+    //! \param ad the ActionDigraph.
+    //! \param initial the initial partition (defaults to the partition with a
+    //! single part).
+    //!
+    //! \returns
+    //! A value of type ActionDigraph<T>.
+    //!
+    //! \throws LibsemigroupsException if \p initial is not empty and its size
+    //! is not ActionDigraph::number_of_nodes.
+    //!
+    //! \par Complexity
+    //! \f$O(kn\log n)\f$ where \f$n\f$ is the number of nodes and \f$k\f$ is
+    //! the out-degree of \p ad.
+    template <typename T>
+    ActionDigraph<T> minimise(ActionDigraph<T> const& ad,
+                              std::vector<T> const&   initial = {}) {
+      return quotient(ad, coarsest_stable_partition(ad, initial));
+    }
+
     namespace detail {
       template <typename T>
       using stack_type  = std::stack<std::pair<node_type<T>, label_type<T>>>;
@@ -26,15 +26,22 @@
 #ifndef LIBSEMIGROUPS_DIGRAPH_HPP_
 #define LIBSEMIGROUPS_DIGRAPH_HPP_
 
-#include <algorithm>    // for uniform_int_distribution
-#include <cstddef>      // for size_t
-#include <iterator>     // for forward_iterator_tag, distance
-#include <queue>        // for queue
-#include <random>       // for mt19937
-#include <stack>        // for stack
-#include <type_traits>  // for is_integral, is_unsigned
-#include <utility>      // for pair
-#include <vector>       // for vector
+#include <algorithm>      // for uniform_int_distribution
+#include <cmath>          // for exp, log
+#include <cstddef>        // for size_t
+#include <iterator>       // for forward_iterator_tag, distance
+#include <limits>         // for numeric_limits
+#include <memory>         // for shared_ptr
+#include <mutex>          // for mutex, lock_guard
+#include <numeric>        // for partial_sum
+#include <queue>          // for queue
+#include <random>         // for mt19937, uniform_real_distribution
+#include <stack>          // for stack
+#include <string>         // for string
+#include <type_traits>    // for is_integral, is_unsigned
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for pair
+#include <vector>         // for vector
 
 #include "containers.hpp"      // for DynamicArray2
 #include "debug.hpp"           // for LIBSEMIGROUPS_ASSERT
@@ -54,6 +61,37 @@ namespace libsemigroups {
       return 0.0015 * N + 2.43;
     }
 
+    // Returns the decimal representation of the natural number whose base
+    // 2 ^ 32 digits, least significant first, are in x.
+    static inline std::string to_decimal_string(std::vector<uint32_t>&& x) {
+      std::string out;
+      while (!x.empty() && x.back() == 0) {
+        x.pop_back();
+      }
+      if (x.empty()) {
+        return "0";
+      }
+      while (!x.empty()) {
+        // Divide x by 10 ^ 9 in place, the remainder consists of the next 9
+        // decimal digits.
+        uint64_t rem = 0;
+        for (auto it = x.rbegin(); it != x.rend(); ++it) {
+          uint64_t const cur = (rem << 32) | *it;
+          *it                = static_cast<uint32_t>(cur / 1000000000);
+          rem                = cur % 1000000000;
+        }
+        while (!x.empty() && x.back() == 0) {
+          x.pop_back();
+        }
+        for (size_t i = 0; i < 9 && (!x.empty() || rem != 0); ++i) {
+          out.push_back(static_cast<char>('0' + rem % 10));
+          rem /= 10;
+        }
+      }
+      std::reverse(out.begin(), out.end());
+      return out;
+    }
+
     // Implemented at end of this file.
     template <typename T>
     IntMat<0, 0, int64_t> adjacency_matrix(ActionDigraph<T> const& ad);
@@ -1009,7 +1047,9 @@ namespace libsemigroups {
     //!
     //! Returns a Forest comprised of spanning trees for each
     //! scc of \c this, rooted on the minimum node of that component, with
-    //! edges oriented away from the root.
+    //! edges oriented away from the root. The ancestor table of the returned
+    //! Forest is initialised (see Forest::init_ancestor_table), so that the
+    //! depths of, and paths to the roots from, its nodes are found quickly.
     //!
     //! \returns
     //! A const reference to a Forest.
@@ -1052,6 +1092,7 @@ namespace libsemigroups {
             queue.pop();
           } while (!queue.empty());
         }
+        _scc_forest._forest.init_ancestor_table();
         _scc_forest._defined = true;
       }
       return _scc_forest._forest;
@@ -1061,7 +1102,9 @@ namespace libsemigroups {
     //!
     //! Returns a Forest comprised of spanning trees for each
     //! scc of \c this, rooted on the minimum node of that component, with
-    //! edges oriented towards the root.
+    //! edges oriented towards the root. The ancestor table of the returned
+    //! Forest is initialised (see Forest::init_ancestor_table), so that the
+    //! depths of, and paths to the roots from, its nodes are found quickly.
     //!
     //! \returns
     //! A const reference to a Forest.
@@ -1120,11 +1163,139 @@ namespace libsemigroups {
             queue.pop();
           }
         }
+        _scc_back_forest._forest.init_ancestor_table();
         _scc_back_forest._defined = true;
       }
       return _scc_back_forest._forest;
     }
 
+    ////////////////////////////////////////////////////////////////////////
+    // ActionDigraph - paths - private
+    ////////////////////////////////////////////////////////////////////////
+
+   private:
+    // The depth first search underlying the path iterators and visit_paths.
+    // The nodes on the current path are stored in an explicit stack, and the
+    // edge labels of the current path (and its last node) are modified in
+    // place, so that no words are copied when moving to the next path. If
+    // target is not UNDEFINED, then only paths ending at target are found,
+    // and only nodes from which target can be reached are entered.
+    class PathStack final {
+     public:
+      PathStack() : PathStack(nullptr, UNDEFINED) {}
+
+      PathStack(ActionDigraph const* ptr, node_type target)
+          : _digraph(ptr),
+            _edge(UNDEFINED),
+            _found(false),
+            _max(0),
+            _min(0),
+            _nodes(),
+            _reach(),
+            _target(target),
+            _value({}, UNDEFINED) {}
+
+      // Start again from source, reusing the memory already allocated.
+      // not noexcept because can_reach isn't
+      void init(node_type source, size_t min, size_t max) {
+        _edge  = UNDEFINED;
+        _found = false;
+        _max   = max;
+        _min   = min;
+        _nodes.clear();
+        _value.first.clear();
+        _value.second = source;
+        if (_min < _max) {
+          if (_target != UNDEFINED && _reach == nullptr) {
+            _reach = _digraph->can_reach(_target);
+          }
+          if (_reach == nullptr || (*_reach)[source]) {
+            _nodes.push_back(source);
+          }
+        }
+      }
+
+      // Move to the next path, and return false if there isn't one.
+      // not noexcept because std::vector::push_back isn't
+      bool next() {
+        if (_nodes.empty()) {
+          return false;
+        } else if (_edge == UNDEFINED) {
+          // first call
+          _edge = 0;
+          if (_min == 0) {
+            _found = true;
+            if (_target == UNDEFINED || _nodes.front() == _target) {
+              // the empty path
+              return true;
+            }
+          }
+        }
+        word_type& path = _value.first;
+        do {
+          node_type next;
+          std::tie(next, _edge)
+              = _digraph->unsafe_next_neighbor(_nodes.back(), _edge);
+          if (next != UNDEFINED && path.size() < _max - 1) {
+            if (_reach != nullptr && !(*_reach)[next]) {
+              // _target cannot be reached via this edge
+              ++_edge;
+              continue;
+            }
+            _nodes.push_back(next);
+            path.push_back(_edge);
+            _edge = 0;
+            if (path.size() >= _min) {
+              _found = true;
+              if (_target == UNDEFINED || next == _target) {
+                _value.second = next;
+                return true;
+              }
+            }
+          } else {
+            _nodes.pop_back();
+            if (!path.empty()) {
+              _edge = path.back() + 1;
+              path.pop_back();
+            }
+          }
+        } while (!_nodes.empty());
+        return false;
+      }
+
+      // noexcept because comparison of std::vector<node_type>'s is noexcept
+      // because comparision of node_type's is noexcept
+      bool operator==(PathStack const& that) const noexcept {
+        return _nodes == that._nodes;
+      }
+
+      // Returns true if a path of length at least min (not necessarily ending
+      // at target) was found since the last call to init.
+      bool found() const noexcept {
+        return _found;
+      }
+
+      std::pair<word_type, node_type> const& value() const noexcept {
+        return _value;
+      }
+
+      ActionDigraph const& digraph() const noexcept {
+        return *_digraph;
+      }
+
+     private:
+      ActionDigraph const*                     _digraph;
+      label_type                               _edge;
+      bool                                     _found;
+      size_t                                   _max;
+      size_t                                   _min;
+      std::vector<node_type>                   _nodes;
+      std::shared_ptr<std::vector<bool> const> _reach;
+      node_type                                _target;
+      std::pair<word_type, node_type>          _value;
+    };
+
+   public:
     ////////////////////////////////////////////////////////////////////////
     // ActionDigraph - paths - public
     ////////////////////////////////////////////////////////////////////////
@@ -1173,25 +1344,15 @@ namespace libsemigroups {
                             node_type const      source,
                             size_type const      min,
                             size_type const      max)
-          : _edges({}, source),
-            _digraph(ptr),
-            _edge(UNDEFINED),
-            _min(min),
-            _max(max),
-            _nodes() {
-        if (_min < _max) {
-          _nodes.push_back(source);
-          if (_min != 0) {
-            ++(*this);
-          }
-        }
+          : _stack(ptr, UNDEFINED) {
+        _stack.init(source, min, max);
+        _stack.next();
       }
 
       //! No doc
-      // noexcept because comparison of std::vector<node_type>'s is noexcept
-      // because comparision of node_type's is noexcept
+      // noexcept because PathStack::operator== is noexcept
       bool operator==(const_panilo_iterator const& that) const noexcept {
-        return _nodes == that._nodes;
+        return _stack == that._stack;
       }
 
       //! No doc
@@ -1202,45 +1363,18 @@ namespace libsemigroups {
 
       //! No doc
       const_reference operator*() const noexcept {
-        return _edges;
+        return _stack.value();
       }
 
       //! No doc
       const_pointer operator->() const noexcept {
-        return &_edges;
+        return &_stack.value();
       }
 
       //! No doc
-      // prefix - not noexcept because std::vector::push_back isn't
+      // prefix - not noexcept because PathStack::next isn't
       const_panilo_iterator const& operator++() {
-        if (_nodes.empty()) {
-          return *this;
-        } else if (_edge == UNDEFINED) {
-          // first call
-          _edge = 0;
-        }
-
-        do {
-          node_type next;
-          std::tie(next, _edge)
-              = _digraph->unsafe_next_neighbor(_nodes.back(), _edge);
-          if (next != UNDEFINED && _edges.first.size() < _max - 1) {
-            _nodes.push_back(next);
-            _edges.first.push_back(_edge);
-            _edge = 0;
-            if (_edges.first.size() >= _min) {
-              _edges.second = next;
-              return *this;
-            }
-          } else {
-            _nodes.pop_back();
-            if (!_edges.first.empty()) {
-              _edge = _edges.first.back() + 1;
-              _edges.first.pop_back();
-            }
-          }
-        } while (!_nodes.empty());
-
+        _stack.next();
         return *this;
       }
 
@@ -1254,26 +1388,16 @@ namespace libsemigroups {
 
       //! No doc
       void swap(const_panilo_iterator& that) noexcept {
-        std::swap(_edges, that._edges);
-        std::swap(_digraph, that._digraph);
-        std::swap(_edge, that._edge);
-        std::swap(_min, that._min);
-        std::swap(_max, that._max);
-        std::swap(_nodes, that._nodes);
+        std::swap(_stack, that._stack);
       }
 
       //! No doc
       ActionDigraph const& digraph() const noexcept {
-        return *_digraph;
+        return _stack.digraph();
       }
 
      private:
-      value_type             _edges;
-      ActionDigraph const*   _digraph;
-      label_type             _edge;
-      size_t                 _min;
-      size_t                 _max;
-      std::vector<node_type> _nodes;
+      PathStack _stack;
     };  // const_panilo_iterator
 
     // Assert that the forward iterator requirements are met
@@ -1357,9 +1481,9 @@ namespace libsemigroups {
     // Note that while the complexity of this is bad, it repeatedly does depth
     // first searches, and so will examine every node and edge of the graph
     // multiple times (if u -a-> v belongs to a path of length 10, then it will
-    // be traversed 10 times). But the performance of this iterator is
-    // dominated by memory allocation (when creating
-    // iterators, at least), and so this doesn't seem that bad.
+    // be traversed 10 times). Every depth first search reuses the memory of
+    // the previous one, and so no memory is allocated after the longest path
+    // so far has been found.
     //! Return type of cbegin_panislo and cend_panislo.
     class const_panislo_iterator final {
      public:
@@ -1381,7 +1505,7 @@ namespace libsemigroups {
       using iterator_category = std::forward_iterator_tag;
 
       // None of the constructors are noexcept because the corresponding
-      // constructors for const_panilo_iterator are not.
+      // constructors for std::vector aren't (until C++17).
       //! No doc
       const_panislo_iterator() = default;
       //! No doc
@@ -1401,21 +1525,30 @@ namespace libsemigroups {
                              node_type const      source,
                              size_type const      min,
                              size_type const      max)
+          : const_panislo_iterator(ptr, source, UNDEFINED, min, max) {}
+
+      //! No doc
+      // Only the paths ending at target are found, unless target is
+      // UNDEFINED.
+      const_panislo_iterator(ActionDigraph const* ptr,
+                             node_type const      source,
+                             node_type const      target,
+                             size_type const      min,
+                             size_type const      max)
           : _length(min >= max ? UNDEFINED : min),
-            _it(),
             _max(max),
-            _source(source) {
+            _source(source),
+            _stack(ptr, target) {
         if (_length != UNDEFINED) {
-          _it = ptr->cbegin_panilo(source, _length, _length + 1);
-        } else {
-          _it = ptr->cend_panilo();
+          _stack.init(_source, _length, _length + 1);
+          ++(*this);
         }
       }
 
       //! No doc
-      // noexcept because comparison of const_panilo_iterator is noexcept
+      // noexcept because PathStack::operator== is noexcept
       bool operator==(const_panislo_iterator const& that) const noexcept {
-        return _length == that._length && _it == that._it;
+        return _length == that._length && _stack == that._stack;
       }
 
       //! No doc
@@ -1426,27 +1559,29 @@ namespace libsemigroups {
 
       //! No doc
       const_reference operator*() const noexcept {
-        return *_it;
+        return _stack.value();
       }
 
       //! No doc
       const_pointer operator->() const noexcept {
-        return &(*_it);
+        return &_stack.value();
       }
 
       //! No doc
-      // prefix - not noexcept because cbegin_panilo isn't
+      // prefix - not noexcept because PathStack::next isn't
       const_panislo_iterator const& operator++() {
-        ++_it;
-        if (_it == _it.digraph().cend_panilo()) {
-          if (_length < _max - 1) {
+        if (_length == UNDEFINED) {
+          return *this;
+        }
+        while (!_stack.next()) {
+          // If there are no paths of length _length, then there are no
+          // longer paths either.
+          if (_stack.found() && _length < _max - 1) {
             ++_length;
-            _it = _it.digraph().cbegin_panilo(_source, _length, _length + 1);
-            if (_it == _it.digraph().cend_panilo()) {
-              _length = UNDEFINED;
-            }
+            _stack.init(_source, _length, _length + 1);
           } else {
             _length = UNDEFINED;
+            break;
           }
         }
         return *this;
@@ -1463,16 +1598,16 @@ namespace libsemigroups {
       //! No doc
       void swap(const_panislo_iterator& that) noexcept {
         std::swap(_length, that._length);
-        std::swap(_it, that._it);
         std::swap(_max, that._max);
         std::swap(_source, that._source);
+        std::swap(_stack, that._stack);
       }
 
      private:
-      size_type             _length;
-      const_panilo_iterator _it;
-      size_type             _max;
-      node_type             _source;
+      size_type _length;
+      size_type _max;
+      node_type _source;
+      PathStack _stack;
     };
 
     // Assert that the forward iterator requirements are met
@@ -1784,24 +1919,17 @@ namespace libsemigroups {
                             node_type const      target,
                             size_type const      min,
                             size_type const      max)
-          : _edges({}),
-            _digraph(ptr),
-            _edge(UNDEFINED),
-            _min(min),
-            _max(max),
-            _nodes(),
-            _target(target) {
-        if (_min < _max) {
-          _nodes.push_back(source);
-          ++(*this);
-        }
+          : _stack(ptr, target) {
+        // The nodes that can reach target are cached by the digraph, and
+        // shared by all iterators with the same target.
+        _stack.init(source, min, max);
+        _stack.next();
       }
 
       //! No doc
-      // noexcept because comparison of std::vector<node_type> is noexcept
-      // because comparision of node_type's is noexcept
+      // noexcept because PathStack::operator== is noexcept
       bool operator==(const_pstilo_iterator const& that) const noexcept {
-        return _nodes == that._nodes;
+        return _stack == that._stack;
       }
 
       //! No doc
@@ -1812,55 +1940,19 @@ namespace libsemigroups {
 
       //! No doc
       const_reference operator*() const noexcept {
-        return _edges;
+        return _stack.value().first;
       }
 
       //! No doc
       const_pointer operator->() const noexcept {
-        return &_edges;
+        return &_stack.value().first;
       }
 
       // prefix
       //! No doc
-      // not noexcept because std::vector::push_back isn't
+      // not noexcept because PathStack::next isn't
       const_pstilo_iterator const& operator++() {
-        if (_nodes.empty()) {
-          return *this;
-        } else if (_edge == UNDEFINED) {
-          // first call
-          _edge = 0;
-          init_can_reach_target();
-          if (_min == 0 && _nodes.front() == _target) {
-            // special case if the source == target, and we allow words of
-            // length 0, then we return the empty word here.
-            return *this;
-          }
-        }
-
-        do {
-          node_type next;
-          std::tie(next, _edge)
-              = _digraph->unsafe_next_neighbor(_nodes.back(), _edge);
-          if (next != UNDEFINED && _edges.size() < _max - 1) {
-            // Avoid infinite loops when we can never reach _target
-            if (_can_reach_target[next]) {
-              _nodes.push_back(next);
-              _edges.push_back(_edge);
-              _edge = 0;
-              if (_edges.size() >= _min && next == _target) {
-                return *this;
-              }
-            } else {
-              _edge++;
-            }
-          } else {
-            _nodes.pop_back();
-            if (!_edges.empty()) {
-              _edge = _edges.back() + 1;
-              _edges.pop_back();
-            }
-          }
-        } while (!_nodes.empty());
+        _stack.next();
         return *this;
       }
 
@@ -1875,59 +1967,11 @@ namespace libsemigroups {
 
       //! No doc
       void swap(const_pstilo_iterator& that) noexcept {
-        std::swap(_edges, that._edges);
-        std::swap(_digraph, that._digraph);
-        std::swap(_edge, that._edge);
-        std::swap(_min, that._min);
-        std::swap(_max, that._max);
-        std::swap(_nodes, that._nodes);
-        std::swap(_target, that._target);
+        std::swap(_stack, that._stack);
       }
 
      private:
-      void init_can_reach_target() {
-        if (_can_reach_target.empty()) {
-          std::vector<std::vector<node_type>> in_neighbours(
-              _digraph->number_of_nodes(), std::vector<node_type>({}));
-          for (auto n = _digraph->cbegin_nodes(); n != _digraph->cend_nodes();
-               ++n) {
-            for (auto e = _digraph->cbegin_edges(*n);
-                 e != _digraph->cend_edges(*n);
-                 ++e) {
-              if (*e != UNDEFINED) {
-                in_neighbours[*e].push_back(*n);
-              }
-            }
-          }
-
-          _can_reach_target.resize(_digraph->number_of_nodes(), false);
-          _can_reach_target[_target]   = true;
-          std::vector<node_type>& todo = in_neighbours[_target];
-          std::vector<node_type>  next;
-
-          while (!todo.empty()) {
-            for (auto& m : todo) {
-              if (_can_reach_target[m] == 0) {
-                _can_reach_target[m] = true;
-                next.insert(next.end(),
-                            in_neighbours[m].cbegin(),
-                            in_neighbours[m].cend());
-              }
-            }
-            std::swap(next, todo);
-            next.clear();
-          }
-        }
-      }
-
-      std::vector<bool>      _can_reach_target;
-      value_type             _edges;
-      ActionDigraph const*   _digraph;
-      label_type             _edge;
-      size_t                 _min;
-      size_t                 _max;
-      std::vector<node_type> _nodes;
-      node_type              _target;
+      PathStack _stack;
     };  // const_pstilo_iterator
 
     // Assert that the forward iterator requirements are met
@@ -2004,65 +2048,11 @@ namespace libsemigroups {
       return const_pstilo_iterator(this, 0, 0, 0, 0);
     }
 
-   private:
-    // PSTISLO
-    // This is a traits class for ConstIteratorStateful in iterator.hpp
-    struct PstisloIteratorTraits {
-      using state_type             = std::pair<node_type, /* terminal node */
-                                   const_panislo_iterator /* cend */>;
-      using internal_iterator_type = const_panislo_iterator;
-      using value_type             = word_type;
-      using reference              = value_type&;
-      using const_reference        = value_type const&;
-      using difference_type        = std::ptrdiff_t;
-      using size_type              = std::size_t;
-      using const_pointer          = value_type const*;
-      using pointer                = value_type*;
-      using iterator_category      = std::forward_iterator_tag;
-
-      struct Deref {
-        //! No doc
-        const_reference
-        operator()(state_type&,
-                   internal_iterator_type const& it) const noexcept {
-          return it->first;
-        }
-      };
-
-      struct AddressOf {
-        //! No doc
-        const_pointer operator()(state_type&, internal_iterator_type const& it)
-            const noexcept {
-          return &it->first;
-        }
-      };
-
-      struct PrefixIncrement {
-        //! No doc
-        // not noexcept because const_panislo_iterator::operator++ isn't
-        void operator()(state_type& st, internal_iterator_type& it) const {
-          if (st.first != UNDEFINED) {
-            ++it;
-            while (it->second != st.first && it != st.second) {
-              ++it;
-            }
-            if (it == st.second) {
-              st.first = UNDEFINED;
-            }
-          }
-        }
-      };
-
-      using EqualTo          = void;
-      using NotEqualTo       = void;
-      using PostfixIncrement = void;
-      using Swap             = void;
-    };
-
    public:
+    // PSTISLO
     //! Return type of \ref cbegin_pstislo and \ref cend_pstislo.
-    using const_pstislo_iterator
-        = detail::ConstIteratorStateful<PstisloIteratorTraits>;
+    using const_pstislo_iterator = detail::ConstIteratorStateless<
+        PiloOrPisloIteratorTraits<const_panislo_iterator>>;
 
     static_assert(std::is_default_constructible<const_pstislo_iterator>::value,
                   "forward iterator requires default-constructible");
@@ -2118,17 +2108,12 @@ namespace libsemigroups {
                                           size_t    min = 0,
                                           size_t    max
                                           = POSITIVE_INFINITY) const {
-      using state_type = typename const_pstislo_iterator::state_type;
       // source & target are validated in is_reachable.
       if (!action_digraph_helper::is_reachable(*this, source, target)) {
         return cend_pstislo();
       }
-      auto st = state_type(target, cend_panislo());
-      auto it = cbegin_panislo(source, min, max);
-      if (it->second != target) {
-        typename PstisloIteratorTraits::PrefixIncrement()(st, it);
-      }
-      return const_pstislo_iterator(st, it);
+      return const_pstislo_iterator(
+          const_panislo_iterator(this, source, target, min, max));
     }
 
     //! Returns an iterator for PSTISLO (Path Source Target In Short Lex
@@ -2143,9 +2128,101 @@ namespace libsemigroups {
     //! \sa cbegin_pstislo
     // not noexcept because cend_panislo isn't
     const_pstislo_iterator cend_pstislo() const {
-      using state_type = typename const_pstislo_iterator::state_type;
-      return const_pstislo_iterator(state_type(UNDEFINED, cend_panislo()),
-                                    cend_panislo());
+      return const_pstislo_iterator(cend_panislo());
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // ActionDigraph - visiting paths - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Visit every path from a node in lex order.
+    //!
+    //! Calls \p visitor for the edge labels of every path (in
+    //! lexicographical order) starting at \p source with length in the range
+    //! \f$[min, max)\f$, and the last node of that path. The first argument
+    //! of \p visitor is a reference to a \ref word_type that is modified in
+    //! place as the paths are enumerated, and so no words are copied unless
+    //! \p visitor copies them. The traversal stops early if \p visitor
+    //! returns \c false.
+    //!
+    //! \tparam TVisitor the type of \p visitor, which must be callable with
+    //! arguments of type `word_type const&` and \ref node_type and return a
+    //! value convertible to `bool`.
+    //!
+    //! \param source the source node
+    //! \param min the minimum length of a path to visit
+    //! \param max the maximum length of a path to visit
+    //! \param visitor the function to call for every path
+    //!
+    //! \returns
+    //! (None)
+    //!
+    //! \throws LibsemigroupsException if \p source is not a node in the
+    //! digraph.
+    //!
+    //! \complexity
+    //! Linear in the number of paths visited (and their lengths).
+    //!
+    //! \warning
+    //! If the action digraph represented by \c this contains a cycle that is
+    //! reachable from \p source, then there are infinitely many paths starting
+    //! at \p source, and so \p max should be chosen with some care.
+    //!
+    //! \sa cbegin_panilo
+    template <typename TVisitor>
+    void visit_paths(node_type  source,
+                     size_t     min,
+                     size_t     max,
+                     TVisitor&& visitor) const {
+      action_digraph_helper::validate_node(*this, source);
+      visit_paths_impl(source, UNDEFINED, min, max, visitor);
+    }
+
+    //! Visit every path from one node to another in lex order.
+    //!
+    //! Calls \p visitor for the edge labels of every path (in
+    //! lexicographical order) starting at \p source and ending at \p target
+    //! with length in the range \f$[min, max)\f$, and \p target. Only the
+    //! nodes from which \p target can be reached are entered, the set of
+    //! these nodes is computed once per target and then cached until \c this
+    //! is next modified. The traversal stops early if \p visitor returns \c
+    //! false.
+    //!
+    //! \tparam TVisitor the type of \p visitor, which must be callable with
+    //! arguments of type `word_type const&` and \ref node_type and return a
+    //! value convertible to `bool`.
+    //!
+    //! \param source the first node
+    //! \param target the last node
+    //! \param min the minimum length of a path to visit
+    //! \param max the maximum length of a path to visit
+    //! \param visitor the function to call for every path
+    //!
+    //! \returns
+    //! (None)
+    //!
+    //! \throws LibsemigroupsException if \p target or \p source is not a node
+    //! in the digraph.
+    //!
+    //! \complexity
+    //! Linear in the number of paths visited (and their lengths), plus the
+    //! number of nodes and edges the first time \p target is used.
+    //!
+    //! \warning
+    //! If the action digraph represented by \c this contains a cycle that is
+    //! reachable from \p source, then there may be infinitely many paths
+    //! starting at \p source, and so \p max should be chosen with some care.
+    //!
+    //! \sa cbegin_pstilo
+    template <typename TVisitor>
+    void visit_paths(node_type  source,
+                     node_type  target,
+                     size_t     min,
+                     size_t     max,
+                     TVisitor&& visitor) const {
+      action_digraph_helper::validate_node(*this, source);
+      action_digraph_helper::validate_node(*this, target);
+      visit_paths_impl(source, target, min, max, visitor);
     }
 
     ////////////////////////////////////////////////////////////////////////
@@ -2304,7 +2381,7 @@ namespace libsemigroups {
 
       switch (lgrthm) {
         case algorithm::dfs:
-          return std::distance(cbegin_panilo(source, min, max), cend_panilo());
+          return number_of_paths_dfs(source, UNDEFINED, min, max);
         case algorithm::matrix:
           return number_of_paths_matrix(source, min, max);
         case algorithm::acyclic:
@@ -2414,8 +2491,7 @@ namespace libsemigroups {
           if (number_of_paths_special(source, target, min, max)) {
             return POSITIVE_INFINITY;
           }
-          return std::distance(cbegin_pstilo(source, target, min, max),
-                               cend_pstilo());
+          return number_of_paths_dfs(source, target, min, max);
         case algorithm::matrix:
           return number_of_paths_matrix(source, target, min, max);
         case algorithm::acyclic:
@@ -2434,6 +2510,209 @@ namespace libsemigroups {
       }
     }
 
+    //! Returns the number of paths from a node modulo an integer.
+    //!
+    //! Returns the number of paths starting at \p source with length in
+    //! the range \f$[min, max)\f$ modulo \p modulus. The numbers of paths of
+    //! every length ending at every node are computed one length at a time,
+    //! reduced modulo \p modulus, and so the result is correct even when the
+    //! actual number of paths exceeds \f$2 ^ {64}\f$.
+    //!
+    //! \param source the source node
+    //! \param min the minimum length of a path
+    //! \param max the maximum length of a path
+    //! \param modulus the modulus
+    //!
+    //! \returns
+    //! A value of type `uint64_t`.
+    //!
+    //! \throws LibsemigroupsException if:
+    //! * \p source is not a node in the digraph;
+    //! * \p modulus is \c 0; or
+    //! * \p max is \ref POSITIVE_INFINITY and there is a cycle reachable from
+    //!   \p source.
+    //!
+    //! \complexity
+    //! At worst \f$O(kmn)\f$ where \f$k\f$ equals \p max, \f$m\f$ is the
+    //! out-degree, and \f$n\f$ is the number of nodes.
+    uint64_t number_of_paths_modulo(node_type source,
+                                    size_t    min,
+                                    size_t    max,
+                                    uint64_t  modulus) const {
+      action_digraph_helper::validate_node(*this, source);
+      return number_of_paths_modulo_impl(source, UNDEFINED, min, max, modulus);
+    }
+
+    //! Returns the number of paths between a pair of nodes modulo an integer.
+    //!
+    //! Returns the number of paths starting at \p source and ending at \p
+    //! target with length in the range \f$[min, max)\f$ modulo \p modulus.
+    //!
+    //! \param source the first node
+    //! \param target the last node
+    //! \param min the minimum length of a path
+    //! \param max the maximum length of a path
+    //! \param modulus the modulus
+    //!
+    //! \returns
+    //! A value of type `uint64_t`.
+    //!
+    //! \throws LibsemigroupsException if:
+    //! * \p source or \p target is not a node in the digraph;
+    //! * \p modulus is \c 0; or
+    //! * \p max is \ref POSITIVE_INFINITY and there is a cycle reachable from
+    //!   \p source.
+    //!
+    //! \complexity
+    //! At worst \f$O(kmn)\f$ where \f$k\f$ equals \p max, \f$m\f$ is the
+    //! out-degree, and \f$n\f$ is the number of nodes.
+    uint64_t number_of_paths_modulo(node_type source,
+                                    node_type target,
+                                    size_t    min,
+                                    size_t    max,
+                                    uint64_t  modulus) const {
+      action_digraph_helper::validate_node(*this, source);
+      action_digraph_helper::validate_node(*this, target);
+      return number_of_paths_modulo_impl(source, target, min, max, modulus);
+    }
+
+    //! Returns the exact number of paths from a node.
+    //!
+    //! Returns the decimal representation of the number of paths starting at
+    //! \p source with length in the range \f$[min, max)\f$. The numbers of
+    //! paths of every length ending at every node are stored as multi-word
+    //! integers, and so the result is correct however large it is.
+    //!
+    //! \param source the source node
+    //! \param min the minimum length of a path
+    //! \param max the maximum length of a path
+    //!
+    //! \returns
+    //! A value of type `std::string`.
+    //!
+    //! \throws LibsemigroupsException if:
+    //! * \p source is not a node in the digraph; or
+    //! * \p max is \ref POSITIVE_INFINITY and there is a cycle reachable from
+    //!   \p source.
+    //!
+    //! \complexity
+    //! At worst \f$O(kmnw)\f$ where \f$k\f$ equals \p max, \f$m\f$ is the
+    //! out-degree, \f$n\f$ is the number of nodes, and \f$w\f$ is the number
+    //! of 32-bit words required to store the result.
+    std::string number_of_paths_exact(node_type source,
+                                      size_t    min,
+                                      size_t    max) const {
+      action_digraph_helper::validate_node(*this, source);
+      return number_of_paths_exact_impl(source, UNDEFINED, min, max);
+    }
+
+    //! Returns the exact number of paths between a pair of nodes.
+    //!
+    //! Returns the decimal representation of the number of paths starting at
+    //! \p source and ending at \p target with length in the range \f$[min,
+    //! max)\f$.
+    //!
+    //! \param source the first node
+    //! \param target the last node
+    //! \param min the minimum length of a path
+    //! \param max the maximum length of a path
+    //!
+    //! \returns
+    //! A value of type `std::string`.
+    //!
+    //! \throws LibsemigroupsException if:
+    //! * \p source or \p target is not a node in the digraph; or
+    //! * \p max is \ref POSITIVE_INFINITY and there is a cycle reachable from
+    //!   \p source.
+    //!
+    //! \complexity
+    //! At worst \f$O(kmnw)\f$ where \f$k\f$ equals \p max, \f$m\f$ is the
+    //! out-degree, \f$n\f$ is the number of nodes, and \f$w\f$ is the number
+    //! of 32-bit words required to store the result.
+    std::string number_of_paths_exact(node_type source,
+                                      node_type target,
+                                      size_t    min,
+                                      size_t    max) const {
+      action_digraph_helper::validate_node(*this, source);
+      action_digraph_helper::validate_node(*this, target);
+      return number_of_paths_exact_impl(source, target, min, max);
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // ActionDigraph - random paths - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Returns a random path from a node.
+    //!
+    //! Returns the labels of the edges of a path of length \p length starting
+    //! at \p source, chosen uniformly at random from all such paths. The
+    //! numbers of paths of every length at most \p length starting at every
+    //! node are computed, and then the edges of the path are chosen one at a
+    //! time, each with probability proportional to the number of paths that
+    //! it can be extended to. None of the paths are enumerated, and so this
+    //! is feasible even when there are very many paths.
+    //!
+    //! \param source the source node
+    //! \param length the length of the path
+    //! \param mt a std::mt19937 used as a random source
+    //!
+    //! \returns
+    //! A value of type \ref word_type.
+    //!
+    //! \throws LibsemigroupsException if:
+    //! * \p source is not a node in the digraph; or
+    //! * there is no path of length \p length starting at \p source.
+    //!
+    //! \complexity
+    //! \f$O(kmn)\f$ where \f$k\f$ equals \p length, \f$m\f$ is the
+    //! out-degree, and \f$n\f$ is the number of nodes.
+    //!
+    //! \note
+    //! The logarithms of the numbers of paths are stored as values of type \c
+    //! double, so that they cannot overflow, and the distribution is uniform
+    //! up to floating point rounding.
+    word_type random_path(node_type     source,
+                          size_t        length,
+                          std::mt19937& mt) const {
+      action_digraph_helper::validate_node(*this, source);
+      return random_path_impl(source, UNDEFINED, length, mt);
+    }
+
+    //! Returns a random path between a pair of nodes.
+    //!
+    //! Returns the labels of the edges of a path of length \p length starting
+    //! at \p source and ending at \p target, chosen uniformly at random from
+    //! all such paths.
+    //!
+    //! \param source the first node
+    //! \param target the last node
+    //! \param length the length of the path
+    //! \param mt a std::mt19937 used as a random source
+    //!
+    //! \returns
+    //! A value of type \ref word_type.
+    //!
+    //! \throws LibsemigroupsException if:
+    //! * \p source or \p target is not a node in the digraph; or
+    //! * there is no path of length \p length from \p source to \p target.
+    //!
+    //! \complexity
+    //! \f$O(kmn)\f$ where \f$k\f$ equals \p length, \f$m\f$ is the
+    //! out-degree, and \f$n\f$ is the number of nodes.
+    //!
+    //! \note
+    //! The logarithms of the numbers of paths are stored as values of type \c
+    //! double, so that they cannot overflow, and the distribution is uniform
+    //! up to floating point rounding.
+    word_type random_path(node_type     source,
+                          node_type     target,
+                          size_t        length,
+                          std::mt19937& mt) const {
+      action_digraph_helper::validate_node(*this, source);
+      action_digraph_helper::validate_node(*this, target);
+      return random_path_impl(source, target, length, mt);
+    }
+
    private:
     // Implemented below
     bool number_of_paths_special(node_type source,
@@ -2441,6 +2720,304 @@ namespace libsemigroups {
                                  size_t    min,
                                  size_t    max) const;
 
+    ////////////////////////////////////////////////////////////////////////
+    // ActionDigraph - visiting paths - private
+    ////////////////////////////////////////////////////////////////////////
+
+    // If target is UNDEFINED, then every path from source is visited, and
+    // otherwise only those ending at target.
+    template <typename TVisitor>
+    void visit_paths_impl(node_type  source,
+                          node_type  target,
+                          size_t     min,
+                          size_t     max,
+                          TVisitor&& visitor) const {
+      PathStack stack(this, target);
+      stack.init(source, min, max);
+      while (stack.next()) {
+        if (!visitor(stack.value().first, stack.value().second)) {
+          return;
+        }
+      }
+    }
+
+    uint64_t number_of_paths_dfs(node_type source,
+                                 node_type target,
+                                 size_t    min,
+                                 size_t    max) const {
+      uint64_t result = 0;
+      visit_paths_impl(
+          source, target, min, max, [&result](word_type const&, node_type) {
+            ++result;
+            return true;
+          });
+      return result;
+    }
+
+    // Returns a vector whose n-th entry is true if and only if target is
+    // reachable from the node n. The vector is computed once per target and
+    // is cached until this is modified, this is thread-safe.
+    std::shared_ptr<std::vector<bool> const> can_reach(node_type target) const {
+      std::lock_guard<std::mutex> lg(_can_reach._mtx);
+      auto it = _can_reach._reach.find(target);
+      if (it != _can_reach._reach.end()) {
+        return it->second;
+      }
+      std::vector<node_type>& first         = _can_reach._first;
+      std::vector<node_type>& in_neighbours = _can_reach._in_neighbours;
+      if (first.empty()) {
+        // The in-neighbours of every node, stored contiguously.
+        first.assign(number_of_nodes() + 1, 0);
+        for (auto n = cbegin_nodes(); n != cend_nodes(); ++n) {
+          for (auto e = cbegin_edges(*n); e != cend_edges(*n); ++e) {
+            if (*e != UNDEFINED) {
+              first[*e + 1]++;
+            }
+          }
+        }
+        std::partial_sum(first.cbegin(), first.cend(), first.begin());
+        in_neighbours.resize(first.back());
+        std::vector<node_type> next(first.cbegin(), first.cend() - 1);
+        for (auto n = cbegin_nodes(); n != cend_nodes(); ++n) {
+          for (auto e = cbegin_edges(*n); e != cend_edges(*n); ++e) {
+            if (*e != UNDEFINED) {
+              in_neighbours[next[*e]++] = *n;
+            }
+          }
+        }
+      }
+
+      auto reach = std::make_shared<std::vector<bool>>(number_of_nodes());
+      (*reach)[target] = true;
+
+      std::vector<node_type> stack(1, target);
+      while (!stack.empty()) {
+        node_type const n = stack.back();
+        stack.pop_back();
+        for (auto m = first[n]; m < first[n + 1]; ++m) {
+          if (!(*reach)[in_neighbours[m]]) {
+            (*reach)[in_neighbours[m]] = true;
+            stack.push_back(in_neighbours[m]);
+          }
+        }
+      }
+      _can_reach._reach.emplace(target, reach);
+      return reach;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // ActionDigraph - number_of_paths_modulo/exact - private
+    ////////////////////////////////////////////////////////////////////////
+
+    // Returns max, or the number of nodes if max is POSITIVE_INFINITY and
+    // every path from source is shorter than this.
+    size_t finite_max_path_length(node_type source, size_t max) const {
+      if (max != POSITIVE_INFINITY) {
+        return max;
+      } else if (action_digraph_helper::topological_sort(*this, source)
+                     .empty()) {
+        LIBSEMIGROUPS_EXCEPTION("there are infinitely many paths starting at "
+                                "%d, the maximum length must be finite",
+                                source);
+      }
+      return number_of_nodes();
+    }
+
+    // Adds the counts in cur of the paths ending at target, or at any node
+    // if target is UNDEFINED, to result, and then replaces cur by the
+    // counts of the paths that are one edge longer, using next as
+    // workspace. Every count consists of width values, and add(x, y) must
+    // add the width values starting at y to those starting at x. Returns
+    // false if there are no longer paths.
+    template <typename TValue, typename TAdd>
+    bool count_paths_step(node_type            target,
+                          bool                 accumulate,
+                          size_t               width,
+                          std::vector<TValue>& cur,
+                          std::vector<TValue>& next,
+                          TValue*              result,
+                          TAdd&&               add) const {
+      size_t const N       = number_of_nodes();
+      auto         is_zero = [&cur, width](size_t v) {
+        return std::all_of(cur.cbegin() + v * width,
+                           cur.cbegin() + (v + 1) * width,
+                           [](TValue x) { return x == 0; });
+      };
+      if (accumulate) {
+        if (target != UNDEFINED) {
+          add(result, cur.data() + target * width);
+        } else {
+          for (size_t v = 0; v < N; ++v) {
+            add(result, cur.data() + v * width);
+          }
+        }
+      }
+      std::fill(next.begin(), next.end(), 0);
+      bool nonzero = false;
+      for (size_t v = 0; v < N; ++v) {
+        if (is_zero(v)) {
+          continue;
+        }
+        for (auto it = cbegin_edges(v); it != cend_edges(v); ++it) {
+          if (*it != UNDEFINED) {
+            add(next.data() + *it * width, cur.data() + v * width);
+            nonzero = true;
+          }
+        }
+      }
+      std::swap(cur, next);
+      return nonzero;
+    }
+
+    uint64_t number_of_paths_modulo_impl(node_type source,
+                                         node_type target,
+                                         size_t    min,
+                                         size_t    max,
+                                         uint64_t  modulus) const {
+      if (modulus == 0) {
+        LIBSEMIGROUPS_EXCEPTION("the modulus must be non-zero");
+      }
+      max = finite_max_path_length(source, max);
+
+      std::vector<uint64_t> cur(number_of_nodes(), 0);
+      std::vector<uint64_t> next(number_of_nodes(), 0);
+      uint64_t              result = 0;
+      cur[source]                  = 1 % modulus;
+
+      auto add = [modulus](uint64_t* x, uint64_t const* y) {
+        // *x + *y may not fit into 64 bits
+        *x = (*x >= modulus - *y ? *x - (modulus - *y) : *x + *y);
+      };
+      for (size_t k = 0; k < max; ++k) {
+        // If every count is 0 modulo modulus, then so are all the counts of
+        // longer paths.
+        if (!count_paths_step(target, k >= min, 1, cur, next, &result, add)) {
+          break;
+        }
+      }
+      return result;
+    }
+
+    std::string number_of_paths_exact_impl(node_type source,
+                                           node_type target,
+                                           size_t    min,
+                                           size_t    max) const {
+      max = finite_max_path_length(source, max);
+
+      // There are at most (out_degree() + 1) ^ max paths of length less than
+      // max, and so this many 32-bit words are enough to store the counts.
+      size_t bits = 1;
+      while ((size_t(1) << bits) <= out_degree()) {
+        ++bits;
+      }
+      size_t const width = (max * bits) / 32 + 1;
+
+      std::vector<uint32_t> cur(number_of_nodes() * width, 0);
+      std::vector<uint32_t> next(number_of_nodes() * width, 0);
+      std::vector<uint32_t> result(width, 0);
+      cur[source * width] = 1;
+
+      // The number of words actually used by the counts of the paths of
+      // length at most k.
+      size_t used = 1;
+      auto   add  = [&used](uint32_t* x, uint32_t const* y) {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < used; ++i) {
+          carry += uint64_t(x[i]) + y[i];
+          x[i]  = static_cast<uint32_t>(carry);
+          carry >>= 32;
+        }
+        LIBSEMIGROUPS_ASSERT(carry == 0);
+      };
+      for (size_t k = 0; k < max; ++k) {
+        used = std::min(width, ((k + 1) * bits) / 32 + 1);
+        if (!count_paths_step(
+                target, k >= min, width, cur, next, result.data(), add)) {
+          break;
+        }
+      }
+      return detail::to_decimal_string(std::move(result));
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // ActionDigraph - random paths - private
+    ////////////////////////////////////////////////////////////////////////
+
+    // If target is UNDEFINED, then the path can end at any node.
+    word_type random_path_impl(node_type     source,
+                               node_type     target,
+                               size_t        length,
+                               std::mt19937& mt) const {
+      size_t const N       = number_of_nodes();
+      double const NEG_INF = -std::numeric_limits<double>::infinity();
+      // count[k * N + v] is the natural logarithm of the number of paths of
+      // length k starting at v (and ending at target), or -infinity if there
+      // are no such paths. The logarithms are stored, rather than the numbers
+      // themselves, so that they cannot overflow however long the paths are.
+      std::vector<double> count((length + 1) * N, NEG_INF);
+      for (size_t v = 0; v < N; ++v) {
+        count[v] = (target == UNDEFINED || v == target ? 0 : NEG_INF);
+      }
+      for (size_t k = 1; k <= length; ++k) {
+        double const* prev = count.data() + (k - 1) * N;
+        for (size_t v = 0; v < N; ++v) {
+          // log(sum(exp(prev[w]))) = m + log(sum(exp(prev[w] - m))) where m
+          // is the maximum of the prev[w], so that exp does not overflow.
+          double m = NEG_INF;
+          for (auto it = cbegin_edges(v); it != cend_edges(v); ++it) {
+            if (*it != UNDEFINED) {
+              m = std::max(m, prev[*it]);
+            }
+          }
+          if (m == NEG_INF) {
+            continue;
+          }
+          double sum = 0;
+          for (auto it = cbegin_edges(v); it != cend_edges(v); ++it) {
+            if (*it != UNDEFINED) {
+              sum += std::exp(prev[*it] - m);
+            }
+          }
+          count[k * N + v] = m + std::log(sum);
+        }
+      }
+      if (count[length * N + source] == NEG_INF) {
+        LIBSEMIGROUPS_EXCEPTION("there are no paths of length %llu starting "
+                                "at %llu",
+                                uint64_t(length),
+                                uint64_t(source));
+      }
+
+      word_type path;
+      path.reserve(length);
+      node_type                              v = source;
+      std::uniform_real_distribution<double> dist(0, 1);
+      for (size_t k = length; k > 0; --k) {
+        // The edge with label a is chosen with probability equal to the
+        // proportion of the paths starting at v of length k that start with
+        // that edge.
+        double const total = count[k * N + v];
+        double       x     = dist(mt);
+        // If x is not exhausted because of rounding errors, then the last
+        // edge that leads to a path is chosen.
+        label_type lbl = UNDEFINED;
+        for (label_type a = 0; a < out_degree(); ++a) {
+          node_type const w = unsafe_neighbor(v, a);
+          if (w != UNDEFINED && count[(k - 1) * N + w] != NEG_INF) {
+            lbl = a;
+            x -= std::exp(count[(k - 1) * N + w] - total);
+            if (x < 0) {
+              break;
+            }
+          }
+        }
+        LIBSEMIGROUPS_ASSERT(lbl != UNDEFINED);
+        path.push_back(lbl);
+        v = unsafe_neighbor(v, lbl);
+      }
+      return path;
+    }
+
     ////////////////////////////////////////////////////////////////////////
     // ActionDigraph - number_of_paths_trivial - private
     ////////////////////////////////////////////////////////////////////////
@@ -2681,6 +3258,7 @@ namespace libsemigroups {
       _scc_back_forest._defined = false;
       _scc._defined             = false;
       _scc_forest._defined      = false;
+      _can_reach.clear();
     }
 
     ////////////////////////////////////////////////////////////////////////
@@ -2790,6 +3368,40 @@ namespace libsemigroups {
       std::vector<std::vector<node_type>> _comps;
       std::vector<scc_index_type>         _id;
     } _scc;
+
+    // The in-neighbours of every node, and for every target used so far, the
+    // nodes from which target can be reached. Unlike the other attributes,
+    // these are filled by const member functions that may be called
+    // concurrently (visit_paths, cbegin_pstilo, ...), and so are protected
+    // by _mtx. Copies start with an empty cache.
+    mutable struct CanReach {
+      CanReach() : _first(), _in_neighbours(), _mtx(), _reach() {}
+      // Can't use = default because std::mutex is non-copyable.
+      CanReach(CanReach const&) : CanReach() {}
+      CanReach(CanReach&&) : CanReach() {}
+      CanReach& operator=(CanReach const&) {
+        clear();
+        return *this;
+      }
+      CanReach& operator=(CanReach&&) {
+        clear();
+        return *this;
+      }
+      ~CanReach() = default;
+
+      // Not thread-safe, only called by non-const member functions.
+      void clear() noexcept {
+        _first.clear();
+        _in_neighbours.clear();
+        _reach.clear();
+      }
+
+      std::vector<node_type> _first;
+      std::vector<node_type> _in_neighbours;
+      std::mutex             _mtx;
+      std::unordered_map<node_type, std::shared_ptr<std::vector<bool> const>>
+          _reach;
+    } _can_reach;
   };
 
   //////////////////////////////////////////////////////////////////////////
@@ -2806,7 +3418,8 @@ namespace libsemigroups {
         _dynamic_array_2(_degree, _nr_nodes, UNDEFINED),
         _scc_back_forest(),
         _scc_forest(),
-        _scc() {}
+        _scc(),
+        _can_reach() {}
 
   template <typename T>
   ActionDigraph<T>::ActionDigraph(ActionDigraph const&) = default;
@@ -21,16 +21,26 @@
 #define LIBSEMIGROUPS_FOREST_HPP_
 
 #include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t
 #include <vector>   // for vector
 
 #include "constants.hpp"  // for UNDEFINED
 #include "exception.hpp"  // for LIBSEMIGROUPS_EXCEPTION
+#include "types.hpp"      // for word_type
 
 namespace libsemigroups {
   //! Defined in ``forest.hpp``.
   //!
   //! This class represents the collection of spanning trees of the strongly
   //! connected components of a digraph.
+  //!
+  //! The depths of the nodes, the ancestors of a node, the lowest common
+  //! ancestor of two nodes, and the labels of the path from a node to its
+  //! root, can be found by walking along the parents of the nodes. If these
+  //! are required many times, then init_ancestor_table() can be used to store
+  //! the depth of every node and its ancestors at distances that are powers
+  //! of \c 2, after which each of these queries, other than the labels of a
+  //! path, takes logarithmic time in the depth of the nodes involved.
   class Forest final {
    public:
     //! Alias for the type of nodes in a forest
@@ -46,7 +56,9 @@ namespace libsemigroups {
     //!
     //! \param n the number of nodes, defaults to \c 0.
     explicit Forest(size_t n = 0)
-        : _edge_label(n, static_cast<size_t>(UNDEFINED)),
+        : _depth(),
+          _edge_label(n, static_cast<size_t>(UNDEFINED)),
+          _jump(),
           _parent(n, static_cast<size_t>(UNDEFINED)) {}
 
     //! Default copy constructor
@@ -79,7 +91,11 @@ namespace libsemigroups {
     //!
     //! \iterator_validity
     //! \iterator_invalid
+    //!
+    //! \note
+    //! This function discards the table created by init_ancestor_table().
     void add_nodes(size_t n) {
+      clear_ancestor_table();
       size_t const old_nr_nodes = number_of_nodes();
       try {
         _edge_label.insert(
@@ -110,6 +126,7 @@ namespace libsemigroups {
     //! (None)
     // std::vector::clear is noexcept
     void clear() noexcept {
+      clear_ancestor_table();
       _edge_label.clear();
       _parent.clear();
     }
@@ -128,10 +145,14 @@ namespace libsemigroups {
     //!
     //! \complexity
     //! Constant
+    //!
+    //! \note
+    //! This function discards the table created by init_ancestor_table().
     // not noexcept because std::vector::operator[] isn't.
     void set(node_type node, node_type parent, label_type gen) {
       validate_node(node);
       validate_node(parent);
+      clear_ancestor_table();
       _parent[node]     = parent;
       _edge_label[node] = gen;
     }
@@ -221,7 +242,145 @@ namespace libsemigroups {
       return _parent.cend();
     }
 
+    //! Store the depths and ancestors of all nodes.
+    //!
+    //! After this function is called, depth() takes constant time, and
+    //! ancestor() and lowest_common_ancestor() take time logarithmic in the
+    //! depth of the nodes involved, until the next call to add_nodes(),
+    //! clear(), or set().
+    //!
+    //! The table uses \f$O(n\log d)\f$ 32-bit integers, where \f$n\f$ is
+    //! number_of_nodes() and \f$d\f$ is the maximum depth of a node.
+    //!
+    //! \returns
+    //! (None)
+    //!
+    //! \throws LibsemigroupsException if the number of nodes is not less
+    //! than \f$2 ^ {32} - 1\f$, or the parents of the nodes contain a
+    //! cycle.
+    //!
+    //! \complexity
+    //! \f$O(n\log d)\f$ where \f$n\f$ is number_of_nodes() and \f$d\f$ is
+    //! the maximum depth of a node.
+    //!
+    //! \par Parameters
+    //! (None)
+    void init_ancestor_table();
+
+    //! Check if the depths and ancestors of the nodes are stored.
+    //!
+    //! \returns
+    //! \c true if init_ancestor_table() has been called since the last call
+    //! to add_nodes(), clear(), or set(), and \c false otherwise.
+    //!
+    //! \exceptions
+    //! \noexcept
+    //!
+    //! \complexity
+    //! Constant.
+    //!
+    //! \par Parameters
+    //! (None)
+    bool has_ancestor_table() const noexcept {
+      return !_depth.empty() || number_of_nodes() == 0;
+    }
+
+    //! Returns the depth of a node.
+    //!
+    //! The depth of a node is the number of edges in the path from the node
+    //! to the root of its tree.
+    //!
+    //! \param i the node.
+    //!
+    //! \returns
+    //! A `size_t`.
+    //!
+    //! \throws LibsemigroupsException if \p i exceeds \p number_of_nodes().
+    //!
+    //! \complexity
+    //! Constant if has_ancestor_table() returns \c true, and linear in the
+    //! depth of \p i if not.
+    size_t depth(node_type i) const;
+
+    //! Returns an ancestor of a node.
+    //!
+    //! \param i the node.
+    //! \param k the distance from \p i to the ancestor.
+    //!
+    //! \returns
+    //! A \ref node_type, equal to \p i if \p k is \c 0, to the parent of
+    //! \p i if \p k is \c 1, and so on, or \ref UNDEFINED if \p k is
+    //! greater than the depth of \p i.
+    //!
+    //! \throws LibsemigroupsException if \p i exceeds \p number_of_nodes().
+    //!
+    //! \complexity
+    //! Logarithmic in \p k if has_ancestor_table() returns \c true, and
+    //! linear in the depth of \p i if not.
+    node_type ancestor(node_type i, size_t k) const;
+
+    //! Returns the lowest common ancestor of two nodes.
+    //!
+    //! \param i the first node.
+    //! \param j the second node.
+    //!
+    //! \returns
+    //! A \ref node_type, the common ancestor of \p i and \p j of greatest
+    //! depth, or \ref UNDEFINED if \p i and \p j belong to different trees.
+    //!
+    //! \throws LibsemigroupsException if \p i or \p j exceeds \p
+    //! number_of_nodes().
+    //!
+    //! \complexity
+    //! Logarithmic in the depths of \p i and \p j if has_ancestor_table()
+    //! returns \c true, and linear in their depths if not.
+    node_type lowest_common_ancestor(node_type i, node_type j) const;
+
+    //! Replaces the contents of a word by the labels of the path from a node
+    //! to its root.
+    //!
+    //! The first letter of \p w is the label of the edge from \p i to its
+    //! parent, and the last is the label of the edge into the root of the
+    //! tree containing \p i. The word \p w is resized only once, and so
+    //! reusing the same word for many nodes avoids repeated allocations.
+    //!
+    //! \param w the word.
+    //! \param i the node.
+    //!
+    //! \returns
+    //! (None)
+    //!
+    //! \throws LibsemigroupsException if \p i exceeds \p number_of_nodes().
+    //!
+    //! \complexity
+    //! Linear in the depth of \p i.
+    void path_to_root(word_type& w, node_type i) const;
+
+    //! Returns the labels of the path from a node to its root.
+    //!
+    //! See path_to_root(word_type&, node_type) const.
+    //!
+    //! \param i the node.
+    //!
+    //! \returns
+    //! A value of type \ref word_type.
+    //!
+    //! \throws LibsemigroupsException if \p i exceeds \p number_of_nodes().
+    //!
+    //! \complexity
+    //! Linear in the depth of \p i.
+    word_type path_to_root(node_type i) const {
+      word_type w;
+      path_to_root(w, i);
+      return w;
+    }
+
    private:
+    void clear_ancestor_table() noexcept {
+      _depth.clear();
+      _jump.clear();
+    }
+
     void validate_node(node_type v) const {
       if (v >= number_of_nodes()) {
         LIBSEMIGROUPS_EXCEPTION("node value out of bounds, expected value in "
@@ -231,8 +390,13 @@ namespace libsemigroups {
       }
     }
 
-    std::vector<size_t> _edge_label;
-    std::vector<size_t> _parent;
+    // _depth and _jump are empty unless init_ancestor_table has been called.
+    // _jump[k * number_of_nodes() + v] is the ancestor of v at distance 2 ^ k,
+    // or the root of the tree containing v if there is no such ancestor.
+    std::vector<uint32_t> _depth;
+    std::vector<size_t>   _edge_label;
+    std::vector<uint32_t> _jump;
+    std::vector<size_t>   _parent;
   };
 
 }  // namespace libsemigroups
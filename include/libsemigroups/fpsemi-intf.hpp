@@ -426,7 +426,9 @@ namespace libsemigroups {
     //! \returns (None)
     //!
     //! \throws LibsemigroupsException if any of the following apply:
-    //! * started() returns \c true; or
+    //! * running() returns \c true; or
+    //! * started() returns \c true and the derived class does not support
+    //!   adding rules incrementally (such as KnuthBendix); or
     //! * \p u or \p v contains a letter that does not belong to alphabet().
     //!
     //! \complexity
@@ -443,7 +445,9 @@ namespace libsemigroups {
     //! \returns (None)
     //!
     //! \throws LibsemigroupsException if any of the following apply:
-    //! * started() returns \c true; or
+    //! * running() returns \c true; or
+    //! * started() returns \c true and the derived class does not support
+    //!   adding rules incrementally (such as KnuthBendix); or
     //! * \p u or \p v contains a letter that is out of bounds.
     //!
     //! \complexity
@@ -871,6 +875,10 @@ namespace libsemigroups {
     virtual void validate_word_impl(word_type const&) const;
     // Returns true if we should add rules for the identity and false if not.
     virtual bool validate_identity_impl(std::string const&) const;
+    // Returns true if rules can be added after this has been started, i.e. if
+    // add_rule_impl can be called when started() and !running(), and false
+    // if not.
+    virtual bool incremental_impl() const noexcept;
 
     //////////////////////////////////////////////////////////////////////////////
     // FpSemigroupInterface - non-virtual member functions - private
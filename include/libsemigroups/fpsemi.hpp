@@ -143,15 +143,13 @@ namespace libsemigroups {
     // Documented in FpSemigroupInterface
     bool equal_to(std::string const& u, std::string const& v) override {
       run();  // to ensure the state is correct
-      return static_cast<FpSemigroupInterface*>(_race.winner().get())
-          ->equal_to(u, v);
+      return winner()->equal_to(u, v);
     }
 
     // Documented in FpSemigroupInterface
     std::string normal_form(std::string const& w) override {
       run();  // to ensure the state is correct
-      return static_cast<FpSemigroupInterface*>(_race.winner().get())
-          ->normal_form(w);
+      return winner()->normal_form(w);
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -280,6 +278,153 @@ namespace libsemigroups {
       return *this;
     }
 
+    //! Get the current maximum amount of memory.
+    //!
+    //! \returns
+    //! A value of type \c size_t.
+    //!
+    //! \exceptions
+    //! \noexcept
+    //!
+    //! \complexity
+    //! Constant.
+    //!
+    //! \parameters
+    //! (None)
+    size_t max_memory() const noexcept {
+      return _race.max_memory();
+    }
+
+    //! Set the maximum amount of memory.
+    //!
+    //! While the algorithms are run in more than one thread, their memory
+    //! usage is monitored (see Runner::memory_usage). If the algorithms still
+    //! running use more than \p val bytes in total, then the one using the
+    //! most memory is stopped, and is not run again. This is repeated until
+    //! the memory usage is below \p val, or only one algorithm is still
+    //! running, which is never stopped. If deterministic() is \c true, then
+    //! the first algorithm that has not been stopped is never stopped either,
+    //! since this would change the result. The stopped algorithms remain
+    //! available (for example, via has_todd_coxeter()), and their memory is
+    //! released when a winner is found, along with that of the other
+    //! algorithms. The memory usage is only approximate, and so \p val is not
+    //! a hard limit. The default value is \ref LIMIT_MAX, meaning that there
+    //! is no limit.
+    //!
+    //! \param val the maximum number of bytes.
+    //!
+    //! \returns A reference to \c this.
+    //!
+    //! \exceptions
+    //! \noexcept
+    //!
+    //! \complexity
+    //! Constant.
+    FpSemigroup& max_memory(size_t val) noexcept {
+      _race.max_memory(val);
+      return *this;
+    }
+
+    //! Check if the winner is chosen deterministically.
+    //!
+    //! \returns
+    //! A value of type \c bool.
+    //!
+    //! \exceptions
+    //! \noexcept
+    //!
+    //! \complexity
+    //! Constant.
+    //!
+    //! \parameters
+    //! (None)
+    bool deterministic() const noexcept {
+      return _race.deterministic();
+    }
+
+    //! Choose the winner deterministically.
+    //!
+    //! By default, the first algorithm to finish is used, and so which
+    //! algorithm is used can vary from one run to the next. If \p val is \c
+    //! true, then the algorithm used is the first one, in the order they were
+    //! added, that finishes. The algorithms added later are stopped as soon
+    //! as any earlier one finishes, but the earlier algorithms are allowed
+    //! to continue. The outcome then depends only on the input (and the
+    //! seeds of any randomised algorithms, see congruence::ToddCoxeter::seed)
+    //! and not on the timing of the threads, at the cost of possibly waiting
+    //! longer for the answer.
+    //!
+    //! \warning
+    //! If the first algorithm that does not throw never terminates (for
+    //! example, if it is fpsemigroup::KnuthBendix and there is no finite
+    //! confluent rewriting system), then run() never returns, even if a later
+    //! algorithm has already finished. Use run_for() or run_until() to limit the time
+    //! spent in this case.
+    //!
+    //! \param val whether or not to choose the winner deterministically.
+    //!
+    //! \returns A reference to \c this.
+    //!
+    //! \exceptions
+    //! \noexcept
+    //!
+    //! \complexity
+    //! Constant.
+    FpSemigroup& deterministic(bool val) noexcept {
+      _race.deterministic(val);
+      return *this;
+    }
+
+    //! Check if the runners are chosen using the presentation.
+    //!
+    //! \returns
+    //! A value of type \c bool.
+    //!
+    //! \exceptions
+    //! \noexcept
+    //!
+    //! \complexity
+    //! Constant.
+    //!
+    //! \parameters
+    //! (None)
+    bool plan_runners() const noexcept {
+      return _plan_runners;
+    }
+
+    //! Choose the runners using the presentation.
+    //!
+    //! By default, every algorithm added at construction, or using
+    //! add_runner, is run in its own thread, with its own settings, until one
+    //! of them finishes. If \p val is \c true, then when FpSemigroup is first
+    //! run, some cheap to compute properties of the presentation are used to
+    //! remove the algorithms that cannot, or are unlikely to, finish first,
+    //! and to choose the settings of those that remain. In particular:
+    //! * Todd-Coxeter is not run if the semigroup is obviously infinite;
+    //! * Todd-Coxeter uses the Felsch strategy if the number of generators
+    //!   times the total length of the rules is small, and the HLT strategy
+    //!   otherwise, with full lookahead if any rule is long;
+    //! * Knuth-Bendix uses the overlap policy
+    //!   fpsemigroup::KnuthBendix::options::overlap::MAX_AB_BC if any rule is
+    //!   long, and fpsemigroup::KnuthBendix::options::overlap::ABC otherwise.
+    //!
+    //! At least one algorithm is always run, and any settings of the
+    //! algorithms made before the first run are overwritten.
+    //!
+    //! \param val whether or not to choose the runners.
+    //!
+    //! \returns A reference to \c this.
+    //!
+    //! \exceptions
+    //! \noexcept
+    //!
+    //! \complexity
+    //! Constant.
+    FpSemigroup& plan_runners(bool val) noexcept {
+      _plan_runners = val;
+      return *this;
+    }
+
    private:
     //////////////////////////////////////////////////////////////////////////
     // FpSemigroupInterface - pure virtual member functions - private
@@ -290,6 +435,7 @@ namespace libsemigroups {
     bool                             is_obviously_infinite_impl() override;
 
     void run_impl() override {
+      plan_if_necessary();
       _race.run_until([this]() { return this->stopped(); });
     }
 
@@ -305,11 +451,33 @@ namespace libsemigroups {
     void set_alphabet_impl(size_t) override;
     bool is_obviously_finite_impl() override;
 
+    //////////////////////////////////////////////////////////////////////////
+    // FpSemigroup - member functions - private
+    //////////////////////////////////////////////////////////////////////////
+
+    // Every function that runs the race or uses its winner must call this
+    // first, so that the runners are planned before any of them runs.
+    void plan_if_necessary() {
+      if (_plan_runners && !_planned) {
+        plan();
+      }
+    }
+
+    void plan();
+
+    // Returns the winner of the race, running the race if necessary.
+    FpSemigroupInterface* winner() {
+      plan_if_necessary();
+      return static_cast<FpSemigroupInterface*>(_race.winner().get());
+    }
+
     //////////////////////////////////////////////////////////////////////////
     // FpSemigroup - data - private
     //////////////////////////////////////////////////////////////////////////
 
     detail::Race _race;
+    bool         _plan_runners;
+    bool         _planned;
   };
 }  // namespace libsemigroups
 #endif  // LIBSEMIGROUPS_FPSEMI_HPP_
@@ -23,6 +23,7 @@
 #include <iterator>  // for forward_iterator_tag
 #include <thread>    // for thread::hardware_concurrency
 
+#include "allocator.hpp"   // for memory_policy
 #include "constants.hpp"   // for UNDEFINED
 #include "containers.hpp"  // for DynamicArray2
 #include "exception.hpp"   // for LIBSEMIGROUPS_EXCEPTION
@@ -217,6 +218,46 @@ namespace libsemigroups {
     //! None.
     size_t concurrency_threshold() const noexcept;
 
+    //! Set the memory policy for the Cayley graphs.
+    //!
+    //! This member function reallocates the left and right Cayley graphs
+    //! according to \p val, and all subsequent allocations for the Cayley
+    //! graphs use \p val. This can be used to back large Cayley graphs with
+    //! huge pages, or to interleave them over the NUMA nodes of the machine.
+    //!
+    //! The default value is memory_policy::standard.
+    //!
+    //! \param val the new memory policy.
+    //!
+    //! \returns A reference to \c this.
+    //!
+    //! \throws std::bad_alloc if the Cayley graphs cannot be reallocated.
+    //!
+    //! \complexity
+    //! Linear in the size of the Cayley graphs.
+    //!
+    //! \sa
+    //! memory_policy().
+    FroidurePinBase& memory_policy(libsemigroups::memory_policy val);
+
+    //! Returns the current memory policy for the Cayley graphs.
+    //!
+    //! \returns
+    //! A value of type memory_policy.
+    //!
+    //! \exceptions
+    //! \noexcept
+    //!
+    //! \complexity
+    //! Constant.
+    //!
+    //! \sa
+    //! memory_policy(memory_policy).
+    //!
+    //! \parameters
+    //! None.
+    libsemigroups::memory_policy memory_policy() const noexcept;
+
     //! Set immutability.
     //!
     //! Prevent further changes to the mathematical semigroup represented by an
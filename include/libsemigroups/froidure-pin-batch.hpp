@@ -0,0 +1,569 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration and implementation of a class template
+// for enumerating many small semigroups, each defined by a generating set, in
+// parallel.
+
+#ifndef LIBSEMIGROUPS_FROIDURE_PIN_BATCH_HPP_
+#define LIBSEMIGROUPS_FROIDURE_PIN_BATCH_HPP_
+
+#include <algorithm>         // for min
+#include <atomic>            // for atomic
+#include <cstddef>           // for size_t
+#include <exception>         // for exception_ptr, rethrow_exception
+#include <functional>        // for ref
+#include <initializer_list>  // for initializer_list
+#include <iterator>          // for distance
+#include <thread>            // for thread
+#include <type_traits>       // for is_pointer, is_void
+#include <unordered_map>     // for unordered_map
+#include <vector>            // for vector
+
+#include "constants.hpp"          // for UNDEFINED
+#include "exception.hpp"          // for LIBSEMIGROUPS_EXCEPTION
+#include "froidure-pin-loop.hpp"  // for froidure_pin_multiply, ...
+#include "froidure-pin.hpp"       // for FroidurePinTraits
+#include "report.hpp"             // for THREAD_ID_MANAGER
+#include "types.hpp"              // for letter_type
+
+namespace libsemigroups {
+  //! Defined in ``froidure-pin-batch.hpp``.
+  //!
+  //! This class template enumerates many independent semigroups, each
+  //! defined by a generating set, and records the size, number of rules, and
+  //! number of idempotents of each. The results are the same as those of a
+  //! FroidurePin instance with the same generating set, but none of the
+  //! other data of a FroidurePin (such as the Cayley graphs, or the normal
+  //! forms of the elements) is retained.
+  //!
+  //! This is intended for computations that enumerate a very large number of
+  //! small semigroups, such as all of the 2-generated semigroups of boolean
+  //! matrices of a given dimension. Constructing a FroidurePin instance for
+  //! each of these is comparatively expensive, since every instance allocates
+  //! its own data, and can only be run in a single thread. Instead, the
+  //! generating sets in a FroidurePinBatch are divided between several
+  //! threads (see number_of_threads()); every thread claims the next
+  //! generating set not yet claimed by any thread, and so no thread is idle
+  //! while there are generating sets remaining. Every thread enumerates its
+  //! semigroups one after another, reusing the same storage for all of them.
+  //!
+  //! \tparam TElementType the type of the elements.
+  //! \tparam TTraits the type of the traits class (defaults to
+  //! FroidurePinTraits<TElementType>).
+  //!
+  //! \par Example
+  //! \code
+  //! FroidurePinBatch<BMat8> batch;
+  //! batch.add_generators({BMat8({{0, 1}, {1, 0}}), BMat8({{1, 0}, {1, 1}})});
+  //! batch.add_generators({BMat8({{1, 1}, {0, 0}})});
+  //! batch.number_of_threads(4).run();
+  //! batch.result(0).size;  // 7
+  //! batch.result(1).size;  // 1
+  //! \endcode
+  template <typename TElementType,
+            typename TTraits = FroidurePinTraits<TElementType>>
+  class FroidurePinBatch final {
+   public:
+    ////////////////////////////////////////////////////////////////////////
+    // FroidurePinBatch - typedefs - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! The type of the elements.
+    using element_type = typename TTraits::element_type;
+
+    static_assert(!std::is_pointer<element_type>::value,
+                  "FroidurePinBatch does not support pointer element types");
+    static_assert(std::is_void<typename TTraits::state_type>::value,
+                  "FroidurePinBatch does not support elements with state");
+
+    //! The type of the results of the enumerations.
+    struct result_type {
+      //! The number of elements in the semigroup.
+      size_t size;
+      //! The number of rules in a presentation for the semigroup.
+      size_t number_of_rules;
+      //! The number of idempotents in the semigroup.
+      size_t number_of_idempotents;
+    };
+
+    ////////////////////////////////////////////////////////////////////////
+    // FroidurePinBatch - constructors - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Default constructor.
+    //!
+    //! Constructs a FroidurePinBatch with no generating sets, which uses a
+    //! single thread.
+    FroidurePinBatch()
+        : _generators(), _first(1, 0), _number_of_threads(1), _results() {}
+
+    //! Default copy constructor.
+    FroidurePinBatch(FroidurePinBatch const&) = default;
+
+    //! Default move constructor.
+    FroidurePinBatch(FroidurePinBatch&&) = default;
+
+    //! Default copy assignment operator.
+    FroidurePinBatch& operator=(FroidurePinBatch const&) = default;
+
+    //! Default move assignment operator.
+    FroidurePinBatch& operator=(FroidurePinBatch&&) = default;
+
+    ~FroidurePinBatch() = default;
+
+    ////////////////////////////////////////////////////////////////////////
+    // FroidurePinBatch - settings - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Set the number of threads used by run().
+    //!
+    //! \param val the number of threads.
+    //!
+    //! \returns A reference to \c this.
+    //!
+    //! \throws LibsemigroupsException if \p val is \c 0.
+    FroidurePinBatch& number_of_threads(size_t val) {
+      if (val == 0) {
+        LIBSEMIGROUPS_EXCEPTION("the number of threads must be non-zero!");
+      }
+      _number_of_threads = val;
+      return *this;
+    }
+
+    //! Returns the number of threads used by run().
+    //!
+    //! \parameters
+    //! (None)
+    //!
+    //! \returns A value of type \c size_t.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t number_of_threads() const noexcept {
+      return _number_of_threads;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // FroidurePinBatch - generating sets - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Add a generating set.
+    //!
+    //! Adds the generating set consisting of the elements in the range \p
+    //! first to \p last. The index of the new generating set is
+    //! number_of_generating_sets() before it is added.
+    //!
+    //! \tparam T the type of the iterators.
+    //!
+    //! \param first iterator pointing to the first generator.
+    //! \param last iterator pointing one beyond the last generator.
+    //!
+    //! \returns
+    //! (None)
+    //!
+    //! \throws LibsemigroupsException if the range is empty, or the
+    //! generators do not all have the same degree.
+    template <typename T>
+    void add_generators(T first, T last) {
+      if (first == last) {
+        LIBSEMIGROUPS_EXCEPTION("a generating set must be non-empty");
+      }
+      size_t const n = Degree()(*first);
+      for (auto it = first; it != last; ++it) {
+        size_t const m = Degree()(*it);
+        if (m != n) {
+          LIBSEMIGROUPS_EXCEPTION(
+              "element has degree %d but should have degree %d", m, n);
+        }
+      }
+      _generators.insert(_generators.end(), first, last);
+      _first.push_back(_generators.size());
+    }
+
+    //! Add a generating set.
+    //!
+    //! See add_generators(T, T).
+    //!
+    //! \param gens the generators.
+    //!
+    //! \returns
+    //! (None)
+    //!
+    //! \throws LibsemigroupsException if \p gens is empty, or the generators
+    //! do not all have the same degree.
+    void add_generators(std::vector<element_type> const& gens) {
+      add_generators(gens.cbegin(), gens.cend());
+    }
+
+    //! Add a generating set.
+    //!
+    //! See add_generators(T, T).
+    //!
+    //! \param gens the generators.
+    //!
+    //! \returns
+    //! (None)
+    //!
+    //! \throws LibsemigroupsException if \p gens is empty, or the generators
+    //! do not all have the same degree.
+    void add_generators(std::initializer_list<element_type> gens) {
+      add_generators(gens.begin(), gens.end());
+    }
+
+    //! Returns the number of generating sets.
+    //!
+    //! \parameters
+    //! (None)
+    //!
+    //! \returns A value of type \c size_t.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t number_of_generating_sets() const noexcept {
+      return _first.size() - 1;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // FroidurePinBatch - running and results - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Enumerate the semigroups.
+    //!
+    //! Enumerates the semigroups generated by those generating sets added
+    //! since the last call to run(), using number_of_threads() threads.
+    //!
+    //! \parameters
+    //! (None)
+    //!
+    //! \returns
+    //! (None)
+    //!
+    //! \throws
+    //! Anything thrown by the adapters for \ref element_type. If an exception
+    //! is thrown in any thread, then the remaining threads stop once they have
+    //! finished their current semigroup, the exception is rethrown, and no
+    //! results are recorded, so that finished() returns \c false.
+    void run() {
+      size_t const first = _results.size();
+      size_t const last  = number_of_generating_sets();
+      if (first == last) {
+        return;
+      }
+      std::vector<result_type> results(last - first);
+      std::atomic<size_t>      next(first);
+      size_t const             N = std::min(_number_of_threads, last - first);
+      std::vector<std::exception_ptr> errors(N);
+
+      auto worker = [this, &next, &results, first, last](
+                        std::exception_ptr& error) {
+        try {
+          size_t const tid = THREAD_ID_MANAGER.tid(std::this_thread::get_id());
+          Arena        arena;
+          for (size_t i = next++; i < last; i = next++) {
+            arena.enumerate(_generators.data() + _first[i],
+                            _generators.data() + _first[i + 1],
+                            tid,
+                            results[i - first]);
+          }
+        } catch (...) {
+          error = std::current_exception();
+          next  = last;
+        }
+      };
+
+      if (N == 1) {
+        worker(errors[0]);
+      } else {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < N; ++i) {
+          threads.emplace_back(worker, std::ref(errors[i]));
+        }
+        for (auto& t : threads) {
+          t.join();
+        }
+      }
+      for (auto const& error : errors) {
+        if (error != nullptr) {
+          std::rethrow_exception(error);
+        }
+      }
+      _results.insert(_results.end(), results.cbegin(), results.cend());
+    }
+
+    //! Check if every semigroup has been enumerated.
+    //!
+    //! \parameters
+    //! (None)
+    //!
+    //! \returns
+    //! \c true if run() has been called since the last generating set was
+    //! added, and \c false if not.
+    //!
+    //! \exceptions
+    //! \noexcept
+    bool finished() const noexcept {
+      return _results.size() == number_of_generating_sets();
+    }
+
+    //! Returns the result for a generating set.
+    //!
+    //! \param i the index of the generating set.
+    //!
+    //! \returns A const reference to a \ref result_type.
+    //!
+    //! \throws LibsemigroupsException if \p i is not less than
+    //! number_of_generating_sets(), or the generating set with index \p i
+    //! has not been enumerated by run().
+    result_type const& result(size_t i) const {
+      if (i >= number_of_generating_sets()) {
+        LIBSEMIGROUPS_EXCEPTION("expected a value less than %d, found %d",
+                                number_of_generating_sets(),
+                                i);
+      } else if (i >= _results.size()) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "the generating set with index %d has not been enumerated", i);
+      }
+      return _results[i];
+    }
+
+   private:
+    ////////////////////////////////////////////////////////////////////////
+    // FroidurePinBatch - typedefs - private
+    ////////////////////////////////////////////////////////////////////////
+
+    using Degree  = typename TTraits::Degree;
+    using EqualTo = typename TTraits::EqualTo;
+    using Hash    = typename TTraits::Hash;
+    using One     = typename TTraits::One;
+    using Product = typename TTraits::Product;
+
+    ////////////////////////////////////////////////////////////////////////
+    // FroidurePinBatch - nested classes - private
+    ////////////////////////////////////////////////////////////////////////
+
+    // An Arena holds the data required to enumerate a single semigroup using
+    // the Froidure-Pin algorithm, exactly as in FroidurePin::run_impl, so that
+    // the numbers of rules agree. The data is cleared but not deallocated
+    // between enumerations, so that a single Arena can be used to enumerate
+    // many semigroups without repeated allocations. The member functions
+    // following enumerate are those required by the functions in
+    // froidure-pin-loop.hpp, which are also used by FroidurePin.
+    class Arena final {
+     public:
+      Arena() = default;
+
+      void enumerate(element_type const* gens_first,
+                     element_type const* gens_last,
+                     size_t              tid,
+                     result_type&        result) {
+        clear(std::distance(gens_first, gens_last));
+
+        _gens = gens_first;
+        _id   = One()(*gens_first);
+        _tid  = tid;
+        _tmp  = _id;
+
+        // Add the generators
+        for (letter_type j = 0; j < _nrgens; ++j) {
+          auto it = _map.find(gens_first[j]);
+          if (it == _map.end()) {
+            add_element(gens_first[j], j, j, UNDEFINED, UNDEFINED);
+            _letter_to_pos.push_back(_elements.size() - 1);
+          } else {
+            // duplicate generator
+            _letter_to_pos.push_back(it->second);
+            _nr_rules++;
+          }
+        }
+        _lenindex.push_back(0);
+        _lenindex.push_back(_elements.size());
+
+        // Multiply the generators by every generator
+        size_t pos = 0;
+        for (; pos < _lenindex[1]; ++pos) {
+          detail::froidure_pin_multiply_generator(*this, pos);
+        }
+        for (size_t i = 0; i < pos; ++i) {
+          detail::froidure_pin_left_generator(*this, i);
+        }
+        size_t wordlen = 1;
+        _lenindex.push_back(_elements.size());
+
+        // Multiply the words of length > 1 by every generator
+        while (pos != _elements.size()) {
+          for (; pos != _lenindex[wordlen + 1]; ++pos) {
+            detail::froidure_pin_multiply(*this, pos);
+          }
+          for (size_t i = _lenindex[wordlen]; i != pos; ++i) {
+            detail::froidure_pin_left(*this, i);
+          }
+          wordlen++;
+          _lenindex.push_back(_elements.size());
+        }
+
+        result.size                  = _elements.size();
+        result.number_of_rules       = _nr_rules;
+        result.number_of_idempotents = 0;
+        for (auto const& x : _elements) {
+          Product()(_tmp, x, x, tid);
+          if (EqualTo()(_tmp, x)) {
+            result.number_of_idempotents++;
+          }
+        }
+      }
+
+      size_t number_of_generators() const noexcept {
+        return _nrgens;
+      }
+
+      letter_type first(size_t i) const noexcept {
+        return _first[i];
+      }
+
+      letter_type final(size_t i) const noexcept {
+        return _final[i];
+      }
+
+      size_t prefix(size_t i) const noexcept {
+        return _prefix[i];
+      }
+
+      size_t suffix(size_t i) const noexcept {
+        return _suffix[i];
+      }
+
+      size_t letter_to_pos(letter_type j) const noexcept {
+        return _letter_to_pos[j];
+      }
+
+      bool is_one(size_t r) const noexcept {
+        return _found_one && r == _pos_one;
+      }
+
+      bool reduced(size_t i, letter_type j) const noexcept {
+        return _reduced[i * _nrgens + j];
+      }
+
+      size_t left(size_t i, letter_type j) const noexcept {
+        return _left[i * _nrgens + j];
+      }
+
+      size_t right(size_t i, letter_type j) const noexcept {
+        return _right[i * _nrgens + j];
+      }
+
+      void set_left(size_t i, letter_type j, size_t r) noexcept {
+        _left[i * _nrgens + j] = r;
+      }
+
+      void set_right(size_t i, letter_type j, size_t r) noexcept {
+        _right[i * _nrgens + j] = r;
+      }
+
+      size_t product_by_generator(size_t i, letter_type j) {
+        Product()(_tmp, _elements[i], _gens[j], _tid);
+        auto it = _map.find(_tmp);
+        return it != _map.end() ? it->second : UNDEFINED;
+      }
+
+      void add_product(size_t i, letter_type j, letter_type b, size_t s) {
+        add_element(_tmp, b, j, i, s);
+        _reduced[i * _nrgens + j] = true;
+        _right[i * _nrgens + j]   = _elements.size() - 1;
+      }
+
+      void add_rule() noexcept {
+        _nr_rules++;
+      }
+
+     private:
+      void clear(size_t nrgens) {
+        _elements.clear();
+        _final.clear();
+        _first.clear();
+        _found_one = false;
+        _left.clear();
+        _lenindex.clear();
+        _letter_to_pos.clear();
+        _map.clear();
+        _nr_rules = 0;
+        _nrgens   = nrgens;
+        _pos_one  = 0;
+        _prefix.clear();
+        _reduced.clear();
+        _right.clear();
+        _suffix.clear();
+      }
+
+      void add_element(element_type const& x,
+                       letter_type         first,
+                       letter_type         final,
+                       size_t              prefix,
+                       size_t              suffix) {
+        size_t const pos = _elements.size();
+        if (!_found_one && EqualTo()(x, _id)) {
+          _pos_one   = pos;
+          _found_one = true;
+        }
+        _elements.push_back(x);
+        _map.emplace(x, pos);
+        _first.push_back(first);
+        _final.push_back(final);
+        _prefix.push_back(prefix);
+        _suffix.push_back(suffix);
+        _left.resize(_left.size() + _nrgens, UNDEFINED);
+        _right.resize(_right.size() + _nrgens, UNDEFINED);
+        _reduced.resize(_reduced.size() + _nrgens, false);
+      }
+
+      std::vector<element_type>                               _elements;
+      std::vector<letter_type>                                _final;
+      std::vector<letter_type>                                _first;
+      bool                                                    _found_one;
+      element_type const*                                     _gens;
+      element_type                                            _id;
+      std::vector<size_t>                                     _left;
+      std::vector<size_t>                                     _lenindex;
+      std::vector<size_t>                                     _letter_to_pos;
+      std::unordered_map<element_type, size_t, Hash, EqualTo> _map;
+      size_t                                                  _nr_rules;
+      size_t                                                  _nrgens;
+      size_t                                                  _pos_one;
+      std::vector<size_t>                                     _prefix;
+      std::vector<bool>                                       _reduced;
+      std::vector<size_t>                                     _right;
+      std::vector<size_t>                                     _suffix;
+      size_t                                                  _tid;
+      element_type                                            _tmp;
+    };
+
+    ////////////////////////////////////////////////////////////////////////
+    // FroidurePinBatch - data members - private
+    ////////////////////////////////////////////////////////////////////////
+
+    std::vector<element_type> _generators;
+    // The generators of the generating set with index i are those in the
+    // range [_first[i], _first[i + 1]) of _generators.
+    std::vector<size_t>      _first;
+    size_t                   _number_of_threads;
+    std::vector<result_type> _results;
+  };
+}  // namespace libsemigroups
+
+#endif  // LIBSEMIGROUPS_FROIDURE_PIN_BATCH_HPP_
@@ -19,10 +19,11 @@
 // This file contains implementations of the member functions for the
 // FroidurePin class.
 
-#include "debug.hpp"      // for LIBSEMIGROUPS_ASSERT
-#include "exception.hpp"  // for LIBSEMIGROUPS_EXCEPTION
-#include "report.hpp"     // for REPORT
-#include "timer.hpp"      // for detail::Timer
+#include "debug.hpp"              // for LIBSEMIGROUPS_ASSERT
+#include "exception.hpp"          // for LIBSEMIGROUPS_EXCEPTION
+#include "froidure-pin-loop.hpp"  // for froidure_pin_multiply, ...
+#include "report.hpp"             // for REPORT
+#include "timer.hpp"              // for detail::Timer
 
 #ifndef LIBSEMIGROUPS_FROIDURE_PIN_IMPL_HPP_
 #define LIBSEMIGROUPS_FROIDURE_PIN_IMPL_HPP_
@@ -379,6 +380,102 @@ namespace libsemigroups {
     return minimal_factorisation(x);
   }
 
+  TEMPLATE
+  class FROIDURE_PIN::LoopStorage final {
+   public:
+    LoopStorage(FroidurePin& fp, state_type* ptr, size_t tid)
+        : _fp(fp), _ptr(ptr), _tid(tid) {}
+
+    size_t number_of_generators() const noexcept {
+      return _fp.number_of_generators();
+    }
+
+    letter_type first(element_index_type i) const noexcept {
+      return _fp._first[i];
+    }
+
+    letter_type final(element_index_type i) const noexcept {
+      return _fp._final[i];
+    }
+
+    element_index_type prefix(element_index_type i) const noexcept {
+      return _fp._prefix[i];
+    }
+
+    element_index_type suffix(element_index_type i) const noexcept {
+      return _fp._suffix[i];
+    }
+
+    element_index_type letter_to_pos(letter_type j) const noexcept {
+      return _fp._letter_to_pos[j];
+    }
+
+    bool is_one(element_index_type r) const noexcept {
+      return _fp._found_one && r == _fp._pos_one;
+    }
+
+    bool reduced(element_index_type i, letter_type j) const {
+      return _fp._reduced.get(i, j);
+    }
+
+    element_index_type left(element_index_type i, letter_type j) const {
+      return _fp._left.get(i, j);
+    }
+
+    element_index_type right(element_index_type i, letter_type j) const {
+      return _fp._right.get(i, j);
+    }
+
+    void set_left(element_index_type i, letter_type j, element_index_type r) {
+      _fp._left.set(i, j, r);
+    }
+
+    void set_right(element_index_type i, letter_type j, element_index_type r) {
+      _fp._right.set(i, j, r);
+    }
+
+    element_index_type product_by_generator(element_index_type i,
+                                            letter_type        j) {
+      InternalProduct()(_fp.to_external(_fp._tmp_product),
+                        _fp.to_external_const(_fp._elements[i]),
+                        _fp.to_external_const(_fp._gens[j]),
+                        _ptr,
+                        _tid);
+#ifdef LIBSEMIGROUPS_VERBOSE
+      _fp._nr_products++;
+#endif
+      auto it = _fp._map.find(_fp._tmp_product);
+      return it != _fp._map.end() ? it->second : UNDEFINED;
+    }
+
+    void add_product(element_index_type i,
+                     letter_type        j,
+                     letter_type        b,
+                     element_index_type s) {
+      _fp.is_one(_fp._tmp_product, _fp._nr);
+      _fp._elements.push_back(_fp.internal_copy(_fp._tmp_product));
+      _fp._first.push_back(b);
+      _fp._final.push_back(j);
+      _fp._length.push_back(_fp._wordlen + 2);
+      _fp._map.emplace(_fp._elements.back(), _fp._nr);
+      _fp._prefix.push_back(i);
+      _fp._reduced.set(i, j, true);
+      _fp._right.set(i, j, _fp._nr);
+      _fp._suffix.push_back(s);
+      _fp._enumerate_order.push_back(_fp._nr);
+      _fp._nr++;
+    }
+
+    void add_rule() noexcept {
+      _fp._nr_rules++;
+    }
+
+   private:
+    FroidurePin& _fp;
+    state_type*  _ptr;
+    size_t       _tid;
+  };
+
   VOID FROIDURE_PIN::run_impl() {
     std::lock_guard<std::mutex> lg(_mtx);
     if (_pos >= _nr) {
@@ -390,50 +487,17 @@ namespace libsemigroups {
 
     LIBSEMIGROUPS_ASSERT(_lenindex.size() > 1);
 
-    auto ptr = _state.get();
+    LoopStorage st(*this, _state.get(), tid);
 
     // product the generators by every generator
     if (_pos < _lenindex[1]) {
       size_type number_of_shorter_elements = _nr;
       while (_pos < _lenindex[1]) {
-        element_index_type i = _enumerate_order[_pos];
-        for (letter_type j = 0; j != number_of_generators(); ++j) {
-          InternalProduct()(this->to_external(_tmp_product),
-                            this->to_external_const(_elements[i]),
-                            this->to_external_const(_gens[j]),
-                            ptr,
-                            tid);
-
-#ifdef LIBSEMIGROUPS_VERBOSE
-          _nr_products++;
-#endif
-          auto it = _map.find(_tmp_product);
-
-          if (it != _map.end()) {
-            _right.set(i, j, it->second);
-            _nr_rules++;
-          } else {
-            is_one(_tmp_product, _nr);
-            _elements.push_back(this->internal_copy(_tmp_product));
-            _first.push_back(_first[i]);
-            _final.push_back(j);
-            _enumerate_order.push_back(_nr);
-            _length.push_back(2);
-            _map.emplace(_elements.back(), _nr);
-            _prefix.push_back(i);
-            _reduced.set(i, j, true);
-            _right.set(i, j, _nr);
-            _suffix.push_back(_letter_to_pos[j]);
-            _nr++;
-          }
-        }
+        detail::froidure_pin_multiply_generator(st, _enumerate_order[_pos]);
         _pos++;
       }
       for (enumerate_index_type i = 0; i != _pos; ++i) {
-        letter_type b = _final[_enumerate_order[i]];
-        for (letter_type j = 0; j != number_of_generators(); ++j) {
-          _left.set(_enumerate_order[i], j, _right.get(_letter_to_pos[j], b));
-        }
+        detail::froidure_pin_left_generator(st, _enumerate_order[i]);
       }
       _wordlen++;
       expand(_nr - number_of_shorter_elements);
@@ -444,60 +508,15 @@ namespace libsemigroups {
     while (_pos != _nr && !stopped()) {
       size_type number_of_shorter_elements = _nr;
       while (_pos != _lenindex[_wordlen + 1] && !stopped()) {
-        element_index_type i = _enumerate_order[_pos];
-        letter_type        b = _first[i];
-        element_index_type s = _suffix[i];
-        for (letter_type j = 0; j != number_of_generators(); ++j) {
-          if (!_reduced.get(s, j)) {
-            element_index_type r = _right.get(s, j);
-            if (_found_one && r == _pos_one) {
-              _right.set(i, j, _letter_to_pos[b]);
-            } else if (_prefix[r] != UNDEFINED) {  // r is not a generator
-              _right.set(i, j, _right.get(_left.get(_prefix[r], b), _final[r]));
-            } else {
-              _right.set(i, j, _right.get(_letter_to_pos[b], _final[r]));
-            }
-          } else {
-            InternalProduct()(this->to_external(_tmp_product),
-                              this->to_external_const(_elements[i]),
-                              this->to_external_const(_gens[j]),
-                              ptr,
-                              tid);
-#ifdef LIBSEMIGROUPS_VERBOSE
-            _nr_products++;
-#endif
-            auto it = _map.find(_tmp_product);
-
-            if (it != _map.end()) {
-              _right.set(i, j, it->second);
-              _nr_rules++;
-            } else {
-              is_one(_tmp_product, _nr);
-              _elements.push_back(this->internal_copy(_tmp_product));
-              _first.push_back(b);
-              _final.push_back(j);
-              _length.push_back(_wordlen + 2);
-              _map.emplace(_elements.back(), _nr);
-              _prefix.push_back(i);
-              _reduced.set(i, j, true);
-              _right.set(i, j, _nr);
-              _suffix.push_back(_right.get(s, j));
-              _enumerate_order.push_back(_nr);
-              _nr++;
-            }
-          }
-        }  // finished applying gens to <_elements.at(_pos)>
+        detail::froidure_pin_multiply(st, _enumerate_order[_pos]);
         _pos++;
+        update_progress(static_cast<double>(_pos) / _nr);
       }  // finished words of length <wordlen> + 1
       expand(_nr - number_of_shorter_elements);
 
       if (_pos > _nr || _pos == _lenindex[_wordlen + 1]) {
         for (enumerate_index_type i = _lenindex[_wordlen]; i != _pos; ++i) {
-          element_index_type p = _prefix[_enumerate_order[i]];
-          letter_type        b = _final[_enumerate_order[i]];
-          for (letter_type j = 0; j != number_of_generators(); ++j) {
-            _left.set(_enumerate_order[i], j, _right.get(_left.get(p, j), b));
-          }
+          detail::froidure_pin_left(st, _enumerate_order[i]);
         }
         _wordlen++;
         _lenindex.push_back(_enumerate_order.size());
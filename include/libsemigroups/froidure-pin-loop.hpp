@@ -0,0 +1,122 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains function templates implementing the steps of the main
+// loop of the Froidure-Pin algorithm, which are shared by FroidurePin and
+// FroidurePinBatch. These only differ in how the elements and the Cayley
+// graphs are stored, and so the functions below access the data through an
+// object st of type TStorage, which must have the following member
+// functions, where i and r are indices of elements, and j is a letter:
+//
+// * number_of_generators()
+// * first(i), final(i), prefix(i), suffix(i), letter_to_pos(j): as in
+//   FroidurePin;
+// * is_one(r): returns true if r is the index of the identity;
+// * reduced(i, j), left(i, j), right(i, j): as in FroidurePin;
+// * set_left(i, j, r), set_right(i, j, r): define the edges of the left and
+//   right Cayley graphs;
+// * product_by_generator(i, j): computes the product of the element i and
+//   the generator j, and returns the index of the product if it is already
+//   an element, and UNDEFINED if not;
+// * add_product(i, j, b, s): adds the product last computed by
+//   product_by_generator(i, j) as a new element with first letter b, suffix
+//   s, prefix i, and final letter j, and sets reduced(i, j) to true and
+//   right(i, j) to the index of the new element;
+// * add_rule(): increments the number of rules.
+
+#ifndef LIBSEMIGROUPS_FROIDURE_PIN_LOOP_HPP_
+#define LIBSEMIGROUPS_FROIDURE_PIN_LOOP_HPP_
+
+#include <cstddef>  // for size_t
+
+#include "constants.hpp"  // for UNDEFINED
+#include "types.hpp"      // for letter_type
+
+namespace libsemigroups {
+  namespace detail {
+
+    // Multiply the element i, which is a generator, by every generator.
+    template <typename TStorage>
+    void froidure_pin_multiply_generator(TStorage& st, size_t i) {
+      for (letter_type j = 0; j != st.number_of_generators(); ++j) {
+        size_t const r = st.product_by_generator(i, j);
+        if (r != UNDEFINED) {
+          st.set_right(i, j, r);
+          st.add_rule();
+        } else {
+          st.add_product(i, j, st.first(i), st.letter_to_pos(j));
+        }
+      }
+    }
+
+    // Multiply the element i, which is not a generator, by every generator.
+    // If the suffix s of i times j is not reduced, then the product is known
+    // already and is found using the Cayley graphs, without multiplying.
+    template <typename TStorage>
+    void froidure_pin_multiply(TStorage& st, size_t i) {
+      letter_type const b = st.first(i);
+      size_t const      s = st.suffix(i);
+      for (letter_type j = 0; j != st.number_of_generators(); ++j) {
+        if (!st.reduced(s, j)) {
+          size_t const r = st.right(s, j);
+          if (st.is_one(r)) {
+            st.set_right(i, j, st.letter_to_pos(b));
+          } else if (st.prefix(r) != UNDEFINED) {  // r is not a generator
+            st.set_right(
+                i, j, st.right(st.left(st.prefix(r), b), st.final(r)));
+          } else {
+            st.set_right(i, j, st.right(st.letter_to_pos(b), st.final(r)));
+          }
+        } else {
+          size_t const r = st.product_by_generator(i, j);
+          if (r != UNDEFINED) {
+            st.set_right(i, j, r);
+            st.add_rule();
+          } else {
+            st.add_product(i, j, b, st.right(s, j));
+          }
+        }
+      }
+    }
+
+    // Define the edges of the left Cayley graph from the element i, which is
+    // a generator, once every generator has been multiplied by every
+    // generator.
+    template <typename TStorage>
+    void froidure_pin_left_generator(TStorage& st, size_t i) {
+      letter_type const b = st.final(i);
+      for (letter_type j = 0; j != st.number_of_generators(); ++j) {
+        st.set_left(i, j, st.right(st.letter_to_pos(j), b));
+      }
+    }
+
+    // Define the edges of the left Cayley graph from the element i, which is
+    // not a generator, once every element of the same length as i has been
+    // multiplied by every generator.
+    template <typename TStorage>
+    void froidure_pin_left(TStorage& st, size_t i) {
+      size_t const      p = st.prefix(i);
+      letter_type const b = st.final(i);
+      for (letter_type j = 0; j != st.number_of_generators(); ++j) {
+        st.set_left(i, j, st.right(st.left(p, j), b));
+      }
+    }
+  }  // namespace detail
+}  // namespace libsemigroups
+
+#endif  // LIBSEMIGROUPS_FROIDURE_PIN_LOOP_HPP_
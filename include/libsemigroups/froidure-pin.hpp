@@ -954,6 +954,10 @@ namespace libsemigroups {
                         std::vector<bool>&,
                         state_type*);
 
+    // Provides the functions in froidure-pin-loop.hpp with access to the data
+    // of a FroidurePin, implemented in froidure-pin-impl.hpp.
+    class LoopStorage;
+
     void init_degree(const_reference);
 
     template <typename T>
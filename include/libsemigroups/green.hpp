@@ -0,0 +1,420 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration of a class for computing the Green's
+// structure of a finite semigroup from the left and right Cayley graphs of a
+// fully enumerated FroidurePinBase.
+
+#ifndef LIBSEMIGROUPS_GREEN_HPP_
+#define LIBSEMIGROUPS_GREEN_HPP_
+
+#include <cstddef>  // for size_t
+#include <vector>   // for vector
+
+#include "constants.hpp"          // for UNDEFINED
+#include "froidure-pin-base.hpp"  // for FroidurePinBase
+
+namespace libsemigroups {
+  //! Defined in ``green.hpp``.
+  //!
+  //! This class computes the Green's structure of a finite semigroup
+  //! represented by a FroidurePinBase, i.e. the \f$\mathscr{R}\f$-,
+  //! \f$\mathscr{L}\f$-, \f$\mathscr{D}\f$-, and \f$\mathscr{H}\f$-classes of
+  //! the semigroup, and the idempotents belonging to each class.
+  //!
+  //! The \f$\mathscr{R}\f$- and \f$\mathscr{L}\f$-classes are the strongly
+  //! connected components of the right and left Cayley graphs of the
+  //! semigroup. If more than one thread is permitted, then these components
+  //! are found at the same time, one graph per thread, but the components of
+  //! each graph are found sequentially, and so at most two threads are ever
+  //! used. The \f$\mathscr{D}\f$-classes are the classes of the join of
+  //! \f$\mathscr{R}\f$ and \f$\mathscr{L}\f$, and the \f$\mathscr{H}\f$-classes
+  //! are the non-empty intersections of \f$\mathscr{R}\f$- and
+  //! \f$\mathscr{L}\f$-classes.
+  //!
+  //! Unlike Konieczny, this class does not require any representation of the
+  //! elements of the semigroup other than the Cayley graphs, and so it can be
+  //! used with any semigroup that can be fully enumerated by FroidurePin.
+  //! Everything is computed when a Green object is constructed, and is stored
+  //! in flat arrays indexed by the positions of the elements in the
+  //! FroidurePinBase.
+  //!
+  //! The classes of every kind are numbered in the order in which their
+  //! least elements (with respect to the positions in the FroidurePinBase)
+  //! occur.
+  //!
+  //! \par Example
+  //! \code
+  //! FroidurePin<Transf<>> S({Transf<>({1, 0, 2}),
+  //!                          Transf<>({1, 2, 0}),
+  //!                          Transf<>({0, 0, 2})});
+  //! Green G(S);
+  //! G.number_of_d_classes();  // 3
+  //! G.number_of_r_classes();  // 5
+  //! G.number_of_l_classes();  // 7
+  //! \endcode
+  class Green final {
+   public:
+    ////////////////////////////////////////////////////////////////////////
+    // Green - typedefs - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! The type of the positions of elements.
+    using element_index_type = FroidurePinBase::element_index_type;
+
+    //! The type of the indices of classes.
+    using class_index_type = FroidurePinBase::element_index_type;
+
+    //! The type of iterators pointing at the positions of the elements in a
+    //! \f$\mathscr{D}\f$- or \f$\mathscr{H}\f$-class.
+    using const_iterator =
+        typename std::vector<element_index_type>::const_iterator;
+
+    ////////////////////////////////////////////////////////////////////////
+    // Green - constructors - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Construct from a FroidurePinBase.
+    //!
+    //! The FroidurePinBase \p S is fully enumerated, and the Green's
+    //! structure of \p S is computed. If \p number_of_threads is greater
+    //! than \c 1, then the \f$\mathscr{R}\f$- and
+    //! \f$\mathscr{L}\f$-classes are found in two threads; everything else
+    //! is computed in the calling thread. \p S is not required after the
+    //! constructor returns.
+    //!
+    //! \param S the semigroup.
+    //! \param number_of_threads the maximum number of threads to use (only
+    //! \c 1 or \c 2 threads are ever used).
+    //!
+    //! \throws LibsemigroupsException if \p number_of_threads is \c 0.
+    //!
+    //! \warning If \p S is infinite, then the constructor never returns.
+    //!
+    //! \complexity
+    //! Linear in the size of \p S times the number of generators of \p S.
+    explicit Green(FroidurePinBase& S, size_t number_of_threads = 2);
+
+    //! Default copy constructor.
+    Green(Green const&) = default;
+
+    //! Default move constructor.
+    Green(Green&&) = default;
+
+    //! Default copy assignment operator.
+    Green& operator=(Green const&) = default;
+
+    //! Default move assignment operator.
+    Green& operator=(Green&&) = default;
+
+    ~Green();
+
+    ////////////////////////////////////////////////////////////////////////
+    // Green - numbers of classes - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Returns the size of the semigroup.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t size() const noexcept {
+      return _r_class.size();
+    }
+
+    //! Returns the number of \f$\mathscr{R}\f$-classes.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t number_of_r_classes() const noexcept {
+      return _number_of_r_classes;
+    }
+
+    //! Returns the number of \f$\mathscr{L}\f$-classes.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t number_of_l_classes() const noexcept {
+      return _number_of_l_classes;
+    }
+
+    //! Returns the number of \f$\mathscr{D}\f$-classes.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t number_of_d_classes() const noexcept {
+      return _d_class_first.size() - 1;
+    }
+
+    //! Returns the number of \f$\mathscr{H}\f$-classes.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t number_of_h_classes() const noexcept {
+      return _h_class_first.size() - 1;
+    }
+
+    //! Returns the number of idempotents.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t number_of_idempotents() const noexcept {
+      return _number_of_idempotents;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Green - classes of elements - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Returns the index of the \f$\mathscr{R}\f$-class of the element in
+    //! position \p pos.
+    //!
+    //! \param pos the position of an element.
+    //!
+    //! \returns A value of type \ref class_index_type.
+    //!
+    //! \throws LibsemigroupsException if \p pos is not less than size().
+    class_index_type r_class(element_index_type pos) const {
+      validate_element_index(pos);
+      return _r_class[pos];
+    }
+
+    //! Returns the index of the \f$\mathscr{L}\f$-class of the element in
+    //! position \p pos.
+    //!
+    //! \param pos the position of an element.
+    //!
+    //! \returns A value of type \ref class_index_type.
+    //!
+    //! \throws LibsemigroupsException if \p pos is not less than size().
+    class_index_type l_class(element_index_type pos) const {
+      validate_element_index(pos);
+      return _l_class[pos];
+    }
+
+    //! Returns the index of the \f$\mathscr{D}\f$-class of the element in
+    //! position \p pos.
+    //!
+    //! \param pos the position of an element.
+    //!
+    //! \returns A value of type \ref class_index_type.
+    //!
+    //! \throws LibsemigroupsException if \p pos is not less than size().
+    class_index_type d_class(element_index_type pos) const {
+      validate_element_index(pos);
+      return _d_class[pos];
+    }
+
+    //! Returns the index of the \f$\mathscr{H}\f$-class of the element in
+    //! position \p pos.
+    //!
+    //! \param pos the position of an element.
+    //!
+    //! \returns A value of type \ref class_index_type.
+    //!
+    //! \throws LibsemigroupsException if \p pos is not less than size().
+    class_index_type h_class(element_index_type pos) const {
+      validate_element_index(pos);
+      return _h_class[pos];
+    }
+
+    //! Check if the element in position \p pos is an idempotent.
+    //!
+    //! \param pos the position of an element.
+    //!
+    //! \returns A value of type \c bool.
+    //!
+    //! \throws LibsemigroupsException if \p pos is not less than size().
+    bool is_idempotent(element_index_type pos) const {
+      validate_element_index(pos);
+      return _is_idempotent[pos];
+    }
+
+    //! Check if the element in position \p pos is regular, i.e. if its
+    //! \f$\mathscr{D}\f$-class contains an idempotent.
+    //!
+    //! \param pos the position of an element.
+    //!
+    //! \returns A value of type \c bool.
+    //!
+    //! \throws LibsemigroupsException if \p pos is not less than size().
+    bool is_regular_element(element_index_type pos) const {
+      return is_regular_d_class(d_class(pos));
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Green - D-classes - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Returns a const_iterator pointing to the position of the first element
+    //! of the \f$\mathscr{D}\f$-class with index \p d.
+    //!
+    //! The positions of the elements of a class are sorted.
+    //!
+    //! \param d the index of a \f$\mathscr{D}\f$-class.
+    //!
+    //! \returns A value of type \ref const_iterator.
+    //!
+    //! \throws LibsemigroupsException if \p d is not less than
+    //! number_of_d_classes().
+    const_iterator cbegin_d_class(class_index_type d) const {
+      validate_d_class_index(d);
+      return _d_class_elts.cbegin() + _d_class_first[d];
+    }
+
+    //! Returns a const_iterator pointing one past the position of the last
+    //! element of the \f$\mathscr{D}\f$-class with index \p d.
+    //!
+    //! \sa cbegin_d_class.
+    const_iterator cend_d_class(class_index_type d) const {
+      validate_d_class_index(d);
+      return _d_class_elts.cbegin() + _d_class_first[d + 1];
+    }
+
+    //! Returns the number of elements in the \f$\mathscr{D}\f$-class with
+    //! index \p d.
+    //!
+    //! \throws LibsemigroupsException if \p d is not less than
+    //! number_of_d_classes().
+    size_t size_d_class(class_index_type d) const {
+      validate_d_class_index(d);
+      return _d_class_first[d + 1] - _d_class_first[d];
+    }
+
+    //! Returns the number of \f$\mathscr{R}\f$-classes contained in the
+    //! \f$\mathscr{D}\f$-class with index \p d.
+    //!
+    //! \throws LibsemigroupsException if \p d is not less than
+    //! number_of_d_classes().
+    size_t number_of_r_classes_d_class(class_index_type d) const {
+      validate_d_class_index(d);
+      return _d_class_number_of_r_classes[d];
+    }
+
+    //! Returns the number of \f$\mathscr{L}\f$-classes contained in the
+    //! \f$\mathscr{D}\f$-class with index \p d.
+    //!
+    //! \throws LibsemigroupsException if \p d is not less than
+    //! number_of_d_classes().
+    size_t number_of_l_classes_d_class(class_index_type d) const {
+      validate_d_class_index(d);
+      return _d_class_number_of_l_classes[d];
+    }
+
+    //! Returns the number of idempotents in the \f$\mathscr{D}\f$-class with
+    //! index \p d.
+    //!
+    //! \throws LibsemigroupsException if \p d is not less than
+    //! number_of_d_classes().
+    size_t number_of_idempotents_d_class(class_index_type d) const {
+      validate_d_class_index(d);
+      return _d_class_number_of_idempotents[d];
+    }
+
+    //! Check if the \f$\mathscr{D}\f$-class with index \p d is regular, i.e.
+    //! if it contains an idempotent.
+    //!
+    //! \throws LibsemigroupsException if \p d is not less than
+    //! number_of_d_classes().
+    bool is_regular_d_class(class_index_type d) const {
+      return number_of_idempotents_d_class(d) != 0;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Green - H-classes - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Returns a const_iterator pointing to the position of the first element
+    //! of the \f$\mathscr{H}\f$-class with index \p h.
+    //!
+    //! The positions of the elements of a class are sorted.
+    //!
+    //! \param h the index of an \f$\mathscr{H}\f$-class.
+    //!
+    //! \returns A value of type \ref const_iterator.
+    //!
+    //! \throws LibsemigroupsException if \p h is not less than
+    //! number_of_h_classes().
+    const_iterator cbegin_h_class(class_index_type h) const {
+      validate_h_class_index(h);
+      return _h_class_elts.cbegin() + _h_class_first[h];
+    }
+
+    //! Returns a const_iterator pointing one past the position of the last
+    //! element of the \f$\mathscr{H}\f$-class with index \p h.
+    //!
+    //! \sa cbegin_h_class.
+    const_iterator cend_h_class(class_index_type h) const {
+      validate_h_class_index(h);
+      return _h_class_elts.cbegin() + _h_class_first[h + 1];
+    }
+
+    //! Returns the number of elements in the \f$\mathscr{H}\f$-class with
+    //! index \p h.
+    //!
+    //! \throws LibsemigroupsException if \p h is not less than
+    //! number_of_h_classes().
+    size_t size_h_class(class_index_type h) const {
+      validate_h_class_index(h);
+      return _h_class_first[h + 1] - _h_class_first[h];
+    }
+
+    //! Check if the \f$\mathscr{H}\f$-class with index \p h is a group, i.e.
+    //! if it contains an idempotent.
+    //!
+    //! \throws LibsemigroupsException if \p h is not less than
+    //! number_of_h_classes().
+    bool is_group_h_class(class_index_type h) const {
+      validate_h_class_index(h);
+      return _h_class_idempotent[h] != UNDEFINED;
+    }
+
+    //! Returns the position of the idempotent in the \f$\mathscr{H}\f$-class
+    //! with index \p h, or \ref UNDEFINED if there is no such idempotent.
+    //!
+    //! \throws LibsemigroupsException if \p h is not less than
+    //! number_of_h_classes().
+    element_index_type idempotent_h_class(class_index_type h) const {
+      validate_h_class_index(h);
+      return _h_class_idempotent[h];
+    }
+
+   private:
+    void validate_element_index(element_index_type) const;
+    void validate_d_class_index(class_index_type) const;
+    void validate_h_class_index(class_index_type) const;
+
+    std::vector<class_index_type>   _d_class;
+    std::vector<element_index_type> _d_class_elts;
+    std::vector<size_t>             _d_class_first;
+    std::vector<size_t>             _d_class_number_of_idempotents;
+    std::vector<size_t>             _d_class_number_of_l_classes;
+    std::vector<size_t>             _d_class_number_of_r_classes;
+    std::vector<class_index_type>   _h_class;
+    std::vector<element_index_type> _h_class_elts;
+    std::vector<size_t>             _h_class_first;
+    std::vector<element_index_type> _h_class_idempotent;
+    std::vector<bool>               _is_idempotent;
+    std::vector<class_index_type>   _l_class;
+    size_t                          _number_of_idempotents;
+    size_t                          _number_of_l_classes;
+    size_t                          _number_of_r_classes;
+    std::vector<class_index_type>   _r_class;
+  };
+}  // namespace libsemigroups
+
+#endif  // LIBSEMIGROUPS_GREEN_HPP_
@@ -28,6 +28,7 @@
 #include <cstddef>  // for size_t
 #include <iosfwd>   // for string, ostream
 #include <memory>   // for unique_ptr
+#include <random>   // for mt19937
 #include <vector>   // for vector
 
 #include "cong-intf.hpp"     // for CongruenceInterface
@@ -58,6 +59,12 @@ namespace libsemigroups {
     //! [string rewriting system](https://w.wiki/9Re)
     //! defining a finitely presented monoid or semigroup.
     //!
+    //! Rules can be added to a KnuthBendix instance after it has been run (but
+    //! not while it is running). If the rewriting system was confluent when a
+    //! rule is added, then, when it is next run, only the new rules, and any
+    //! existing rules made redundant by them, are reduced and overlapped with
+    //! the existing rules.
+    //!
     //! \sa congruence::KnuthBendix.
     //!
     //! \par Example
@@ -585,6 +592,33 @@ namespace libsemigroups {
       //! \ref gilman_digraph.
       uint64_t number_of_normal_forms(size_t min, size_t max);
 
+      //! Returns a random normal form of a given length.
+      //!
+      //! The normal form is chosen uniformly at random from the normal forms
+      //! of length \p length, by choosing a random path in the \ref
+      //! gilman_digraph. The normal forms are not enumerated, and so this is
+      //! feasible even when there are very many normal forms of length \p
+      //! length, or the semigroup is infinite.
+      //!
+      //! \param length the length of the normal form.
+      //! \param mt a std::mt19937 used as a random source.
+      //!
+      //! \returns
+      //! A value of type \c std::string.
+      //!
+      //! \throws LibsemigroupsException if there are no normal forms of
+      //! length \p length.
+      //!
+      //! \complexity
+      //! Assuming that \c this has been run until finished, the complexity of
+      //! this function is at worst \f$O(kmn)\f$ where \f$k\f$ is \p length,
+      //! \f$m\f$ is the number of letters in the alphabet, and \f$n\f$ is the
+      //! number of nodes in the \ref gilman_digraph.
+      //!
+      //! \warning This will terminate when the KnuthBendix instance is
+      //! reduced and confluent, which might be never.
+      std::string random_normal_form(size_t length, std::mt19937& mt);
+
       //////////////////////////////////////////////////////////////////////////
       // FpSemigroupInterface - pure virtual member functions - public
       //////////////////////////////////////////////////////////////////////////
@@ -653,6 +687,10 @@ namespace libsemigroups {
 
       bool validate_identity_impl(std::string const&) const override;
 
+      bool incremental_impl() const noexcept override {
+        return true;
+      }
+
       //////////////////////////////////////////////////////////////////////////
       // KnuthBendix - data - private
       //////////////////////////////////////////////////////////////////////////
@@ -809,6 +847,10 @@ namespace libsemigroups {
 
       bool finished_impl() const override;
 
+      size_t memory_usage_impl() const noexcept override {
+        return _kb->memory_usage();
+      }
+
       ////////////////////////////////////////////////////////////////////////////
       // CongruenceInterface - pure virtual methods - private
       ////////////////////////////////////////////////////////////////////////////
@@ -828,6 +870,10 @@ namespace libsemigroups {
       bool is_quotient_obviously_finite_impl() override;
       bool is_quotient_obviously_infinite_impl() override;
 
+      bool incremental_impl() const noexcept override {
+        return true;
+      }
+
       ////////////////////////////////////////////////////////////////////////////
       // KnuthBendix - data - private
       ////////////////////////////////////////////////////////////////////////////
@@ -25,8 +25,9 @@
 #ifndef LIBSEMIGROUPS_KONIECZNY_HPP_
 #define LIBSEMIGROUPS_KONIECZNY_HPP_
 
-#include <algorithm>      // for binary_search
+#include <algorithm>      // for binary_search, find_if
 #include <cstddef>        // for size_t
+#include <random>         // for mt19937, uniform_int_distribution
 #include <set>            // for set
 #include <type_traits>    // for is_pointer
 #include <unordered_map>  // for unordered_map
@@ -847,6 +848,62 @@ namespace libsemigroups {
       return val;
     }
 
+    //! Returns a random element.
+    //!
+    //! The element is chosen uniformly at random from the elements of the
+    //! semigroup. A \f$\mathscr{D}\f$-class is chosen with probability
+    //! proportional to its size, and then an element of the chosen
+    //! \f$\mathscr{D}\f$-class is chosen uniformly at random from the
+    //! products \f$xhy\f$ where \f$x\f$ and \f$y\f$ are multipliers taking
+    //! the \f$\mathscr{H}\f$-class \f$H\f$ of the representative to the
+    //! other \f$\mathscr{H}\f$-classes, and \f$h \in H\f$. The elements are
+    //! not enumerated, and so this is feasible even when the semigroup is
+    //! too large to enumerate.
+    //!
+    //! \param mt a std::mt19937 used as a random source.
+    //!
+    //! \returns
+    //! A value of type \ref element_type.
+    //!
+    //! \exceptions
+    //! \no_libsemigroups_except
+    //!
+    //! \note This function triggers a full enumeration of the frames of every
+    //! \f$\mathscr{D}\f$-class.
+    element_type random_element(std::mt19937& mt) {
+      run();
+      std::uniform_int_distribution<size_t> dist(0, current_size() - 1);
+      size_t                                pos = dist(mt);
+      // The first D-class is that of the adjoined identity, which is skipped
+      // unless it belongs to the semigroup, as in cbegin_D_classes.
+      auto first = _D_classes.cbegin() + (_adjoined_identity_contained ? 0 : 1);
+      auto it    = std::find_if(first, _D_classes.cend(), [&pos](DClass* D) {
+        if (pos < D->size()) {
+          return true;
+        }
+        pos -= D->size();
+        return false;
+      });
+      LIBSEMIGROUPS_ASSERT(it != _D_classes.cend());
+      DClass*      D = *it;
+      size_t const i = pos % D->number_of_L_classes();
+      pos /= D->number_of_L_classes();
+      size_t const j = pos / D->size_H_class();
+      size_t const k = pos % D->size_H_class();
+
+      PoolGuard cg1(element_pool());
+      PoolGuard cg2(element_pool());
+      auto      tmp1 = cg1.get();
+      auto      tmp2 = cg2.get();
+      Product()(this->to_external(tmp1),
+                this->to_external_const(D->cbegin_right_mults()[j]),
+                this->to_external_const(D->cbegin_H_class()[k]));
+      Product()(this->to_external(tmp2),
+                this->to_external(tmp1),
+                this->to_external_const(D->cbegin_left_mults()[i]));
+      return this->external_copy(this->to_external_const(tmp2));
+    }
+
     //! Returns the degree of elements.
     //!
     //! All elements of a Konieczny must have the same degree, as computed by
@@ -23,11 +23,15 @@
 
 #include "action.hpp"
 #include "adapters.hpp"
+#include "allocator.hpp"
+#include "automatic.hpp"
+#include "binary.hpp"
 #include "bipart.hpp"
 #include "bitset.hpp"
 #include "bmat.hpp"
 #include "bmat8.hpp"
 #include "bruidhinn-traits.hpp"
+#include "canonical-form.hpp"
 #include "config.hpp"
 #include "cong-intf.hpp"
 #include "cong-pair.hpp"
@@ -45,7 +49,9 @@
 #include "fpsemi-intf.hpp"
 #include "fpsemi.hpp"
 #include "froidure-pin-base.hpp"
+#include "froidure-pin-batch.hpp"
 #include "froidure-pin.hpp"
+#include "green.hpp"
 #include "function-ref.hpp"
 #include "hpcombi.hpp"
 #include "int-range.hpp"
@@ -62,6 +68,7 @@
 #include "report.hpp"
 #include "runner.hpp"
 #include "schreier-sims.hpp"
+#include "sims1.hpp"
 #include "siso.hpp"
 #include "stl.hpp"
 #include "string.hpp"
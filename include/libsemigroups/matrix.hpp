@@ -2711,9 +2711,10 @@ namespace libsemigroups {
       static_assert(IsBMat<Mat>, "IsBMat<Mat> must be true!");
       static_assert(IsBitSet<value_type> || IsStdBitSet<value_type>,
                     "Container::value_type must be BitSet or std::bitset");
-      LIBSEMIGROUPS_ASSERT(rows.size() <= BitSet<1>::max_size());
-      LIBSEMIGROUPS_ASSERT(rows.empty()
-                           || rows[0].size() <= BitSet<1>::max_size());
+      LIBSEMIGROUPS_ASSERT(rows.size() <= value_type().size());
+      // std::bitset is compared using to_ullong in LessBitSet
+      LIBSEMIGROUPS_ASSERT(IsBitSet<value_type>
+                           || value_type().size() <= BitSet<1>::max_size());
 
       std::sort(rows.begin(), rows.end(), detail::LessBitSet());
       // Remove duplicates
@@ -2743,9 +2744,9 @@ namespace libsemigroups {
       static_assert(IsBMat<Mat>, "IsBMat<Mat> must be true!");
       static_assert(IsBitSet<value_type> || IsStdBitSet<value_type>,
                     "Container::value_type must be BitSet or std::bitset");
-      LIBSEMIGROUPS_ASSERT(rows.size() <= BitSet<1>::max_size());
-      LIBSEMIGROUPS_ASSERT(rows.empty()
-                           || rows[0].size() <= BitSet<1>::max_size());
+      LIBSEMIGROUPS_ASSERT(rows.size() <= value_type().size());
+      LIBSEMIGROUPS_ASSERT(IsBitSet<value_type>
+                           || value_type().size() <= BitSet<1>::max_size());
       std::decay_t<Container> result;
       bitset_row_basis<Mat>(std::forward<Container>(rows), result);
       return result;
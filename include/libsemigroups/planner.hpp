@@ -0,0 +1,68 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration of the functions used by Congruence and
+// FpSemigroup to choose which of the runners in their Race to run, and how to
+// configure them, from some cheap to compute statistics about the
+// presentation.
+
+#ifndef LIBSEMIGROUPS_PLANNER_HPP_
+#define LIBSEMIGROUPS_PLANNER_HPP_
+
+#include <cstddef>  // for size_t
+
+namespace libsemigroups {
+  namespace detail {
+    class Race;
+
+    struct PresentationStats {
+      PresentationStats() noexcept
+          : number_of_generators(0),
+            number_of_relations(0),
+            max_relation_length(0),
+            total_relation_length(0),
+            obviously_infinite(false) {}
+
+      void add_relation(size_t lhs_length, size_t rhs_length) noexcept;
+
+      // Add the relations in [first, last), TIterator must point at pairs of
+      // words or strings.
+      template <typename TIterator>
+      void add_relations(TIterator first, TIterator last) {
+        for (auto it = first; it != last; ++it) {
+          add_relation(it->first.size(), it->second.size());
+        }
+      }
+
+      size_t number_of_generators;
+      size_t number_of_relations;
+      size_t max_relation_length;
+      size_t total_relation_length;
+      bool   obviously_infinite;
+    };
+
+    // Removes the runners in race that are unlikely to win, or can never
+    // win, and configures those that remain according to stats. At least one
+    // runner is always kept. The runners must be derived from
+    // CongruenceInterface or FpSemigroupInterface, and the race must not have
+    // started.
+    void plan_runners(Race& race, PresentationStats const& stats);
+  }  // namespace detail
+}  // namespace libsemigroups
+
+#endif  // LIBSEMIGROUPS_PLANNER_HPP_
@@ -27,12 +27,17 @@
 #ifndef LIBSEMIGROUPS_RACE_HPP_
 #define LIBSEMIGROUPS_RACE_HPP_
 
-#include <chrono>   // for nanoseconds
-#include <cstddef>  // for size_t
-#include <memory>   // for std::shared_ptr
-#include <thread>   // for mutex
-#include <vector>   // for vector
+#include <algorithm>           // for find_if, remove_if
+#include <chrono>              // for nanoseconds
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <memory>              // for std::shared_ptr
+#include <mutex>               // for mutex, unique_lock
+#include <thread>              // for thread
+#include <utility>             // for forward
+#include <vector>              // for vector
 
+#include "constants.hpp"  // for LIMIT_MAX
 #include "debug.hpp"      // for LIBSEMIGROUPS_ASSERT
 #include "exception.hpp"  // for LIBSEMIGROUPS_EXCEPTION
 #include "report.hpp"     // for REPORT_DEFAULT, REPORT_TIME
@@ -49,9 +54,11 @@ namespace libsemigroups {
       Race();
       Race(Race const& other) : Race() {
         // Can't use = default because std::mutex is non-copyable.
-        _runners     = other._runners;
-        _max_threads = other._max_threads;
-        _winner      = other._winner;
+        _runners       = other._runners;
+        _max_threads   = other._max_threads;
+        _winner        = other._winner;
+        _deterministic = other._deterministic;
+        _max_memory    = other._max_memory;
       }
 
       Race(Race&&)  = delete;
@@ -71,6 +78,45 @@ namespace libsemigroups {
         return _max_threads;
       }
 
+      // Set whether or not the winner is chosen deterministically. If val is
+      // true, then the winner is the first Runner, in the order they were
+      // added, that finishes without being killed. A Runner that finishes
+      // only kills the Runners added after it, and those added before it run
+      // until they finish, are killed, or throw. The winner then only depends
+      // on the Runners and not on the timing of the threads, provided that
+      // each Runner is itself deterministic. The price is that the race can
+      // take as long as the slowest of the Runners before the winner. In
+      // particular, if the first Runner that is not killed never finishes,
+      // then run() never returns, even if a later Runner has finished; use
+      // run_for or run_until to bound the time spent in this case.
+      Race& deterministic(bool val) noexcept {
+        _deterministic = val;
+        return *this;
+      }
+
+      bool deterministic() const noexcept {
+        return _deterministic;
+      }
+
+      // Set the approximate maximum number of bytes that the Runners in the
+      // race can use in total, as reported by Runner::memory_usage. While the
+      // race is run in more than one thread, if the Runners that are still
+      // running use more than val bytes, then the one using the most memory
+      // is killed. The last Runner still running is never killed, and
+      // neither is the first Runner that is not dead if the race is
+      // deterministic, since that would change the winner. Killed Runners
+      // remain in the race, so that they can still be found by find_runner,
+      // and are released with the other losers once there is a winner. The
+      // default value is LIMIT_MAX, meaning that there is no limit.
+      Race& max_memory(size_t val) noexcept {
+        _max_memory = val;
+        return *this;
+      }
+
+      size_t max_memory() const noexcept {
+        return _max_memory;
+      }
+
       // Runs the method Runner::run on every Runner in the Race, and returns
       // the one that finishes first. The losers are deleted.
       std::shared_ptr<Runner> winner() {
@@ -85,6 +131,19 @@ namespace libsemigroups {
       // Adds a Runner to the race, throws if the race is already over.
       void add_runner(std::shared_ptr<Runner>);
 
+      // Removes every Runner r in the race for which pred(r) returns true,
+      // throws if the race is already over.
+      template <typename TPredicate>
+      void remove_runners_if(TPredicate&& pred) {
+        if (_winner != nullptr) {
+          LIBSEMIGROUPS_EXCEPTION("the race is over, cannot remove runners");
+        }
+        _runners.erase(std::remove_if(_runners.begin(),
+                                      _runners.end(),
+                                      std::forward<TPredicate>(pred)),
+                       _runners.end());
+      }
+
       using const_iterator =
           typename std::vector<std::shared_ptr<Runner>>::const_iterator;
 
@@ -168,6 +227,16 @@ namespace libsemigroups {
       }
 
      private:
+      // Returns the first Runner that is not dead if it is finished, and
+      // nullptr if it is not, or if every Runner is dead.
+      std::shared_ptr<Runner> deterministic_winner() const;
+
+      // Kills the running Runner using the most memory, if the running
+      // Runners use more than _max_memory bytes. The first done.size()
+      // Runners are those being run, and done[i] is true if the thread
+      // running the i-th Runner has stopped. Must be called with _mtx locked.
+      void enforce_max_memory(std::vector<bool> const& done);
+
       // Runs the callable object \p func on every Runner in parallel.
       template <typename TCallable>
       void run_func(TCallable const& func) {
@@ -187,13 +256,22 @@ namespace libsemigroups {
             REPORT_TIME(tmr);
             return;
           }
-          for (size_t i = 0; i < _runners.size(); ++i) {
-            if (_runners[i]->finished()) {
+          if (_deterministic) {
+            _winner = deterministic_winner();
+            if (_winner != nullptr) {
               REPORT_DEFAULT("using 0 additional threads\n");
-              _winner = _runners[i];
-              REPORT_DEFAULT("#%d is already finished!\n", i);
+              REPORT_DEFAULT("the winner is already finished!\n");
               return;
             }
+          } else {
+            for (size_t i = 0; i < _runners.size(); ++i) {
+              if (_runners[i]->finished()) {
+                REPORT_DEFAULT("using 0 additional threads\n");
+                _winner = _runners[i];
+                REPORT_DEFAULT("#%d is already finished!\n", i);
+                return;
+              }
+            }
           }
 
           std::vector<std::thread::id> tids(_runners.size(),
@@ -205,21 +283,35 @@ namespace libsemigroups {
           detail::Timer tmr;
           LIBSEMIGROUPS_ASSERT(nr_threads != 0);
 
-          auto thread_func = [this, &func, &tids](size_t pos) {
+          std::vector<bool>       done(nr_threads, false);
+          std::condition_variable cv;
+
+          auto thread_func = [this, &func, &tids, &done, &cv](size_t pos) {
             tids[pos] = std::this_thread::get_id();
             try {
               func(_runners.at(pos));
             } catch (std::exception const& e) {
               size_t tid = THREAD_ID_MANAGER.tid(tids[pos]);
               REPORT_DEFAULT("exception thrown by #%d:\n%s\n", tid, e.what());
+              std::lock_guard<std::mutex> lg(_mtx);
+              if (_deterministic) {
+                // Otherwise the Runners added after this one would wait for
+                // it to finish.
+                _runners.at(pos)->kill();
+              }
+              done[pos] = true;
+              cv.notify_one();
               return;
             }
             // Stop two Runner* objects from killing each other
             {
               std::lock_guard<std::mutex> lg(_mtx);
               if (_runners.at(pos)->finished()) {
-                for (auto it = _runners.begin(); it < _runners.begin() + pos;
-                     it++) {
+                // In deterministic mode, the Runners added before this one
+                // can still win, and so they are not killed.
+                auto first = _deterministic ? _runners.begin() + pos
+                                            : _runners.begin();
+                for (auto it = first; it < _runners.begin() + pos; it++) {
                   (*it)->kill();
                 }
                 for (auto it = _runners.begin() + pos + 1; it < _runners.end();
@@ -227,6 +319,8 @@ namespace libsemigroups {
                   (*it)->kill();
                 }
               }
+              done[pos] = true;
+              cv.notify_one();
             }
           };
 
@@ -236,19 +330,31 @@ namespace libsemigroups {
           for (size_t i = 0; i < nr_threads; ++i) {
             t.push_back(std::thread(thread_func, i));
           }
+          if (_max_memory != LIMIT_MAX) {
+            std::unique_lock<std::mutex> lk(_mtx);
+            while (std::find(done.cbegin(), done.cend(), false)
+                   != done.cend()) {
+              cv.wait_for(lk, std::chrono::milliseconds(1));
+              enforce_max_memory(done);
+            }
+          }
           for (size_t i = 0; i < nr_threads; ++i) {
             t.at(i).join();
           }
           REPORT_TIME(tmr);
-          for (auto method = _runners.begin(); method < _runners.end();
-               ++method) {
-            if ((*method)->finished()) {
-              LIBSEMIGROUPS_ASSERT(_winner == nullptr);
-              _winner = *method;
-              size_t tid
-                  = THREAD_ID_MANAGER.tid(tids.at(method - _runners.begin()));
-              REPORT_DEFAULT("#%d is the winner!\n", tid);
-              break;
+          if (_deterministic) {
+            _winner = deterministic_winner();
+          } else {
+            for (auto method = _runners.begin(); method < _runners.end();
+                 ++method) {
+              if ((*method)->finished()) {
+                LIBSEMIGROUPS_ASSERT(_winner == nullptr);
+                _winner = *method;
+                size_t tid = THREAD_ID_MANAGER.tid(
+                    tids.at(method - _runners.begin()));
+                REPORT_DEFAULT("#%d is the winner!\n", tid);
+                break;
+              }
             }
           }
           if (_winner != nullptr) {
@@ -267,6 +373,8 @@ namespace libsemigroups {
       size_t                               _max_threads;
       std::mutex                           _mtx;
       std::shared_ptr<Runner>              _winner;
+      bool                                 _deterministic;
+      size_t                               _max_memory;
     };
   }  // namespace detail
 }  // namespace libsemigroups
@@ -25,6 +25,8 @@
 
 #include <atomic>       // for atomic
 #include <chrono>       // for nanoseconds, high_resolution_clock
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint64_t
 #include <type_traits>  // for forward
 
 #include "exception.hpp"     // for LibsemigroupsException
@@ -32,6 +34,10 @@
 #include "report.hpp"        // for REPORT_DEFAULT
 
 namespace libsemigroups {
+  namespace detail {
+    class DeadlineService;
+  }  // namespace detail
+
   //! A pseudonym for std::chrono::nanoseconds::max().
   constexpr std::chrono::nanoseconds FOREVER = std::chrono::nanoseconds::max();
 
@@ -50,7 +56,15 @@ namespace libsemigroups {
   //! (\ref dead)? has it timed out (\ref timed_out)? has it
   //! \ref stopped for any reason?
   //! * permit the function \ref run to be killed from another thread
-  //! (\ref kill).
+  //! (\ref kill), or paused from another thread and resumed later,
+  //! possibly in a different thread (\ref pause and \ref resume);
+  //! * estimating how far the algorithm has progressed (\ref progress).
+  //!
+  //! While \ref run, \ref run_for, or \ref run_until is being executed, a
+  //! single thread shared by all Runner instances keeps track of when the
+  //! time passed to \ref run_for has elapsed and when it is time to report
+  //! again. Hence \ref timed_out and \ref report do not query the clock, and
+  //! can be called in every iteration of the main loop of a derived class.
   class Runner {
     // Enum class for the state of the Runner.
     enum class state {
@@ -59,6 +73,7 @@ namespace libsemigroups {
       running_for          = 2,
       running_until        = 3,
       timed_out            = 4,
+      paused               = 5,
       stopped_by_predicate = 6,
       not_running          = 7,
       dead                 = 8
@@ -88,7 +103,9 @@ namespace libsemigroups {
     //!
     //! \param other the Runner to copy.
     Runner(Runner const& other) : Runner() {
-      _state = other._state.load();
+      _memory_usage = other._memory_usage.load();
+      _progress     = other._progress.load();
+      _state        = other._state.load();
     }
 
     //! Move constructor
@@ -99,7 +116,9 @@ namespace libsemigroups {
     //!
     //! \param other the Runner to move from.
     Runner(Runner&& other) : Runner() {
-      _state = other._state.load();
+      _memory_usage = other._memory_usage.load();
+      _progress     = other._progress.load();
+      _state        = other._state.load();
     }
 
     //! Deleted.
@@ -128,17 +147,22 @@ namespace libsemigroups {
     void run() {
       if (!finished() && !dead()) {
         before_run();
+        DeadlineGuard dg(this, FOREVER);
         set_state(state::running_to_finish);
+        _resume_for = FOREVER;
         try {
           run_impl();
         } catch (LibsemigroupsException const& e) {
           if (!dead()) {
-            set_state(state::not_running);
+            set_state(paused_or(state::not_running));
           }
           throw;
         }
         if (!dead()) {
-          set_state(state::not_running);
+          set_state(paused_or(state::not_running));
+          if (!paused()) {
+            update_progress(1.0);
+          }
         }
       }
     }
@@ -191,11 +215,9 @@ namespace libsemigroups {
     //! \sa run_for(std::chrono::nanoseconds) and
     //! run_for(TIntType).
     bool timed_out() const {
-      return (running_for()
-                  ? std::chrono::duration_cast<std::chrono::nanoseconds>(
-                        std::chrono::high_resolution_clock::now() - _start_time)
-                        >= _run_for
-                  : get_state() == state::timed_out);
+      // _timed_out is set by the deadline service, see runner.cpp
+      return (running_for() ? _timed_out.load(std::memory_order_relaxed)
+                            : get_state() == state::timed_out);
     }
 
     //! Run until a nullary predicate returns \p true or \ref finished.
@@ -211,13 +233,15 @@ namespace libsemigroups {
       REPORT_DEFAULT("running until predicate returns true or finished. . .\n");
       if (!finished() && !dead()) {
         before_run();
-        _stopper = std::forward<T>(func);
+        DeadlineGuard dg(this, FOREVER);
+        _stopper    = std::forward<T>(func);
+        _resume_for = std::chrono::nanoseconds::min();
         if (!_stopper()) {
           set_state(state::running_until);
           run_impl();
           if (!finished()) {
             if (!dead()) {
-              set_state(state::stopped_by_predicate);
+              set_state(paused_or(state::stopped_by_predicate));
             }
           } else {
             set_state(state::not_running);
@@ -315,6 +339,7 @@ namespace libsemigroups {
     bool finished() const {
       if (started() && !dead() && finished_impl()) {
         _state = state::not_running;
+        _progress.store(1.0, std::memory_order_relaxed);
         return true;
       } else {
         return false;
@@ -396,6 +421,106 @@ namespace libsemigroups {
       return get_state() == state::dead;
     }
 
+    //! Pause \ref run (thread-safe).
+    //!
+    //! This function can be used to stop run(), run_for(), or run_until()
+    //! from another thread. Unlike kill(), the Runner remains in a valid
+    //! state, and paused() returns \c true once the function that was
+    //! running has returned, unless it finished in the meantime. If \c this
+    //! is not running, then this function does nothing.
+    //!
+    //! \par Parameters
+    //! (None)
+    //!
+    //! \returns
+    //! (None).
+    //!
+    //! \exceptions
+    //! \noexcept
+    //!
+    //! \sa resume()
+    void pause() noexcept {
+      if (running()) {
+        _pause_requested.store(true, std::memory_order_relaxed);
+      }
+    }
+
+    //! Check if the runner was paused.
+    //!
+    //! \returns
+    //! \c true if \c this was stopped by pause() the last time that it was
+    //! running, and \c false otherwise.
+    //!
+    //! \par Parameters
+    //! (None)
+    //!
+    //! \exceptions
+    //! \noexcept
+    bool paused() const noexcept {
+      return get_state() == state::paused;
+    }
+
+    //! Resume a paused runner.
+    //!
+    //! If \c this was paused during run(), then this function calls run(),
+    //! and if \c this was paused during run_for(), then this function calls
+    //! run_for() with the time remaining when it was paused. This function
+    //! can be called from a thread other than the one where \c this was
+    //! paused. If \c this is not paused(), then this function does nothing.
+    //!
+    //! \par Parameters
+    //! (None)
+    //!
+    //! \returns
+    //! (None).
+    //!
+    //! \throws LibsemigroupsException if \c this was paused during
+    //! run_until(), since the predicate is not stored; in this case
+    //! run_until() should be called again instead.
+    void resume();
+
+    //! Returns an estimate of the progress of \ref run.
+    //!
+    //! The value returned is in the range \f$[0, 1]\f$, where \c 0
+    //! indicates that nothing has been done, and \c 1 that \c this is
+    //! finished. The value is updated by a derived class while it is
+    //! running, and is only an estimate; for example, it might decrease if
+    //! it is discovered that there is more work to do than previously thought.
+    //! This function can be called from any thread.
+    //!
+    //! \par Parameters
+    //! (None)
+    //!
+    //! \returns
+    //! A \c double.
+    //!
+    //! \exceptions
+    //! \noexcept
+    double progress() const noexcept {
+      return _progress.load(std::memory_order_relaxed);
+    }
+
+    //! Returns an estimate of the memory used by \c this.
+    //!
+    //! The value returned is an approximation of the number of bytes used by
+    //! the largest data structures of \c this, such as the coset table of a
+    //! congruence::ToddCoxeter or the rules of a fpsemigroup::KnuthBendix.
+    //! It is updated by a derived class when these data structures grow,
+    //! and is \c 0 for derived classes that do not estimate their memory
+    //! usage. This function can be called from any thread.
+    //!
+    //! \par Parameters
+    //! (None)
+    //!
+    //! \returns
+    //! A \c size_t.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t memory_usage() const noexcept {
+      return memory_usage_impl();
+    }
+
     //! Check if the runner is stopped.
     //!
     //! This function can be used to check whether or not run() has been
@@ -408,7 +533,9 @@ namespace libsemigroups {
     //! \par Parameters
     //! (None)
     bool stopped() const {
-      return (running() ? (timed_out() || stopped_by_predicate())
+      return (running() ? (timed_out()
+                           || _pause_requested.load(std::memory_order_relaxed)
+                           || stopped_by_predicate())
                         : get_state() > state::running_until);
     }
 
@@ -441,7 +568,61 @@ namespace libsemigroups {
       }
     }
 
+   protected:
+    //! Set the value returned by progress().
+    //!
+    //! This function should be called periodically by a derived class while
+    //! it is running. Values outside of the range \f$[0, 1]\f$ are clamped.
+    //!
+    //! \param val the estimated progress.
+    //!
+    //! \returns
+    //! (None).
+    //!
+    //! \exceptions
+    //! \noexcept
+    void update_progress(double val) noexcept {
+      _progress.store(val < 0 ? 0 : (val > 1 ? 1 : val),
+                      std::memory_order_relaxed);
+    }
+
+    //! Set the value returned by memory_usage().
+    //!
+    //! This function should be called by a derived class whenever its
+    //! largest data structures grow, or shrink, significantly.
+    //!
+    //! \param val the estimated number of bytes used.
+    //!
+    //! \returns
+    //! (None).
+    //!
+    //! \exceptions
+    //! \noexcept
+    void update_memory_usage(size_t val) noexcept {
+      _memory_usage.store(val, std::memory_order_relaxed);
+    }
+
    private:
+    friend class detail::DeadlineService;
+
+    // Registers the runner with the deadline service on construction, and
+    // deregisters it on destruction. If timeout is not FOREVER, then
+    // _timed_out is set once timeout has elapsed, and while at least one
+    // DeadlineGuard exists for a runner _report_due is set every
+    // _report_time_interval.
+    class DeadlineGuard {
+     public:
+      DeadlineGuard(Runner* runner, std::chrono::nanoseconds timeout);
+      ~DeadlineGuard();
+
+      DeadlineGuard(DeadlineGuard const&) = delete;
+      DeadlineGuard& operator=(DeadlineGuard const&) = delete;
+
+     private:
+      Runner*  _runner;
+      uint64_t _timeout_id;
+    };
+
     bool running_for() const noexcept {
       return _state == state::running_for;
     }
@@ -454,10 +635,24 @@ namespace libsemigroups {
     virtual bool finished_impl() const = 0;
     virtual void before_run() {}
 
+    // Derived classes that wrap another Runner should override this to
+    // return the memory usage of the wrapped Runner.
+    virtual size_t memory_usage_impl() const noexcept {
+      return _memory_usage.load(std::memory_order_relaxed);
+    }
+
     state get_state() const noexcept {
       return _state;
     }
 
+    // Returns state::paused if pause() was called during the current run, and
+    // stt otherwise.
+    state paused_or(state stt) noexcept {
+      return _pause_requested.exchange(false, std::memory_order_relaxed)
+                 ? state::paused
+                 : stt;
+    }
+
     void set_state(state stt) const {
       LIBSEMIGROUPS_ASSERT(stt != state::never_run);
       if (!dead()) {
@@ -472,11 +667,17 @@ namespace libsemigroups {
     ////////////////////////////////////////////////////////////////////////
 
     mutable std::chrono::high_resolution_clock::time_point _last_report;
+    std::atomic<size_t>                            _memory_usage;
+    std::atomic<bool>                              _pause_requested;
+    mutable std::atomic<double>                    _progress;
+    mutable std::atomic<bool>                      _report_due;
+    uint64_t                                       _report_id;
     std::chrono::nanoseconds                       _report_time_interval;
-    std::chrono::nanoseconds                       _run_for;
-    std::chrono::high_resolution_clock::time_point _start_time;
+    std::chrono::nanoseconds                       _resume_for;
+    size_t                                         _run_depth;
     mutable std::atomic<state>                     _state;
     detail::FunctionRef<bool(void)>                _stopper;
+    std::atomic<bool>                              _timed_out;
   };
 }  // namespace libsemigroups
 #endif  // LIBSEMIGROUPS_RUNNER_HPP_
@@ -0,0 +1,344 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains a declaration of a class for performing the "low-index
+// congruence" algorithm for monoids, i.e. for enumerating the one-sided
+// congruences with at most n classes of a finitely presented monoid, by
+// backtracking over partially defined coset tables.
+
+#ifndef LIBSEMIGROUPS_SIMS1_HPP_
+#define LIBSEMIGROUPS_SIMS1_HPP_
+
+#include <cstddef>           // for size_t, ptrdiff_t
+#include <cstdint>           // for uint32_t, uint64_t
+#include <functional>        // for function
+#include <initializer_list>  // for initializer_list
+#include <iterator>          // for forward_iterator_tag
+#include <memory>            // for shared_ptr
+#include <vector>            // for vector
+
+#include "cong-intf.hpp"  // for congruence_kind
+#include "digraph.hpp"    // for ActionDigraph
+#include "types.hpp"      // for word_type, letter_type
+
+namespace libsemigroups {
+  //! Defined in ``sims1.hpp``.
+  //!
+  //! This class implements a version of the "low-index subgroups" algorithm
+  //! of Sims for monoids. It can be used to enumerate the left or right
+  //! congruences with at most \c n classes of the monoid defined by the
+  //! generators and generating pairs of a Sims1 instance.
+  //!
+  //! Every such congruence is represented by an ActionDigraph with (at most)
+  //! \c n nodes, where node \c 0 corresponds to the class of the identity,
+  //! and the edge labelled \c a from node \c x is the class obtained by
+  //! multiplying the class \c x by the generator \c a (on the right for
+  //! right congruences, and on the left for left congruences). Exactly one
+  //! digraph is produced for every congruence, and the nodes in every
+  //! digraph are numbered in the order they are first reached when the
+  //! edges are considered in order of source node and then label.
+  //!
+  //! The search is a backtrack over partially defined coset tables, where
+  //! the consequences of every edge definition are deduced, in the style of
+  //! Felsch's strategy for the Todd-Coxeter algorithm, before a further edge
+  //! is defined. A table with a pair of edges that are forced to coincide is
+  //! abandoned rather than collapsed, since it cannot lead to a congruence
+  //! not already found elsewhere in the search.
+  //!
+  //! The digraphs are never stored, and are instead either passed one at a
+  //! time to a function (for_each() and find_if()), or returned one at a time
+  //! by an iterator (cbegin() and cend()). The search performed by for_each()
+  //! and find_if() can be run in parallel (see number_of_threads()), in
+  //! which case every thread processes a subtree of the search tree, and an
+  //! idle thread steals the shallowest unexplored subtree of another thread.
+  //!
+  //! \par Example
+  //! \code
+  //! Sims1 S(congruence_kind::right);
+  //! S.set_number_of_generators(2);
+  //! S.add_pair({0, 0}, {});
+  //! S.add_pair({1, 1, 1}, {});
+  //! S.add_pair({0, 1, 0, 1}, {});
+  //! S.number_of_congruences(6);  // 6 == the number of subgroups of S3
+  //! \endcode
+  class Sims1 final {
+   public:
+    ////////////////////////////////////////////////////////////////////////
+    // Sims1 - typedefs - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! The type of the nodes in the digraphs produced.
+    using node_type = uint32_t;
+
+    //! The type of the digraphs produced.
+    using digraph_type = ActionDigraph<node_type>;
+
+    ////////////////////////////////////////////////////////////////////////
+    // Sims1 - constructors - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Construct from the kind of congruence.
+    //!
+    //! \param knd the kind of the congruences to enumerate.
+    //!
+    //! \throws LibsemigroupsException if \p knd is congruence_kind::twosided.
+    explicit Sims1(congruence_kind knd);
+
+    //! Default copy constructor.
+    Sims1(Sims1 const&) = default;
+
+    //! Default move constructor.
+    Sims1(Sims1&&) = default;
+
+    //! Default copy assignment operator.
+    Sims1& operator=(Sims1 const&) = default;
+
+    //! Default move assignment operator.
+    Sims1& operator=(Sims1&&) = default;
+
+    ~Sims1();
+
+    ////////////////////////////////////////////////////////////////////////
+    // Sims1 - presentation - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Set the number of generators of the monoid.
+    //!
+    //! \param n the number of generators.
+    //!
+    //! \returns A reference to \c this.
+    //!
+    //! \throws LibsemigroupsException if \p n is \c 0, or if the number of
+    //! generators has already been set to a different value.
+    Sims1& set_number_of_generators(size_t n);
+
+    //! Returns the number of generators of the monoid.
+    //!
+    //! \returns A value of type \c size_t, or \ref UNDEFINED if the number of
+    //! generators has not been set.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t number_of_generators() const noexcept {
+      return _number_of_generators;
+    }
+
+    //! Add a relation to the presentation of the monoid.
+    //!
+    //! Unlike CongruenceInterface::add_pair, either or both of \p u and \p v
+    //! can be the empty word, which represents the identity of the monoid.
+    //!
+    //! \param u a word over the generators.
+    //! \param v a word over the generators.
+    //!
+    //! \returns A reference to \c this.
+    //!
+    //! \throws LibsemigroupsException if the number of generators has not
+    //! been set, or if \p u or \p v contains a letter that is out of bounds.
+    Sims1& add_pair(word_type const& u, word_type const& v);
+
+    //! Add a relation to the presentation of the monoid.
+    //! \sa add_pair(word_type const&, word_type const&)
+    Sims1& add_pair(std::initializer_list<size_t> l,
+                    std::initializer_list<size_t> r) {
+      return add_pair(word_type(l), word_type(r));
+    }
+
+    //! Returns the number of relations added using add_pair().
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t number_of_generating_pairs() const noexcept {
+      return _relations.size() / 2;
+    }
+
+    //! Returns the kind of the congruences enumerated.
+    //!
+    //! \exceptions
+    //! \noexcept
+    congruence_kind kind() const noexcept {
+      return _kind;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Sims1 - settings - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Set the number of threads used by for_each(), find_if(), and
+    //! number_of_congruences().
+    //!
+    //! \param val the number of threads.
+    //!
+    //! \returns A reference to \c this.
+    //!
+    //! \throws LibsemigroupsException if \p val is \c 0.
+    Sims1& number_of_threads(size_t val);
+
+    //! Returns the number of threads used by for_each(), find_if(), and
+    //! number_of_congruences(). The default value is \c 1.
+    //!
+    //! \exceptions
+    //! \noexcept
+    size_t number_of_threads() const noexcept {
+      return _number_of_threads;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Sims1 - the main functions - public
+    ////////////////////////////////////////////////////////////////////////
+
+    //! Apply a function to every congruence with at most \p n classes.
+    //!
+    //! The digraph passed to \p hook is only valid for the duration of the
+    //! call. If number_of_threads() is greater than \c 1, then \p hook is
+    //! called concurrently from several threads, and the order in which the
+    //! digraphs are passed to \p hook is not specified.
+    //!
+    //! \param n the maximum number of classes.
+    //! \param hook the function to apply.
+    //!
+    //! \throws LibsemigroupsException if \p n is \c 0, or the number of
+    //! generators has not been set.
+    void for_each(size_t                                     n,
+                  std::function<void(digraph_type const&)> hook) const;
+
+    //! Find a congruence with at most \p n classes satisfying a predicate.
+    //!
+    //! If number_of_threads() is greater than \c 1, then \p pred is called
+    //! concurrently from several threads, and which of several digraphs
+    //! satisfying \p pred is returned is not specified.
+    //!
+    //! \param n the maximum number of classes.
+    //! \param pred the predicate.
+    //!
+    //! \returns The first digraph found for which \p pred returns \c true, or
+    //! a digraph with \c 0 nodes if there is no such digraph.
+    //!
+    //! \throws LibsemigroupsException if \p n is \c 0, or the number of
+    //! generators has not been set.
+    digraph_type find_if(size_t                                     n,
+                         std::function<bool(digraph_type const&)> pred) const;
+
+    //! Returns the number of congruences with at most \p n classes.
+    //!
+    //! \param n the maximum number of classes.
+    //!
+    //! \returns A value of type \c uint64_t.
+    //!
+    //! \throws LibsemigroupsException if \p n is \c 0, or the number of
+    //! generators has not been set.
+    uint64_t number_of_congruences(size_t n) const;
+
+   private:
+    struct PendingDef;
+    class iterator_base;
+    class thread_runner;
+    class thread_pool;
+
+   public:
+    //! A forward iterator over the digraphs of the congruences with at most
+    //! a given number of classes (see cbegin() and cend()).
+    //!
+    //! The search is performed lazily, i.e. incrementing an iterator performs
+    //! the search only as far as the next congruence. Iterators of this type
+    //! only ever use a single thread.
+    class const_iterator {
+     public:
+      //! No doc
+      using value_type = digraph_type;
+      //! No doc
+      using reference = digraph_type const&;
+      //! No doc
+      using pointer = digraph_type const*;
+      //! No doc
+      using difference_type = std::ptrdiff_t;
+      //! No doc
+      using iterator_category = std::forward_iterator_tag;
+
+      //! No doc
+      const_iterator(Sims1 const* sims, size_t n);
+      //! No doc
+      const_iterator(const_iterator const&);
+      //! No doc
+      const_iterator(const_iterator&&);
+      //! No doc
+      const_iterator& operator=(const_iterator const&);
+      //! No doc
+      const_iterator& operator=(const_iterator&&);
+      //! No doc
+      ~const_iterator();
+
+      //! No doc
+      bool operator==(const_iterator const& that) const noexcept;
+
+      //! No doc
+      bool operator!=(const_iterator const& that) const noexcept {
+        return !(*this == that);
+      }
+
+      //! No doc
+      reference operator*() const noexcept;
+
+      //! No doc
+      pointer operator->() const noexcept {
+        return &**this;
+      }
+
+      //! No doc
+      const_iterator& operator++();
+
+      //! No doc
+      const_iterator operator++(int) {
+        const_iterator copy(*this);
+        ++(*this);
+        return copy;
+      }
+
+     private:
+      std::shared_ptr<iterator_base> _ptr;
+    };
+
+    //! Returns a const_iterator pointing to the digraph of the first
+    //! congruence with at most \p n classes.
+    //!
+    //! \param n the maximum number of classes.
+    //!
+    //! \throws LibsemigroupsException if \p n is \c 0, or the number of
+    //! generators has not been set.
+    const_iterator cbegin(size_t n) const;
+
+    //! Returns a const_iterator pointing one past the digraph of the last
+    //! congruence with at most \p n classes.
+    //!
+    //! \param n the maximum number of classes.
+    //!
+    //! \throws LibsemigroupsException if \p n is \c 0, or the number of
+    //! generators has not been set.
+    const_iterator cend(size_t n) const;
+
+   private:
+    void validate(size_t n) const;
+
+    congruence_kind        _kind;
+    size_t                 _number_of_generators;
+    size_t                 _number_of_threads;
+    std::vector<word_type> _relations;
+  };
+}  // namespace libsemigroups
+
+#endif  // LIBSEMIGROUPS_SIMS1_HPP_
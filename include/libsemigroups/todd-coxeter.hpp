@@ -24,6 +24,7 @@
 
 #include <chrono>      // for chrono::nanoseconds
 #include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t
 #include <functional>  // for function
 #include <memory>      // for shared_ptr
 #include <numeric>     // for std::iota
@@ -31,6 +32,7 @@
 #include <utility>     // for pair
 #include <vector>      // for vector
 
+#include "allocator.hpp"   // for memory_policy
 #include "cong-intf.hpp"   // for congruence_kind,...
 #include "cong-wrap.hpp"   // for CongruenceWrapper
 #include "containers.hpp"  // for DynamicArray2
@@ -76,6 +78,13 @@ namespace libsemigroups {
     //! In this documentation we use the term "coset enumeration" to mean the
     //! execution of (any version of) the Todd-Coxeter algorithm.
     //!
+    //! Generating pairs can be added using add_pair() after the enumeration
+    //! has finished. In this case, the new pairs are traced through the
+    //! existing complete coset table and the resulting coincidences are
+    //! processed, so that the table of the quotient is obtained without
+    //! enumerating again. The table is re-standardized the next time that it
+    //! is required.
+    //!
     //! \sa congruence_kind and tril.
     //!
     //! \par Example 1
@@ -246,7 +255,9 @@ namespace libsemigroups {
           none,
           //! Use the relations of a FroidurePin instance
           use_relations,
-          //! Use the left or right Cayley graph of a FroidurePin instance
+          //! Use the left or right Cayley graph of a FroidurePin instance;
+          //! the generating pairs are traced through the Cayley graph in
+          //! place, and only the coset table of the quotient is stored.
           use_cayley_graph
         };
       };
@@ -596,6 +607,36 @@ namespace libsemigroups {
       //! \noexcept
       options::strategy strategy() const noexcept;
 
+      //! Specify how the memory for the coset table is allocated.
+      //!
+      //! The coset table, and the tables of preimages, are reallocated
+      //! according to \p val, and all subsequent allocations for these tables
+      //! use \p val. This can be used to back a large coset table with huge
+      //! pages, or to interleave it over the NUMA nodes of the machine.
+      //!
+      //! The default value is memory_policy::standard.
+      //!
+      //! \param val the memory policy.
+      //!
+      //! \returns A reference to `*this`.
+      //!
+      //! \throws std::bad_alloc if the tables cannot be reallocated.
+      //!
+      //! \complexity
+      //! Linear in the size of the coset table.
+      ToddCoxeter& memory_policy(libsemigroups::memory_policy val);
+
+      //! The current memory policy for the coset table.
+      //!
+      //! \parameters
+      //! (None)
+      //!
+      //! \returns A value of type memory_policy.
+      //!
+      //! \exceptions
+      //! \noexcept
+      libsemigroups::memory_policy memory_policy() const noexcept;
+
       //! Set the amount of time per strategy for options::strategy::random.
       //!
       //! Sets the duration in nanoseconds that a given randomly selected
@@ -634,6 +675,43 @@ namespace libsemigroups {
         return random_interval(std::chrono::nanoseconds(val));
       }
 
+      //! Set the seed of the pseudo-random number generator.
+      //!
+      //! The pseudo-random number generator of \c this is used by
+      //! random_shuffle_generating_pairs and by the strategy
+      //! options::strategy::random. Each ToddCoxeter instance has its own
+      //! generator, which is copied along with the other settings, and so
+      //! two instances with the same seed make the same sequence of random
+      //! choices.
+      //!
+      //! The default value is chosen using \c std::random_device, and can
+      //! be recovered using seed() so that a run can be reproduced.
+      //!
+      //! \param val the seed.
+      //!
+      //! \returns A reference to `*this`.
+      //!
+      //! \exceptions
+      //! \noexcept
+      //!
+      //! \note
+      //! When the strategy is options::strategy::random, each randomly
+      //! chosen strategy runs for random_interval(), and so the amount of
+      //! work done by each strategy depends on the speed of the machine.
+      ToddCoxeter& seed(uint64_t val) noexcept;
+
+      //! The seed of the pseudo-random number generator.
+      //!
+      //! \parameters
+      //! (None)
+      //!
+      //! \returns The last value passed to seed(uint64_t), or the default
+      //! seed, a value of type \c uint64_t.
+      //!
+      //! \exceptions
+      //! \noexcept
+      uint64_t seed() const noexcept;
+
       //! Type of the argument to \ref sort_generating_pairs.
       //!
       //! A type alias for functions that can be used as an argument to
@@ -684,7 +762,8 @@ namespace libsemigroups {
       //!
       //! Additionally, if \c this was defined over a finitely presented
       //! semigroup, then the copy of the defining relations of that semigroup
-      //! contained in \c this (if any) are also sorted according to \p func.
+      //! contained in \c this (if any) are also shuffled. The shuffle is
+      //! determined by seed().
       //!
       //! \returns A reference to `*this`.
       //!
@@ -913,7 +992,11 @@ namespace libsemigroups {
       // CongruenceInterface - non-pure virtual member functions - private
       ////////////////////////////////////////////////////////////////////////
 
+      void       add_pair_impl(word_type const&, word_type const&) override;
+      void       class_indices_impl(FroidurePinBase const&,
+                                    std::vector<coset_type>&) override;
       coset_type const_word_to_class_index(word_type const&) const override;
+      bool       incremental_impl() const noexcept override;
       bool       is_quotient_obviously_finite_impl() override;
       bool       is_quotient_obviously_infinite_impl() override;
       void       set_number_of_generators_impl(size_t) override;
@@ -932,7 +1015,6 @@ namespace libsemigroups {
       void init();
       void init_felsch_tree();
       void init_preimages_from_table();
-      void prefill(FroidurePinBase&);
       void prefill_and_validate(table_type const&, bool);
       void reverse_if_necessary_and_push_back(word_type,
                                               std::vector<word_type>&);
@@ -943,6 +1025,7 @@ namespace libsemigroups {
 
       coset_type new_coset();
       void       remove_preimage(coset_type, letter_type, coset_type);
+      size_t     memory_in_tables() const noexcept;
 
       void make_deductions_dfs(coset_type);
       void process_deductions();
@@ -1143,6 +1226,7 @@ namespace libsemigroups {
       // ToddCoxeter - member functions (main strategies) - private
       ////////////////////////////////////////////////////////////////////////
 
+      void enumerate_cayley_graph();
       void felsch();
       void hlt();
       void sims();
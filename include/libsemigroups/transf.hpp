@@ -1932,9 +1932,9 @@ namespace libsemigroups {
     }
   };
 
-  // Fastest, but limited to at most degree 64
+  // Fastest, but limited to at most degree 1024
   //! Specialization of the adapter ImageRightAction for instances of
-  //! Transformation and BitSet<N> (\f$0 \leq N leq 64\f$).
+  //! Transformation and BitSet<N> (\f$0 \leq N \leq 1024\f$).
   //!
   //! \sa ImageRightAction
   template <size_t N, typename Scalar, size_t M>
@@ -2154,9 +2154,9 @@ namespace libsemigroups {
     }
   };
 
-  // Fastest, but limited to at most degree 64
+  // Fastest, but limited to at most degree 1024
   //! Specialization of the adapter ImageRightAction for instances of
-  //! PPerm and BitSet<N> (\f$0 \leq N \leq 64\f$).
+  //! PPerm and BitSet<N> (\f$0 \leq N \leq 1024\f$).
   //!
   //! \sa ImageRightAction
   template <size_t N, typename Scalar, size_t M>
@@ -2193,16 +2193,12 @@ namespace libsemigroups {
 
   // Fastest when used with BitSet<N>.
   // works for T = std::vector and T = BitSet<N>
-  // Using BitSet<N> limits this to size 64. However, if we are trying to
-  // compute a LeftAction object, then the max size of such is 2 ^ 64, which
-  // is probably not achievable. So, for higher degrees, we will only be able
-  // to compute relatively sparse LeftActions (i.e. not containing the
-  // majority of the 2 ^ n possible subsets), in which case using vectors or
-  // StaticVector1's might be not be appreciable slower anyway. All of this is
-  // to say that it probably isn't worthwhile trying to make BitSet's work for
-  // more than 64 bits.
+  // Using BitSet<N> limits this to size 1024. For degrees above 64 we will
+  // only be able to compute relatively sparse LeftActions (i.e. not
+  // containing the majority of the 2 ^ n possible subsets), but BitSet<N> is
+  // still faster than vectors or StaticVector1's for these.
   //! Specialization of the adapter ImageLeftAction for instances of
-  //! PPerm and std::vector or BitSet<N> (\f$0 \leq N \leq 64\f$).
+  //! PPerm and std::vector or BitSet<N> (\f$0 \leq N \leq 1024\f$).
   //!
   //! \sa ImageLeftAction.
   template <size_t N, typename Scalar, typename T>
@@ -29,12 +29,12 @@
 #ifndef LIBSEMIGROUPS_UF_HPP_
 #define LIBSEMIGROUPS_UF_HPP_
 
-#include <algorithm>      // for for_each
-#include <array>          // for array
-#include <cstddef>        // for size_t
-#include <numeric>        // for iota
-#include <unordered_map>  // for unordered_map
-#include <vector>         // for vector
+#include <algorithm>  // for for_each, min
+#include <array>      // for array
+#include <cstddef>    // for size_t
+#include <numeric>    // for iota, partial_sum
+#include <thread>     // for thread
+#include <vector>     // for vector
 
 #include "config.hpp"    // for LIBSEMIGROUPS_SIZEOF_VOID_P
 #include "debug.hpp"     // for LIBSEMIGROUPS_ASSERT
@@ -123,6 +123,21 @@ namespace libsemigroups {
         }
       }
 
+      // not noexcept because UF::find isn't
+      // Unites the pairs in the range [first, last), where TIterator is an
+      // iterator to std::pair<index_type, index_type> (or similar), and then
+      // compresses using (at most) number_of_threads threads, so that
+      // afterwards find is constant time for every index.
+      template <typename TIterator>
+      void unite_pairs(TIterator first,
+                       TIterator last,
+                       size_t    number_of_threads = 1) {
+        for (auto it = first; it != last; ++it) {
+          unite(it->first, it->second);
+        }
+        compress(number_of_threads);
+      }
+
       // not noexcept because UF::find isn't
       void unite(index_type x, index_type y) {
         LIBSEMIGROUPS_ASSERT(x < _data.size());
@@ -162,15 +177,14 @@ namespace libsemigroups {
       // if this contains that
       bool contains(UF const& that) const {
         LIBSEMIGROUPS_ASSERT(size() == that.size());
-        // reps of that to reps of this
-        std::unordered_map<index_type, index_type> lookup;
+        // reps of that to reps of this, size() indicates no value
+        std::vector<size_type> lookup(size(), size());
 
         for (index_type i = 0; i < size(); ++i) {
-          index_type j  = that.find(i);
-          auto       it = lookup.find(j);
-          if (it == lookup.end()) {
-            lookup.emplace(j, find(i));
-          } else if (it->second != find(i)) {
+          index_type j = that.find(i);
+          if (lookup[j] == size()) {
+            lookup[j] = find(i);
+          } else if (lookup[j] != find(i)) {
             return false;
           }
         }
@@ -204,32 +218,81 @@ namespace libsemigroups {
 
       // not noexcept because std::array::operator[] and
       // std::vector::operator[] aren't
-      void compress() {
-        for (index_type i = 0; i < _data.size(); ++i) {
-          index_type j  = find(index(_data[i]));
-          rank_type  rk = (j == i ? 0 : 1);
-          _data[i]      = node(j) | rk;
+      // If number_of_threads > 1 and there are sufficiently many indices,
+      // then the roots are found by several threads, each of which only
+      // reads _data, and then _data is overwritten by several threads.
+      void compress(size_t number_of_threads = 1) {
+        number_of_threads = std::min(
+            number_of_threads, size() / size_type(MIN_COMPRESS_PER_THREAD));
+        if (number_of_threads <= 1) {
+          for (index_type i = 0; i < _data.size(); ++i) {
+            index_type j  = find(index(_data[i]));
+            rank_type  rk = (j == i ? 0 : 1);
+            _data[i]      = node(j) | rk;
+          }
+          return;
         }
+        std::vector<index_type> roots(size());
+        for_each_chunk(number_of_threads,
+                       [this, &roots](index_type first, index_type last) {
+                         for (index_type i = first; i < last; ++i) {
+                           roots[i] = root(i);
+                         }
+                       });
+        for_each_chunk(number_of_threads,
+                       [this, &roots](index_type first, index_type last) {
+                         for (index_type i = first; i < last; ++i) {
+                           _data[i] = node(roots[i]) | (roots[i] == i ? 0 : 1);
+                         }
+                       });
       }
 
       // not noexcept because compress isn't
       void normalize() {
         compress();
-        // old -> new class indexing
-        std::unordered_map<index_type, index_type> lookup;
-        container_type                             data;
-        set_data_capacity(data, size());
+        // old -> new class indexing, size() indicates no value
+        std::vector<size_type> lookup(size(), size());
         for (index_type i = 0; i < size(); ++i) {
-          index_type j  = find(i);
-          auto       it = lookup.find(j);
-          if (it == lookup.end()) {
-            lookup.emplace(j, i);
-            data[i] = node(i);  // rank 0
-          } else {
-            data[i] = node(it->second) | 1;
+          index_type j = index(_data[i]);  // == find(i) since compressed
+          if (lookup[j] == size()) {
+            lookup[j] = i;
           }
         }
-        std::swap(_data, data);
+        for (index_type i = 0; i < size(); ++i) {
+          index_type j = lookup[index(_data[i])];
+          _data[i]     = node(j) | (j == i ? 0 : 1);
+        }
+      }
+
+      // not noexcept because find isn't
+      // Calls f(first, last) for every block, where [first, last) is a range
+      // of const iterators pointing at the indices in the block in increasing
+      // order. The blocks are visited in increasing order of their least
+      // indices. The blocks are found in a single pass using a counting sort,
+      // rather than by scanning all the indices once per block.
+      template <typename TFunc>
+      void for_each_block(TFunc&& f) const {
+        size_type const N = size();
+        // lookup: roots -> blocks, block: indices -> blocks
+        std::vector<size_type> lookup(N, N), block(N), offsets(1, 0);
+        for (index_type i = 0; i < N; ++i) {
+          index_type j = find(i);
+          if (lookup[j] == N) {
+            lookup[j] = offsets.size() - 1;
+            offsets.push_back(0);
+          }
+          block[i] = lookup[j];
+          offsets[block[i] + 1]++;
+        }
+        std::partial_sum(offsets.cbegin(), offsets.cend(), offsets.begin());
+        std::vector<index_type> indices(N);
+        lookup.assign(offsets.cbegin(), offsets.cend() - 1);
+        for (index_type i = 0; i < N; ++i) {
+          indices[lookup[block[i]]++] = i;
+        }
+        for (size_type b = 0; b < offsets.size() - 1; ++b) {
+          f(indices.cbegin() + offsets[b], indices.cbegin() + offsets[b + 1]);
+        }
       }
 
       // not noexcept because unite isn't
@@ -386,6 +449,39 @@ namespace libsemigroups {
       static constexpr index_type rank_mask
           = ((index_type(1) << RANK_BITS) - index_type(1));
 
+      // The least number of indices for which it is worth using an extra
+      // thread in compress.
+      static constexpr size_type MIN_COMPRESS_PER_THREAD = 1 << 16;
+
+      // Like find, but without path compression, so that it can be called by
+      // several threads at once.
+      index_type root(index_type x) const {
+        LIBSEMIGROUPS_ASSERT(x < _data.size());
+        index_type y = index(_data[x]);
+        while (y != x) {
+          x = y;
+          y = index(_data[x]);
+        }
+        return y;
+      }
+
+      // Calls f(first, last) for number_of_threads ranges [first, last)
+      // partitioning [0, size()), each in a separate thread.
+      template <typename TFunc>
+      void for_each_chunk(size_t number_of_threads, TFunc&& f) const {
+        size_type const          chunk = size() / number_of_threads;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < number_of_threads; ++t) {
+          index_type first = t * chunk;
+          index_type last
+              = (t == number_of_threads - 1 ? size() : first + chunk);
+          threads.emplace_back(f, first, last);
+        }
+        for (auto& thrd : threads) {
+          thrd.join();
+        }
+      }
+
       static inline rank_type rank(node_type i) noexcept {
         return i & rank_mask;
       }
@@ -0,0 +1,137 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the implementation of the allocation functions used by
+// PolicyAllocator.
+
+#include "libsemigroups/allocator.hpp"
+
+#include <cstdint>  // for uintptr_t
+
+#ifdef __linux__
+#include <sys/mman.h>     // for mmap, munmap, madvise
+#include <sys/syscall.h>  // for SYS_mbind, SYS_get_mempolicy
+#include <unistd.h>       // for syscall
+#endif
+
+namespace libsemigroups {
+  namespace detail {
+#ifdef __linux__
+    namespace {
+      // The size (and alignment) of a transparent huge page on x86-64 and
+      // most other architectures.
+      constexpr size_t HUGE_PAGE_SIZE = size_t(1) << 21;
+
+      // MPOL_INTERLEAVE and MPOL_F_MEMS_ALLOWED from <numaif.h>, which is
+      // not installed unless libnuma is.
+      constexpr int      INTERLEAVE_POLICY = 3;
+      constexpr unsigned MEMS_ALLOWED_FLAG = 1 << 2;
+      constexpr size_t   MAX_NUMA_NODES    = 1024;
+
+      bool uses_mmap(size_t n, memory_policy p) noexcept {
+        return p != memory_policy::standard && n >= HUGE_PAGE_SIZE;
+      }
+
+      size_t round_up(size_t n) noexcept {
+        return (n + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+      }
+
+      void interleave(void* ptr, size_t n) noexcept {
+        unsigned long nodes[MAX_NUMA_NODES / (8 * sizeof(unsigned long))]
+            = {0};
+        // Interleave over the nodes this process is allowed to use. If
+        // either call fails, for example because the kernel does not support
+        // NUMA, then the default policy (first touch) is used.
+        if (syscall(SYS_get_mempolicy,
+                    nullptr,
+                    nodes,
+                    MAX_NUMA_NODES,
+                    nullptr,
+                    MEMS_ALLOWED_FLAG)
+            == 0) {
+          syscall(SYS_mbind,
+                  ptr,
+                  n,
+                  INTERLEAVE_POLICY,
+                  nodes,
+                  MAX_NUMA_NODES,
+                  0);
+        }
+      }
+    }  // namespace
+#endif
+
+    void* policy_allocate(size_t n, memory_policy p) {
+#ifdef __linux__
+      if (uses_mmap(n, p)) {
+        // Map an extra huge page so that the returned memory can be aligned
+        // to a huge page boundary, then unmap the unused ends.
+        size_t const len  = round_up(n);
+        void*        addr = mmap(nullptr,
+                          len + HUGE_PAGE_SIZE,
+                          PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS,
+                          -1,
+                          0);
+        if (addr == MAP_FAILED) {
+          throw std::bad_alloc();
+        }
+        uintptr_t const first = reinterpret_cast<uintptr_t>(addr);
+        uintptr_t const start
+            = (first + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+        if (start != first) {
+          munmap(addr, start - first);
+        }
+        munmap(reinterpret_cast<void*>(start + len),
+               first + HUGE_PAGE_SIZE - start);
+        void* ptr = reinterpret_cast<void*>(start);
+        // The pages have not been touched yet, and so these take effect for
+        // every page of the allocation. Failures are ignored, since both are
+        // only hints.
+        if (p == memory_policy::huge_pages
+            || p == memory_policy::huge_pages_and_interleave) {
+#ifdef MADV_HUGEPAGE
+          madvise(ptr, len, MADV_HUGEPAGE);
+#endif
+        }
+        if (p == memory_policy::interleave
+            || p == memory_policy::huge_pages_and_interleave) {
+          interleave(ptr, len);
+        }
+        return ptr;
+      }
+#else
+      (void) p;
+#endif
+      return ::operator new(n);
+    }
+
+    void policy_deallocate(void* ptr, size_t n, memory_policy p) noexcept {
+#ifdef __linux__
+      if (uses_mmap(n, p)) {
+        munmap(ptr, round_up(n));
+        return;
+      }
+#else
+      (void) n;
+      (void) p;
+#endif
+      ::operator delete(ptr);
+    }
+  }  // namespace detail
+}  // namespace libsemigroups
@@ -0,0 +1,920 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the implementation of the class AutomaticGroup.
+//
+// Throughout this file the letters of the alphabet are 0, ..., n - 1, and n is
+// the padding symbol, usually written $. The 2-tape automata (the word
+// difference machine, the general multiplier, and the composite multipliers)
+// read padded pairs of letters (a, b) not both equal to $, the label of (a, b)
+// is a(n + 1) + b, and so the labels are 0, ..., (n + 1) ^ 2 - 2.
+
+#include "libsemigroups/automatic.hpp"
+
+#include <algorithm>      // for sort, reverse, unique
+#include <array>          // for array
+#include <cstddef>        // for size_t
+#include <memory>         // for make_unique
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <unordered_set>  // for unordered_set
+#include <utility>        // for move
+#include <vector>         // for vector
+
+#include "libsemigroups/constants.hpp"          // for UNDEFINED
+#include "libsemigroups/debug.hpp"              // for LIBSEMIGROUPS_ASSERT
+#include "libsemigroups/digraph-helper.hpp"     // for is_acyclic
+#include "libsemigroups/exception.hpp"          // for LIBSEMIGROUPS_EXCEPTION
+#include "libsemigroups/froidure-pin-base.hpp"  // for FroidurePinBase
+#include "libsemigroups/report.hpp"             // for REPORT_DEFAULT
+
+namespace libsemigroups {
+  namespace fpsemigroup {
+    namespace {
+      // Comparison of the prefixes of the two tapes read so far in the word
+      // acceptor construction, or that the second tape has been padded.
+      enum class prefix : size_t {
+        equal   = 0,
+        less    = 1,
+        greater = 2,
+        padded  = 3
+      };
+
+      // A subset construction helper: returns the index of the set <s> in
+      // <sets>, adding it if it is not already present.
+      template <typename T>
+      size_t find_or_add(std::vector<T>&                         sets,
+                         std::unordered_map<T, size_t, Hash<T>>& map,
+                         T&&                                     s) {
+        auto it = map.find(s);
+        if (it != map.end()) {
+          return it->second;
+        }
+        map.emplace(s, sets.size());
+        sets.push_back(std::move(s));
+        return sets.size() - 1;
+      }
+
+      // Returns the word obtained from the labels of the path <path> in a
+      // 2-tape automaton, by reading the tape <tape>.
+      word_type tape(std::vector<size_t> const& path, size_t tape, size_t n) {
+        word_type result;
+        for (auto const& label : path) {
+          size_t const a = (tape == 0 ? label / (n + 1) : label % (n + 1));
+          if (a != n) {
+            result.push_back(a);
+          }
+        }
+        return result;
+      }
+
+    }  // namespace
+
+    ////////////////////////////////////////////////////////////////////////
+    // AutomaticGroup - constructors and destructor - public
+    ////////////////////////////////////////////////////////////////////////
+
+    AutomaticGroup::AutomaticGroup()
+        : FpSemigroupInterface(),
+          _diffs(),
+          _diffs_map(),
+          _gm_diffs(),
+          _gm(),
+          _inverses(),
+          _kb(std::make_unique<KnuthBendix>()),
+          _max_rules(64),
+          _verified(false),
+          _wa(),
+          _wd() {}
+
+    AutomaticGroup::~AutomaticGroup() = default;
+
+    ////////////////////////////////////////////////////////////////////////
+    // AutomaticGroup - settings - public
+    ////////////////////////////////////////////////////////////////////////
+
+    AutomaticGroup& AutomaticGroup::max_rules(size_t val) {
+      if (val == 0) {
+        LIBSEMIGROUPS_EXCEPTION("the argument must be positive, found 0");
+      }
+      _max_rules = val;
+      return *this;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // AutomaticGroup - automata - public
+    ////////////////////////////////////////////////////////////////////////
+
+    ActionDigraph<size_t> const& AutomaticGroup::word_difference_machine() {
+      run();
+      return _wd;
+    }
+
+    ActionDigraph<size_t> const& AutomaticGroup::word_acceptor() {
+      run();
+      return _wa;
+    }
+
+    ActionDigraph<size_t> const& AutomaticGroup::general_multiplier() {
+      run();
+      return _gm;
+    }
+
+    bool AutomaticGroup::multiplier_accepts(std::string const& u,
+                                            std::string const& v,
+                                            std::string const& x) {
+      validate_word(u);
+      validate_word(v);
+      validate_word(x);
+      if (x.size() > 1) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "the 3rd argument must have length at most 1, found %d",
+            x.size());
+      }
+      run();
+      size_t const dx = _diffs_map.find(reduce(string_to_word(x)))->second;
+      size_t const n  = padding();
+      node_type    t  = 0;
+      for (size_t i = 0; i < std::max(u.size(), v.size()); ++i) {
+        size_t const a = (i < u.size() ? char_to_uint(u[i]) : n);
+        size_t const b = (i < v.size() ? char_to_uint(v[i]) : n);
+        t              = _gm.unsafe_neighbor(t, pair_label(a, b));
+        if (t == UNDEFINED) {
+          return false;
+        }
+      }
+      return _gm_diffs[t] == dx;
+    }
+
+    AutomaticGroup::node_type
+    AutomaticGroup::pair_label(letter_type a, letter_type b) const noexcept {
+      size_t const n = padding();
+      a              = (a == UNDEFINED ? n : a);
+      b              = (b == UNDEFINED ? n : b);
+      return a * (n + 1) + b;
+    }
+
+    uint64_t AutomaticGroup::number_of_normal_forms(size_t min, size_t max) {
+      run();
+      return _wa.number_of_paths(0, min, max);
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // FpSemigroupInterface - pure virtual member functions - public
+    ////////////////////////////////////////////////////////////////////////
+
+    uint64_t AutomaticGroup::size() {
+      run();
+      return _wa.number_of_paths(0);
+    }
+
+    bool AutomaticGroup::equal_to(std::string const& u, std::string const& v) {
+      validate_word(u);
+      validate_word(v);
+      return u == v || normal_form(u) == normal_form(v);
+    }
+
+    std::string AutomaticGroup::normal_form(std::string const& w) {
+      validate_word(w);
+      run();
+      word_type v;
+      for (auto const& c : w) {
+        v = multiply(v, char_to_uint(c));
+      }
+      return word_to_string(v);
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // AutomaticGroup - member functions - private
+    ////////////////////////////////////////////////////////////////////////
+
+    word_type AutomaticGroup::inverse(word_type const& w) const {
+      word_type result;
+      result.reserve(w.size());
+      for (auto it = w.crbegin(); it != w.crend(); ++it) {
+        result.push_back(_inverses[*it]);
+      }
+      return result;
+    }
+
+    word_type AutomaticGroup::reduce(word_type const& w) const {
+      return string_to_word(_kb->rewrite(word_to_string(w)));
+    }
+
+    // Adds the word difference <w>, and its inverse, returns true if anything
+    // was added.
+    bool AutomaticGroup::add_word_difference(word_type const& w) {
+      bool result = false;
+      for (auto&& d : {reduce(w), reduce(inverse(w))}) {
+        if (_diffs_map.find(d) == _diffs_map.end()) {
+          _diffs_map.emplace(d, _diffs.size());
+          _diffs.push_back(std::move(d));
+          result = true;
+        }
+      }
+      return result;
+    }
+
+    // Adds the word differences of the pair (u, v), which must represent the
+    // same element of the group.
+    bool AutomaticGroup::add_word_differences(word_type const& u,
+                                              word_type const& v) {
+      bool      result = false;
+      word_type w;
+      for (size_t i = 1; i <= std::max(u.size(), v.size()); ++i) {
+        w = inverse(word_type(u.cbegin(), u.cbegin() + std::min(i, u.size())));
+        w.insert(w.end(), v.cbegin(), v.cbegin() + std::min(i, v.size()));
+        result |= add_word_difference(w);
+      }
+      return result;
+    }
+
+    void AutomaticGroup::init_word_differences() {
+      _diffs.clear();
+      _diffs_map.clear();
+      add_word_difference({});
+      for (letter_type x = 0; x < padding(); ++x) {
+        add_word_difference({x});
+      }
+    }
+
+    void AutomaticGroup::make_word_difference_machine() {
+      size_t const n = padding();
+      _wd            = digraph_type(_diffs.size(), (n + 1) * (n + 1) - 1);
+      for (size_t d = 0; d < _diffs.size(); ++d) {
+        for (size_t a = 0; a <= n; ++a) {
+          for (size_t b = 0; b <= n; ++b) {
+            if (a == n && b == n) {
+              continue;
+            }
+            word_type w = (a == n ? word_type() : word_type({_inverses[a]}));
+            w.insert(w.end(), _diffs[d].cbegin(), _diffs[d].cend());
+            if (b != n) {
+              w.push_back(b);
+            }
+            auto it = _diffs_map.find(reduce(w));
+            if (it != _diffs_map.end()) {
+              _wd.add_edge(d, it->second, pair_label(a, b));
+            }
+          }
+        }
+      }
+    }
+
+    // The word acceptor is obtained by the subset construction from the
+    // non-deterministic automaton whose states are pairs (d, c) where d is a
+    // word difference and c is a value of type prefix. A word w is rejected if
+    // and only if there is a word v that is short-lex less than w, such that
+    // the difference of every prefix of w and v is a word difference, and w =
+    // v.
+    void AutomaticGroup::make_word_acceptor() {
+      using set_type = std::vector<size_t>;
+      size_t const n = padding();
+
+      std::vector<set_type>                                sets;
+      std::unordered_map<set_type, size_t, Hash<set_type>> map;
+      std::vector<std::pair<size_t, size_t>>               edges;
+      find_or_add(sets, map, set_type({static_cast<size_t>(prefix::equal)}));
+
+      for (size_t i = 0; i < sets.size(); ++i) {
+        for (size_t a = 0; a < n; ++a) {
+          set_type next;
+          bool     reducible = false;
+          for (auto const& s : sets[i]) {
+            size_t const d = s / 4;
+            auto const   c = static_cast<prefix>(s % 4);
+            for (size_t b = 0; b <= n && !reducible; ++b) {
+              if (c == prefix::padded && b != n) {
+                continue;
+              }
+              auto const e = _wd.unsafe_neighbor(d, pair_label(a, b));
+              if (e == UNDEFINED) {
+                continue;
+              }
+              prefix cc = c;
+              if (b == n) {
+                cc = prefix::padded;
+              } else if (c == prefix::equal && b != a) {
+                cc = (b < a ? prefix::less : prefix::greater);
+              }
+              if (e == 0 && (cc == prefix::less || cc == prefix::padded)) {
+                reducible = true;
+              } else {
+                next.push_back(4 * e + static_cast<size_t>(cc));
+              }
+            }
+            if (reducible) {
+              break;
+            }
+          }
+          if (!reducible) {
+            std::sort(next.begin(), next.end());
+            next.erase(std::unique(next.begin(), next.end()), next.end());
+            edges.emplace_back(i * n + a,
+                               find_or_add(sets, map, std::move(next)));
+          }
+        }
+      }
+      _wa = digraph_type(sets.size(), n);
+      for (auto const& e : edges) {
+        _wa.add_edge(e.first / n, e.second, e.first % n);
+      }
+    }
+
+    // The states of the general multiplier are triples (s, t, d) where s and t
+    // are states of the word acceptor, or the end of the word (represented by
+    // the number of nodes in the word acceptor), and d is a word difference.
+    void AutomaticGroup::make_general_multiplier() {
+      size_t const n      = padding();
+      size_t const end    = _wa.number_of_nodes();
+      size_t const labels = (n + 1) * (n + 1) - 1;
+
+      std::vector<std::array<size_t, 3>>     states = {{0, 0, 0}};
+      std::unordered_map<size_t, size_t>     map;
+      std::vector<std::pair<size_t, size_t>> edges;
+      auto key = [this, &end](size_t s, size_t t, size_t d) {
+        return (s * (end + 1) + t) * _diffs.size() + d;
+      };
+      map.emplace(0, 0);
+
+      for (size_t i = 0; i < states.size(); ++i) {
+        for (size_t a = 0; a <= n; ++a) {
+          size_t s = states[i][0];
+          if (a != n) {
+            s = (s == end ? UNDEFINED : _wa.unsafe_neighbor(s, a));
+          } else {
+            s = end;
+          }
+          if (s == UNDEFINED) {
+            continue;
+          }
+          for (size_t b = 0; b <= n; ++b) {
+            if (a == n && b == n) {
+              continue;
+            }
+            size_t t = states[i][1];
+            if (b != n) {
+              t = (t == end ? UNDEFINED : _wa.unsafe_neighbor(t, b));
+            } else {
+              t = end;
+            }
+            if (t == UNDEFINED) {
+              continue;
+            }
+            auto const d = _wd.unsafe_neighbor(states[i][2], pair_label(a, b));
+            if (d == UNDEFINED) {
+              continue;
+            }
+            auto it = map.find(key(s, t, d));
+            if (it == map.end()) {
+              it = map.emplace(key(s, t, d), states.size()).first;
+              states.push_back({s, t, d});
+            }
+            edges.emplace_back(i * labels + pair_label(a, b), it->second);
+          }
+        }
+      }
+      _gm = digraph_type(states.size(), labels);
+      for (auto const& e : edges) {
+        _gm.add_edge(e.first / labels, e.second, e.first % labels);
+      }
+      _gm_diffs.clear();
+      _gm_diffs.reserve(states.size());
+      for (auto const& s : states) {
+        _gm_diffs.push_back(s[2]);
+      }
+    }
+
+    // Checks that for every word u accepted by the word acceptor, and every
+    // generator x, there is exactly one word v accepted by the word acceptor
+    // such that (u, v) is accepted by the multiplier for x. If this is not the
+    // case, then new word differences are added.
+    bool AutomaticGroup::check_multipliers() {
+      using set_type = std::vector<size_t>;
+      size_t const n = padding();
+
+      std::vector<size_t> accept;  // the word differences of the generators
+      for (letter_type x = 0; x < n; ++x) {
+        accept.push_back(_diffs_map.find(reduce({x}))->second);
+      }
+
+      // Existence: the states are the state of the word acceptor reached by
+      // reading u, followed by the set of states in the general multiplier
+      // reached by reading u on the first tape.
+      {
+        std::vector<set_type>                                sets;
+        std::unordered_map<set_type, size_t, Hash<set_type>> map;
+        std::vector<std::pair<size_t, letter_type>>          parent;
+        find_or_add(sets, map, set_type({0, 0}));
+        parent.emplace_back(UNDEFINED, UNDEFINED);
+
+        std::vector<bool> seen(_gm.number_of_nodes(), false);
+        std::vector<bool> diffs(_diffs.size(), false);
+        for (size_t i = 0; i < sets.size(); ++i) {
+          if (stopped()) {
+            return false;
+          }
+          // Close the set under reading ($, b)
+          std::vector<size_t> closure(sets[i].cbegin() + 1, sets[i].cend());
+          std::fill(seen.begin(), seen.end(), false);
+          std::fill(diffs.begin(), diffs.end(), false);
+          for (auto const& t : closure) {
+            seen[t] = true;
+          }
+          for (size_t j = 0; j < closure.size(); ++j) {
+            diffs[_gm_diffs[closure[j]]] = true;
+            for (size_t b = 0; b < n; ++b) {
+              auto const t = _gm.unsafe_neighbor(closure[j], pair_label(n, b));
+              if (t != UNDEFINED && !seen[t]) {
+                seen[t] = true;
+                closure.push_back(t);
+              }
+            }
+          }
+          for (letter_type x = 0; x < n; ++x) {
+            if (!diffs[accept[x]]) {
+              word_type u;
+              for (size_t j = i; parent[j].first != UNDEFINED;
+                   j         = parent[j].first) {
+                u.push_back(parent[j].second);
+              }
+              std::reverse(u.begin(), u.end());
+              word_type v = u;
+              v.push_back(x);
+              REPORT_DEFAULT("no multiplier for %s * %c\n",
+                             word_to_string(u).c_str(),
+                             uint_to_char(x));
+              add_word_differences(u, reduce(v));
+              return false;
+            }
+          }
+          for (letter_type a = 0; a < n; ++a) {
+            auto const s = _wa.unsafe_neighbor(sets[i][0], a);
+            if (s == UNDEFINED) {
+              continue;
+            }
+            set_type next;
+            for (auto it = sets[i].cbegin() + 1; it < sets[i].cend(); ++it) {
+              for (size_t b = 0; b <= n; ++b) {
+                auto const t = _gm.unsafe_neighbor(*it, pair_label(a, b));
+                if (t != UNDEFINED) {
+                  next.push_back(t);
+                }
+              }
+            }
+            std::sort(next.begin(), next.end());
+            next.erase(std::unique(next.begin(), next.end()), next.end());
+            next.insert(next.begin(), s);
+            size_t const m = sets.size();
+            if (find_or_add(sets, map, std::move(next)) == m) {
+              parent.emplace_back(i, a);
+            }
+          }
+        }
+      }
+
+      // Uniqueness: the states are pairs of states (s, t) of the general
+      // multiplier reached by reading (u, v) and (u, w), whether or not v and w
+      // differ, and whether or not s or t has read its last pair of letters.
+      {
+        std::vector<bool> is_accept(_diffs.size(), false);
+        is_accept[0] = true;
+        for (auto const& d : accept) {
+          is_accept[d] = true;
+        }
+        size_t const N = _gm.number_of_nodes();
+        // state = (((s * N) + t) * 2 + differ) * 4 + frozen_s * 2 + frozen_t
+        std::vector<size_t>                states = {0};
+        std::vector<std::array<size_t, 4>> parent = {{UNDEFINED, 0, 0, 0}};
+        std::unordered_set<size_t>         seen   = {0};
+
+        for (size_t i = 0; i < states.size(); ++i) {
+          if (stopped()) {
+            return false;
+          }
+          size_t const s      = (states[i] / 8) / N;
+          size_t const t      = (states[i] / 8) % N;
+          bool const   differ = (states[i] / 4) % 2;
+          bool const   fs     = (states[i] / 2) % 2;
+          bool const   ft     = states[i] % 2;
+          if (differ && _gm_diffs[s] == _gm_diffs[t]
+              && is_accept[_gm_diffs[s]]) {
+            std::vector<size_t> path1, path2;
+            for (size_t j = i; parent[j][0] != UNDEFINED; j = parent[j][0]) {
+              path1.push_back(parent[j][1] * (n + 1) + parent[j][2]);
+              path2.push_back(parent[j][1] * (n + 1) + parent[j][3]);
+            }
+            std::reverse(path1.begin(), path1.end());
+            std::reverse(path2.begin(), path2.end());
+            word_type const v = tape(path1, 1, n);
+            word_type const w = tape(path2, 1, n);
+            REPORT_DEFAULT("the normal forms %s and %s are equal\n",
+                           word_to_string(v).c_str(),
+                           word_to_string(w).c_str());
+            add_word_differences(v, w);
+            return false;
+          }
+          for (size_t a = 0; a <= n; ++a) {
+            for (size_t b = 0; b <= n; ++b) {
+              size_t ss  = s;
+              bool   fss = fs;
+              if (a == n && b == n) {
+                fss = true;
+              } else if (fs) {
+                continue;
+              } else {
+                ss = _gm.unsafe_neighbor(s, pair_label(a, b));
+                if (ss == UNDEFINED) {
+                  continue;
+                }
+              }
+              for (size_t c = 0; c <= n; ++c) {
+                size_t tt  = t;
+                bool   ftt = ft;
+                if (a == n && c == n) {
+                  if (fss) {
+                    continue;
+                  }
+                  ftt = true;
+                } else if (ft) {
+                  continue;
+                } else {
+                  tt = _gm.unsafe_neighbor(t, pair_label(a, c));
+                  if (tt == UNDEFINED) {
+                    continue;
+                  }
+                }
+                size_t const next = (((ss * N) + tt) * 2 + (differ || b != c))
+                                        * 4
+                                    + fss * 2 + ftt;
+                if (seen.insert(next).second) {
+                  states.push_back(next);
+                  parent.push_back({i, a, b, c});
+                }
+              }
+            }
+          }
+        }
+      }
+      return true;
+    }
+
+    // Returns the multiplier for the word w, i.e. the automaton accepting the
+    // pairs of normal forms (u, v) such that uw = v.
+    AutomaticGroup::Multiplier
+    AutomaticGroup::multiplier(word_type const& w) const {
+      auto multiplier = [this](size_t d) {
+        Multiplier result{_gm, std::vector<bool>(_gm.number_of_nodes(), false)};
+        for (size_t t = 0; t < _gm.number_of_nodes(); ++t) {
+          result.accept[t] = (_gm_diffs[t] == d);
+        }
+        return result;
+      };
+      if (w.empty()) {
+        return multiplier(0);
+      }
+      Multiplier result
+          = multiplier(_diffs_map.find(reduce({w[0]}))->second);
+      for (auto it = w.cbegin() + 1; it < w.cend(); ++it) {
+        result = compose(result,
+                         multiplier(_diffs_map.find(reduce({*it}))->second));
+      }
+      return result;
+    }
+
+    // Returns the composite of the multipliers A and B, i.e. the automaton
+    // accepting pairs (u, w) such that (u, v) is accepted by A and (v, w) is
+    // accepted by B for some v. The states of the non-deterministic automaton
+    // are (p, q, fp, fq) where p and q are states in A and B, and fp and fq
+    // indicate whether or not A or B have read their last pair of letters.
+    AutomaticGroup::Multiplier
+    AutomaticGroup::compose(Multiplier const& A, Multiplier const& B) const {
+      using set_type    = std::vector<size_t>;
+      size_t const n    = padding();
+      size_t const N    = B.graph.number_of_nodes();
+      size_t const labs = (n + 1) * (n + 1) - 1;
+
+      auto encode = [&N](size_t p, size_t q, bool fp, bool fq) {
+        return ((p * N + q) * 2 + fp) * 2 + fq;
+      };
+
+      // The pair (p, q) is accepting if it is possible to reach a pair of
+      // accept states by reading ($, b) in A and (b, $) in B.
+      auto accepts = [&](size_t p, size_t q, bool fp, bool fq) {
+        if (fp || fq) {
+          return A.accept[p] && B.accept[q];
+        }
+        std::vector<std::pair<size_t, size_t>> todo = {{p, q}};
+        std::unordered_set<size_t>             seen = {encode(p, q, 0, 0)};
+        for (size_t i = 0; i < todo.size(); ++i) {
+          if (A.accept[todo[i].first] && B.accept[todo[i].second]) {
+            return true;
+          }
+          for (size_t b = 0; b < n; ++b) {
+            auto const pp = A.graph.unsafe_neighbor(todo[i].first,
+                                                    pair_label(n, b));
+            auto const qq = B.graph.unsafe_neighbor(todo[i].second,
+                                                    pair_label(b, n));
+            if (pp != UNDEFINED && qq != UNDEFINED
+                && seen.insert(encode(pp, qq, 0, 0)).second) {
+              todo.emplace_back(pp, qq);
+            }
+          }
+        }
+        return false;
+      };
+
+      std::vector<set_type>                                sets;
+      std::unordered_map<set_type, size_t, Hash<set_type>> map;
+      std::vector<std::pair<size_t, size_t>>               edges;
+      find_or_add(sets, map, set_type({0}));
+
+      for (size_t i = 0; i < sets.size(); ++i) {
+        for (size_t a = 0; a <= n; ++a) {
+          for (size_t c = 0; c <= n; ++c) {
+            if (a == n && c == n) {
+              continue;
+            }
+            set_type next;
+            for (auto const& s : sets[i]) {
+              size_t const p  = (s / 4) / N;
+              size_t const q  = (s / 4) % N;
+              bool const   fp = (s / 2) % 2;
+              bool const   fq = s % 2;
+              for (size_t b = 0; b <= n; ++b) {
+                size_t pp = p, qq = q;
+                bool   fpp = fp, fqq = fq;
+                if (a == n && b == n) {
+                  fpp = true;
+                } else if (fp) {
+                  continue;
+                } else {
+                  pp = A.graph.unsafe_neighbor(p, pair_label(a, b));
+                  if (pp == UNDEFINED) {
+                    continue;
+                  }
+                }
+                if (b == n && c == n) {
+                  fqq = true;
+                } else if (fq) {
+                  continue;
+                } else {
+                  qq = B.graph.unsafe_neighbor(q, pair_label(b, c));
+                  if (qq == UNDEFINED) {
+                    continue;
+                  }
+                }
+                next.push_back(encode(pp, qq, fpp, fqq));
+              }
+            }
+            if (!next.empty()) {
+              std::sort(next.begin(), next.end());
+              next.erase(std::unique(next.begin(), next.end()), next.end());
+              edges.emplace_back(i * labs + pair_label(a, c),
+                                 find_or_add(sets, map, std::move(next)));
+            }
+          }
+        }
+      }
+      Multiplier result{digraph_type(sets.size(), labs),
+                        std::vector<bool>(sets.size(), false)};
+      for (auto const& e : edges) {
+        result.graph.add_edge(e.first / labs, e.second, e.first % labs);
+      }
+      for (size_t i = 0; i < sets.size(); ++i) {
+        for (auto const& s : sets[i]) {
+          if (accepts((s / 4) / N, (s / 4) % N, (s / 2) % 2, s % 2)) {
+            result.accept[i] = true;
+            break;
+          }
+        }
+      }
+      return result;
+    }
+
+    // Returns true if A and B accept the same language, by searching the
+    // product of A and B (with a sink state) for a pair of states exactly one
+    // of which is accepting.
+    bool AutomaticGroup::equal_languages(Multiplier const& A,
+                                         Multiplier const& B) const {
+      size_t const sink
+          = std::max(A.graph.number_of_nodes(), B.graph.number_of_nodes());
+      size_t const labs = A.graph.out_degree();
+
+      std::vector<std::pair<size_t, size_t>> states = {{0, 0}};
+      std::unordered_set<size_t>             seen   = {0};
+
+      for (size_t i = 0; i < states.size(); ++i) {
+        size_t const p = states[i].first;
+        size_t const q = states[i].second;
+        if ((p != sink && A.accept[p]) != (q != sink && B.accept[q])) {
+          return false;
+        }
+        for (size_t l = 0; l < labs; ++l) {
+          size_t const pp
+              = (p == sink ? sink : A.graph.unsafe_neighbor(p, l));
+          size_t const qq
+              = (q == sink ? sink : B.graph.unsafe_neighbor(q, l));
+          size_t const ppp = (pp == UNDEFINED ? sink : pp);
+          size_t const qqq = (qq == UNDEFINED ? sink : qq);
+          if ((ppp != sink || qqq != sink)
+              && seen.insert(ppp * (sink + 1) + qqq).second) {
+            states.emplace_back(ppp, qqq);
+          }
+        }
+      }
+      return true;
+    }
+
+    // Checks that the multipliers satisfy the defining relations.
+    bool AutomaticGroup::check_axioms() {
+      for (auto it = cbegin_rules(); it != cend_rules(); ++it) {
+        if (stopped()) {
+          return false;
+        }
+        word_type const u = string_to_word(it->first);
+        word_type const v = string_to_word(it->second);
+        if (!equal_languages(multiplier(u), multiplier(v))) {
+          REPORT_DEFAULT("the multipliers for %s and %s are not equal\n",
+                         it->first.c_str(),
+                         it->second.c_str());
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // Returns the unique normal form v such that (u, v) is accepted by the
+    // multiplier for x, where u is a normal form.
+    word_type AutomaticGroup::multiply(word_type const& u,
+                                       letter_type      x) const {
+      struct Node {
+        node_type   state;
+        size_t      parent;
+        letter_type b;
+      };
+      size_t const n  = padding();
+      size_t const dx = _diffs_map.find(reduce({x}))->second;
+
+      std::vector<Node>             nodes = {{0, UNDEFINED, UNDEFINED}};
+      std::vector<size_t>           layer = {0};
+      std::unordered_set<node_type> seen;
+
+      for (auto const& a : u) {
+        std::vector<size_t> next;
+        seen.clear();
+        for (auto const& i : layer) {
+          for (size_t b = 0; b <= n; ++b) {
+            auto const t
+                = _gm.unsafe_neighbor(nodes[i].state, pair_label(a, b));
+            if (t != UNDEFINED && seen.insert(t).second) {
+              next.push_back(nodes.size());
+              nodes.push_back({t, i, b});
+            }
+          }
+        }
+        layer = std::move(next);
+      }
+      seen.clear();
+      for (auto const& i : layer) {
+        seen.insert(nodes[i].state);
+      }
+      for (size_t j = 0; j < layer.size(); ++j) {
+        size_t const i = layer[j];
+        if (_gm_diffs[nodes[i].state] == dx) {
+          word_type v;
+          for (size_t k = i; nodes[k].parent != UNDEFINED;
+               k        = nodes[k].parent) {
+            if (nodes[k].b != n) {
+              v.push_back(nodes[k].b);
+            }
+          }
+          std::reverse(v.begin(), v.end());
+          return v;
+        }
+        for (size_t b = 0; b < n; ++b) {
+          auto const t = _gm.unsafe_neighbor(nodes[i].state, pair_label(n, b));
+          if (t != UNDEFINED && seen.insert(t).second) {
+            layer.push_back(nodes.size());
+            nodes.push_back({t, i, b});
+          }
+        }
+      }
+      LIBSEMIGROUPS_ASSERT(false);
+      return {};
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // FpSemigroupInterface - pure virtual member functions - private
+    ////////////////////////////////////////////////////////////////////////
+
+    void AutomaticGroup::add_rule_impl(std::string const& u,
+                                       std::string const& v) {
+      _kb->add_rule(u, v);
+    }
+
+    std::shared_ptr<FroidurePinBase> AutomaticGroup::froidure_pin_impl() {
+      return _kb->froidure_pin();
+    }
+
+    void AutomaticGroup::before_run() {
+      // Throws if the inverses (and hence the identity) have not been
+      // defined.
+      _inverses = string_to_word(inverses());
+    }
+
+    void AutomaticGroup::run_impl() {
+      init_word_differences();
+      size_t max_rules = _max_rules;
+
+      while (!stopped()) {
+        _kb->max_rules(max_rules);
+        _kb->run_until([this]() -> bool { return stopped(); });
+        if (stopped()) {
+          break;
+        }
+        for (auto const& rule : _kb->active_rules()) {
+          add_word_differences(string_to_word(rule.first),
+                               string_to_word(rule.second));
+        }
+        size_t number_of_diffs;
+        do {
+          number_of_diffs = _diffs.size();
+          REPORT_DEFAULT("%d active rules, %d word differences\n",
+                         _kb->number_of_active_rules(),
+                         _diffs.size());
+          make_word_difference_machine();
+          make_word_acceptor();
+          make_general_multiplier();
+          REPORT_DEFAULT("word acceptor with %d states, general multiplier "
+                         "with %d states\n",
+                         _wa.number_of_nodes(),
+                         _gm.number_of_nodes());
+          if (check_multipliers() && check_axioms()) {
+            _verified = true;
+            report_why_we_stopped();
+            return;
+          }
+        } while (_diffs.size() > number_of_diffs && !stopped());
+        if (!stopped() && _kb->finished()) {
+          LIBSEMIGROUPS_EXCEPTION(
+              "the rewriting system is confluent, but no automatic structure "
+              "could be found");
+        }
+        max_rules *= 2;
+      }
+      report_why_we_stopped();
+    }
+
+    bool AutomaticGroup::is_obviously_infinite_impl() {
+      if (finished()) {
+        return !action_digraph_helper::is_acyclic(_wa);
+      }
+      return _kb->is_obviously_infinite();
+    }
+
+    bool AutomaticGroup::is_obviously_finite_impl() {
+      if (finished()) {
+        return action_digraph_helper::is_acyclic(_wa);
+      }
+      return _kb->is_obviously_finite();
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // FpSemigroupInterface - non-pure virtual member functions - private
+    ////////////////////////////////////////////////////////////////////////
+
+    void AutomaticGroup::set_alphabet_impl(std::string const& lphbt) {
+      _kb->set_alphabet(lphbt);
+    }
+
+    void AutomaticGroup::set_alphabet_impl(size_t n) {
+      _kb->set_alphabet(n);
+    }
+
+    bool
+    AutomaticGroup::validate_identity_impl(std::string const& id) const {
+      if (!id.empty()) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "invalid identity, found %d letters, should be 0 letters",
+            id.length());
+      }
+      return false;  // Don't add rules for the identity
+    }
+  }  // namespace fpsemigroup
+}  // namespace libsemigroups
@@ -0,0 +1,329 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the implementation of the non-template functions for
+// reading and writing binary files.
+
+#include "libsemigroups/binary.hpp"
+
+#include <fcntl.h>     // for open, O_RDONLY
+#include <sys/mman.h>  // for mmap, munmap
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+
+#include <cerrno>   // for errno
+#include <cstdint>  // for uint8_t
+#include <cstring>  // for memcpy, strerror
+#include <limits>   // for numeric_limits
+#include <utility>  // for swap
+#include <vector>   // for vector
+
+namespace libsemigroups {
+  namespace {
+    constexpr char     MAGIC[8]   = {'L', 'S', 'G', 'P', 'B', 'I', 'N', '\0'};
+    constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    inline uint64_t rotl(uint64_t x, int r) noexcept {
+      return (x << r) | (x >> (64 - r));
+    }
+
+    inline uint64_t mix(uint64_t h, uint64_t w) noexcept {
+      return rotl(h ^ (w * 0x9e3779b97f4a7c15), 29) * 0xbf58476d1ce4e5b9;
+    }
+
+    // Returns false if the size of the payload does not fit into a uint64_t,
+    // which can only happen if the header is corrupt.
+    bool payload_size(detail::BinaryHeader const& header,
+                      uint64_t&                   result) noexcept {
+      uint64_t const max  = std::numeric_limits<uint64_t>::max();
+      uint64_t const rows = header.number_of_rows;
+      uint64_t const cols = header.number_of_cols;
+      uint64_t const size = header.value_size;
+      if (cols != 0 && rows > max / cols) {
+        return false;
+      }
+      result = rows * cols;
+      if (size != 0 && result > max / size) {
+        return false;
+      }
+      result *= size;
+      return true;
+    }
+  }  // namespace
+
+  namespace detail {
+    ////////////////////////////////////////////////////////////////////////
+    // BinaryChecksum
+    ////////////////////////////////////////////////////////////////////////
+
+    BinaryChecksum::BinaryChecksum() noexcept
+        : _buf(), _fill(0), _hash(0x243f6a8885a308d3), _length(0) {}
+
+    void BinaryChecksum::update(void const* data, size_t n) noexcept {
+      auto p = static_cast<unsigned char const*>(data);
+      _length += n;
+      if (_fill != 0) {
+        size_t const m = std::min(n, sizeof(_buf) - _fill);
+        std::memcpy(_buf + _fill, p, m);
+        _fill += m;
+        p += m;
+        n -= m;
+        if (_fill < sizeof(_buf)) {
+          return;
+        }
+        uint64_t w;
+        std::memcpy(&w, _buf, sizeof(w));
+        _hash = mix(_hash, w);
+        _fill = 0;
+      }
+      for (; n >= sizeof(uint64_t); n -= sizeof(uint64_t)) {
+        uint64_t w;
+        std::memcpy(&w, p, sizeof(w));
+        _hash = mix(_hash, w);
+        p += sizeof(uint64_t);
+      }
+      std::memcpy(_buf, p, n);
+      _fill = n;
+    }
+
+    uint64_t BinaryChecksum::get() const noexcept {
+      uint64_t h = _hash;
+      if (_fill != 0) {
+        unsigned char buf[8] = {0};
+        std::memcpy(buf, _buf, _fill);
+        uint64_t w;
+        std::memcpy(&w, buf, sizeof(w));
+        h = mix(h, w);
+      }
+      h ^= _length;
+      // The finalizer of splitmix64, so that every bit of the input affects
+      // every bit of the checksum.
+      h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9;
+      h = (h ^ (h >> 27)) * 0x94d049bb133111eb;
+      return h ^ (h >> 31);
+    }
+
+    BinaryHeader make_binary_header(binary::kind k,
+                                    size_t       value_size,
+                                    size_t       number_of_rows,
+                                    size_t       number_of_cols,
+                                    uint64_t     checksum) {
+      BinaryHeader header;
+      std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+      header.version        = binary::VERSION;
+      header.kind           = static_cast<uint32_t>(k);
+      header.value_size     = value_size;
+      header.byte_order     = BYTE_ORDER_MARK;
+      header.number_of_rows = number_of_rows;
+      header.number_of_cols = number_of_cols;
+      if (!payload_size(header, header.payload_size)) {
+        LIBSEMIGROUPS_EXCEPTION("the size of the payload (%llu x %llu values "
+                                "of size %llu) is too large",
+                                uint64_t(number_of_rows),
+                                uint64_t(number_of_cols),
+                                uint64_t(value_size));
+      }
+      header.checksum       = checksum;
+      header.reserved       = 0;
+      return header;
+    }
+  }  // namespace detail
+
+  namespace binary {
+    ////////////////////////////////////////////////////////////////////////
+    // MappedFile
+    ////////////////////////////////////////////////////////////////////////
+
+    MappedFile::MappedFile(std::string const& filename, bool verify)
+        : _addr(nullptr), _length(0) {
+      int fd = ::open(filename.c_str(), O_RDONLY);
+      if (fd == -1) {
+        LIBSEMIGROUPS_EXCEPTION("cannot open the file %s: %s",
+                                filename.c_str(),
+                                std::strerror(errno));
+      }
+      struct stat st;
+      if (::fstat(fd, &st) == -1) {
+        int err = errno;
+        ::close(fd);
+        LIBSEMIGROUPS_EXCEPTION(
+            "cannot stat the file %s: %s", filename.c_str(), std::strerror(err));
+      }
+      _length = st.st_size;
+      if (_length < sizeof(detail::BinaryHeader)) {
+        ::close(fd);
+        LIBSEMIGROUPS_EXCEPTION(
+            "the file %s is too short, expected at least %llu bytes, found "
+            "%llu",
+            filename.c_str(),
+            uint64_t(sizeof(detail::BinaryHeader)),
+            uint64_t(_length));
+      }
+      void* addr = ::mmap(nullptr, _length, PROT_READ, MAP_SHARED, fd, 0);
+      int   err  = errno;
+      // The mapping remains valid after the file descriptor is closed.
+      ::close(fd);
+      if (addr == MAP_FAILED) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "cannot map the file %s: %s", filename.c_str(), std::strerror(err));
+      }
+      _addr = addr;
+
+      detail::BinaryHeader const& h = header();
+      if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        ::munmap(_addr, _length);
+        LIBSEMIGROUPS_EXCEPTION(
+            "the file %s is not a libsemigroups binary file", filename.c_str());
+      } else if (h.byte_order != BYTE_ORDER_MARK) {
+        ::munmap(_addr, _length);
+        LIBSEMIGROUPS_EXCEPTION(
+            "the file %s was written on a machine with a different byte order",
+            filename.c_str());
+      } else if (h.version != VERSION) {
+        uint32_t version = h.version;
+        ::munmap(_addr, _length);
+        LIBSEMIGROUPS_EXCEPTION(
+            "the file %s has version %llu of the binary format, expected "
+            "version %llu",
+            filename.c_str(),
+            uint64_t(version),
+            uint64_t(VERSION));
+      }
+      uint64_t expected = 0;
+      if (!payload_size(h, expected) || h.payload_size != expected
+          || _length - sizeof(detail::BinaryHeader) < h.payload_size) {
+        ::munmap(_addr, _length);
+        LIBSEMIGROUPS_EXCEPTION("the file %s is truncated or corrupt",
+                                filename.c_str());
+      } else if (verify && !verify_checksum()) {
+        ::munmap(_addr, _length);
+        LIBSEMIGROUPS_EXCEPTION("the checksum of the file %s is incorrect",
+                                filename.c_str());
+      }
+    }
+
+    MappedFile::MappedFile(MappedFile&& that) noexcept
+        : _addr(that._addr), _length(that._length) {
+      that._addr   = nullptr;
+      that._length = 0;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& that) noexcept {
+      std::swap(_addr, that._addr);
+      std::swap(_length, that._length);
+      return *this;
+    }
+
+    MappedFile::~MappedFile() {
+      if (_addr != nullptr) {
+        ::munmap(_addr, _length);
+      }
+    }
+
+    bool MappedFile::verify_checksum() const noexcept {
+      detail::BinaryChecksum cs;
+      cs.update(data(), header().payload_size);
+      return cs.get() == header().checksum;
+    }
+
+    void MappedFile::validate(binary::kind k, size_t value_size) const {
+      if (kind() != k) {
+        LIBSEMIGROUPS_EXCEPTION("the file contains the wrong kind of object, "
+                                "expected %llu, found %llu",
+                                uint64_t(k),
+                                uint64_t(kind()));
+      } else if (this->value_size() != value_size) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "the file contains values of the wrong size, expected %llu bytes, "
+            "found %llu bytes",
+            uint64_t(value_size),
+            uint64_t(this->value_size()));
+      }
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Forests
+    ////////////////////////////////////////////////////////////////////////
+
+    void write(std::ostream& os, Forest const& f) {
+      detail::write_binary<size_t>(
+          os, kind::forest, f.number_of_nodes(), 2, [&f](auto&& sink) {
+            for (size_t i = 0; i < f.number_of_nodes(); ++i) {
+              size_t const row[2] = {f.parent(i), f.label(i)};
+              sink(row, sizeof(row));
+            }
+          });
+    }
+
+    Forest read_forest(MappedFile const& file) {
+      file.validate(kind::forest, sizeof(size_t));
+      if (file.number_of_cols() != 2) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "the file contains a forest with %llu columns, expected 2",
+            uint64_t(file.number_of_cols()));
+      }
+      size_t const n    = file.number_of_rows();
+      auto         data = static_cast<size_t const*>(file.data());
+      Forest       f(n);
+      for (size_t i = 0; i < n; ++i) {
+        size_t const parent = data[2 * i];
+        size_t const label  = data[2 * i + 1];
+        if (parent == UNDEFINED) {
+          if (label != UNDEFINED) {
+            LIBSEMIGROUPS_EXCEPTION(
+                "the file is corrupt, the root %llu has label %llu",
+                uint64_t(i),
+                uint64_t(label));
+          }
+        } else if (parent >= n) {
+          LIBSEMIGROUPS_EXCEPTION("the file is corrupt, the parent %llu of "
+                                  "node %llu is not in the range [0, %llu)",
+                                  uint64_t(parent),
+                                  uint64_t(i),
+                                  uint64_t(n));
+        } else if (label == UNDEFINED) {
+          LIBSEMIGROUPS_EXCEPTION(
+              "the file is corrupt, the node %llu has no label", uint64_t(i));
+        } else {
+          f.set(i, parent, label);
+        }
+      }
+      // Check that the parents do not contain a cycle, which would make
+      // every walk towards a root loop forever. Every node is coloured 0 if
+      // it has not been visited, 1 if it is on the current walk, and 2 if a
+      // root is reachable from it.
+      std::vector<uint8_t> colour(n, 0);
+      for (size_t i = 0; i < n; ++i) {
+        size_t j = i;
+        while (j != UNDEFINED && colour[j] == 0) {
+          colour[j] = 1;
+          j         = data[2 * j];
+        }
+        if (j != UNDEFINED && colour[j] == 1) {
+          LIBSEMIGROUPS_EXCEPTION(
+              "the file is corrupt, the node %llu is its own ancestor",
+              uint64_t(j));
+        }
+        for (j = i; j != UNDEFINED && colour[j] == 1; j = data[2 * j]) {
+          colour[j] = 2;
+        }
+      }
+      return f;
+    }
+  }  // namespace binary
+}  // namespace libsemigroups
@@ -188,17 +188,41 @@ namespace libsemigroups {
     }
   }
 
-  // Not noexcept because it can throw.
-  BMat8 BMat8::random(size_t dim) {
-    if (0 == dim || dim > 8) {
-      LIBSEMIGROUPS_EXCEPTION("the argument should be in [1, 8], got %d", dim);
+  namespace {
+    void validate_dim(size_t dim) {
+      if (0 == dim || dim > 8) {
+        LIBSEMIGROUPS_EXCEPTION("the argument should be in [1, 8], got %d",
+                                dim);
+      }
     }
-    BMat8 bm = BMat8::random();
-    for (size_t i = dim; i < 8; ++i) {
-      bm._data &= ~(ROW_MASK[i]);
-      bm._data &= ~(COL_MASK[i]);
+
+    BMat8 restrict_dim(BMat8 bm, size_t dim) noexcept {
+      uint64_t data = bm.to_int();
+      for (size_t i = dim; i < 8; ++i) {
+        data &= ~(ROW_MASK[i]);
+        data &= ~(COL_MASK[i]);
+      }
+      return BMat8(data);
     }
-    return bm;
+  }  // namespace
+
+  // Not noexcept because it can throw.
+  BMat8 BMat8::random(size_t dim) {
+    validate_dim(dim);
+    return restrict_dim(BMat8::random(), dim);
+  }
+
+  // Not noexcept since std::uniform_int_distribution::operator() is not
+  // noexcept.
+  BMat8 BMat8::random(std::mt19937& mt) {
+    std::uniform_int_distribution<uint64_t> dist(0, 0xffffffffffffffff);
+    return BMat8(dist(mt));
+  }
+
+  // Not noexcept because it can throw.
+  BMat8 BMat8::random(size_t dim, std::mt19937& mt) {
+    validate_dim(dim);
+    return restrict_dim(BMat8::random(mt), dim);
   }
 
   ////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,358 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the implementation of the CanonicalForm class.
+
+#include "libsemigroups/canonical-form.hpp"
+
+#include <algorithm>  // for sort, find_if, all_of, any_of
+#include <atomic>     // for atomic
+#include <cstdint>    // for uint64_t
+#include <mutex>      // for mutex, lock_guard
+#include <numeric>    // for iota
+#include <thread>     // for thread
+#include <utility>    // for move
+
+#include "libsemigroups/constants.hpp"  // for UNDEFINED
+#include "libsemigroups/exception.hpp"  // for LIBSEMIGROUPS_EXCEPTION
+#include "libsemigroups/report.hpp"     // for REPORT_DEFAULT
+#include "libsemigroups/stl.hpp"        // for hash<vector>
+#include "libsemigroups/timer.hpp"      // for Timer
+#include "libsemigroups/uf.hpp"         // for Duf
+
+namespace libsemigroups {
+  using element_index_type = CanonicalForm::element_index_type;
+  using colouring_type     = std::vector<element_index_type>;
+  using permutation_type   = std::vector<element_index_type>;
+
+  namespace {
+    // Returns the multiplication table of S, stored row by row. Every column
+    // is obtained from the column of the prefix of the corresponding
+    // element, and so the columns are computed in order of length.
+    std::vector<element_index_type> multiplication_table(FroidurePinBase& S) {
+      size_t const n     = S.size();
+      auto const&  right = S.right_cayley_graph();
+
+      std::vector<element_index_type> by_length(n);
+      std::iota(by_length.begin(), by_length.end(), 0);
+      std::stable_sort(by_length.begin(),
+                       by_length.end(),
+                       [&S](element_index_type x, element_index_type y) {
+                         return S.current_length(x) < S.current_length(y);
+                       });
+
+      std::vector<element_index_type> table(n * n);
+      for (auto y : by_length) {
+        element_index_type const p = S.prefix(y);
+        letter_type const        a = S.final_letter(y);
+        for (element_index_type x = 0; x < n; ++x) {
+          table[x * n + y]
+              = right.get(p == UNDEFINED ? x : table[x * n + p], a);
+        }
+      }
+      return table;
+    }
+
+    // A Search finds the least certificate arising from the discrete
+    // colourings below a given colouring, using the automorphisms it finds to
+    // prune the search tree.
+    struct Search {
+      Search(std::vector<element_index_type> const& tbl,
+             size_t                                 N,
+             std::vector<permutation_type>          autos)
+          : automorphisms(std::move(autos)),
+            best_certificate(),
+            best_labelling(),
+            n(N),
+            number_of_known_automorphisms(automorphisms.size()),
+            path(),
+            table(tbl) {}
+
+      // Refines the colouring c until every two elements of the same colour
+      // have the same numbers of products of every combination of colours.
+      // The new colours are numbered by sorting invariants of the elements,
+      // and so the result does not depend on the positions of the elements.
+      void refine(colouring_type& c) const {
+        size_t                             number_of_colours = 0;
+        std::vector<std::vector<uint64_t>> signature(n);
+        std::vector<element_index_type>    order(n);
+        while (true) {
+          for (element_index_type x = 0; x < n; ++x) {
+            auto& sig = signature[x];
+            sig.resize(n);
+            for (element_index_type y = 0; y < n; ++y) {
+              sig[y] = (uint64_t(c[y]) * n + c[table[x * n + y]]) * n
+                       + c[table[y * n + x]];
+            }
+            std::sort(sig.begin(), sig.end());
+          }
+          std::iota(order.begin(), order.end(), 0);
+          std::sort(order.begin(),
+                    order.end(),
+                    [&c, &signature](element_index_type x,
+                                     element_index_type y) {
+                      return c[x] < c[y]
+                             || (c[x] == c[y] && signature[x] < signature[y]);
+                    });
+          colouring_type     new_c(n);
+          element_index_type colour = 0;
+          for (size_t i = 0; i < n; ++i) {
+            if (i > 0
+                && (c[order[i]] != c[order[i - 1]]
+                    || signature[order[i]] != signature[order[i - 1]])) {
+              ++colour;
+            }
+            new_c[order[i]] = colour;
+          }
+          c.swap(new_c);
+          if (colour + 1 == number_of_colours) {
+            return;
+          }
+          number_of_colours = colour + 1;
+        }
+      }
+
+      // Returns the refinement of the colouring c in which x has its own
+      // colour. The colours of c must be 0, 1, ..., k - 1 for some k < n.
+      colouring_type individualise(colouring_type const& c,
+                                   element_index_type    x) const {
+        colouring_type result(n);
+        for (element_index_type y = 0; y < n; ++y) {
+          result[y] = (c[y] < c[x] || y == x ? c[y] : c[y] + 1);
+        }
+        refine(result);
+        return result;
+      }
+
+      // Returns the elements with the least colour shared by more than one
+      // element, or an empty vector if c is discrete.
+      std::vector<element_index_type>
+      target_cell(colouring_type const& c) const {
+        std::vector<size_t> count(n, 0);
+        for (auto colour : c) {
+          count[colour]++;
+        }
+        auto it = std::find_if(
+            count.cbegin(), count.cend(), [](size_t k) { return k > 1; });
+        std::vector<element_index_type> result;
+        if (it != count.cend()) {
+          element_index_type const colour = it - count.cbegin();
+          for (element_index_type x = 0; x < n; ++x) {
+            if (c[x] == colour) {
+              result.push_back(x);
+            }
+          }
+        }
+        return result;
+      }
+
+      // Searches below the stable colouring c, where the elements in path
+      // have been individualised.
+      void search(colouring_type const& c) {
+        auto cell = target_cell(c);
+        if (cell.empty()) {
+          leaf(c);
+          return;
+        }
+        std::vector<element_index_type> explored;
+        for (auto x : cell) {
+          if (!explored.empty() && is_pruned(x, explored)) {
+            continue;
+          }
+          explored.push_back(x);
+          path.push_back(x);
+          search(individualise(c, x));
+          path.pop_back();
+        }
+      }
+
+      // Returns true if x is in the same orbit as an element of explored
+      // under the automorphisms found so far that fix path pointwise.
+      bool is_pruned(element_index_type                     x,
+                     std::vector<element_index_type> const& explored) const {
+        detail::Duf<> uf(n);
+        for (auto const& g : automorphisms) {
+          if (std::all_of(path.cbegin(),
+                          path.cend(),
+                          [&g](element_index_type y) { return g[y] == y; })) {
+            for (element_index_type y = 0; y < n; ++y) {
+              uf.unite(y, g[y]);
+            }
+          }
+        }
+        return std::any_of(explored.cbegin(),
+                           explored.cend(),
+                           [&uf, x](element_index_type y) {
+                             return uf.find(x) == uf.find(y);
+                           });
+      }
+
+      // Compares the certificate of the discrete colouring c with the best
+      // found so far.
+      void leaf(colouring_type const& c) {
+        std::vector<element_index_type> cert(n * n);
+        for (element_index_type x = 0; x < n; ++x) {
+          for (element_index_type y = 0; y < n; ++y) {
+            cert[c[x] * n + c[y]] = c[table[x * n + y]];
+          }
+        }
+        if (best_labelling.empty() || cert < best_certificate) {
+          best_certificate = std::move(cert);
+          best_labelling   = c;
+        } else if (cert == best_certificate) {
+          add_automorphism(best_labelling, c);
+        }
+      }
+
+      // Adds the automorphism mapping every x with label1[x] = i to the
+      // element y with label2[y] = i, if it is not the identity.
+      void add_automorphism(colouring_type const& label1,
+                            colouring_type const& label2) {
+        permutation_type inv(n);
+        for (element_index_type y = 0; y < n; ++y) {
+          inv[label2[y]] = y;
+        }
+        permutation_type g(n);
+        bool             is_identity = true;
+        for (element_index_type x = 0; x < n; ++x) {
+          g[x] = inv[label1[x]];
+          is_identity &= (g[x] == x);
+        }
+        if (!is_identity) {
+          automorphisms.push_back(std::move(g));
+        }
+      }
+
+      std::vector<permutation_type>          automorphisms;
+      std::vector<element_index_type>        best_certificate;
+      colouring_type                         best_labelling;
+      size_t                                 n;
+      size_t                                 number_of_known_automorphisms;
+      std::vector<element_index_type>        path;
+      std::vector<element_index_type> const& table;
+    };
+  }  // namespace
+
+  ////////////////////////////////////////////////////////////////////////
+  // CanonicalForm - constructor - public
+  ////////////////////////////////////////////////////////////////////////
+
+  CanonicalForm::CanonicalForm(FroidurePinBase& S, size_t number_of_threads)
+      : _automorphisms(), _certificate(), _hash_value(0), _labelling() {
+    if (number_of_threads == 0) {
+      LIBSEMIGROUPS_EXCEPTION("the number of threads must be positive");
+    }
+    detail::Timer t;
+    auto const    table = multiplication_table(S);
+    size_t const  n     = S.size();
+
+    Search root(table, n, {});
+    // The initial colouring distinguishes the idempotents
+    colouring_type c(n);
+    for (element_index_type x = 0; x < n; ++x) {
+      c[x] = (table[x * n + x] == x ? 0 : 1);
+    }
+    root.refine(c);
+    auto const cell = root.target_cell(c);
+
+    if (cell.empty() || number_of_threads == 1) {
+      root.search(c);
+    } else {
+      // The subtrees below the elements of the first target cell are searched
+      // in parallel. Before a thread searches the subtree below x, it checks
+      // that x is not in the same orbit as an element whose subtree has
+      // already been claimed, under the automorphisms found so far.
+      std::mutex                      mtx;
+      std::atomic<size_t>             next(0);
+      std::vector<element_index_type> claimed;
+
+      auto worker = [&]() {
+        for (size_t i = next++; i < cell.size(); i = next++) {
+          std::vector<permutation_type> automorphisms;
+          {
+            std::lock_guard<std::mutex> lg(mtx);
+            if (!claimed.empty() && root.is_pruned(cell[i], claimed)) {
+              continue;
+            }
+            claimed.push_back(cell[i]);
+            automorphisms = root.automorphisms;
+          }
+          Search s(table, n, std::move(automorphisms));
+          s.path.push_back(cell[i]);
+          s.search(s.individualise(c, cell[i]));
+
+          std::lock_guard<std::mutex> lg(mtx);
+          root.automorphisms.insert(
+              root.automorphisms.end(),
+              s.automorphisms.cbegin() + s.number_of_known_automorphisms,
+              s.automorphisms.cend());
+          if (root.best_labelling.empty()
+              || s.best_certificate < root.best_certificate) {
+            root.best_certificate = std::move(s.best_certificate);
+            root.best_labelling   = std::move(s.best_labelling);
+          } else if (s.best_certificate == root.best_certificate) {
+            root.add_automorphism(root.best_labelling, s.best_labelling);
+          }
+        }
+      };
+
+      std::vector<std::thread> threads;
+      for (size_t i = 0; i < std::min(number_of_threads, cell.size()); ++i) {
+        threads.emplace_back(worker);
+      }
+      for (auto& th : threads) {
+        th.join();
+      }
+    }
+
+    _automorphisms = std::move(root.automorphisms);
+    _certificate   = std::move(root.best_certificate);
+    _labelling     = std::move(root.best_labelling);
+    _hash_value    = std::hash<std::vector<element_index_type>>()(_certificate);
+    REPORT_DEFAULT("found canonical form with %llu automorphisms in %s\n",
+                   uint64_t(_automorphisms.size()),
+                   t.string().c_str());
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // CanonicalForm - member functions - public
+  ////////////////////////////////////////////////////////////////////////
+
+  element_index_type CanonicalForm::label(element_index_type pos) const {
+    validate_label(pos);
+    return _labelling[pos];
+  }
+
+  element_index_type CanonicalForm::product(element_index_type i,
+                                            element_index_type j) const {
+    validate_label(i);
+    validate_label(j);
+    return _certificate[i * size() + j];
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // CanonicalForm - validation - private
+  ////////////////////////////////////////////////////////////////////////
+
+  void CanonicalForm::validate_label(element_index_type i) const {
+    if (i >= size()) {
+      LIBSEMIGROUPS_EXCEPTION(
+          "expected a value less than %llu, found %llu", size(), i);
+    }
+  }
+}  // namespace libsemigroups
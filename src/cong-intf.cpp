@@ -18,6 +18,10 @@
 
 #include "libsemigroups/cong-intf.hpp"
 
+#include <algorithm>   // for max, min
+#include <functional>  // for function
+#include <thread>      // for thread
+
 #include "libsemigroups/constants.hpp"          // for UNDEFINED
 #include "libsemigroups/debug.hpp"              // for LIBSEMIGROUPS_ASSERT
 #include "libsemigroups/exception.hpp"          // for LIBSEMIGROUPS_EXCEPTION
@@ -80,6 +84,16 @@ namespace libsemigroups {
     mutable std::shared_ptr<FpSemigroupInterface> _fp_semigroup;
   };
 
+  ////////////////////////////////////////////////////////////////////////////
+  // NonTrivialClasses
+  ////////////////////////////////////////////////////////////////////////////
+
+  NonTrivialClasses::const_word_iterator::const_reference
+  NonTrivialClasses::const_word_iterator::operator*() const {
+    _froidure_pin->minimal_factorisation(_word, *_it);
+    return _word;
+  }
+
   ////////////////////////////////////////////////////////////////////////////
   // CongruenceInterface - constructors + destructor - public
   ////////////////////////////////////////////////////////////////////////////
@@ -96,7 +110,8 @@ namespace libsemigroups {
         _is_obviously_finite(false),
         _is_obviously_infinite(false),
         _quotient(nullptr),
-        _non_trivial_classes() {
+        _non_trivial_classes(),
+        _non_trivial_class_indices() {
     reset();
   }
 
@@ -165,7 +180,7 @@ namespace libsemigroups {
   /////////////////////////////////////////////////////////////////////////
 
   void CongruenceInterface::add_pair(word_type const& u, word_type const& v) {
-    if (started()) {
+    if (running() || (started() && !incremental_impl())) {
       LIBSEMIGROUPS_EXCEPTION(
           "cannot add further generating pairs at this stage");
     }
@@ -267,6 +282,104 @@ namespace libsemigroups {
     return word_to_class_index_impl(word);
   }
 
+  std::shared_ptr<NonTrivialClasses const>
+  CongruenceInterface::non_trivial_class_indices() {
+    if (_non_trivial_class_indices != nullptr) {
+      return _non_trivial_class_indices;
+    }
+    if (!_parent->can_compute_froidure_pin()) {
+      LIBSEMIGROUPS_EXCEPTION("Cannot determine the parent FroidurePin and so "
+                              "cannot compute non-trivial classes!");
+    }
+    // The next two lines may trigger an infinite computation
+    auto         fp = _parent->froidure_pin();
+    size_t const n  = fp->size();
+    size_t const m  = number_of_classes();
+
+    std::vector<class_index_type> klass(n);
+    class_indices_impl(*fp, klass);
+
+    // Group the elements by class using a counting sort. The sizes of the
+    // classes are found first, and only the non-trivial classes are numbered,
+    // so that index[i] is the number of class i among the non-trivial
+    // classes, or UNDEFINED if class i is trivial.
+    std::vector<size_t> index(m, 0);
+    for (auto i : klass) {
+      LIBSEMIGROUPS_ASSERT(i < m);
+      index[i]++;
+    }
+    size_t number_of_non_trivial_classes = 0;
+    for (auto& i : index) {
+      i = (i <= 1 ? size_t(UNDEFINED) : number_of_non_trivial_classes++);
+    }
+
+    // Each thread counts the sizes of the non-trivial classes in its chunk of
+    // [0, n) and then places the elements in its chunk after those in the
+    // previous chunks, so that the elements of every class are sorted.
+    size_t const nr_threads
+        = (n < fp->concurrency_threshold()
+               ? 1
+               : std::max(size_t(1), std::min(fp->max_threads(), n)));
+    size_t const chunk = n / nr_threads;
+    auto         first = [chunk](size_t t) { return t * chunk; };
+    auto         last  = [chunk, n, nr_threads](size_t t) {
+      return (t == nr_threads - 1 ? n : (t + 1) * chunk);
+    };
+    auto in_parallel = [nr_threads](std::function<void(size_t)> const& func) {
+      if (nr_threads == 1) {
+        func(0);
+        return;
+      }
+      std::vector<std::thread> threads;
+      for (size_t t = 0; t < nr_threads; ++t) {
+        threads.emplace_back(func, t);
+      }
+      for (auto& t : threads) {
+        t.join();
+      }
+    };
+
+    std::vector<std::vector<size_t>> count(
+        nr_threads, std::vector<size_t>(number_of_non_trivial_classes, 0));
+    in_parallel([&](size_t t) {
+      for (size_t pos = first(t); pos < last(t); ++pos) {
+        size_t const i = index[klass[pos]];
+        if (i != UNDEFINED) {
+          count[t][i]++;
+        }
+      }
+    });
+
+    // count[t][i] becomes the position of the next element of the i-th
+    // non-trivial class in the chunk of thread t.
+    std::vector<size_t> offsets;
+    offsets.reserve(number_of_non_trivial_classes + 1);
+    size_t total = 0;
+    for (size_t i = 0; i < number_of_non_trivial_classes; ++i) {
+      offsets.push_back(total);
+      for (size_t t = 0; t < nr_threads; ++t) {
+        size_t const c = count[t][i];
+        count[t][i]    = total;
+        total += c;
+      }
+    }
+    offsets.push_back(total);
+
+    std::vector<NonTrivialClasses::element_index_type> elements(total);
+    in_parallel([&](size_t t) {
+      for (size_t pos = first(t); pos < last(t); ++pos) {
+        size_t const i = index[klass[pos]];
+        if (i != UNDEFINED) {
+          elements[count[t][i]++] = pos;
+        }
+      }
+    });
+
+    _non_trivial_class_indices = std::make_shared<NonTrivialClasses>(
+        fp, std::move(offsets), std::move(elements));
+    return _non_trivial_class_indices;
+  }
+
   /////////////////////////////////////////////////////////////////////////
   // CongruenceInterface - non-virtual methods - protected
   /////////////////////////////////////////////////////////////////////////
@@ -315,28 +428,23 @@ namespace libsemigroups {
 
   std::shared_ptr<CongruenceInterface::non_trivial_classes_type const>
   CongruenceInterface::non_trivial_classes_impl() {
-    if (!_parent->can_compute_froidure_pin()) {
-      LIBSEMIGROUPS_EXCEPTION("Cannot determine the parent FroidurePin and so "
-                              "cannot compute non-trivial classes!");
+    auto indices = non_trivial_class_indices();
+    auto ntc     = std::make_shared<non_trivial_classes_type>();
+    ntc->reserve(indices->number_of_classes());
+    for (size_t i = 0; i < indices->number_of_classes(); ++i) {
+      ntc->emplace_back(indices->cbegin_words(i), indices->cend_words(i));
     }
-    // The next line may trigger an infinite computation
-    auto fp  = _parent->froidure_pin();
-    auto ntc = non_trivial_classes_type(number_of_classes(),
-                                        std::vector<word_type>());
+    return ntc;
+  }
 
+  void CongruenceInterface::class_indices_impl(
+      FroidurePinBase const&         fp,
+      std::vector<class_index_type>& out) {
     word_type w;
-    for (size_t pos = 0; pos < fp->size(); ++pos) {
-      fp->factorisation(w, pos);
-      LIBSEMIGROUPS_ASSERT(word_to_class_index(w) < ntc.size());
-      ntc[word_to_class_index(w)].push_back(w);
-    }
-    ntc.erase(std::remove_if(ntc.begin(),
-                             ntc.end(),
-                             [](std::vector<word_type> const& klass) -> bool {
-                               return klass.size() <= 1;
-                             }),
-              ntc.end());
-    return std::make_shared<non_trivial_classes_type>(ntc);
+    for (size_t pos = 0; pos < fp.current_size(); ++pos) {
+      fp.minimal_factorisation(w, pos);
+      out[pos] = word_to_class_index(w);
+    }
   }
 
   /////////////////////////////////////////////////////////////////////////
@@ -353,6 +461,7 @@ namespace libsemigroups {
   void CongruenceInterface::reset() noexcept {
     // set_finished(false);
     _non_trivial_classes.reset();
+    _non_trivial_class_indices.reset();
     _init_ntc_done = false;
     _quotient.reset();
     _is_obviously_finite   = false;
@@ -29,6 +29,7 @@
 #include "libsemigroups/fpsemi.hpp"     // for FpSemigroup
 #include "libsemigroups/froidure-pin-base.hpp"  // for FroidurePinBase
 #include "libsemigroups/knuth-bendix.hpp"       // for KnuthBendix
+#include "libsemigroups/planner.hpp"            // for plan_runners
 #include "libsemigroups/todd-coxeter.hpp"       // for ToddCoxeter
 
 namespace libsemigroups {
@@ -42,7 +43,10 @@ namespace libsemigroups {
   //////////////////////////////////////////////////////////////////////////
 
   Congruence::Congruence(congruence_kind type, options::runners p)
-      : CongruenceInterface(type), _race() {
+      : CongruenceInterface(type),
+        _race(),
+        _plan_runners(false),
+        _planned(false) {
     if (p == options::runners::standard) {
       _race.add_runner(std::make_shared<ToddCoxeter>(type));
       if (type == congruence_kind::twosided) {
@@ -192,34 +196,31 @@ namespace libsemigroups {
     // then start enumerating its FroidurePin, then we can find the word of any
     // (sufficiently small) class index without any of the runners in the race
     // winning.
-    if (_race.winner() == nullptr) {
+    if (winner() == nullptr) {
       LIBSEMIGROUPS_EXCEPTION(
           "cannot determine the word corresponding to class index %llu",
           static_cast<uint64_t>(i));
     }
-    return static_cast<CongruenceInterface*>(_race.winner().get())
-        ->class_index_to_word(i);
+    return winner()->class_index_to_word(i);
   }
 
   size_t Congruence::number_of_classes_impl() {
     run();  // to ensure the state is correctly set.
-    if (_race.winner() == nullptr) {
+    if (winner() == nullptr) {
       // The next line is not testable, this is just a sanity check in case
       // all threads in the _race throw, and so there is no winner.
       LIBSEMIGROUPS_EXCEPTION("cannot determine the number of classes");
     }
-    return static_cast<CongruenceInterface*>(_race.winner().get())
-        ->number_of_classes();
+    return winner()->number_of_classes();
   }
 
   std::shared_ptr<FroidurePinBase> Congruence::quotient_impl() {
-    if (_race.winner() == nullptr) {
+    if (winner() == nullptr) {
       // The next line is not testable, this is just a sanity check in case
       // all threads in the _race throw, and so there is no winner.
       LIBSEMIGROUPS_EXCEPTION("cannot determine the quotient FroidurePin");
     }
-    return static_cast<CongruenceInterface*>(_race.winner().get())
-        ->quotient_froidure_pin();
+    return winner()->quotient_froidure_pin();
   }
 
   class_index_type Congruence::word_to_class_index_impl(word_type const& word) {
@@ -228,15 +229,12 @@ namespace libsemigroups {
     // then start enumerating its FroidurePin, then we can find the class index
     // of any (sufficiently small) word without any of the runners in the race
     // winning.
-    if (_race.winner() == nullptr) {
+    if (winner() == nullptr) {
       LIBSEMIGROUPS_EXCEPTION("cannot determine the class index of word %s",
                               detail::to_string(word).c_str());
     }
-    LIBSEMIGROUPS_ASSERT(static_cast<CongruenceInterface*>(_race.winner().get())
-                             ->word_to_class_index(word)
-                         != UNDEFINED);
-    return static_cast<CongruenceInterface*>(_race.winner().get())
-        ->word_to_class_index(word);
+    LIBSEMIGROUPS_ASSERT(winner()->word_to_class_index(word) != UNDEFINED);
+    return winner()->word_to_class_index(word);
   }
 
   //////////////////////////////////////////////////////////////////////////
@@ -252,14 +250,14 @@ namespace libsemigroups {
   std::shared_ptr<CongruenceInterface::non_trivial_classes_type const>
   Congruence::non_trivial_classes_impl() {
     run();  // required so that state is correctly set.
-    auto winner = static_cast<CongruenceInterface*>(_race.winner().get());
-    if (winner == nullptr) {
+    auto w = winner();
+    if (w == nullptr) {
       // The next line is not testable, this is just a sanity check in case
       // all threads in the _race throw, and so there is no winner.
       LIBSEMIGROUPS_EXCEPTION("cannot determine the non-trivial classes!");
     }
     try {
-      return winner->non_trivial_classes();
+      return w->non_trivial_classes();
     } catch (LibsemigroupsException const& e) {
       // Special case don't currently know a better way of doing this
       if (has_parent_fpsemigroup()) {
@@ -308,4 +306,24 @@ namespace libsemigroups {
           ->set_number_of_generators(n);
     }
   }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Congruence - member functions - private
+  //////////////////////////////////////////////////////////////////////////
+
+  void Congruence::plan() {
+    LIBSEMIGROUPS_ASSERT(!_planned);
+    detail::PresentationStats stats;
+    if (number_of_generators() != UNDEFINED) {
+      stats.number_of_generators = number_of_generators();
+    }
+    stats.add_relations(cbegin_generating_pairs(), cend_generating_pairs());
+    if (has_parent_fpsemigroup()) {
+      auto S = parent_fpsemigroup();
+      stats.add_relations(S->cbegin_rules(), S->cend_rules());
+    }
+    stats.obviously_infinite = is_quotient_obviously_infinite();
+    detail::plan_runners(_race, stats);
+    _planned = true;
+  }
 }  // namespace libsemigroups
@@ -18,6 +18,125 @@
 
 #include "libsemigroups/forest.hpp"
 
+#include <algorithm>  // for max, swap
+#include <cstdint>    // for uint32_t, uint64_t
+
 namespace libsemigroups {
   Forest::~Forest() = default;
-}
+
+  void Forest::init_ancestor_table() {
+    size_t const n = number_of_nodes();
+    if (n >= static_cast<uint32_t>(UNDEFINED)) {
+      LIBSEMIGROUPS_EXCEPTION("the forest must have fewer than %llu nodes, "
+                              "found %llu",
+                              uint64_t(static_cast<uint32_t>(UNDEFINED)),
+                              uint64_t(n));
+    }
+    std::vector<uint32_t>  depth(n, static_cast<uint32_t>(UNDEFINED));
+    std::vector<node_type> stack;
+    uint32_t               max_depth = 0;
+    for (node_type v = 0; v < n; ++v) {
+      // Find the first ancestor of v whose depth is known, and then set the
+      // depths of the nodes on the path from v to it.
+      node_type u = v;
+      while (u != UNDEFINED && depth[u] == UNDEFINED) {
+        stack.push_back(u);
+        if (stack.size() > n) {
+          LIBSEMIGROUPS_EXCEPTION("the parents of the nodes contain a cycle");
+        }
+        u = _parent[u];
+      }
+      uint32_t d = (u == UNDEFINED ? 0 : depth[u] + 1);
+      while (!stack.empty()) {
+        depth[stack.back()] = d++;
+        stack.pop_back();
+      }
+      max_depth = std::max(max_depth, d - 1);
+    }
+
+    size_t number_of_levels = 1;
+    while ((uint64_t(1) << number_of_levels) <= max_depth) {
+      ++number_of_levels;
+    }
+    std::vector<uint32_t> jump(number_of_levels * n);
+    for (node_type v = 0; v < n; ++v) {
+      jump[v] = (_parent[v] == UNDEFINED ? v : _parent[v]);
+    }
+    for (size_t k = 1; k < number_of_levels; ++k) {
+      uint32_t const* prev = jump.data() + (k - 1) * n;
+      uint32_t*       next = jump.data() + k * n;
+      for (node_type v = 0; v < n; ++v) {
+        next[v] = prev[prev[v]];
+      }
+    }
+    std::swap(_depth, depth);
+    std::swap(_jump, jump);
+  }
+
+  size_t Forest::depth(node_type i) const {
+    validate_node(i);
+    if (has_ancestor_table()) {
+      return _depth[i];
+    }
+    size_t result = 0;
+    for (i = _parent[i]; i != UNDEFINED; i = _parent[i]) {
+      ++result;
+    }
+    return result;
+  }
+
+  Forest::node_type Forest::ancestor(node_type i, size_t k) const {
+    if (k > depth(i)) {
+      return UNDEFINED;
+    } else if (has_ancestor_table()) {
+      size_t const n = number_of_nodes();
+      for (size_t level = 0; k != 0; ++level, k >>= 1) {
+        if (k & 1) {
+          i = _jump[level * n + i];
+        }
+      }
+      return i;
+    }
+    for (; k != 0; --k) {
+      i = _parent[i];
+    }
+    return i;
+  }
+
+  Forest::node_type Forest::lowest_common_ancestor(node_type i,
+                                                   node_type j) const {
+    size_t const di = depth(i);
+    size_t const dj = depth(j);
+    if (di > dj) {
+      i = ancestor(i, di - dj);
+    } else if (dj > di) {
+      j = ancestor(j, dj - di);
+    }
+    if (i == j) {
+      return i;
+    } else if (has_ancestor_table()) {
+      // Find the deepest ancestors of i and j that are distinct
+      size_t const n = number_of_nodes();
+      for (size_t level = _jump.size() / n; level-- > 0;) {
+        if (_jump[level * n + i] != _jump[level * n + j]) {
+          i = _jump[level * n + i];
+          j = _jump[level * n + j];
+        }
+      }
+    } else {
+      while (_parent[i] != _parent[j]) {
+        i = _parent[i];
+        j = _parent[j];
+      }
+    }
+    return _parent[i] == _parent[j] ? _parent[i] : UNDEFINED;
+  }
+
+  void Forest::path_to_root(word_type& w, node_type i) const {
+    w.resize(depth(i));
+    for (auto it = w.begin(); it != w.end(); ++it) {
+      *it = _edge_label[i];
+      i   = _parent[i];
+    }
+  }
+}  // namespace libsemigroups
@@ -409,6 +409,10 @@ namespace libsemigroups {
     return false;
   }
 
+  bool FpSemigroupInterface::incremental_impl() const noexcept {
+    return false;
+  }
+
   void FpSemigroupInterface::validate_word_impl(std::string const& w) const {
     if (w.empty()) {
       LIBSEMIGROUPS_EXCEPTION("invalid word, found the empty word but "
@@ -446,13 +450,8 @@ namespace libsemigroups {
 
   void FpSemigroupInterface::add_rule_private(std::string&& u,
                                               std::string&& v) {
-    if (started()) {
+    if (running() || (started() && !incremental_impl())) {
       LIBSEMIGROUPS_EXCEPTION("cannot add further rules at this stage");
-      // Note that there is actually nothing that prevents us from adding
-      // rules to KnuthBendix (i.e. it is setup so that it can be run
-      // (partially or fully) and then more rules can be added and everything
-      // is valid. We add this restriction to simplify things in the first
-      // instance.
     }
     validate_word(u);
     validate_word(v);
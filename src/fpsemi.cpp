@@ -27,8 +27,10 @@
 
 #include <string>  // for string
 
+#include "libsemigroups/debug.hpp"              // for LIBSEMIGROUPS_ASSERT
 #include "libsemigroups/froidure-pin-base.hpp"  // for FroidurePinBase
 #include "libsemigroups/knuth-bendix.hpp"       // for KnuthBendix
+#include "libsemigroups/planner.hpp"            // for plan_runners
 
 namespace libsemigroups {
 
@@ -39,7 +41,11 @@ namespace libsemigroups {
   // FpSemigroup - constructors - public
   //////////////////////////////////////////////////////////////////////////
 
-  FpSemigroup::FpSemigroup() : FpSemigroupInterface(), _race() {
+  FpSemigroup::FpSemigroup()
+      : FpSemigroupInterface(),
+        _race(),
+        _plan_runners(false),
+        _planned(false) {
     _race.add_runner(std::make_shared<ToddCoxeter>());
     _race.add_runner(std::make_shared<KnuthBendix>());
   }
@@ -61,7 +67,7 @@ namespace libsemigroups {
       return POSITIVE_INFINITY;
     } else {
       run();  // required so that the state is correct
-      return static_cast<FpSemigroupInterface*>(_race.winner().get())->size();
+      return winner()->size();
     }
   }
 
@@ -85,7 +91,7 @@ namespace libsemigroups {
       }
     }
     run();  // required to that the state is correct.
-    return static_cast<FpSemigroupInterface*>(_race.winner().get())
+    return winner()
         ->froidure_pin();
   }
 
@@ -125,4 +131,17 @@ namespace libsemigroups {
     return false;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  // FpSemigroup - member functions - private
+  //////////////////////////////////////////////////////////////////////////////
+
+  void FpSemigroup::plan() {
+    LIBSEMIGROUPS_ASSERT(!_planned);
+    detail::PresentationStats stats;
+    stats.number_of_generators = alphabet().size();
+    stats.add_relations(cbegin_rules(), cend_rules());
+    stats.obviously_infinite = is_obviously_infinite();
+    detail::plan_runners(_race, stats);
+    _planned = true;
+  }
 }  // namespace libsemigroups
@@ -249,6 +249,20 @@ namespace libsemigroups {
     return _settings._concurrency_threshold;
   }
 
+  FroidurePinBase&
+  FroidurePinBase::memory_policy(libsemigroups::memory_policy val) {
+    _left.set_allocator(cayley_graph_type::allocator_type(val));
+    _right.set_allocator(cayley_graph_type::allocator_type(val));
+    _reduced.set_allocator(decltype(_reduced)::allocator_type(val));
+    return *this;
+  }
+
+  // The policy is stored in the allocators of the Cayley graphs, which are
+  // copied along with them.
+  libsemigroups::memory_policy FroidurePinBase::memory_policy() const noexcept {
+    return _right.get_allocator().policy();
+  }
+
   FroidurePinBase& FroidurePinBase::immutable(bool val) noexcept {
     _settings._immutable = val;
     return *this;
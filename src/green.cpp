@@ -0,0 +1,322 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the implementation of the Green class.
+
+#include "libsemigroups/green.hpp"
+
+#include <cstdint>  // for uint64_t
+#include <stack>    // for stack
+#include <thread>   // for thread
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+#include "libsemigroups/constants.hpp"  // for UNDEFINED
+#include "libsemigroups/debug.hpp"      // for LIBSEMIGROUPS_ASSERT
+#include "libsemigroups/exception.hpp"  // for LIBSEMIGROUPS_EXCEPTION
+#include "libsemigroups/report.hpp"     // for REPORT_DEFAULT
+#include "libsemigroups/timer.hpp"      // for Timer
+#include "libsemigroups/uf.hpp"         // for Duf
+
+namespace libsemigroups {
+  using element_index_type = Green::element_index_type;
+  using class_index_type   = Green::class_index_type;
+  using cayley_graph_type  = FroidurePinBase::cayley_graph_type;
+
+  namespace {
+    // Finds the strongly connected components of the first n nodes of the
+    // Cayley graph g, using the same path-based algorithm of Gabow as
+    // ActionDigraph::gabow_scc. The latter uses static stacks, and so two
+    // ActionDigraphs cannot find their components at the same time, which is
+    // why the algorithm is repeated here. The components are numbered in the
+    // order of their least nodes, the index of the component of every node is
+    // written into id, and the number of components is returned.
+    size_t scc(cayley_graph_type const&       g,
+               size_t                         n,
+               std::vector<class_index_type>& id) {
+      std::stack<element_index_type>                    stack1;
+      std::stack<element_index_type>                    stack2;
+      std::stack<std::pair<element_index_type, size_t>> frame;
+      std::vector<element_index_type>                   preorder(
+          n, static_cast<element_index_type>(UNDEFINED));
+      id.assign(n, UNDEFINED);
+
+      size_t const     degree = g.number_of_cols();
+      size_t           C      = 0;
+      class_index_type index  = 0;
+
+      for (element_index_type w = 0; w < n; ++w) {
+        if (id[w] != UNDEFINED) {
+          continue;
+        }
+        frame.emplace(w, 0);
+        preorder[w] = C++;
+        stack1.push(w);
+        stack2.push(w);
+        while (!frame.empty()) {
+          element_index_type const v = frame.top().first;
+          size_t&                  i = frame.top().second;
+          if (i < degree) {
+            element_index_type const u = g.get(v, i++);
+            if (preorder[u] == UNDEFINED) {
+              frame.emplace(u, 0);
+              preorder[u] = C++;
+              stack1.push(u);
+              stack2.push(u);
+            } else if (id[u] == UNDEFINED) {
+              LIBSEMIGROUPS_ASSERT(!stack2.empty());
+              while (preorder[stack2.top()] > preorder[u]) {
+                stack2.pop();
+              }
+            }
+            continue;
+          }
+          if (v == stack2.top()) {
+            element_index_type x;
+            do {
+              LIBSEMIGROUPS_ASSERT(!stack1.empty());
+              x     = stack1.top();
+              id[x] = index;
+              stack1.pop();
+            } while (x != v);
+            ++index;
+            stack2.pop();
+          }
+          frame.pop();
+        }
+      }
+
+      // Renumber the components in the order of their least nodes
+      std::vector<class_index_type> lookup(
+          index, static_cast<class_index_type>(UNDEFINED));
+      class_index_type next = 0;
+      for (element_index_type i = 0; i < n; ++i) {
+        if (lookup[id[i]] == UNDEFINED) {
+          lookup[id[i]] = next++;
+        }
+        id[i] = lookup[id[i]];
+      }
+      return index;
+    }
+
+    // Renumbers the classes in cls in the order of their least elements, and
+    // returns the number of classes. The index of every class in cls must be
+    // less than cls.size().
+    size_t renumber(std::vector<class_index_type>& cls) {
+      std::vector<class_index_type> lookup(
+          cls.size(), static_cast<class_index_type>(UNDEFINED));
+      class_index_type next = 0;
+      for (auto& c : cls) {
+        LIBSEMIGROUPS_ASSERT(c < cls.size());
+        if (lookup[c] == UNDEFINED) {
+          lookup[c] = next++;
+        }
+        c = lookup[c];
+      }
+      return next;
+    }
+
+    // Sorts the positions of the elements by the index of their class, using
+    // a counting sort. Afterwards the positions of the elements in class c
+    // are in [elts.begin() + first[c], elts.begin() + first[c + 1]), in
+    // increasing order.
+    void flatten(std::vector<class_index_type> const& cls,
+                 size_t                               number_of_classes,
+                 std::vector<element_index_type>&     elts,
+                 std::vector<size_t>&                 first) {
+      first.assign(number_of_classes + 1, 0);
+      for (auto c : cls) {
+        first[c + 1]++;
+      }
+      for (size_t c = 0; c < number_of_classes; ++c) {
+        first[c + 1] += first[c];
+      }
+      std::vector<size_t> next(first.cbegin(), first.cend() - 1);
+      elts.resize(cls.size());
+      for (element_index_type i = 0; i < cls.size(); ++i) {
+        elts[next[cls[i]]++] = i;
+      }
+    }
+  }  // namespace
+
+  ////////////////////////////////////////////////////////////////////////
+  // Green - constructors - public
+  ////////////////////////////////////////////////////////////////////////
+
+  Green::Green(FroidurePinBase& S, size_t number_of_threads)
+      : _d_class(),
+        _d_class_elts(),
+        _d_class_first(),
+        _d_class_number_of_idempotents(),
+        _d_class_number_of_l_classes(),
+        _d_class_number_of_r_classes(),
+        _h_class(),
+        _h_class_elts(),
+        _h_class_first(),
+        _h_class_idempotent(),
+        _is_idempotent(),
+        _l_class(),
+        _number_of_idempotents(0),
+        _number_of_l_classes(0),
+        _number_of_r_classes(0),
+        _r_class() {
+    if (number_of_threads == 0) {
+      LIBSEMIGROUPS_EXCEPTION("the number of threads must be positive");
+    }
+    size_t const n = S.size();
+    // Calling these after S is fully enumerated does not modify S.
+    auto const& right = S.right_cayley_graph();
+    auto const& left  = S.left_cayley_graph();
+
+    detail::Timer t;
+    // The right and left Cayley graphs are only read, and so their strongly
+    // connected components can be found at the same time.
+    if (number_of_threads > 1) {
+      std::thread th([this, &left, n]() {
+        _number_of_l_classes = scc(left, n, _l_class);
+      });
+      _number_of_r_classes = scc(right, n, _r_class);
+      th.join();
+    } else {
+      _number_of_r_classes = scc(right, n, _r_class);
+      _number_of_l_classes = scc(left, n, _l_class);
+    }
+    REPORT_DEFAULT("found %llu R-classes and %llu L-classes in %s\n",
+                   uint64_t(_number_of_r_classes),
+                   uint64_t(_number_of_l_classes),
+                   t.string().c_str());
+
+    _number_of_idempotents = S.number_of_idempotents();
+    _is_idempotent.resize(n);
+    for (element_index_type i = 0; i < n; ++i) {
+      _is_idempotent[i] = S.is_idempotent(i);
+    }
+
+    // D is the join of R and L, and since the R- and L-classes are numbered
+    // in the order of their least elements, the least element of every
+    // class is found when its index first occurs.
+    {
+      std::vector<element_index_type> r_least(_number_of_r_classes, n);
+      std::vector<element_index_type> l_least(_number_of_l_classes, n);
+      detail::Duf<>                   uf(n);
+      for (element_index_type i = 0; i < n; ++i) {
+        if (r_least[_r_class[i]] == n) {
+          r_least[_r_class[i]] = i;
+        } else {
+          uf.unite(i, r_least[_r_class[i]]);
+        }
+        if (l_least[_l_class[i]] == n) {
+          l_least[_l_class[i]] = i;
+        } else {
+          uf.unite(i, l_least[_l_class[i]]);
+        }
+      }
+      _d_class.resize(n);
+      for (element_index_type i = 0; i < n; ++i) {
+        _d_class[i] = uf.find(i);
+      }
+      size_t const number_of_d_classes = renumber(_d_class);
+      flatten(_d_class, number_of_d_classes, _d_class_elts, _d_class_first);
+
+      _d_class_number_of_r_classes.assign(number_of_d_classes, 0);
+      _d_class_number_of_l_classes.assign(number_of_d_classes, 0);
+      for (auto i : r_least) {
+        _d_class_number_of_r_classes[_d_class[i]]++;
+      }
+      for (auto i : l_least) {
+        _d_class_number_of_l_classes[_d_class[i]]++;
+      }
+    }
+
+    // H is the intersection of R and L, the H-classes contained in every
+    // R-class are numbered using the L-classes of its elements, and then
+    // renumbered in the order of their least elements.
+    _h_class.resize(n);
+    {
+      std::vector<element_index_type> r_class_elts;
+      std::vector<size_t>             r_class_first;
+      flatten(_r_class, _number_of_r_classes, r_class_elts, r_class_first);
+      std::vector<class_index_type> lookup(
+          _number_of_l_classes, static_cast<class_index_type>(UNDEFINED));
+      class_index_type next = 0;
+      for (class_index_type r = 0; r < _number_of_r_classes; ++r) {
+        auto const first = r_class_elts.cbegin() + r_class_first[r];
+        auto const last  = r_class_elts.cbegin() + r_class_first[r + 1];
+        for (auto it = first; it != last; ++it) {
+          class_index_type& h = lookup[_l_class[*it]];
+          if (h == UNDEFINED) {
+            h = next++;
+          }
+          _h_class[*it] = h;
+        }
+        for (auto it = first; it != last; ++it) {
+          lookup[_l_class[*it]] = UNDEFINED;
+        }
+      }
+    }
+    size_t const number_of_h_classes = renumber(_h_class);
+    flatten(_h_class, number_of_h_classes, _h_class_elts, _h_class_first);
+
+    _d_class_number_of_idempotents.assign(number_of_d_classes(), 0);
+    _h_class_idempotent.assign(number_of_h_classes, UNDEFINED);
+    for (element_index_type i = 0; i < n; ++i) {
+      if (_is_idempotent[i]) {
+        _d_class_number_of_idempotents[_d_class[i]]++;
+        LIBSEMIGROUPS_ASSERT(_h_class_idempotent[_h_class[i]] == UNDEFINED);
+        _h_class_idempotent[_h_class[i]] = i;
+      }
+    }
+    REPORT_DEFAULT("found %llu D-classes and %llu H-classes in %s\n",
+                   uint64_t(number_of_d_classes()),
+                   uint64_t(number_of_h_classes),
+                   t.string().c_str());
+  }
+
+  Green::~Green() = default;
+
+  ////////////////////////////////////////////////////////////////////////
+  // Green - validation - private
+  ////////////////////////////////////////////////////////////////////////
+
+  void Green::validate_element_index(element_index_type pos) const {
+    if (pos >= size()) {
+      LIBSEMIGROUPS_EXCEPTION(
+          "element index out of bounds, expected value in [0, %llu), got %llu",
+          uint64_t(size()),
+          uint64_t(pos));
+    }
+  }
+
+  void Green::validate_d_class_index(class_index_type d) const {
+    if (d >= number_of_d_classes()) {
+      LIBSEMIGROUPS_EXCEPTION(
+          "D-class index out of bounds, expected value in [0, %llu), got %llu",
+          uint64_t(number_of_d_classes()),
+          uint64_t(d));
+    }
+  }
+
+  void Green::validate_h_class_index(class_index_type h) const {
+    if (h >= number_of_h_classes()) {
+      LIBSEMIGROUPS_EXCEPTION(
+          "H-class index out of bounds, expected value in [0, %llu), got %llu",
+          uint64_t(number_of_h_classes()),
+          uint64_t(h));
+    }
+  }
+}  // namespace libsemigroups
@@ -26,6 +26,7 @@
 #include <atomic>       // for atomic
 #include <cinttypes>    // for int64_t
 #include <cstddef>      // for size_t
+#include <iterator>     // for distance
 #include <limits>       // for numeric_limits
 #include <list>         // for list, list<>::iterator
 #include <ostream>      // for string
@@ -273,6 +274,7 @@ namespace libsemigroups {
             _confluent(false),
             _confluence_known(false),
             _inactive_rules(),
+            _incremental(false),
             _internal_is_same_as_external(false),
             _contains_empty_string(false),
             _kb(kb),
@@ -281,7 +283,9 @@ namespace libsemigroups {
             _stack(),
             _tmp_word1(new internal_string_type()),
             _tmp_word2(new internal_string_type()),
-            _total_rules(0) {
+            _total_rules(0),
+            _active_rules_length(0),
+            _rule_objects(0) {
         _next_rule_it1 = _active_rules.end();  // null
         _next_rule_it2 = _active_rules.end();  // null
         this->set_overlap_policy(options::overlap::ABC);
@@ -404,6 +408,14 @@ namespace libsemigroups {
 
       void add_rule(std::string const& p, std::string const& q) {
         LIBSEMIGROUPS_ASSERT(p != q);
+        if (_stack.empty() && _confluence_known && _confluent) {
+          // The active rules are confluent, and so it is only necessary to
+          // consider the overlaps involving the new rule (and any rules that
+          // it makes redundant), which are added to the end of _active_rules,
+          // after _next_rule_it1, see knuth_bendix.
+          _next_rule_it1 = _active_rules.end();
+          _incremental   = true;
+        }
         auto pp = new external_string_type(p);
         auto qq = new external_string_type(q);
         external_to_internal_string(*pp);
@@ -459,6 +471,7 @@ namespace libsemigroups {
           _inactive_rules.erase(_inactive_rules.begin());
         } else {
           rule = new Rule(this, _total_rules);
+          ++_rule_objects;
         }
         LIBSEMIGROUPS_ASSERT(!rule->active());
         return rule;
@@ -509,6 +522,8 @@ namespace libsemigroups {
 #endif
         rule->activate();
         _active_rules.push_back(rule);
+        _active_rules_length += rule->lhs()->size() + rule->rhs()->size();
+        _kb->update_memory_usage(memory_in_rules());
         if (_next_rule_it1 == _active_rules.end()) {
           --_next_rule_it1;
         }
@@ -527,6 +542,15 @@ namespace libsemigroups {
         LIBSEMIGROUPS_ASSERT(_set_rules.size() == _active_rules.size());
       }
 
+      // Returns an estimate of the number of bytes used by the rules: every
+      // Rule owns 2 strings, and every active rule is also stored in
+      // _active_rules and _set_rules.
+      size_t memory_in_rules() const noexcept {
+        return _rule_objects * (sizeof(Rule) + 2 * sizeof(internal_string_type))
+               + _active_rules.size() * (sizeof(RuleLookup) + 7 * sizeof(void*))
+               + _active_rules_length;
+      }
+
       std::list<Rule const*>::iterator
       remove_rule(std::list<Rule const*>::iterator it) {
 #ifdef LIBSEMIGROUPS_VERBOSE
@@ -534,6 +558,9 @@ namespace libsemigroups {
 #endif
         Rule* rule = const_cast<Rule*>(*it);
         rule->deactivate();
+        _active_rules_length
+            -= std::min(_active_rules_length,
+                        rule->lhs()->size() + rule->rhs()->size());
         if (it != _next_rule_it1 && it != _next_rule_it2) {
           it = _active_rules.erase(it);
         } else if (it == _next_rule_it1 && it != _next_rule_it2) {
@@ -862,21 +889,39 @@ namespace libsemigroups {
           REPORT_DEFAULT("too many rules\n");
           return false;
         }
-        // Reduce the rules
-        _next_rule_it1 = _active_rules.begin();
-        while (_next_rule_it1 != _active_rules.end() && !_kb->stopped()) {
-          // Copy *_next_rule_it1 and push_stack so that it is not modified by
-          // the call to clear_stack.
-          LIBSEMIGROUPS_ASSERT((*_next_rule_it1)->lhs()
-                               != (*_next_rule_it1)->rhs());
-          push_stack(new_rule(*_next_rule_it1));
-          ++_next_rule_it1;
+        if (_incremental) {
+          // Rules were added to a confluent system, the overlaps of the rules
+          // before _next_rule_it1 have already been considered, and so we only
+          // reduce the new rules (by clearing the stack) and start with the
+          // first new rule.
+          _incremental = false;
+          clear_stack();
+        } else {
+          // Reduce the rules
+          _next_rule_it1 = _active_rules.begin();
+          while (_next_rule_it1 != _active_rules.end() && !_kb->stopped()) {
+            // Copy *_next_rule_it1 and push_stack so that it is not modified
+            // by the call to clear_stack.
+            LIBSEMIGROUPS_ASSERT((*_next_rule_it1)->lhs()
+                                 != (*_next_rule_it1)->rhs());
+            push_stack(new_rule(*_next_rule_it1));
+            ++_next_rule_it1;
+          }
+          _next_rule_it1 = _active_rules.begin();
         }
-        _next_rule_it1 = _active_rules.begin();
-        size_t nr      = 0;
+        size_t nr = 0;
+        // The number of rules before _next_rule_it1, used to estimate the
+        // proportion of the pairs of active rules whose overlaps have been
+        // considered.
+        double nr_done
+            = std::distance(_active_rules.begin(), _next_rule_it1);
         while (_next_rule_it1 != _active_rules.cend()
                && _active_rules.size() < _kb->_settings._max_rules
                && !_kb->stopped()) {
+          double const nr_active = _active_rules.size();
+          _kb->update_progress((nr_done * (nr_done + 1))
+                               / (nr_active * (nr_active + 1)));
+          ++nr_done;
           Rule const* rule1 = *_next_rule_it1;
           _next_rule_it2    = _next_rule_it1;
           ++_next_rule_it1;
@@ -913,7 +958,9 @@ namespace libsemigroups {
           for (Rule* rule : _inactive_rules) {
             delete rule;
           }
+          _rule_objects -= _inactive_rules.size();
           _inactive_rules.clear();
+          _kb->update_memory_usage(memory_in_rules());
           ret = true;
         } else {
           ret = false;
@@ -1004,6 +1051,7 @@ namespace libsemigroups {
       mutable std::atomic<bool>        _confluent;
       mutable std::atomic<bool>        _confluence_known;
       mutable std::list<Rule*>         _inactive_rules;
+      bool                             _incremental;
       bool                             _internal_is_same_as_external;
       bool                             _contains_empty_string;
       KnuthBendix*                     _kb;
@@ -1016,6 +1064,8 @@ namespace libsemigroups {
       internal_string_type*            _tmp_word1;
       internal_string_type*            _tmp_word2;
       mutable size_t                   _total_rules;
+      size_t                           _active_rules_length;
+      mutable size_t                   _rule_objects;
 
 #ifdef LIBSEMIGROUPS_VERBOSE
       //////////////////////////////////////////////////////////////////////////
@@ -17,6 +17,7 @@
 //
 
 #include <cstddef>  // for size_t
+#include <random>   // for mt19937
 #include <string>   // for string
 
 #include "libsemigroups/cong-intf.hpp"  // for CongruenceInterface, CongruenceInterface::...
@@ -30,6 +31,7 @@
 #include "libsemigroups/knuth-bendix.hpp"       // for KnuthBendix, KnuthBe...
 #include "libsemigroups/obvinf.hpp"             // for IsObviouslyInfinitePairs
 #include "libsemigroups/types.hpp"              // for word_type
+#include "libsemigroups/word.hpp"               // for word_to_string
 
 #include "knuth-bendix-impl.hpp"
 
@@ -236,6 +238,18 @@ namespace libsemigroups {
       }
     }
 
+    std::string KnuthBendix::random_normal_form(size_t        length,
+                                                std::mt19937& mt) {
+      if (alphabet().empty() || (length == 0 && !contains_empty_string())) {
+        LIBSEMIGROUPS_EXCEPTION("there are no normal forms of length %llu",
+                                uint64_t(length));
+      }
+      std::string result;
+      detail::word_to_string(
+          alphabet(), gilman_digraph().random_path(0, length, mt), result);
+      return result;
+    }
+
     size_t KnuthBendix::number_of_active_rules() const noexcept {
       return _impl->number_of_rules();
     }
@@ -295,6 +309,11 @@ namespace libsemigroups {
 
     void KnuthBendix::add_rule_impl(std::string const& p,
                                     std::string const& q) {
+      if (started()) {
+        // Rules are being added incrementally, and so the Gilman digraph (if
+        // any) is no longer valid.
+        _gilman_digraph = ActionDigraph<size_t>();
+      }
       _impl->add_rule(p, q);
     }
 
@@ -0,0 +1,143 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the implementation of the functions used by Congruence
+// and FpSemigroup to choose and configure the runners in their Race.
+
+#include "libsemigroups/planner.hpp"
+
+#include <algorithm>  // for all_of, any_of, max
+#include <memory>     // for shared_ptr
+
+#include "libsemigroups/exception.hpp"          // for LibsemigroupsException
+#include "libsemigroups/froidure-pin-base.hpp"  // for FroidurePinBase
+#include "libsemigroups/knuth-bendix.hpp"       // for KnuthBendix
+#include "libsemigroups/race.hpp"               // for Race
+#include "libsemigroups/runner.hpp"             // for Runner
+#include "libsemigroups/todd-coxeter.hpp"       // for ToddCoxeter
+
+namespace libsemigroups {
+  namespace detail {
+    namespace {
+      using ToddCoxeter = congruence::ToddCoxeter;
+      using KnuthBendix = fpsemigroup::KnuthBendix;
+
+      // If the number of generators times the total length of the relations
+      // is at most this value, then Felsch is used rather than HLT. Every
+      // definition made by Felsch is followed by processing the deductions it
+      // causes, which is cheap when the presentation is small, and avoids
+      // the many redundant cosets that HLT can define.
+      constexpr size_t FELSCH_MAX_COST = 256;
+
+      // If any relation is at least this long, then HLT uses full rather
+      // than partial lookaheads, and Knuth-Bendix measures overlaps by
+      // max(|AB|, |BC|) rather than |ABC|, so that the many long overlaps are
+      // not all considered before the short ones.
+      constexpr size_t LONG_RELATION_LENGTH = 16;
+
+      // Returns true if tc coset enumerates the right or left Cayley graph
+      // of a FroidurePin that is already fully enumerated, in which case it
+      // is guaranteed to terminate in time linear in the size of the graph.
+      bool uses_known_cayley_graph(ToddCoxeter const& tc) {
+        return tc.has_parent_froidure_pin()
+               && tc.froidure_pin_policy()
+                      == ToddCoxeter::options::froidure_pin::use_cayley_graph
+               && tc.parent_froidure_pin()->finished();
+      }
+
+      void configure(ToddCoxeter& tc, PresentationStats const& stats) {
+        if (tc.has_parent_froidure_pin()
+            && tc.froidure_pin_policy()
+                   != ToddCoxeter::options::froidure_pin::use_relations) {
+          return;
+        }
+        if (stats.number_of_generators * stats.total_relation_length
+            <= FELSCH_MAX_COST) {
+          try {
+            tc.strategy(ToddCoxeter::options::strategy::felsch);
+          } catch (LibsemigroupsException const&) {
+            // Felsch cannot be used if tc was prefilled, in which case the
+            // strategy is left as it was.
+          }
+        } else {
+          tc.strategy(ToddCoxeter::options::strategy::hlt);
+          tc.lookahead(stats.max_relation_length >= LONG_RELATION_LENGTH
+                           ? ToddCoxeter::options::lookahead::full
+                           : ToddCoxeter::options::lookahead::partial);
+        }
+      }
+
+      void configure(KnuthBendix& kb, PresentationStats const& stats) {
+        kb.overlap_policy(stats.max_relation_length >= LONG_RELATION_LENGTH
+                              ? KnuthBendix::options::overlap::MAX_AB_BC
+                              : KnuthBendix::options::overlap::ABC);
+      }
+    }  // namespace
+
+    void PresentationStats::add_relation(size_t lhs_length,
+                                         size_t rhs_length) noexcept {
+      number_of_relations++;
+      max_relation_length
+          = std::max(max_relation_length, std::max(lhs_length, rhs_length));
+      total_relation_length += lhs_length + rhs_length;
+    }
+
+    void plan_runners(Race& race, PresentationStats const& stats) {
+      bool const certain = std::any_of(
+          race.begin(), race.end(), [](std::shared_ptr<Runner> const& r) {
+            auto tc = dynamic_cast<ToddCoxeter const*>(r.get());
+            return tc != nullptr && uses_known_cayley_graph(*tc);
+          });
+
+      // If one of the runners is certain to terminate quickly, then the
+      // others are only using memory; and if the quotient is obviously
+      // infinite, then coset enumeration cannot terminate.
+      auto hopeless = [&stats, certain](std::shared_ptr<Runner> const& r) {
+        Runner* ptr = r.get();
+        if (auto tc = dynamic_cast<ToddCoxeter const*>(ptr)) {
+          return certain ? !uses_known_cayley_graph(*tc)
+                         : stats.obviously_infinite;
+        } else if (dynamic_cast<fpsemigroup::ToddCoxeter const*>(ptr)
+                   != nullptr) {
+          return stats.obviously_infinite;
+        } else if (dynamic_cast<congruence::KnuthBendix const*>(ptr) != nullptr
+                   || dynamic_cast<KnuthBendix const*>(ptr) != nullptr) {
+          return certain;
+        }
+        return false;
+      };
+
+      if (!std::all_of(race.begin(), race.end(), hopeless)) {
+        race.remove_runners_if(hopeless);
+      }
+
+      for (auto const& r : race) {
+        Runner* ptr = r.get();
+        if (auto tc = dynamic_cast<ToddCoxeter*>(ptr)) {
+          configure(*tc, stats);
+        } else if (auto fp = dynamic_cast<fpsemigroup::ToddCoxeter*>(ptr)) {
+          configure(fp->congruence(), stats);
+        } else if (auto ckb = dynamic_cast<congruence::KnuthBendix*>(ptr)) {
+          configure(ckb->knuth_bendix(), stats);
+        } else if (auto kb = dynamic_cast<KnuthBendix*>(ptr)) {
+          configure(*kb, stats);
+        }
+      }
+    }
+  }  // namespace detail
+}  // namespace libsemigroups
@@ -23,6 +23,7 @@
 
 #include "libsemigroups/race.hpp"
 
+#include <cstdint>     // for uint64_t
 #include <functional>  // for mem_fn
 #include <thread>
 
@@ -36,7 +37,9 @@ namespace libsemigroups {
     Race::Race()
         : _max_threads(std::thread::hardware_concurrency()),
           _mtx(),
-          _winner(nullptr) {}
+          _winner(nullptr),
+          _deterministic(false),
+          _max_memory(LIMIT_MAX) {}
 
     void Race::add_runner(std::shared_ptr<Runner> r) {
       if (_winner != nullptr) {
@@ -52,6 +55,52 @@ namespace libsemigroups {
       run_func(std::mem_fn(&Runner::run));
     }
 
+    std::shared_ptr<Runner> Race::deterministic_winner() const {
+      for (auto const& rnnr : _runners) {
+        if (!rnnr->dead()) {
+          return rnnr->finished() ? rnnr : nullptr;
+        }
+      }
+      return nullptr;
+    }
+
+    void Race::enforce_max_memory(std::vector<bool> const& done) {
+      size_t total       = 0;
+      size_t worst       = UNDEFINED;
+      size_t worst_bytes = 0;
+      size_t alive       = 0;
+      // In deterministic mode, killing the first Runner that is not dead
+      // would change the winner, and so it is never killed.
+      size_t head = UNDEFINED;
+      for (size_t i = 0; i < done.size(); ++i) {
+        if (_runners[i]->dead()) {
+          continue;
+        } else if (head == UNDEFINED) {
+          head = i;
+        }
+        size_t const bytes = _runners[i]->memory_usage();
+        total += bytes;
+        if (!done[i]) {
+          alive++;
+          if ((!_deterministic || i != head)
+              && (worst == UNDEFINED || bytes > worst_bytes)) {
+            worst       = i;
+            worst_bytes = bytes;
+          }
+        }
+      }
+      if (total > _max_memory && alive > 1) {
+        LIBSEMIGROUPS_ASSERT(worst != UNDEFINED);
+        REPORT_DEFAULT("using %llu bytes of memory, the limit is %llu, "
+                       "killing runner %d using %llu bytes\n",
+                       uint64_t(total),
+                       uint64_t(_max_memory),
+                       worst,
+                       uint64_t(worst_bytes));
+        _runners[worst]->kill();
+      }
+    }
+
     void Race::run_for(std::chrono::nanoseconds x) {
       if (empty()) {
         LIBSEMIGROUPS_EXCEPTION("no runners given, cannot run_for");
@@ -17,21 +17,210 @@
 //
 
 // This file contains implementations of the member functions for the Runner
-// class.
+// class, and of the deadline service used by Runner.
 
 #include "libsemigroups/runner.hpp"
 
+#include <algorithm>           // for max, min_element
+#include <condition_variable>  // for condition_variable
+#include <mutex>               // for mutex, lock_guard, unique_lock
+#include <thread>              // for thread
+#include <vector>              // for vector
+
+#include "libsemigroups/debug.hpp"   // for LIBSEMIGROUPS_ASSERT
 #include "libsemigroups/report.hpp"  // for REPORT_DEFAULT
 #include "libsemigroups/timer.hpp"   // for Timer::string
 
 namespace libsemigroups {
+  namespace detail {
+    // The deadline service is a single thread, started the first time that it
+    // is required, which sleeps until the earliest deadline of any running
+    // Runner, and then sets the corresponding flag of that Runner. Deadlines
+    // with a period are rescheduled after they are reached (for reporting),
+    // and those without are removed (for timing out). This means that
+    // Runner::timed_out and Runner::report are atomic loads, rather than calls
+    // to std::chrono::high_resolution_clock::now.
+    class DeadlineService {
+      using clock      = std::chrono::steady_clock;
+      using time_point = clock::time_point;
+
+      struct Deadline {
+        uint64_t                 id;
+        Runner*                  runner;
+        time_point               when;
+        std::chrono::nanoseconds period;
+      };
+
+     public:
+      DeadlineService()
+          : _cv(), _deadlines(), _mtx(), _next_id(1), _stop(false), _thread() {}
+
+      ~DeadlineService() {
+        {
+          std::lock_guard<std::mutex> lock(_mtx);
+          _stop = true;
+        }
+        _cv.notify_one();
+        if (_thread.joinable()) {
+          _thread.join();
+        }
+      }
+
+      static DeadlineService& instance() {
+        static DeadlineService ds;
+        return ds;
+      }
+
+      // Returns the time point at which the given duration from now elapses,
+      // or time_point::max() if this time point is not representable.
+      static time_point from_now(std::chrono::nanoseconds t) {
+        time_point const now = clock::now();
+        if (t >= time_point::max() - now) {
+          return time_point::max();
+        }
+        return now + std::chrono::duration_cast<clock::duration>(t);
+      }
+
+      // A period of 0 indicates that the deadline is a timeout.
+      uint64_t add(Runner*                  runner,
+                   time_point               when,
+                   std::chrono::nanoseconds period) {
+        std::lock_guard<std::mutex> lock(_mtx);
+        if (!_thread.joinable()) {
+          _thread = std::thread(&DeadlineService::loop, this);
+        }
+        _deadlines.push_back({_next_id, runner, when, period});
+        _cv.notify_one();
+        return _next_id++;
+      }
+
+      void reschedule(uint64_t                 id,
+                      time_point               when,
+                      std::chrono::nanoseconds period) {
+        std::lock_guard<std::mutex> lock(_mtx);
+        auto it = find(id);
+        LIBSEMIGROUPS_ASSERT(it != _deadlines.end());
+        it->when   = when;
+        it->period = period;
+        _cv.notify_one();
+      }
+
+      // Timeouts are removed when they are reached, so id may already have
+      // been removed.
+      void remove(uint64_t id) {
+        std::lock_guard<std::mutex> lock(_mtx);
+        auto                        it = find(id);
+        if (it != _deadlines.end()) {
+          _deadlines.erase(it);
+        }
+      }
+
+     private:
+      std::vector<Deadline>::iterator find(uint64_t id) {
+        return std::find_if(
+            _deadlines.begin(), _deadlines.end(), [&id](Deadline const& d) {
+              return d.id == id;
+            });
+      }
+
+      void loop() {
+        std::unique_lock<std::mutex> lock(_mtx);
+        while (!_stop) {
+          // There are only as many deadlines as there are running Runners,
+          // and so we just look for the earliest one.
+          auto it = std::min_element(
+              _deadlines.begin(),
+              _deadlines.end(),
+              [](Deadline const& x, Deadline const& y) {
+                return x.when < y.when;
+              });
+          if (it == _deadlines.end() || it->when == time_point::max()) {
+            _cv.wait(lock);
+          } else if (it->when > clock::now()) {
+            _cv.wait_until(lock, it->when);
+          } else if (it->period == std::chrono::nanoseconds(0)) {
+            it->runner->_timed_out.store(true, std::memory_order_relaxed);
+            _deadlines.erase(it);
+          } else {
+            it->runner->_report_due.store(true, std::memory_order_relaxed);
+            it->when = from_now(it->period);
+          }
+        }
+      }
+
+      std::condition_variable _cv;
+      std::vector<Deadline>   _deadlines;
+      std::mutex              _mtx;
+      uint64_t                _next_id;
+      bool                    _stop;
+      std::thread             _thread;
+    };
+
+    namespace {
+      // Report intervals shorter than this are not handled by the deadline
+      // service, since it would spend all of its time waking up, and instead
+      // Runner::report checks the clock.
+      constexpr std::chrono::nanoseconds MIN_REPORT_INTERVAL
+          = std::chrono::milliseconds(1);
+    }  // namespace
+  }    // namespace detail
+
+  Runner::DeadlineGuard::DeadlineGuard(Runner*                  runner,
+                                       std::chrono::nanoseconds timeout)
+      : _runner(runner), _timeout_id(0) {
+    auto& ds = detail::DeadlineService::instance();
+    if (timeout != FOREVER) {
+      _runner->_timed_out.store(timeout <= std::chrono::nanoseconds(0),
+                                std::memory_order_relaxed);
+      _timeout_id = ds.add(_runner,
+                           detail::DeadlineService::from_now(timeout),
+                           std::chrono::nanoseconds(0));
+    }
+    if (_runner->_run_depth == 0) {
+      // Discard any call to pause that happened after the previous run
+      // stopped checking.
+      _runner->_pause_requested.store(false, std::memory_order_relaxed);
+    }
+    if (_runner->_run_depth++ == 0
+        && _runner->_report_time_interval >= detail::MIN_REPORT_INTERVAL) {
+      auto const elapsed
+          = std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::high_resolution_clock::now()
+              - _runner->_last_report);
+      auto const next = _runner->_report_time_interval - elapsed;
+      _runner->_report_due.store(next <= std::chrono::nanoseconds(0),
+                                 std::memory_order_relaxed);
+      _runner->_report_id
+          = ds.add(_runner,
+                   detail::DeadlineService::from_now(next),
+                   _runner->_report_time_interval);
+    }
+  }
+
+  Runner::DeadlineGuard::~DeadlineGuard() {
+    auto& ds = detail::DeadlineService::instance();
+    if (_timeout_id != 0) {
+      ds.remove(_timeout_id);
+    }
+    if (--_runner->_run_depth == 0 && _runner->_report_id != 0) {
+      ds.remove(_runner->_report_id);
+      _runner->_report_id = 0;
+    }
+  }
+
   Runner::Runner()
       : _last_report(std::chrono::high_resolution_clock::now()),
+        _memory_usage(0),
+        _pause_requested(false),
+        _progress(0),
+        _report_due(false),
+        _report_id(0),
         _report_time_interval(),
-        _run_for(FOREVER),
-        _start_time(),
+        _resume_for(FOREVER),
+        _run_depth(0),
         _state(state::never_run),
-        _stopper() {
+        _stopper(),
+        _timed_out(false) {
     report_every(std::chrono::seconds(1));
   }
 
@@ -46,14 +235,20 @@ namespace libsemigroups {
         return;
       }
       before_run();
+      DeadlineGuard dg(this, val);
       set_state(state::running_for);
-      _start_time = std::chrono::high_resolution_clock::now();
-      _run_for    = val;
+      auto start = std::chrono::high_resolution_clock::now();
       // run_impl should depend on the method timed_out!
       run_impl();
       if (!finished()) {
         if (!dead()) {
-          set_state(state::timed_out);
+          set_state(paused_or(state::timed_out));
+          if (paused()) {
+            auto elapsed
+                = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::high_resolution_clock::now() - start);
+            _resume_for = std::max(val - elapsed, std::chrono::nanoseconds(0));
+          }
         }
       } else {
         set_state(state::not_running);
@@ -63,7 +258,27 @@ namespace libsemigroups {
     }
   }
 
+  void Runner::resume() {
+    if (!paused()) {
+      return;
+    } else if (_resume_for == std::chrono::nanoseconds::min()) {
+      LIBSEMIGROUPS_EXCEPTION("cannot resume after pausing run_until, call "
+                              "run_until again instead");
+    }
+    REPORT_DEFAULT("resuming . . .\n");
+    run_for(_resume_for);
+  }
+
   bool Runner::report() const {
+    if (_report_id != 0) {
+      // _report_due is set by the deadline service
+      if (!_report_due.load(std::memory_order_relaxed)) {
+        return false;
+      }
+      _report_due.store(false, std::memory_order_relaxed);
+      _last_report = std::chrono::high_resolution_clock::now();
+      return true;
+    }
     auto t       = std::chrono::high_resolution_clock::now();
     auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
         t - _last_report);
@@ -78,11 +293,22 @@ namespace libsemigroups {
   void Runner::report_every(std::chrono::nanoseconds val) {
     _last_report          = std::chrono::high_resolution_clock::now();
     _report_time_interval = val;
+    if (_report_id != 0) {
+      auto& ds = detail::DeadlineService::instance();
+      if (val >= detail::MIN_REPORT_INTERVAL) {
+        ds.reschedule(_report_id, ds.from_now(val), val);
+      } else {
+        ds.remove(_report_id);
+        _report_id = 0;
+      }
+    }
   }
 
   void Runner::report_why_we_stopped() const {
     if (dead()) {
       REPORT_DEFAULT("killed!\n");
+    } else if (running() ? _pause_requested.load() : paused()) {
+      REPORT_DEFAULT("paused!\n");
     } else if (timed_out()) {
       REPORT_DEFAULT("timed out!\n");
     }
@@ -0,0 +1,686 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains an implementation of the low-index congruence algorithm
+// for monoids.
+
+#include "libsemigroups/sims1.hpp"
+
+#include <algorithm>  // for reverse
+#include <atomic>     // for atomic
+#include <deque>      // for deque
+#include <memory>     // for make_shared, make_unique
+#include <mutex>      // for mutex, lock_guard
+#include <thread>     // for thread, yield
+#include <utility>    // for pair
+
+#include "libsemigroups/constants.hpp"   // for UNDEFINED
+#include "libsemigroups/containers.hpp"  // for DynamicArray2
+#include "libsemigroups/debug.hpp"       // for LIBSEMIGROUPS_ASSERT
+#include "libsemigroups/exception.hpp"   // for LIBSEMIGROUPS_EXCEPTION
+#include "libsemigroups/report.hpp"      // for REPORT_DEFAULT
+#include "libsemigroups/timer.hpp"       // for Timer
+
+namespace libsemigroups {
+  using node_type    = Sims1::node_type;
+  using digraph_type = Sims1::digraph_type;
+
+  ////////////////////////////////////////////////////////////////////////
+  // Sims1 - inner classes - private
+  ////////////////////////////////////////////////////////////////////////
+
+  // A PendingDef is an edge that has still to be tried, together with the
+  // size of the table at the point where the decision to try the edge was
+  // made, so that the table can be restored to that point by undoing the
+  // edges defined since.
+  struct Sims1::PendingDef {
+    PendingDef() = default;
+    PendingDef(node_type   s,
+               letter_type g,
+               node_type   t,
+               size_t      e,
+               size_t      n) noexcept
+        : source(s), generator(g), target(t), num_edges(e), num_nodes(n) {}
+
+    node_type   source;
+    letter_type generator;
+    node_type   target;
+    size_t      num_edges;
+    size_t      num_nodes;
+  };
+
+  // An iterator_base contains the state of a depth-first search through the
+  // tree of partially defined coset tables.
+  class Sims1::iterator_base {
+   public:
+    iterator_base(Sims1 const* sims, size_t n)
+        : _digraph(),
+          _edges(),
+          _max_nodes(n),
+          _num_active_nodes(1),
+          _num_found(0),
+          _pending(),
+          _preim_init(sims->number_of_generators(), n, UNDEFINED),
+          _preim_next(sims->number_of_generators(), n, UNDEFINED),
+          _relations(&sims->_relations),
+          _root_complete(false),
+          _table(sims->number_of_generators(), n, UNDEFINED) {
+      // The relations might force some edges from the identity node before
+      // any choice is made, for example if a generator is equal to the
+      // identity.
+      if (push_new_node(0) && process_deductions(0)) {
+        _root_complete = !push_children(0, 0);
+      }
+    }
+
+    iterator_base(iterator_base const&) = default;
+    iterator_base& operator=(iterator_base const&) = default;
+
+    virtual ~iterator_base() = default;
+
+    // Advance to the next complete compatible table and returns true, or
+    // returns false if there are no further such tables.
+    bool next() {
+      if (_root_complete) {
+        _root_complete = false;
+        make_digraph();
+        return true;
+      }
+      PendingDef pd;
+      while (!_pending.empty()) {
+        pd = _pending.back();
+        _pending.pop_back();
+        if (install(pd) && !push_children(pd.source, pd.generator)) {
+          make_digraph();
+          return true;
+        }
+      }
+      return false;
+    }
+
+    digraph_type const& digraph() const noexcept {
+      return _digraph;
+    }
+
+    uint64_t number_found() const noexcept {
+      return _num_found;
+    }
+
+    // Returns true if this and that are at the same point of the same search.
+    // Since the search is deterministic, it suffices to compare the number of
+    // digraphs found so far.
+    bool operator==(iterator_base const& that) const noexcept {
+      return _relations == that._relations && _max_nodes == that._max_nodes
+             && _num_found == that._num_found;
+    }
+
+   protected:
+    // Restore the table to the state when pd was created, define the edge
+    // described by pd, and process any deductions. Returns false if the
+    // resulting table is not compatible with the relations.
+    bool install(PendingDef const& pd) {
+      while (_edges.size() > pd.num_edges) {
+        undefine_last();
+      }
+      _num_active_nodes = pd.num_nodes;
+      bool const new_node = (pd.target == _num_active_nodes);
+      if (new_node) {
+        _num_active_nodes++;
+      }
+      size_t const first = _edges.size();
+      define(pd.source, pd.generator, pd.target);
+      return (!new_node || push_new_node(pd.target))
+             && process_deductions(first);
+    }
+
+    // Push the possible targets of the first undefined edge at or after the
+    // edge with source s and label a (all edges before which are defined).
+    // Returns false if there is no undefined edge, i.e. the table is
+    // complete.
+    bool push_children(node_type s, letter_type a) {
+      size_t const m = _table.number_of_cols();
+      for (; s < _num_active_nodes; ++s) {
+        for (; a < m; ++a) {
+          if (_table.get(s, a) == UNDEFINED) {
+            // Push the new node first, so that it is tried last.
+            if (_num_active_nodes < _max_nodes) {
+              _pending.emplace_back(s,
+                                    a,
+                                    _num_active_nodes,
+                                    _edges.size(),
+                                    _num_active_nodes);
+            }
+            for (node_type t = _num_active_nodes; t-- > 0;) {
+              _pending.emplace_back(
+                  s, a, t, _edges.size(), _num_active_nodes);
+            }
+            return true;
+          }
+        }
+        a = 0;
+      }
+      return false;
+    }
+
+    void make_digraph() {
+      size_t const m = _table.number_of_cols();
+      _digraph       = digraph_type(_num_active_nodes, m);
+      for (node_type s = 0; s < _num_active_nodes; ++s) {
+        for (letter_type a = 0; a < m; ++a) {
+          _digraph.add_edge(s, _table.get(s, a), a);
+        }
+      }
+      _num_found++;
+    }
+
+    digraph_type                                  _digraph;
+    std::vector<std::pair<node_type, letter_type>> _edges;
+    size_t                                        _max_nodes;
+    size_t                                        _num_active_nodes;
+    uint64_t                                      _num_found;
+    std::deque<PendingDef>                        _pending;
+    detail::DynamicArray2<node_type>              _preim_init;
+    detail::DynamicArray2<node_type>              _preim_next;
+    std::vector<word_type> const*                 _relations;
+    bool                                          _root_complete;
+    detail::DynamicArray2<node_type>              _table;
+
+   private:
+    // The preimages of t under a are stored as a linked list starting at
+    // _preim_init.get(t, a) and continuing via _preim_next, as in
+    // ToddCoxeter. Edges are always undone in the reverse of the order they
+    // were defined, and so the edge being undone is the head of its list.
+    void define(node_type s, letter_type a, node_type t) {
+      LIBSEMIGROUPS_ASSERT(_table.get(s, a) == UNDEFINED);
+      _table.set(s, a, t);
+      _preim_next.set(s, a, _preim_init.get(t, a));
+      _preim_init.set(t, a, s);
+      _edges.emplace_back(s, a);
+    }
+
+    void undefine_last() {
+      node_type const   s = _edges.back().first;
+      letter_type const a = _edges.back().second;
+      node_type const   t = _table.get(s, a);
+      LIBSEMIGROUPS_ASSERT(_preim_init.get(t, a) == s);
+      _preim_init.set(t, a, _preim_next.get(s, a));
+      _table.set(s, a, UNDEFINED);
+      _edges.pop_back();
+    }
+
+    node_type tau(node_type                 c,
+                  word_type::const_iterator first,
+                  word_type::const_iterator last) const noexcept {
+      for (auto it = first; it < last && c != UNDEFINED; ++it) {
+        c = _table.get(c, *it);
+      }
+      return c;
+    }
+
+    // Trace w from c, and set x to the node reached by all but the last
+    // letter of w and xa to the node reached by w. Returns false if x is not
+    // defined.
+    bool trace(node_type        c,
+               word_type const& w,
+               node_type&       x,
+               node_type&       xa) const noexcept {
+      if (w.empty()) {
+        x  = UNDEFINED;
+        xa = c;
+        return true;
+      }
+      x = tau(c, w.cbegin(), w.cend() - 1);
+      if (x == UNDEFINED) {
+        return false;
+      }
+      xa = _table.get(x, w.back());
+      return true;
+    }
+
+    // The analogue of ToddCoxeter::push_definition_felsch, except that a
+    // coincidence means that the table is incompatible, and so the return
+    // value is false.
+    bool push_definition(node_type        c,
+                         word_type const& u,
+                         word_type const& v) {
+      node_type x, xa, y, yb;
+      if (!trace(c, u, x, xa) || !trace(c, v, y, yb)) {
+        return true;
+      }
+      if (xa == UNDEFINED && yb != UNDEFINED) {
+        define(x, u.back(), yb);
+      } else if (xa != UNDEFINED && yb == UNDEFINED) {
+        define(y, v.back(), xa);
+      } else if (xa != yb) {
+        return false;
+      }
+      return true;
+    }
+
+    // Push every node c such that the path labelled by the first i letters of
+    // w from c ends at s through the relation u = v.
+    bool push_preimages(node_type        s,
+                        word_type const& w,
+                        size_t           i,
+                        word_type const& u,
+                        word_type const& v) {
+      if (i == 0) {
+        return push_definition(s, u, v);
+      }
+      letter_type const a = w[i - 1];
+      for (node_type c = _preim_init.get(s, a); c != UNDEFINED;
+           c = _preim_next.get(c, a)) {
+        if (!push_preimages(c, w, i - 1, u, v)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // Push the new node t through every relation, this is only required for
+    // relations where the path labelled by one side from t only uses the
+    // edge being defined, such as {a} = {}.
+    bool push_new_node(node_type t) {
+      auto const& rels = *_relations;
+      for (auto it = rels.cbegin(); it < rels.cend(); it += 2) {
+        if (!push_definition(t, *it, *(it + 1))) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // Process the edges in _edges from position first onwards, including any
+    // that are defined during processing. The path labelled by a side of a
+    // relation from a node can only change when one of its edges is defined,
+    // and so only the nodes whose paths go through the new edges are pushed
+    // through the relations. Returns false if the table is not compatible
+    // with the relations.
+    bool process_deductions(size_t first) {
+      auto const& rels = *_relations;
+      for (size_t k = first; k < _edges.size(); ++k) {
+        node_type const   s = _edges[k].first;
+        letter_type const a = _edges[k].second;
+        for (auto it = rels.cbegin(); it < rels.cend(); it += 2) {
+          for (auto const& w : {it, it + 1}) {
+            for (size_t i = 0; i < w->size(); ++i) {
+              if ((*w)[i] == a && !push_preimages(s, *w, i, *it, *(it + 1))) {
+                return false;
+              }
+            }
+          }
+        }
+      }
+      return true;
+    }
+  };
+
+  // A thread_runner is an iterator_base whose pending definitions can be
+  // stolen by other threads.
+  class Sims1::thread_runner final : public iterator_base {
+   public:
+    thread_runner(Sims1 const* sims, size_t n)
+        : iterator_base(sims, n), _idle(false), _mtx() {}
+
+    // Pops a pending definition, or marks this as idle if there are none.
+    bool try_pop(PendingDef& pd, std::atomic<size_t>& num_idle) {
+      std::lock_guard<std::mutex> lock(_mtx);
+      if (_pending.empty()) {
+        if (!_idle) {
+          _idle = true;
+          num_idle++;
+        }
+        return false;
+      }
+      pd = _pending.back();
+      _pending.pop_back();
+      return true;
+    }
+
+    // Steals the oldest pending definition of victim, which is the root of
+    // the largest unexplored subtree, and the table it applies to. Only
+    // called when this is idle.
+    bool try_steal(thread_runner&       victim,
+                   PendingDef&          pd,
+                   std::atomic<size_t>& num_idle) {
+      LIBSEMIGROUPS_ASSERT(_idle);
+      LIBSEMIGROUPS_ASSERT(_pending.empty());
+      std::lock_guard<std::mutex> lock(victim._mtx);
+      if (victim._pending.empty()) {
+        return false;
+      }
+      pd = victim._pending.front();
+      victim._pending.pop_front();
+      // The edges [0, pd.num_edges) of victim cannot have been undone, since
+      // pd was still pending, and the remaining edges are undone by install.
+      _table      = victim._table;
+      _edges      = victim._edges;
+      _preim_init = victim._preim_init;
+      _preim_next = victim._preim_next;
+      _idle = false;
+      num_idle--;
+      return true;
+    }
+
+    // Returns true if the table obtained from pd is complete (in which case
+    // digraph() contains the corresponding digraph).
+    bool process(PendingDef const& pd) {
+      {
+        std::lock_guard<std::mutex> lock(_mtx);
+        if (!install(pd) || push_children(pd.source, pd.generator)) {
+          return false;
+        }
+      }
+      make_digraph();
+      return true;
+    }
+
+    void make_idle(std::atomic<size_t>& num_idle) {
+      std::lock_guard<std::mutex> lock(_mtx);
+      _pending.clear();
+      _root_complete = false;
+      _idle          = true;
+      num_idle++;
+    }
+
+    bool root_complete() const noexcept {
+      return _root_complete;
+    }
+
+    void emit_root() {
+      _root_complete = false;
+      make_digraph();
+    }
+
+    thread_runner& operator=(thread_runner const&) = delete;
+
+   private:
+    bool       _idle;
+    std::mutex _mtx;
+  };
+
+  // A thread_pool runs a depth-first search in several threads, where idle
+  // threads steal work from the others.
+  class Sims1::thread_pool final {
+   public:
+    thread_pool(Sims1 const*                             sims,
+                size_t                                   n,
+                size_t                                   num_threads,
+                std::function<bool(digraph_type const&)> hook)
+        : _hook(hook), _num_idle(0), _runners(), _stop(false) {
+      for (size_t i = 0; i < num_threads; ++i) {
+        _runners.push_back(std::make_unique<thread_runner>(sims, n));
+      }
+      // All the work initially belongs to the first thread.
+      for (size_t i = 1; i < num_threads; ++i) {
+        _runners[i]->make_idle(_num_idle);
+      }
+    }
+
+    void run() {
+      if (_runners[0]->root_complete()) {
+        _runners[0]->emit_root();
+        _hook(_runners[0]->digraph());
+        return;
+      }
+      std::vector<std::thread> threads;
+      for (size_t i = 0; i < _runners.size(); ++i) {
+        threads.emplace_back(&thread_pool::worker, this, i);
+      }
+      for (auto& t : threads) {
+        t.join();
+      }
+    }
+
+   private:
+    void worker(size_t i) {
+      thread_runner& me = *_runners[i];
+      size_t const   N  = _runners.size();
+      PendingDef     pd;
+      while (!_stop) {
+        bool found = me.try_pop(pd, _num_idle);
+        for (size_t j = (i + 1) % N; !found && j != i; j = (j + 1) % N) {
+          found = me.try_steal(*_runners[j], pd, _num_idle);
+        }
+        if (found) {
+          if (me.process(pd) && _hook(me.digraph())) {
+            _stop = true;
+          }
+        } else if (_num_idle == N) {
+          return;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+
+    std::function<bool(digraph_type const&)>    _hook;
+    std::atomic<size_t>                         _num_idle;
+    std::vector<std::unique_ptr<thread_runner>> _runners;
+    std::atomic<bool>                           _stop;
+  };
+
+  ////////////////////////////////////////////////////////////////////////
+  // Sims1 - constructors - public
+  ////////////////////////////////////////////////////////////////////////
+
+  Sims1::Sims1(congruence_kind knd)
+      : _kind(knd),
+        _number_of_generators(UNDEFINED),
+        _number_of_threads(1),
+        _relations() {
+    if (knd == congruence_kind::twosided) {
+      LIBSEMIGROUPS_EXCEPTION(
+          "expected congruence_kind::left or congruence_kind::right");
+    }
+  }
+
+  Sims1::~Sims1() = default;
+
+  ////////////////////////////////////////////////////////////////////////
+  // Sims1 - presentation - public
+  ////////////////////////////////////////////////////////////////////////
+
+  Sims1& Sims1::set_number_of_generators(size_t n) {
+    if (n == 0) {
+      LIBSEMIGROUPS_EXCEPTION("the number of generators must be non-zero!");
+    } else if (_number_of_generators != UNDEFINED
+               && _number_of_generators != n) {
+      LIBSEMIGROUPS_EXCEPTION("cannot change the number of generators");
+    }
+    _number_of_generators = n;
+    return *this;
+  }
+
+  Sims1& Sims1::add_pair(word_type const& u, word_type const& v) {
+    if (_number_of_generators == UNDEFINED) {
+      LIBSEMIGROUPS_EXCEPTION("no generators have been defined");
+    }
+    for (auto const& w : {u, v}) {
+      for (auto const& a : w) {
+        if (a >= _number_of_generators) {
+          LIBSEMIGROUPS_EXCEPTION(
+              "invalid letter %d, the valid range is [0, %d)",
+              a,
+              _number_of_generators);
+        }
+      }
+    }
+    if (u == v) {
+      return *this;
+    }
+    _relations.push_back(u);
+    _relations.push_back(v);
+    if (_kind == congruence_kind::left) {
+      std::reverse(_relations.rbegin()->begin(), _relations.rbegin()->end());
+      std::reverse((_relations.rbegin() + 1)->begin(),
+                   (_relations.rbegin() + 1)->end());
+    }
+    return *this;
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // Sims1 - settings - public
+  ////////////////////////////////////////////////////////////////////////
+
+  Sims1& Sims1::number_of_threads(size_t val) {
+    if (val == 0) {
+      LIBSEMIGROUPS_EXCEPTION("the number of threads must be non-zero!");
+    }
+    _number_of_threads = val;
+    return *this;
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // Sims1 - the main functions - public
+  ////////////////////////////////////////////////////////////////////////
+
+  void Sims1::for_each(size_t                                     n,
+                       std::function<void(digraph_type const&)> hook) const {
+    validate(n);
+    detail::Timer tmr;
+    if (_number_of_threads == 1) {
+      iterator_base it(this, n);
+      while (it.next()) {
+        hook(it.digraph());
+      }
+    } else {
+      thread_pool pool(
+          this, n, _number_of_threads, [&hook](digraph_type const& d) {
+            hook(d);
+            return false;
+          });
+      pool.run();
+    }
+    REPORT_TIME(tmr);
+  }
+
+  digraph_type
+  Sims1::find_if(size_t                                     n,
+                 std::function<bool(digraph_type const&)> pred) const {
+    validate(n);
+    if (_number_of_threads == 1) {
+      iterator_base it(this, n);
+      while (it.next()) {
+        if (pred(it.digraph())) {
+          return it.digraph();
+        }
+      }
+      return digraph_type();
+    }
+    digraph_type result;
+    std::mutex   mtx;
+    thread_pool  pool(this,
+                     n,
+                     _number_of_threads,
+                     [&pred, &result, &mtx](digraph_type const& d) {
+                       if (pred(d)) {
+                         std::lock_guard<std::mutex> lock(mtx);
+                         if (result.number_of_nodes() == 0) {
+                           result = d;
+                         }
+                         return true;
+                       }
+                       return false;
+                     });
+    pool.run();
+    return result;
+  }
+
+  uint64_t Sims1::number_of_congruences(size_t n) const {
+    std::atomic<uint64_t> result(0);
+    for_each(n, [&result](digraph_type const&) { result++; });
+    return result;
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // Sims1::const_iterator
+  ////////////////////////////////////////////////////////////////////////
+
+  Sims1::const_iterator::const_iterator(Sims1 const* sims, size_t n)
+      : _ptr(nullptr) {
+    if (n != 0) {
+      _ptr = std::make_shared<iterator_base>(sims, n);
+      ++(*this);
+    }
+  }
+
+  Sims1::const_iterator::const_iterator(const_iterator const& that)
+      : _ptr(that._ptr == nullptr ? nullptr
+                                  : std::make_shared<iterator_base>(
+                                      *that._ptr)) {}
+
+  Sims1::const_iterator::const_iterator(const_iterator&&) = default;
+
+  Sims1::const_iterator&
+  Sims1::const_iterator::operator=(const_iterator const& that) {
+    _ptr = (that._ptr == nullptr ? nullptr
+                                 : std::make_shared<iterator_base>(*that._ptr));
+    return *this;
+  }
+
+  Sims1::const_iterator&
+  Sims1::const_iterator::operator=(const_iterator&&) = default;
+
+  Sims1::const_iterator::~const_iterator() = default;
+
+  bool Sims1::const_iterator::operator==(const_iterator const& that) const
+      noexcept {
+    if (_ptr == nullptr || that._ptr == nullptr) {
+      return _ptr == that._ptr;
+    }
+    return *_ptr == *that._ptr;
+  }
+
+  Sims1::const_iterator::reference Sims1::const_iterator::operator*() const
+      noexcept {
+    LIBSEMIGROUPS_ASSERT(_ptr != nullptr);
+    return _ptr->digraph();
+  }
+
+  Sims1::const_iterator& Sims1::const_iterator::operator++() {
+    LIBSEMIGROUPS_ASSERT(_ptr != nullptr);
+    if (!_ptr->next()) {
+      _ptr = nullptr;
+    }
+    return *this;
+  }
+
+  Sims1::const_iterator Sims1::cbegin(size_t n) const {
+    validate(n);
+    return const_iterator(this, n);
+  }
+
+  Sims1::const_iterator Sims1::cend(size_t n) const {
+    validate(n);
+    return const_iterator(this, 0);
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // Sims1 - validation - private
+  ////////////////////////////////////////////////////////////////////////
+
+  void Sims1::validate(size_t n) const {
+    if (_number_of_generators == UNDEFINED) {
+      LIBSEMIGROUPS_EXCEPTION("no generators have been defined");
+    } else if (n == 0) {
+      LIBSEMIGROUPS_EXCEPTION(
+          "the maximum number of classes must be non-zero!");
+    }
+  }
+}  // namespace libsemigroups
@@ -26,7 +26,7 @@
 #include <cstddef>    // for size_t
 #include <memory>     // for shared_ptr
 #include <numeric>    // for iota
-#include <random>     // for mt19937
+#include <random>     // for mt19937_64, random_device
 #include <string>     // for operator+, basic_string
 #include <utility>    // for pair
 
@@ -48,6 +48,7 @@
 #include "libsemigroups/tce.hpp"                // for TCE
 #include "libsemigroups/timer.hpp"              // for detail::Timer
 #include "libsemigroups/types.hpp"              // for letter_type
+#include "libsemigroups/uf.hpp"                 // for Duf
 
 // TODO(later)
 //
@@ -232,6 +233,9 @@ namespace libsemigroups {
             next_lookahead(5000000),
             froidure_pin(options::froidure_pin::none),
             random_interval(200000000),
+            memory_policy(libsemigroups::memory_policy::standard),
+            seed(std::random_device()()),
+            mt(seed),
             save(false),
             standardize(false),
             strategy(options::strategy::hlt) {
@@ -242,14 +246,17 @@ namespace libsemigroups {
 #ifdef LIBSEMIGROUPS_DEBUG
       bool enable_debug_verify_no_missing_deductions;
 #endif
-      options::lookahead       lookahead;
-      size_t                   lower_bound;
-      size_t                   next_lookahead;
-      options::froidure_pin    froidure_pin;
-      std::chrono::nanoseconds random_interval;
-      bool                     save;
-      bool                     standardize;
-      options::strategy        strategy;
+      options::lookahead           lookahead;
+      size_t                       lower_bound;
+      size_t                       next_lookahead;
+      options::froidure_pin        froidure_pin;
+      std::chrono::nanoseconds     random_interval;
+      libsemigroups::memory_policy memory_policy;
+      uint64_t                     seed;
+      std::mt19937_64              mt;
+      bool                         save;
+      bool                         standardize;
+      options::strategy            strategy;
     };
 
     class ToddCoxeter::FelschTree {
@@ -559,12 +566,36 @@ namespace libsemigroups {
       return _settings->strategy;
     }
 
+    ToddCoxeter&
+    ToddCoxeter::memory_policy(libsemigroups::memory_policy val) {
+      _settings->memory_policy = val;
+      table_type::allocator_type alloc(val);
+      _table.set_allocator(alloc);
+      _preim_init.set_allocator(alloc);
+      _preim_next.set_allocator(alloc);
+      return *this;
+    }
+
+    libsemigroups::memory_policy ToddCoxeter::memory_policy() const noexcept {
+      return _settings->memory_policy;
+    }
+
     ToddCoxeter&
     ToddCoxeter::random_interval(std::chrono::nanoseconds x) noexcept {
       _settings->random_interval = x;
       return *this;
     }
 
+    ToddCoxeter& ToddCoxeter::seed(uint64_t val) noexcept {
+      _settings->seed = val;
+      _settings->mt.seed(val);
+      return *this;
+    }
+
+    uint64_t ToddCoxeter::seed() const noexcept {
+      return _settings->seed;
+    }
+
     ToddCoxeter& ToddCoxeter::sort_generating_pairs(
         std::function<bool(word_type const&, word_type const&)> func) {
       if (started()) {
@@ -584,12 +615,13 @@ namespace libsemigroups {
             "Cannot shuffle relations, the coset enumeration has started!")
       }
       init();
-      std::vector<class_index_type> perm(0, _relations.size());
+      std::vector<class_index_type> perm(_relations.size() / 2);
       std::iota(perm.begin(), perm.end(), 0);
-      std::random_device rd;
-      std::mt19937       g(rd());
-      std::shuffle(perm.begin(), perm.end(), g);
+      std::shuffle(perm.begin(), perm.end(), _settings->mt);
       ::sort_generating_pairs(perm, _relations);
+      perm.resize(_extra.size() / 2);
+      std::iota(perm.begin(), perm.end(), 0);
+      std::shuffle(perm.begin(), perm.end(), _settings->mt);
       ::sort_generating_pairs(perm, _extra);
       return *this;
     }
@@ -600,7 +632,7 @@ namespace libsemigroups {
 
     bool ToddCoxeter::empty() const {
       return _relations.empty() && _extra.empty()
-             && number_of_cosets_active() == 1;
+             && number_of_cosets_active() == 1 && !_prefilled;
     }
 
     void ToddCoxeter::reserve(size_t n) {
@@ -611,6 +643,7 @@ namespace libsemigroups {
         _preim_init.add_rows(m);
         _preim_next.add_rows(m);
         add_free_cosets(m);
+        update_memory_usage(memory_in_tables());
       }
     }
 
@@ -632,6 +665,7 @@ namespace libsemigroups {
       _extra.clear();
       _extra.shrink_to_fit();
       erase_free_cosets();
+      update_memory_usage(memory_in_tables());
     }
 
     ////////////////////////////////////////////////////////////////////////
@@ -764,6 +798,12 @@ namespace libsemigroups {
             "there are infinitely many classes in the congruence and "
             "Todd-Coxeter will never terminate");
       }
+      init();
+      if (_state == state::initialized && _prefilled
+          && has_parent_froidure_pin() && number_of_cosets_active() == 1) {
+        enumerate_cayley_graph();
+        return;
+      }
       if (_settings->lower_bound != UNDEFINED) {
         size_t const bound     = _settings->lower_bound;
         _settings->lower_bound = UNDEFINED;
@@ -799,6 +839,67 @@ namespace libsemigroups {
     // CongruenceInterface - non-pure virtual member functions - private
     ////////////////////////////////////////////////////////////////////////
 
+    void ToddCoxeter::add_pair_impl(word_type const&, word_type const&) {
+      if (_state != state::finished) {
+        // The pair is picked up by init() when the enumeration starts.
+        return;
+      }
+      REPORT_DEFAULT("adding a generating pair to a complete coset table...\n");
+      detail::Timer tmr;
+      // The table is complete and compatible with the existing relations, so
+      // the quotient by the new pair is obtained by tracing it through the
+      // table and processing the resulting coincidences.
+      auto& rels = (kind() == congruence_kind::twosided ? _relations : _extra);
+      size_t const first = rels.size();
+      init();  // appends the new pair (reversed if necessary) to rels
+      _felsch_tree.reset();
+
+      coset_type c = _id_coset;
+      do {
+        for (auto it = rels.cbegin() + first; it < rels.cend(); it += 2) {
+          coset_type const x = tau(c, it->cbegin(), it->cend());
+          coset_type const y = tau(c, (it + 1)->cbegin(), (it + 1)->cend());
+          LIBSEMIGROUPS_ASSERT(is_active_coset(x) && is_active_coset(y));
+          if (x != y) {
+            _coinc.emplace(x, y);
+          }
+        }
+        // Left and right congruences only require the pair to hold at the
+        // identity coset, two-sided congruences require it at every coset.
+        c = (kind() == congruence_kind::twosided ? next_active_coset(c)
+                                                  : first_free_coset());
+      } while (c != first_free_coset());
+
+      process_coincidences<DoNotStackDeductions>();
+      LIBSEMIGROUPS_ASSERT(complete());
+      _standardized = order::none;
+      TODD_COXETER_REPORT_COSETS();
+      REPORT_TIME(tmr);
+    }
+
+    void ToddCoxeter::class_indices_impl(FroidurePinBase const&   fp,
+                                         std::vector<coset_type>& out) {
+      run();
+      LIBSEMIGROUPS_ASSERT(finished());
+      if (!is_standardized()) {
+        standardize(order::shortlex);
+      }
+      // Rather than tracing a word for every element of fp, the coset of
+      // every element is obtained from that of its prefix (or suffix for
+      // left congruences) by following a single edge, since the prefix and
+      // suffix of an element always have smaller index than the element.
+      bool const left = (kind() == congruence_kind::left);
+      for (size_t pos = 0; pos < fp.current_size(); ++pos) {
+        size_t const prev = (left ? fp.suffix(pos) : fp.prefix(pos));
+        letter_type const a
+            = (left ? fp.first_letter(pos) : fp.final_letter(pos));
+        coset_type const c = (prev == UNDEFINED ? _id_coset : out[prev] + 1);
+        LIBSEMIGROUPS_ASSERT(prev == UNDEFINED || prev < pos);
+        LIBSEMIGROUPS_ASSERT(_table.get(c, a) != UNDEFINED);
+        out[pos] = _table.get(c, a) - 1;
+      }
+    }
+
     coset_type
     ToddCoxeter::const_word_to_class_index(word_type const& w) const {
       validate_word(w);
@@ -812,6 +913,10 @@ namespace libsemigroups {
       return (c == UNDEFINED ? c : c - 1);
     }
 
+    bool ToddCoxeter::incremental_impl() const noexcept {
+      return _state == state::finished;
+    }
+
     bool ToddCoxeter::is_quotient_obviously_finite_impl() {
       if (finished()) {
         return true;
@@ -842,9 +947,13 @@ namespace libsemigroups {
 
     void ToddCoxeter::set_number_of_generators_impl(size_t n) {
       // TODO(later) add columns to make it up to n?
+      table_type::allocator_type alloc(_settings->memory_policy);
       _preim_init = table_type(n, 1, UNDEFINED);
       _preim_next = table_type(n, 1, UNDEFINED);
       _table      = table_type(n, 1, UNDEFINED);
+      _preim_init.set_allocator(alloc);
+      _preim_next.set_allocator(alloc);
+      _table.set_allocator(alloc);
     }
 
     ////////////////////////////////////////////////////////////////////////
@@ -918,12 +1027,13 @@ namespace libsemigroups {
               || _settings->froidure_pin == options::froidure_pin::none) {
             REPORT_DEBUG_DEFAULT("using Cayley graph...\n");
             LIBSEMIGROUPS_ASSERT(_relations.empty());
-            prefill(*parent_froidure_pin());
-#ifdef LIBSEMIGROUPS_DEBUG
-            // This is a check of program logic, since we use parent() to fill
-            // the table, so we only validate in debug mode.
-            validate_table(_table, 1, parent_froidure_pin()->size() + 1);
-#endif
+            if (_settings->strategy == options::strategy::felsch) {
+              LIBSEMIGROUPS_EXCEPTION("it is not possible to prefill when "
+                                      "using the Felsch strategy");
+            }
+            // The Cayley graph is not copied into _table, the generating
+            // pairs are traced through it in enumerate_cayley_graph.
+            _prefilled = true;
           } else {
             REPORT_DEBUG_DEFAULT("using presentation...\n");
             LIBSEMIGROUPS_ASSERT(_settings->froidure_pin
@@ -981,8 +1091,8 @@ namespace libsemigroups {
       LIBSEMIGROUPS_ASSERT(_table.number_of_rows()
                            >= number_of_cosets_active());
       LIBSEMIGROUPS_ASSERT(_prefilled);
-      LIBSEMIGROUPS_ASSERT(_state == state::constructed);
-      LIBSEMIGROUPS_ASSERT(_relations.empty());
+      LIBSEMIGROUPS_ASSERT(_state == state::constructed
+                           || _state == state::initialized);
 
       for (coset_type c = 0; c < number_of_cosets_active(); c++) {
         for (size_t i = 0; i < number_of_generators(); i++) {
@@ -993,22 +1103,98 @@ namespace libsemigroups {
       }
     }
 
-    void ToddCoxeter::prefill(FroidurePinBase& S) {
-      REPORT_DEBUG_DEFAULT("prefilling the coset table from FroidurePin...\n");
-      LIBSEMIGROUPS_ASSERT(_state == state::constructed);
-      LIBSEMIGROUPS_ASSERT(
-          _settings->froidure_pin == options::froidure_pin::use_cayley_graph
-          || _settings->froidure_pin == options::froidure_pin::none);
+    // Computes the congruence generated by the generating pairs on the parent
+    // FroidurePin by tracing them through its Cayley graph and taking the
+    // closure of the resulting coincidences using union-find. Since the
+    // Cayley graph is complete, this requires neither a copy of the Cayley
+    // graph nor any preimages, and only the coset table of the quotient is
+    // constructed.
+    void ToddCoxeter::enumerate_cayley_graph() {
+      REPORT_DEFAULT("tracing pairs through the Cayley graph...\n");
+      detail::Timer tmr;
+      LIBSEMIGROUPS_ASSERT(_state == state::initialized);
+      LIBSEMIGROUPS_ASSERT(_prefilled);
+      LIBSEMIGROUPS_ASSERT(number_of_cosets_active() == 1);
+
+      FroidurePinBase& S = *parent_froidure_pin();
       LIBSEMIGROUPS_ASSERT(S.number_of_generators() == number_of_generators());
-      if (kind() == congruence_kind::left) {
-        prefill_and_validate(S.left_cayley_graph(), false);
-      } else {
-        prefill_and_validate(S.right_cayley_graph(), false);
+      auto const& graph = (kind() == congruence_kind::left
+                               ? S.left_cayley_graph()
+                               : S.right_cayley_graph());
+      size_t const n = number_of_generators();
+      // Node 0 is the identity coset, and node i + 1 is element i of S.
+      size_t const N = S.size() + 1;
+
+      auto target = [&S, &graph](coset_type c, letter_type x) -> coset_type {
+        return (c == 0 ? S.current_position(x) : graph.get(c - 1, x)) + 1;
+      };
+      auto tau = [&target](coset_type c, word_type const& w) -> coset_type {
+        for (auto const& x : w) {
+          c = target(c, x);
+        }
+        return c;
+      };
+
+      detail::Duf<>           uf(N);
+      std::vector<Coincidence> stck;
+      auto                     process = [&uf, &stck, &target, &n]() {
+        while (!stck.empty()) {
+          coset_type c = uf.find(stck.back().first);
+          coset_type d = uf.find(stck.back().second);
+          stck.pop_back();
+          if (c != d) {
+            uf.unite(c, d);
+            for (letter_type x = 0; x < n; ++x) {
+              stck.emplace_back(target(c, x), target(d, x));
+            }
+          }
+        }
+      };
+
+      for (auto it = _extra.cbegin(); it < _extra.cend(); it += 2) {
+        stck.emplace_back(tau(_id_coset, *it), tau(_id_coset, *(it + 1)));
+      }
+      process();
+      if (!_relations.empty()) {
+        for (coset_type c = 0; c < N && !stopped(); ++c) {
+          for (auto it = _relations.cbegin(); it < _relations.cend();
+               it += 2) {
+            stck.emplace_back(tau(c, *it), tau(c, *(it + 1)));
+          }
+          process();
+        }
       }
-      for (size_t i = 0; i < number_of_generators(); i++) {
-        _table.set(0, i, S.current_position(i) + 1);
+      if (stopped()) {
+        // Nothing has been written to the coset table yet, and so the next
+        // call to run_impl starts tracing the pairs again from scratch.
+        report_why_we_stopped();
+        return;
+      }
+
+      // Number the classes in order of their least element, and construct
+      // the coset table of the quotient.
+      std::vector<coset_type> lookup(N, static_cast<coset_type>(UNDEFINED));
+      coset_type              next = 0;
+      for (coset_type c = 0; c < N; ++c) {
+        coset_type const r = uf.find(c);
+        if (lookup[r] == UNDEFINED) {
+          lookup[r] = next++;
+        }
+      }
+      reserve(next);
+      add_active_cosets(next - number_of_cosets_active());
+      for (coset_type c = 0; c < N; ++c) {
+        coset_type const r = lookup[uf.find(c)];
+        if (_table.get(r, 0) == UNDEFINED) {
+          for (letter_type x = 0; x < n; ++x) {
+            _table.set(r, x, lookup[uf.find(target(c, x))]);
+          }
+        }
       }
       init_preimages_from_table();
+      _state = state::finished;
+      TODD_COXETER_REPORT_COSETS();
+      REPORT_TIME(tmr);
     }
 
     void ToddCoxeter::prefill_and_validate(table_type const& table,
@@ -1039,6 +1225,7 @@ namespace libsemigroups {
       add_active_cosets(m - number_of_cosets_active());
       _preim_init.add_rows(m - _preim_init.number_of_rows());
       _preim_next.add_rows(m - _preim_next.number_of_rows());
+      update_memory_usage(memory_in_tables());
     }
 
     void
@@ -1069,6 +1256,14 @@ namespace libsemigroups {
       }
     }
 
+    size_t ToddCoxeter::memory_in_tables() const noexcept {
+      // The coset table, the two tables of preimages, and the 3 lists used by
+      // CosetManager to store the cosets.
+      return sizeof(coset_type) * coset_capacity()
+             * (_table.number_of_cols() + _preim_init.number_of_cols()
+                + _preim_next.number_of_cols() + 3);
+    }
+
     void ToddCoxeter::remove_preimage(coset_type  cx,
                                       letter_type x,
                                       coset_type  d) {
@@ -1166,6 +1361,9 @@ namespace libsemigroups {
         _current = _id_coset;
       }
       _state = state::felsch;
+      // The number of cosets processed in this call, used to estimate the
+      // proportion of the active cosets that have been processed.
+      size_t nr_done = 0;
       while (_current != first_free_coset() && !stopped()) {
         for (letter_type a = 0; a < n; ++a) {
           if (_table.get(_current, a) == UNDEFINED) {
@@ -1184,6 +1382,8 @@ namespace libsemigroups {
         if (report()) {
           TODD_COXETER_REPORT_COSETS()
         }
+        update_progress(static_cast<double>(++nr_done)
+                        / number_of_cosets_active());
         _current = next_active_coset(_current);
       }
       LIBSEMIGROUPS_ASSERT(_coinc.empty());
@@ -1235,6 +1435,7 @@ namespace libsemigroups {
         init_felsch_tree();
       }
       // size_t const n = number_of_generators();
+      size_t nr_done = 0;  // see felsch
       while (_current != first_free_coset() && !stopped()) {
         if (!_settings->save) {
           for (auto it = _relations.cbegin(); it < _relations.cend(); it += 2) {
@@ -1272,6 +1473,8 @@ namespace libsemigroups {
         if (report()) {
           TODD_COXETER_REPORT_COSETS()
         }
+        update_progress(static_cast<double>(++nr_done)
+                        / number_of_cosets_active());
         _current = next_active_coset(_current);
       }
       LIBSEMIGROUPS_ASSERT(_coinc.empty());
@@ -1290,10 +1493,7 @@ namespace libsemigroups {
     // are already accounted for in the above.
     void ToddCoxeter::sims() {
       REPORT_DEFAULT("performing random Sims' TEN_CE strategy...\n");
-      using int_dist_type
-          = std::uniform_int_distribution<std::mt19937::result_type>;
-      static int_dist_type dist(0, 9);
-      static std::mt19937  mt;
+      std::uniform_int_distribution<size_t> dist(0, 9);
 
       static constexpr std::array<bool, 8> full
           = {true, true, true, true, false, false, false, false};
@@ -1311,7 +1511,7 @@ namespace libsemigroups {
       _settings->enable_debug_verify_no_missing_deductions = false;
 #endif
       while (!finished()) {
-        size_t m = dist(mt);
+        size_t m = dist(_settings->mt);
         if (m < 8) {
           strategy(options::strategy::hlt);
           lookahead((full[m] ? options::lookahead::full
@@ -18,9 +18,12 @@
 // TODO(later):
 // 1. add examples from Action
 
-#include <algorithm>  // for sort
-#include <cstdint>    // for uint8_t
+#include <algorithm>  // for equal, find, sort
+#include <cstdint>    // for uint8_t, uint32_t
+#include <iterator>   // for distance
+#include <memory>     // for make_unique
 #include <stdexcept>  // for out_of_range
+#include <utility>    // for move, swap
 #include <vector>     // for vector
 
 #include "libsemigroups/action.hpp"  // for LeftAction, RightAction
@@ -696,4 +699,177 @@ namespace libsemigroups {
       "[standard][no-valgrind]") {
     test000<BMat<5>>();
   }
+
+  LIBSEMIGROUPS_TEST_CASE("Action",
+                          "022",
+                          "orbit of a 2-set under Transf<> of degree 100",
+                          "[quick]") {
+    auto rg = ReportGuard(REPORT);
+    using bitset_type = BitSet<128>;
+    RightAction<Transf<>, bitset_type, ImageRightAction<Transf<>, bitset_type>>
+        o;
+
+    std::vector<uint32_t> cycle(100), transp(100), collapse(100);
+    for (size_t i = 0; i < 100; ++i) {
+      cycle[i]    = (i + 1) % 100;
+      transp[i]   = i;
+      collapse[i] = i;
+    }
+    std::swap(transp[0], transp[1]);
+    collapse[0] = 1;
+    o.add_generator(Transf<>::make(cycle));
+    o.add_generator(Transf<>::make(transp));
+    o.add_generator(Transf<>::make(collapse));
+
+    bitset_type seed;
+    seed.set(0);
+    seed.set(1);
+    o.add_seed(seed);
+    // All subsets of size 1 and 2
+    REQUIRE(o.size() == 5050);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Action",
+                          "023",
+                          "points are numbered as if found one at a time",
+                          "[quick]") {
+    auto rg    = ReportGuard(REPORT);
+    using Perm = LeastPerm<10>;
+    using Pt   = std::vector<uint8_t>;
+    RightAction<Perm, Pt, OnTuples<Perm, uint8_t, Pt>> o;
+    std::vector<Perm> gens = {Perm({1, 0, 2, 3, 4, 5, 6, 7, 8, 9}),
+                              Perm({1, 2, 3, 4, 5, 6, 7, 8, 9, 0}),
+                              Perm({0, 1, 2, 4, 3, 5, 6, 7, 8, 9})};
+    o.add_seed({0, 1, 2});
+    for (auto const& x : gens) {
+      o.add_generator(x);
+    }
+    REQUIRE(o.size() == 720);
+
+    // Breadth first search, one point and one generator at a time
+    std::vector<Pt> expected = {{0, 1, 2}};
+    for (size_t i = 0; i < expected.size(); ++i) {
+      for (size_t j = 0; j < gens.size(); ++j) {
+        Pt pt = expected[i];
+        for (auto& x : pt) {
+          x = gens[j][x];
+        }
+        auto it = std::find(expected.cbegin(), expected.cend(), pt);
+        REQUIRE(o.digraph().neighbor(i, j)
+                == size_t(std::distance(expected.cbegin(), it)));
+        if (it == expected.cend()) {
+          expected.push_back(pt);
+        }
+      }
+    }
+    REQUIRE(std::vector<Pt>(o.cbegin(), o.cend()) == expected);
+    for (size_t i = 0; i < expected.size(); ++i) {
+      REQUIRE(o.position(expected[i]) == i);
+    }
+    REQUIRE(o.position(Pt({0, 0, 0})) == UNDEFINED);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Action", "024", "copy and move", "[quick]") {
+    auto rg = ReportGuard(REPORT);
+    using action_type
+        = RightAction<PPerm<>, PPerm<>, ImageRightAction<PPerm<>, PPerm<>>>;
+    auto o = std::make_unique<action_type>();
+    o->add_seed(PPerm<>::identity(5));
+    o->add_generator(PPerm<>({0, 1, 2, 3, 4}, {1, 2, 3, 4, 0}, 5));
+    o->add_generator(PPerm<>({0, 1, 2, 3, 4}, {1, 0, 2, 3, 4}, 5));
+    o->add_generator(PPerm<>({1, 2, 3, 4}, {0, 1, 2, 3}, 5));
+    o->run_until([&o]() { return o->current_size() > 4; });
+    REQUIRE(!o->finished());
+
+    action_type copy(*o);
+    REQUIRE(copy.current_size() == o->current_size());
+    REQUIRE(std::equal(copy.cbegin(), copy.cend(), o->cbegin()));
+    action_type moved(std::move(*o));
+    REQUIRE(moved.current_size() == copy.current_size());
+    o.reset();
+
+    REQUIRE(copy.size() == 32);
+    REQUIRE(moved.size() == 32);
+    REQUIRE(std::equal(copy.cbegin(), copy.cend(), moved.cbegin()));
+    REQUIRE(copy.position(PPerm<>::identity(5)) == 0);
+
+    action_type copy2(copy);
+    REQUIRE(copy2.size() == 32);
+    REQUIRE(copy2.finished());
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Action",
+                          "025",
+                          "multipliers with and without caching",
+                          "[quick]") {
+    auto rg = ReportGuard(REPORT);
+    using action_type
+        = RightAction<PPerm<>, PPerm<>, ImageRightAction<PPerm<>, PPerm<>>>;
+    action_type o;
+    o.add_seed(PPerm<>::identity(6));
+    o.add_generator(PPerm<>({0, 1, 2, 3, 4, 5}, {1, 2, 3, 4, 5, 0}, 6));
+    o.add_generator(PPerm<>({0, 1, 2, 3, 4, 5}, {1, 0, 2, 3, 4, 5}, 6));
+    o.add_generator(PPerm<>({1, 2, 3, 4, 5}, {0, 1, 2, 3, 4}, 6));
+    REQUIRE(o.size() == 64);
+    REQUIRE(!o.cache_scc_multipliers());
+    REQUIRE(o.digraph().spanning_forest().has_ancestor_table());
+    REQUIRE(o.digraph().reverse_spanning_forest().has_ancestor_table());
+
+    std::vector<PPerm<>> from, to;
+    for (size_t i = 0; i < o.size(); ++i) {
+      from.push_back(o.multiplier_from_scc_root(i));
+      to.push_back(o.multiplier_to_scc_root(i));
+    }
+    o.cache_scc_multipliers(true);
+    PPerm<> x(6);
+    for (size_t i = 0; i < o.size(); ++i) {
+      REQUIRE(o.multiplier_from_scc_root(i) == from[i]);
+      REQUIRE(o.multiplier_to_scc_root(i) == to[i]);
+      ImageRightAction<PPerm<>, PPerm<>>()(x, o.root_of_scc(i), from[i]);
+      REQUIRE(x == o.at(i));
+      ImageRightAction<PPerm<>, PPerm<>>()(x, o.at(i), to[i]);
+      REQUIRE(x == o.root_of_scc(i));
+    }
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Action",
+                          "026",
+                          "points of fixed and varying size",
+                          "[quick]") {
+    auto rg    = ReportGuard(REPORT);
+    using Perm = LeastPerm<10>;
+
+    RightAction<Perm, std::vector<uint8_t>, OnTuples<Perm, uint8_t>> o;
+    o.add_seed({0, 1, 2});
+    o.add_generator(Perm({1, 0, 2, 3, 4, 5, 6, 7, 8, 9}));
+    o.add_generator(Perm({1, 2, 3, 4, 5, 6, 7, 8, 9, 0}));
+    REQUIRE(o.size() == 720);
+    for (size_t i = 0; i < o.size(); ++i) {
+      REQUIRE(o.position(o[i]) == i);
+    }
+    REQUIRE(o.position({9, 8, 7}) != UNDEFINED);
+    REQUIRE(o.position({9, 9, 7}) == UNDEFINED);
+    REQUIRE(o.position({0, 1}) == UNDEFINED);
+    REQUIRE(o.position({0, 1, 2, 3}) == UNDEFINED);
+
+    auto copy(o);
+    REQUIRE(copy.position({9, 8, 7}) == o.position({9, 8, 7}));
+
+    // The image sets of a transformation have different sizes
+    using Transf = LeastTransf<5>;
+    RightAction<Transf,
+                std::vector<uint8_t>,
+                ImageRightAction<Transf, std::vector<uint8_t>>>
+        p;
+    p.add_seed({0, 1, 2, 3, 4});
+    p.add_generator(Transf({1, 0, 2, 3, 4}));
+    p.add_generator(Transf({1, 2, 3, 4, 0}));
+    p.add_generator(Transf({0, 0, 2, 3, 4}));
+    REQUIRE(p.size() == 31);
+    for (size_t i = 0; i < p.size(); ++i) {
+      REQUIRE(p.position(p[i]) == i);
+    }
+    REQUIRE(p.position({0, 4}) != UNDEFINED);
+    REQUIRE(p.position({0, 0}) == UNDEFINED);
+  }
 }  // namespace libsemigroups
@@ -0,0 +1,126 @@
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <string>  // for string
+
+#include "catch.hpp"      // for REQUIRE, REQUIRE_NOTHROW, REQUIRE_THROWS_AS
+#include "test-main.hpp"  // for LIBSEMIGROUPS_TEST_CASE
+
+#include "libsemigroups/automatic.hpp"  // for AutomaticGroup
+#include "libsemigroups/constants.hpp"  // for POSITIVE_INFINITY
+#include "libsemigroups/report.hpp"     // for ReportGuard
+
+namespace libsemigroups {
+  struct LibsemigroupsException;
+  constexpr bool REPORT = false;
+
+  namespace fpsemigroup {
+    LIBSEMIGROUPS_TEST_CASE("AutomaticGroup",
+                            "000",
+                            "free group of rank 2",
+                            "[quick][automatic][fpsemigroup]") {
+      auto           rg = ReportGuard(REPORT);
+      AutomaticGroup ag;
+      ag.set_alphabet("aAbB");
+      ag.set_identity("");
+      ag.set_inverses("AaBb");
+      REQUIRE(ag.size() == POSITIVE_INFINITY);
+      REQUIRE(ag.finished());
+      REQUIRE(ag.number_of_normal_forms(0, 4) == 53);
+      REQUIRE(ag.word_acceptor().number_of_nodes() == 5);
+      REQUIRE(ag.normal_form("aAbBBbab") == "ab");
+      REQUIRE(ag.equal_to("abAB", "abBbAaAB"));
+      REQUIRE(!ag.equal_to("abAB", "baBA"));
+      REQUIRE(ag.is_obviously_infinite());
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("AutomaticGroup",
+                            "001",
+                            "free abelian group of rank 2",
+                            "[quick][automatic][fpsemigroup]") {
+      auto           rg = ReportGuard(REPORT);
+      AutomaticGroup ag;
+      ag.set_alphabet("aAbB");
+      ag.set_identity("");
+      ag.set_inverses("AaBb");
+      ag.add_rule("ba", "ab");
+      REQUIRE(ag.size() == POSITIVE_INFINITY);
+      REQUIRE(ag.number_of_normal_forms(0, 5) == 41);
+      REQUIRE(ag.normal_form("bAbaB") == "b");
+      REQUIRE(ag.normal_form("BaBAbaab") == "aa");
+      REQUIRE(ag.equal_to("abAB", ""));
+      REQUIRE(ag.equal_to("bbA", "Abb"));
+      REQUIRE(ag.multiplier_accepts("ab", "abb", "b"));
+      REQUIRE(ag.multiplier_accepts("ab", "aab", "a"));
+      REQUIRE(!ag.multiplier_accepts("ab", "aab", "b"));
+      REQUIRE(ag.multiplier_accepts("ab", "ab", ""));
+      REQUIRE_THROWS_AS(ag.multiplier_accepts("ab", "ab", "ab"),
+                        LibsemigroupsException);
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("AutomaticGroup",
+                            "002",
+                            "symmetric group of degree 3",
+                            "[quick][automatic][fpsemigroup]") {
+      auto           rg = ReportGuard(REPORT);
+      AutomaticGroup ag;
+      ag.set_alphabet("abB");
+      ag.set_identity("");
+      ag.set_inverses("aBb");
+      ag.add_rule("aa", "");
+      ag.add_rule("bbb", "");
+      ag.add_rule("abab", "");
+      REQUIRE(ag.size() == 6);
+      REQUIRE(ag.number_of_normal_forms(0, 2) == 4);
+      REQUIRE(ag.equal_to("ab", "Ba"));
+      REQUIRE(ag.is_obviously_finite());
+      REQUIRE(ag.froidure_pin()->size() == 6);
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("AutomaticGroup",
+                            "003",
+                            "braid group on 3 strands",
+                            "[quick][automatic][fpsemigroup]") {
+      auto           rg = ReportGuard(REPORT);
+      AutomaticGroup ag;
+      ag.set_alphabet("aAbB");
+      ag.set_identity("");
+      ag.set_inverses("AaBb");
+      ag.add_rule("bab", "aba");
+      REQUIRE(ag.size() == POSITIVE_INFINITY);
+      REQUIRE(!ag.knuth_bendix().confluent());
+      REQUIRE(ag.number_of_normal_forms(0, 3) == 17);
+      REQUIRE(ag.number_of_normal_forms(0, 7) == 577);
+      REQUIRE(ag.equal_to("abaBAB", ""));
+      REQUIRE(!ag.equal_to("ab", "ba"));
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("AutomaticGroup",
+                            "004",
+                            "exceptions",
+                            "[quick][automatic][fpsemigroup]") {
+      auto           rg = ReportGuard(REPORT);
+      AutomaticGroup ag;
+      ag.set_alphabet("aAbB");
+      REQUIRE_THROWS_AS(ag.set_identity("a"), LibsemigroupsException);
+      REQUIRE_THROWS_AS(ag.max_rules(0), LibsemigroupsException);
+      REQUIRE_THROWS_AS(ag.run(), LibsemigroupsException);
+      ag.set_identity("");
+      REQUIRE_THROWS_AS(ag.run(), LibsemigroupsException);
+    }
+  }  // namespace fpsemigroup
+}  // namespace libsemigroups
@@ -0,0 +1,257 @@
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>  // for equal
+#include <array>      // for array
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint8_t, uint32_t
+#include <cstdio>     // for remove
+#include <fstream>    // for fstream, ifstream, ofstream
+#include <iterator>   // for istreambuf_iterator
+#include <string>     // for string
+#include <vector>     // for vector
+
+#include "catch.hpp"      // for REQUIRE, REQUIRE_THROWS_AS
+#include "test-main.hpp"  // for LIBSEMIGROUPS_TEST_CASE
+
+#include "libsemigroups/action.hpp"        // for RightAction
+#include "libsemigroups/binary.hpp"        // for MappedFile, write_file
+#include "libsemigroups/digraph.hpp"       // for ActionDigraph
+#include "libsemigroups/forest.hpp"        // for Forest
+#include "libsemigroups/froidure-pin.hpp"  // for FroidurePin
+#include "libsemigroups/report.hpp"        // for ReportGuard
+#include "libsemigroups/todd-coxeter.hpp"  // for ToddCoxeter
+#include "libsemigroups/transf.hpp"        // for Transf<>, LeastPerm
+
+namespace libsemigroups {
+  struct LibsemigroupsException;
+  constexpr bool REPORT = false;
+
+  congruence_kind constexpr twosided = congruence_kind::twosided;
+
+  using binary::MappedFile;
+
+  LIBSEMIGROUPS_TEST_CASE("binary",
+                          "000",
+                          "ActionDigraph round trip",
+                          "[quick]") {
+    std::string const fnam = "test-binary-000.bin";
+    auto              ad   = ActionDigraph<uint32_t>::random(1000, 5, 2000);
+    binary::write_file(fnam, ad);
+    {
+      MappedFile file(fnam);
+      REQUIRE(file.kind() == binary::kind::digraph);
+      REQUIRE(file.value_size() == sizeof(uint32_t));
+      REQUIRE(file.number_of_rows() == 1000);
+      REQUIRE(file.number_of_cols() == 5);
+
+      binary::TableView<uint32_t> view(file);
+      for (uint32_t i = 0; i < ad.number_of_nodes(); ++i) {
+        REQUIRE(std::vector<uint32_t>(view.cbegin_row(i), view.cend_row(i))
+                == std::vector<uint32_t>(ad.cbegin_edges(i),
+                                         ad.cend_edges(i)));
+      }
+      auto copy = binary::read_action_digraph<uint32_t>(file);
+      REQUIRE(copy.number_of_nodes() == ad.number_of_nodes());
+      REQUIRE(copy.out_degree() == ad.out_degree());
+      REQUIRE(copy.number_of_edges() == ad.number_of_edges());
+      for (uint32_t i = 0; i < ad.number_of_nodes(); ++i) {
+        REQUIRE(std::equal(
+            ad.cbegin_edges(i), ad.cend_edges(i), copy.cbegin_edges(i)));
+      }
+      REQUIRE_THROWS_AS(binary::read_action_digraph<uint64_t>(file),
+                        LibsemigroupsException);
+      REQUIRE_THROWS_AS(binary::read_points<uint32_t>(file),
+                        LibsemigroupsException);
+    }
+    std::remove(fnam.c_str());
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("binary",
+                          "001",
+                          "prefill ToddCoxeter from a Cayley graph",
+                          "[quick]") {
+    auto                  rg   = ReportGuard(REPORT);
+    std::string const     fnam = "test-binary-001.bin";
+    FroidurePin<Transf<>> S;
+    S.add_generator(Transf<>({1, 0, 2, 3, 4}));
+    S.add_generator(Transf<>({1, 2, 3, 4, 0}));
+    S.add_generator(Transf<>({0, 0, 2, 3, 4}));
+    REQUIRE(S.size() == 3125);
+    binary::write_file(fnam, S.right_cayley_graph());
+    {
+      MappedFile file(fnam);
+      REQUIRE(file.kind() == binary::kind::table);
+      auto table = binary::read_table<size_t>(file);
+      REQUIRE(table == S.right_cayley_graph());
+
+      congruence::ToddCoxeter tc(twosided);
+      tc.set_number_of_generators(3);
+      tc.prefill(table);
+      REQUIRE(tc.number_of_classes() == 3125);
+    }
+    std::remove(fnam.c_str());
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("binary",
+                          "002",
+                          "Forest and orbit round trip",
+                          "[quick]") {
+    auto              rg   = ReportGuard(REPORT);
+    std::string const fnam = "test-binary-002.bin";
+    {
+      Forest f(100);
+      for (size_t i = 1; i < 100; ++i) {
+        f.set(i, i / 2, i % 3);
+      }
+      binary::write_file(fnam, f);
+      MappedFile file(fnam);
+      auto       g = binary::read_forest(file);
+      REQUIRE(g.number_of_nodes() == 100);
+      REQUIRE(g.parent(0) == UNDEFINED);
+      for (size_t i = 1; i < 100; ++i) {
+        REQUIRE(g.parent(i) == i / 2);
+        REQUIRE(g.label(i) == i % 3);
+      }
+    }
+    {
+      using Perm  = LeastPerm<8>;
+      using point = std::array<uint8_t, 3>;
+      RightAction<Perm, point, OnTuples<Perm, uint8_t, point>> o;
+      o.add_seed({0, 1, 2});
+      o.add_generator(Perm({1, 0, 2, 3, 4, 5, 6, 7}));
+      o.add_generator(Perm({1, 2, 3, 4, 5, 6, 7, 0}));
+      REQUIRE(o.size() == 336);
+
+      std::ofstream os(fnam, std::ios::out | std::ios::binary);
+      binary::write_points(os, o.cbegin(), o.cend());
+      os.close();
+
+      MappedFile                file(fnam);
+      binary::PointsView<point> view(file);
+      REQUIRE(view.size() == 336);
+      REQUIRE(std::vector<point>(view.cbegin(), view.cend())
+              == std::vector<point>(o.cbegin(), o.cend()));
+      REQUIRE(binary::read_points<point>(file)
+              == std::vector<point>(o.cbegin(), o.cend()));
+      REQUIRE_THROWS_AS(binary::read_forest(file), LibsemigroupsException);
+    }
+    std::remove(fnam.c_str());
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("binary",
+                          "003",
+                          "corrupt, truncated, and missing files",
+                          "[quick]") {
+    std::string const fnam = "test-binary-003.bin";
+    REQUIRE_THROWS_AS(MappedFile(fnam), LibsemigroupsException);
+
+    std::vector<uint32_t> v(1000);
+    for (size_t i = 0; i < v.size(); ++i) {
+      v[i] = i * i;
+    }
+    binary::write_file(fnam, v);
+    REQUIRE(binary::read_points<uint32_t>(MappedFile(fnam)) == v);
+    {
+      // Change one bit of the last point
+      std::fstream fs(fnam, std::ios::in | std::ios::out | std::ios::binary);
+      fs.seekg(-1, std::ios::end);
+      char const c = fs.get();
+      fs.seekp(-1, std::ios::end);
+      fs.put(c ^ 1);
+    }
+    REQUIRE_THROWS_AS(MappedFile(fnam), LibsemigroupsException);
+    REQUIRE_NOTHROW(MappedFile(fnam, false));
+    REQUIRE(!MappedFile(fnam, false).verify_checksum());
+    {
+      std::ofstream os(fnam, std::ios::out | std::ios::binary);
+      binary::write(os, v);
+      // Truncate the file
+      os.close();
+      std::ifstream is(fnam, std::ios::in | std::ios::binary);
+      std::string   contents((std::istreambuf_iterator<char>(is)),
+                           std::istreambuf_iterator<char>());
+      is.close();
+      std::ofstream os2(fnam, std::ios::out | std::ios::binary);
+      os2.write(contents.data(), contents.size() - 4);
+    }
+    REQUIRE_THROWS_AS(MappedFile(fnam), LibsemigroupsException);
+    {
+      std::ofstream os(fnam, std::ios::out | std::ios::binary);
+      os << std::string(100, 'a');
+    }
+    REQUIRE_THROWS_AS(MappedFile(fnam), LibsemigroupsException);
+    std::remove(fnam.c_str());
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("binary",
+                          "004",
+                          "overflowing headers and corrupt forests",
+                          "[quick]") {
+    std::string const fnam = "test-binary-004.bin";
+    // Overwrite the 8 bytes at offset pos in the file fnam by val.
+    auto patch = [&fnam](std::streamoff pos, uint64_t val) {
+      std::fstream fs(fnam, std::ios::in | std::ios::out | std::ios::binary);
+      fs.seekp(pos);
+      fs.write(reinterpret_cast<char const*>(&val), sizeof(val));
+    };
+    std::vector<uint32_t> v(1000, 1);
+    binary::write_file(fnam, v);
+    REQUIRE_NOTHROW(MappedFile(fnam));
+    // The number of rows is at offset 24 and the payload size at offset 40 in
+    // the header, 2 ^ 62 rows of 4 bytes each overflows to 0.
+    patch(24, uint64_t(1) << 62);
+    patch(40, 0);
+    REQUIRE_THROWS_AS(MappedFile(fnam, false), LibsemigroupsException);
+
+    Forest f(10);
+    for (size_t i = 1; i < 10; ++i) {
+      f.set(i, i - 1, 0);
+    }
+    binary::write_file(fnam, f);
+    REQUIRE(binary::read_forest(MappedFile(fnam)).parent(9) == 8);
+    // The data starts at offset 64, and the parent of node 9 at offset 208.
+    patch(64 + 2 * 9 * sizeof(size_t), 10);
+    REQUIRE_THROWS_AS(binary::read_forest(MappedFile(fnam, false)),
+                      LibsemigroupsException);
+    patch(64 + 2 * 9 * sizeof(size_t), 8);
+    REQUIRE_NOTHROW(binary::read_forest(MappedFile(fnam, false)));
+    patch(64 + (2 * 9 + 1) * sizeof(size_t), UNDEFINED);
+    REQUIRE_THROWS_AS(binary::read_forest(MappedFile(fnam, false)),
+                      LibsemigroupsException);
+    patch(64 + (2 * 9 + 1) * sizeof(size_t), 0);
+    patch(64 + sizeof(size_t), 0);
+    REQUIRE_THROWS_AS(binary::read_forest(MappedFile(fnam, false)),
+                      LibsemigroupsException);
+    // The node 0 is its own parent
+    patch(64, 0);
+    REQUIRE_THROWS_AS(binary::read_forest(MappedFile(fnam, false)),
+                      LibsemigroupsException);
+    // The nodes 0, 1, ..., 9 form a cycle
+    patch(64, 9);
+    REQUIRE_THROWS_AS(binary::read_forest(MappedFile(fnam, false)),
+                      LibsemigroupsException);
+    // The nodes 5, 6, ..., 9 form a cycle, and 0 is a root
+    patch(64, UNDEFINED);
+    patch(64 + sizeof(size_t), UNDEFINED);
+    REQUIRE_NOTHROW(binary::read_forest(MappedFile(fnam, false)));
+    patch(64 + 2 * 5 * sizeof(size_t), 9);
+    REQUIRE_THROWS_AS(binary::read_forest(MappedFile(fnam, false)),
+                      LibsemigroupsException);
+    std::remove(fnam.c_str());
+  }
+}  // namespace libsemigroups
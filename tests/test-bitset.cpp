@@ -16,8 +16,13 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <functional>  // for hash
+#include <utility>     // for move
+#include <vector>      // for vector
+
 #include "catch.hpp"                 // for REQUIRE
 #include "libsemigroups/bitset.hpp"  // for BitSet
+#include "libsemigroups/matrix.hpp"  // for BMat, bitset_row_basis
 #include "test-main.hpp"             // for LIBSEMIGROUPS_TEST_CASE
 
 namespace libsemigroups {
@@ -39,6 +44,9 @@ namespace libsemigroups {
     test_bitset_000<40>();
     test_bitset_000<64>();
 #endif
+    test_bitset_000<100>();
+    test_bitset_000<128>();
+    test_bitset_000<1024>();
   }
 
   template <size_t N>
@@ -63,6 +71,9 @@ namespace libsemigroups {
     test_bitset_001<40>();
     test_bitset_001<64>();
 #endif
+    test_bitset_001<100>();
+    test_bitset_001<128>();
+    test_bitset_001<1024>();
   }
 
   template <size_t N>
@@ -89,6 +100,9 @@ namespace libsemigroups {
     test_bitset_002<40>();
     test_bitset_002<64>();
 #endif
+    test_bitset_002<100>();
+    test_bitset_002<128>();
+    test_bitset_002<1024>();
   }
 
   template <size_t N>
@@ -115,6 +129,9 @@ namespace libsemigroups {
     test_bitset_003<40>();
     test_bitset_003<64>();
 #endif
+    test_bitset_003<100>();
+    test_bitset_003<128>();
+    test_bitset_003<1024>();
   }
 
   template <size_t N>
@@ -143,6 +160,9 @@ namespace libsemigroups {
     test_bitset_004<40>();
     test_bitset_004<64>();
 #endif
+    test_bitset_004<100>();
+    test_bitset_004<128>();
+    test_bitset_004<1024>();
   }
 
   template <size_t N>
@@ -173,6 +193,9 @@ namespace libsemigroups {
     test_bitset_005<40>();
     test_bitset_005<64>();
 #endif
+    test_bitset_005<100>();
+    test_bitset_005<128>();
+    test_bitset_005<1024>();
   }
 
   template <size_t N>
@@ -203,6 +226,9 @@ namespace libsemigroups {
     test_bitset_006<40>();
     test_bitset_006<64>();
 #endif
+    test_bitset_006<100>();
+    test_bitset_006<128>();
+    test_bitset_006<1024>();
   }
 
   template <size_t N>
@@ -231,6 +257,9 @@ namespace libsemigroups {
     test_bitset_007<40>();
     test_bitset_007<64>();
 #endif
+    test_bitset_007<100>();
+    test_bitset_007<128>();
+    test_bitset_007<1024>();
   }
 
   template <size_t N>
@@ -257,6 +286,9 @@ namespace libsemigroups {
     test_bitset_008<40>();
     test_bitset_008<64>();
 #endif
+    test_bitset_008<100>();
+    test_bitset_008<128>();
+    test_bitset_008<1024>();
   }
 
   template <size_t N>
@@ -287,6 +319,9 @@ namespace libsemigroups {
     test_bitset_009<40>();
     test_bitset_009<64>();
 #endif
+    test_bitset_009<100>();
+    test_bitset_009<128>();
+    test_bitset_009<1024>();
   }
 
   template <size_t N>
@@ -319,6 +354,9 @@ namespace libsemigroups {
     test_bitset_010<40>();
     test_bitset_010<64>();
 #endif
+    test_bitset_010<100>();
+    test_bitset_010<128>();
+    test_bitset_010<1024>();
   }
 
   template <size_t N>
@@ -351,6 +389,9 @@ namespace libsemigroups {
     test_bitset_011<40>();
     test_bitset_011<64>();
 #endif
+    test_bitset_011<100>();
+    test_bitset_011<128>();
+    test_bitset_011<1024>();
   }
 
   template <size_t N>
@@ -383,6 +424,9 @@ namespace libsemigroups {
     test_bitset_012<40>();
     test_bitset_012<64>();
 #endif
+    test_bitset_012<100>();
+    test_bitset_012<128>();
+    test_bitset_012<1024>();
   }
 
   template <size_t N>
@@ -424,6 +468,9 @@ namespace libsemigroups {
     test_bitset_013<40>();
     test_bitset_013<64>();
 #endif
+    test_bitset_013<100>();
+    test_bitset_013<128>();
+    test_bitset_013<1024>();
   }
 
   template <size_t N>
@@ -444,6 +491,9 @@ namespace libsemigroups {
     test_bitset_014<40>();
     test_bitset_014<64>();
 #endif
+    test_bitset_014<100>();
+    test_bitset_014<128>();
+    test_bitset_014<1024>();
   }
 
   LIBSEMIGROUPS_TEST_CASE("BitSet", "015", "constructors", "[bitset][quick]") {
@@ -548,4 +598,59 @@ namespace libsemigroups {
     std::ostream   os(&buff);
     os << bs;  // does nothing visible
   }
+
+  LIBSEMIGROUPS_TEST_CASE("BitSet",
+                          "018",
+                          "more than 64 entries",
+                          "[bitset][quick]") {
+    REQUIRE(BitSet<1024>::max_size() == 1024);
+    BitSet<130> bs1;
+    REQUIRE(bs1.count() == 0);
+    bs1.set(60, 70, true);
+    bs1.set(129);
+    REQUIRE(bs1.count() == 11);
+    REQUIRE(!bs1[59]);
+    REQUIRE(bs1[60]);
+    REQUIRE(bs1[69]);
+    REQUIRE(!bs1[70]);
+    REQUIRE(bs1[129]);
+
+    std::vector<size_t> set_bits;
+    bs1.apply([&set_bits](size_t i) { set_bits.push_back(i); });
+    REQUIRE(set_bits
+            == std::vector<size_t>(
+                {60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 129}));
+
+    BitSet<130> bs2;
+    bs2.set();
+    REQUIRE(bs2.count() == 130);
+    bs2.reset(0, 128);
+    REQUIRE(bs2.count() == 2);
+    REQUIRE(bs1 < bs2);
+    REQUIRE((bs1 & bs2).count() == 1);
+    REQUIRE((bs1 | bs2).count() == 12);
+    bs2 |= bs1;
+    REQUIRE(bs2.count() == 12);
+    bs2 &= bs1;
+    REQUIRE(bs2 == bs1);
+    REQUIRE(std::hash<BitSet<130>>()(bs1) == std::hash<BitSet<130>>()(bs2));
+    bs2.reset(129);
+    REQUIRE(bs2 != bs1);
+    REQUIRE(bs2 < bs1);
+    REQUIRE(BitSet<130>(0x15).count() == 3);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("BitSet",
+                          "019",
+                          "bitset_row_basis with more than 64 columns",
+                          "[bitset][quick]") {
+    std::vector<BitSet<100>> rows(4);
+    rows[0].set(0, 80, true);
+    rows[1].set(0, 40, true);
+    rows[2].set(40, 80, true);
+    rows[3].set(99);
+    std::vector<BitSet<100>> expected = {rows[1], rows[2], rows[3]};
+    auto result = matrix_helpers::bitset_row_basis<BMat<>>(std::move(rows));
+    REQUIRE(result == expected);
+  }
 }  // namespace libsemigroups
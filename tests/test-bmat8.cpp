@@ -17,6 +17,7 @@
 #include <cstddef>        // for size_t
 #include <cstdint>        // for uint64_t
 #include <iosfwd>         // for ostream, ostringstream, stringbuf
+#include <random>         // for mt19937
 #include <set>            // for set
 #include <unordered_set>  // for unordered_set
 #include <vector>         // for vector
@@ -712,4 +713,24 @@ namespace libsemigroups {
     REQUIRE(BMat8::one(8) == BMat8::one());
   }
 
+  LIBSEMIGROUPS_TEST_CASE("BMat8", "019", "random with a seed", "[quick]") {
+    std::mt19937 mt1(42), mt2(42);
+    for (size_t i = 0; i < 100; ++i) {
+      REQUIRE(BMat8::random(mt1) == BMat8::random(mt2));
+    }
+    for (size_t d = 1; d < 9; ++d) {
+      BMat8 bm = BMat8::random(d, mt1);
+      REQUIRE(bm == BMat8::random(d, mt2));
+      for (size_t i = d; i < 8; ++i) {
+        for (size_t j = 0; j < 8; ++j) {
+          REQUIRE(bm.get(i, j) == 0);
+          REQUIRE(bm.get(j, i) == 0);
+        }
+      }
+    }
+    REQUIRE_THROWS_AS(BMat8::random(0, mt1), LibsemigroupsException);
+    REQUIRE_THROWS_AS(BMat8::random(9, mt1), LibsemigroupsException);
+    REQUIRE(BMat8::random(mt1) == BMat8::random(mt2));
+  }
+
 }  // namespace libsemigroups
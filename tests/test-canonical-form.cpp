@@ -0,0 +1,151 @@
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <cstddef>        // for size_t
+#include <unordered_set>  // for unordered_set
+#include <vector>         // for vector
+
+#include "catch.hpp"      // for REQUIRE, REQUIRE_THROWS_AS
+#include "test-main.hpp"  // for LIBSEMIGROUPS_TEST_CASE
+
+#include "libsemigroups/canonical-form.hpp"  // for CanonicalForm
+#include "libsemigroups/froidure-pin.hpp"    // for FroidurePin
+#include "libsemigroups/report.hpp"          // for ReportGuard
+#include "libsemigroups/transf.hpp"          // for Transf<>
+
+namespace libsemigroups {
+  struct LibsemigroupsException;
+  constexpr bool REPORT = false;
+
+  namespace {
+    // Checks that the labels of the elements of S are a bijection, and that
+    // the certificate is the multiplication table of S.
+    void check_canonical_form(FroidurePinBase& S, CanonicalForm const& cf) {
+      REQUIRE(cf.size() == S.size());
+      std::vector<bool> seen(S.size(), false);
+      for (size_t x = 0; x < S.size(); ++x) {
+        REQUIRE(!seen[cf.label(x)]);
+        seen[cf.label(x)] = true;
+        for (size_t y = 0; y < S.size(); ++y) {
+          REQUIRE(cf.product(cf.label(x), cf.label(y))
+                  == cf.label(S.fast_product(x, y)));
+        }
+      }
+      for (auto const& g : cf.automorphisms()) {
+        for (size_t x = 0; x < S.size(); ++x) {
+          for (size_t y = 0; y < S.size(); ++y) {
+            REQUIRE(g[S.fast_product(x, y)] == S.fast_product(g[x], g[y]));
+          }
+        }
+      }
+    }
+
+    // Returns p ^ -1 x p.
+    Transf<> conjugate(Transf<> const& x, Transf<> const& p) {
+      Transf<> result(x);
+      for (size_t i = 0; i < x.degree(); ++i) {
+        result[p[i]] = p[x[i]];
+      }
+      return result;
+    }
+  }  // namespace
+
+  LIBSEMIGROUPS_TEST_CASE("CanonicalForm",
+                          "000",
+                          "isomorphic transformation semigroups",
+                          "[quick][canonical-form]") {
+    auto                  rg = ReportGuard(REPORT);
+    FroidurePin<Transf<>> S({Transf<>({1, 0, 2}), Transf<>({0, 0, 2})});
+    FroidurePin<Transf<>> T({Transf<>({0, 2, 1}), Transf<>({0, 1, 1})});
+    CanonicalForm         cfS(S);
+    CanonicalForm         cfT(T);
+    check_canonical_form(S, cfS);
+    check_canonical_form(T, cfT);
+    REQUIRE(cfS.size() == 4);
+    REQUIRE(cfS == cfT);
+    REQUIRE(cfS.hash_value() == cfT.hash_value());
+    REQUIRE(std::hash<CanonicalForm>()(cfS) == cfS.hash_value());
+
+    FroidurePin<Transf<>> U({Transf<>({1, 2, 3, 0}), Transf<>({0, 0, 2, 3})});
+    CanonicalForm         cfU(U);
+    check_canonical_form(U, cfU);
+    REQUIRE(cfU != cfS);
+
+    REQUIRE_THROWS_AS(cfS.label(4), LibsemigroupsException);
+    REQUIRE_THROWS_AS(cfS.product(0, 4), LibsemigroupsException);
+    REQUIRE_THROWS_AS(CanonicalForm(S, 0), LibsemigroupsException);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("CanonicalForm",
+                          "001",
+                          "conjugate generators in a different order",
+                          "[quick][canonical-form]") {
+    auto                  rg = ReportGuard(REPORT);
+    std::vector<Transf<>> gens = {Transf<>({1, 2, 0, 3, 4}),
+                                  Transf<>({0, 0, 2, 4, 3}),
+                                  Transf<>({0, 1, 2, 4, 4})};
+    std::vector<Transf<>> perms = {Transf<>({1, 2, 3, 4, 0}),
+                                   Transf<>({4, 3, 2, 1, 0}),
+                                   Transf<>({2, 0, 4, 1, 3})};
+    FroidurePin<Transf<>> S(gens);
+    CanonicalForm         cfS(S);
+    check_canonical_form(S, cfS);
+    REQUIRE(S.size() == 90);
+    // S has non-trivial automorphisms
+    REQUIRE(!cfS.automorphisms().empty());
+
+    for (auto const& p : perms) {
+      FroidurePin<Transf<>> T({conjugate(gens[2], p),
+                               conjugate(gens[1], p),
+                               conjugate(gens[0], p),
+                               conjugate(gens[1], p)});
+      REQUIRE(CanonicalForm(T) == cfS);
+      REQUIRE(CanonicalForm(T, 4) == cfS);
+    }
+    REQUIRE(CanonicalForm(S, 4) == cfS);
+    check_canonical_form(S, CanonicalForm(S, 4));
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("CanonicalForm",
+                          "002",
+                          "the 5 semigroups of size 2",
+                          "[quick][canonical-form]") {
+    auto                  rg = ReportGuard(REPORT);
+    std::vector<Transf<>> T3;
+    for (size_t i = 0; i < 27; ++i) {
+      T3.push_back(Transf<>({i % 3, (i / 3) % 3, i / 9}));
+    }
+    std::unordered_set<CanonicalForm> size2;
+    std::unordered_set<CanonicalForm> size3;
+    for (auto const& x : T3) {
+      for (auto const& y : T3) {
+        FroidurePin<Transf<>> S({x, y});
+        if (S.size() == 2) {
+          size2.insert(CanonicalForm(S));
+        } else if (S.size() == 3) {
+          CanonicalForm cf(S, 2);
+          check_canonical_form(S, cf);
+          size3.insert(std::move(cf));
+        }
+      }
+    }
+    REQUIRE(size2.size() == 5);
+    // There are 24 semigroups of size 3, up to isomorphism, but not all of
+    // them are 2-generated subsemigroups of T3.
+    REQUIRE(size3.size() <= 24);
+  }
+}  // namespace libsemigroups
@@ -17,6 +17,9 @@
 
 // The purpose of this file is to test the CongruenceInterface class.
 
+#include <algorithm>  // for equal, remove_if
+#include <vector>     // for vector
+
 #include "catch.hpp"      // for REQUIRE
 #include "test-main.hpp"  // for LIBSEMIGROUPS_TEST_CASE
 
@@ -48,12 +51,15 @@ namespace libsemigroups {
       auto rg = ReportGuard(REPORT);
 
       std::unique_ptr<CongruenceInterface> cong;
+      bool                                 incremental = false;
 
       SECTION("ToddCoxeter") {
-        cong = std::make_unique<ToddCoxeter>(twosided);
+        cong        = std::make_unique<ToddCoxeter>(twosided);
+        incremental = true;
       }
       SECTION("KnuthBendix") {
-        cong = std::make_unique<KnuthBendix>();
+        cong        = std::make_unique<KnuthBendix>();
+        incremental = true;
       }
       SECTION("CongruenceByPairs") {
         ToddCoxeter tc(twosided);
@@ -85,7 +91,12 @@ namespace libsemigroups {
       REQUIRE(cong->number_of_classes() == 27);
       REQUIRE(cong->finished());
       REQUIRE(cong->started());
-      REQUIRE_THROWS_AS(cong->add_pair({0}, {1}), LibsemigroupsException);
+      if (incremental) {
+        cong->add_pair({0}, {1});
+        REQUIRE(cong->number_of_classes() == 1);
+      } else {
+        REQUIRE_THROWS_AS(cong->add_pair({0}, {1}), LibsemigroupsException);
+      }
     }
 
     LIBSEMIGROUPS_TEST_CASE("CongruenceInterface",
@@ -578,5 +589,71 @@ namespace libsemigroups {
       REQUIRE(!cong.contains({1}, {2, 2, 2, 2, 2, 2, 2, 2, 2, 2}));
       REQUIRE(cong.number_of_classes() == 88);
     }
+
+    LIBSEMIGROUPS_TEST_CASE("CongruenceInterface",
+                            "013",
+                            "non_trivial_class_indices",
+                            "[quick][cong]") {
+      auto rg = ReportGuard(REPORT);
+      auto S  = FroidurePin<Transf<>>(
+          {Transf<>({1, 3, 4, 2, 3}), Transf<>({3, 2, 1, 3, 3})});
+      REQUIRE(S.size() == 88);
+
+      word_type const u = S.factorisation(Transf<>({3, 4, 4, 4, 4}));
+      word_type const v = S.factorisation(Transf<>({3, 1, 3, 3, 3}));
+
+      auto check = [](CongruenceInterface& cong) {
+        auto ntc = cong.non_trivial_class_indices();
+        REQUIRE(ntc == cong.non_trivial_class_indices());
+        auto fp = ntc->froidure_pin();
+        REQUIRE(fp->size() == 88);
+
+        std::vector<std::vector<size_t>> expected(cong.number_of_classes());
+        for (size_t pos = 0; pos < fp->size(); ++pos) {
+          expected[cong.word_to_class_index(fp->factorisation(pos))]
+              .push_back(pos);
+        }
+        expected.erase(std::remove_if(expected.begin(),
+                                      expected.end(),
+                                      [](std::vector<size_t> const& klass) {
+                                        return klass.size() <= 1;
+                                      }),
+                       expected.end());
+
+        REQUIRE(ntc->number_of_classes() == expected.size());
+        REQUIRE(ntc->number_of_classes()
+                == cong.number_of_non_trivial_classes());
+        size_t nr = 0;
+        for (size_t i = 0; i < ntc->number_of_classes(); ++i) {
+          REQUIRE(ntc->size(i) == expected[i].size());
+          REQUIRE(
+              std::equal(ntc->cbegin(i), ntc->cend(i), expected[i].cbegin()));
+          auto it = ntc->cbegin_words(i);
+          for (auto pos : expected[i]) {
+            REQUIRE(*it == fp->minimal_factorisation(pos));
+            ++it;
+          }
+          REQUIRE(it == ntc->cend_words(i));
+          nr += ntc->size(i);
+        }
+        REQUIRE(ntc->number_of_elements() == nr);
+        REQUIRE_THROWS_AS(ntc->size(ntc->number_of_classes()),
+                          LibsemigroupsException);
+      };
+
+      for (auto knd : {left, right, twosided}) {
+        ToddCoxeter tc(knd, S);
+        tc.add_pair(u, v);
+        check(tc);
+
+        CongruenceByPairs<FroidurePin<Transf<>>> cbp(knd, S);
+        cbp.add_pair(u, v);
+        check(cbp);
+
+        Congruence cong(knd, S);
+        cong.add_pair(u, v);
+        check(cong);
+      }
+    }
   }  // namespace congruence
 }  // namespace libsemigroups
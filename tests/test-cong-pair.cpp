@@ -1242,6 +1242,75 @@ namespace libsemigroups {
     REQUIRE(!S.finished());  // S is copied into p
   }
 
+  LIBSEMIGROUPS_TEST_CASE("CongruenceByPairs",
+                          "032",
+                          "(cong) quotient_froidure_pin",
+                          "[quick][cong][cong-pair][no-valgrind]") {
+    auto rg = ReportGuard(REPORT);
+    // Check that the words representing the elements of the parent are equal
+    // in the quotient if and only if they are in the same class.
+    auto check = [](CongruenceInterface& cong, size_t nr_classes) {
+      auto  q = cong.quotient_froidure_pin();
+      auto& S = *cong.parent_froidure_pin();
+      REQUIRE(q->size() == nr_classes);
+      REQUIRE(q->number_of_generators() == S.number_of_generators());
+      std::vector<size_t> lookup(nr_classes, static_cast<size_t>(UNDEFINED));
+      for (size_t i = 0; i < S.size(); ++i) {
+        word_type w   = S.factorisation(i);
+        size_t    c   = cong.word_to_class_index(w);
+        size_t    pos = q->current_position(w);
+        if (lookup[c] == UNDEFINED) {
+          lookup[c] = pos;
+        } else {
+          REQUIRE(lookup[c] == pos);
+        }
+      }
+      std::sort(lookup.begin(), lookup.end());
+      REQUIRE(std::unique(lookup.begin(), lookup.end()) == lookup.end());
+    };
+    {
+      FroidurePin<Transf<>> S({Transf<>({7, 3, 5, 3, 4, 2, 7, 7}),
+                               Transf<>({1, 2, 4, 4, 7, 3, 0, 7}),
+                               Transf<>({0, 6, 4, 2, 2, 6, 6, 4}),
+                               Transf<>({3, 6, 3, 4, 0, 6, 0, 7})});
+      CongruenceByPairs<decltype(S)> cong(twosided, S);
+      cong.add_pair({1, 3, 0, 1, 2, 2, 0, 2}, {1, 0, 0, 1, 3, 1});
+      check(cong, 9597);
+    }
+    {
+      // Two of the generators belong to the same class
+      FroidurePin<Transf<>> S({Transf<>({5, 3, 5, 3, 4, 2}),
+                               Transf<>({1, 2, 4, 4, 5, 3}),
+                               Transf<>({0, 5, 4, 2, 2, 4})});
+      CongruenceByPairs<decltype(S)> cong(twosided, S);
+      cong.add_pair({0}, {1});
+      check(cong, 4);
+    }
+    {
+      // The trivial congruence
+      FroidurePin<Transf<>> S({Transf<>({1, 3, 4, 2, 3}),
+                               Transf<>({3, 2, 1, 3, 3})});
+      CongruenceByPairs<decltype(S)> cong(twosided, S);
+      check(cong, 88);
+      REQUIRE(cong.quotient_froidure_pin()->number_of_rules() == 18);
+    }
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("CongruenceByPairs",
+                          "033",
+                          "(cong) quotient_froidure_pin after kill",
+                          "[quick][cong][cong-pair]") {
+    auto                  rg = ReportGuard(REPORT);
+    FroidurePin<Transf<>> S({Transf<>({1, 3, 4, 2, 3}),
+                             Transf<>({3, 2, 1, 3, 3})});
+    CongruenceByPairs<decltype(S)> cong(twosided, S);
+    cong.add_pair({0}, {1});
+    cong.kill();
+    REQUIRE(!cong.finished());
+    REQUIRE_THROWS_AS(cong.quotient_froidure_pin(), LibsemigroupsException);
+    REQUIRE(!cong.has_quotient_froidure_pin());
+  }
+
   // This test is commented out because it does not and should not compile,
   // the FpSemigroupByPairs class requires a base semigroup over which to
   // compute, in the example below there is no such base semigroup.
@@ -1622,4 +1622,109 @@ namespace libsemigroups {
   //   }
   // }
 
+  LIBSEMIGROUPS_TEST_CASE("Congruence",
+                          "047",
+                          "plan_runners",
+                          "[quick][cong]") {
+    auto rg = ReportGuard(REPORT);
+    {
+      using Transf = LeastTransf<5>;
+      FroidurePin<Transf> S({Transf({1, 3, 4, 2, 3}), Transf({3, 2, 1, 3, 3})});
+      REQUIRE(S.size() == 88);
+
+      Congruence cong(twosided, S);
+      REQUIRE(!cong.plan_runners());
+      // With 1 thread only the first runner is run, which, without planning,
+      // is ToddCoxeter using the relations of S.
+      cong.plan_runners(true).max_threads(1);
+      REQUIRE(cong.plan_runners());
+      cong.add_pair(S.factorisation(Transf({3, 4, 4, 4, 4})),
+                    S.factorisation(Transf({3, 1, 3, 3, 3})));
+      REQUIRE(cong.number_of_classes() == 21);
+      REQUIRE(cong.has_todd_coxeter());
+      REQUIRE(cong.todd_coxeter()->froidure_pin_policy()
+              == congruence::ToddCoxeter::options::froidure_pin::
+                  use_cayley_graph);
+    }
+    {
+      Congruence cong(twosided);
+      cong.set_number_of_generators(2);
+      cong.add_pair({0, 0}, {0});
+      cong.plan_runners(true).max_threads(1);
+      REQUIRE(cong.is_quotient_obviously_infinite());
+      cong.run();
+      REQUIRE(cong.finished());
+      REQUIRE(!cong.has_todd_coxeter());
+      REQUIRE(cong.has_knuth_bendix());
+      REQUIRE(cong.contains({0, 0, 0}, {0}));
+      REQUIRE(!cong.contains({1, 1}, {1}));
+    }
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Congruence",
+                          "048",
+                          "max_memory",
+                          "[quick][cong]") {
+    auto rg = ReportGuard(REPORT);
+    {
+      congruence::KnuthBendix kb;
+      kb.set_number_of_generators(2);
+      kb.add_pair({0, 0, 0}, {0});
+      kb.add_pair({1, 1}, {1});
+      kb.add_pair({0, 1, 0, 1}, {0});
+      REQUIRE(kb.memory_usage() > 0);
+      REQUIRE(kb.memory_usage() == kb.knuth_bendix().memory_usage());
+      REQUIRE(kb.number_of_classes() == 3);
+    }
+    {
+      Congruence cong(twosided);
+      REQUIRE(cong.max_memory() == static_cast<size_t>(LIMIT_MAX));
+      // The last algorithm still running is never stopped, and so setting
+      // the maximum memory to 1 byte should still give the right answer.
+      cong.max_threads(2).max_memory(1);
+      REQUIRE(cong.max_memory() == 1);
+      cong.set_number_of_generators(2);
+      cong.add_pair({0, 0, 0}, {0});
+      cong.add_pair({1, 1}, {1});
+      cong.add_pair({0, 1, 0, 1}, {0});
+      REQUIRE(cong.number_of_classes() == 3);
+    }
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Congruence",
+                          "049",
+                          "plan_runners before word_to_class_index/contains",
+                          "[quick][cong]") {
+    auto rg = ReportGuard(REPORT);
+    {
+      using Transf = LeastTransf<5>;
+      FroidurePin<Transf> S({Transf({1, 3, 4, 2, 3}), Transf({3, 2, 1, 3, 3})});
+
+      Congruence cong(twosided, S);
+      cong.plan_runners(true).max_threads(1);
+      word_type u = S.factorisation(Transf({3, 4, 4, 4, 4}));
+      word_type v = S.factorisation(Transf({3, 1, 3, 3, 3}));
+      cong.add_pair(u, v);
+      REQUIRE(cong.word_to_class_index(u) == cong.word_to_class_index(v));
+      REQUIRE(cong.has_todd_coxeter());
+      REQUIRE(cong.todd_coxeter()->froidure_pin_policy()
+              == congruence::ToddCoxeter::options::froidure_pin::
+                  use_cayley_graph);
+      REQUIRE(cong.quotient_froidure_pin()->size() == 21);
+    }
+    {
+      Congruence cong(twosided);
+      cong.set_number_of_generators(2);
+      cong.add_pair({0, 0}, {0});
+      cong.plan_runners(true).max_threads(1);
+      // Without planning, the only runner run is ToddCoxeter, which would
+      // never terminate.
+      REQUIRE(cong.word_to_class_index({0, 0, 0})
+              == cong.word_to_class_index({0}));
+      REQUIRE(!cong.has_todd_coxeter());
+      REQUIRE(cong.has_knuth_bendix());
+      REQUIRE(cong.contains({0, 0, 0}, {0}));
+      REQUIRE(!cong.contains({1, 1}, {1}));
+    }
+  }
 }  // namespace libsemigroups
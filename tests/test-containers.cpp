@@ -1521,6 +1521,46 @@ namespace libsemigroups {
       REQUIRE(da == DynamicArray2<size_t>({{0, 1, 0, 0}, {0, 0, 0, 0}}));
     }
 
+    LIBSEMIGROUPS_TEST_CASE("DynamicArray2",
+                            "044",
+                            "set_allocator",
+                            "[containers][quick]") {
+      using allocator_type = DynamicArray2<size_t>::allocator_type;
+      // 8MB, so that the policies other than standard are used
+      DynamicArray2<size_t> da(1000, 1000);
+      REQUIRE(da.get_allocator().policy() == memory_policy::standard);
+      for (size_t i = 0; i < 1000; ++i) {
+        for (size_t j = 0; j < 1000; ++j) {
+          da.set(i, j, i * j);
+        }
+      }
+      DynamicArray2<size_t> const expected(da);
+      for (auto p : {memory_policy::huge_pages,
+                     memory_policy::interleave,
+                     memory_policy::huge_pages_and_interleave,
+                     memory_policy::standard}) {
+        da.set_allocator(allocator_type(p));
+        REQUIRE(da.get_allocator().policy() == p);
+        REQUIRE(da == expected);
+
+        DynamicArray2<size_t> copy(da);
+        REQUIRE(copy.get_allocator().policy() == p);
+        copy.add_rows(1000);
+        copy.add_cols(10);
+        REQUIRE(copy.get_allocator().policy() == p);
+        REQUIRE(copy.get(999, 999) == 999 * 999);
+        REQUIRE(copy.get(1999, 1009) == 0);
+        copy = expected;
+        REQUIRE(copy.get_allocator().policy() == memory_policy::standard);
+      }
+      DynamicArray2<bool> db(10, 1000000);
+      db.set(999999, 9, true);
+      db.set_allocator(
+          DynamicArray2<bool>::allocator_type(memory_policy::huge_pages));
+      REQUIRE(db.get(999999, 9));
+      REQUIRE(!db.get(999999, 8));
+    }
+
     LIBSEMIGROUPS_TEST_CASE("StaticVector2",
                             "042",
                             "all",
@@ -16,6 +16,10 @@
 //
 
 #include <cstddef>
+#include <map>     // for map
+#include <random>  // for mt19937
+#include <set>     // for set
+#include <vector>  // for vector
 
 #include "catch.hpp"  // for REQUIRE, REQUIRE_NOTHROW, REQUIRE_THROWS_AS
 #include "libsemigroups/digraph-helper.hpp"  // for is_acyclic
@@ -59,6 +63,29 @@ namespace libsemigroups {
       add_clique(g, n);
       return g;
     }
+    // Returns the coarsest stable partition refining initial, computed by
+    // repeatedly refining by the parts of the targets of the edges.
+    std::vector<size_t> naive_partition(ActionDigraph<size_t> const& ad,
+                                        std::vector<size_t>          part) {
+      size_t const n = ad.number_of_nodes();
+      while (true) {
+        std::map<std::vector<size_t>, size_t> index;
+        std::vector<size_t>                   next(n);
+        for (size_t v = 0; v < n; ++v) {
+          std::vector<size_t> sig = {part[v]};
+          for (size_t a = 0; a < ad.out_degree(); ++a) {
+            size_t w = ad.unsafe_neighbor(v, a);
+            sig.push_back(w == UNDEFINED ? UNDEFINED : part[w]);
+          }
+          next[v] = index.emplace(sig, index.size()).first->second;
+        }
+        if (index.size()
+            == std::set<size_t>(part.cbegin(), part.cend()).size()) {
+          return next;
+        }
+        part = std::move(next);
+      }
+    }
   }  // namespace
 
   LIBSEMIGROUPS_TEST_CASE("is_acyclic", "000", "2-cycle", "[quick]") {
@@ -281,4 +308,103 @@ namespace libsemigroups {
     REQUIRE_THROWS_AS(action_digraph_helper::validate_label(ad, 10),
                       LibsemigroupsException);
   }
+
+  LIBSEMIGROUPS_TEST_CASE("coarsest_stable_partition",
+                          "014",
+                          "cycles",
+                          "[quick]") {
+    using action_digraph_helper::coarsest_stable_partition;
+    ActionDigraph<size_t> ad(0, 1);
+    action_digraph_helper::add_cycle(ad, 6);
+    REQUIRE(coarsest_stable_partition(ad)
+            == std::vector<size_t>({0, 0, 0, 0, 0, 0}));
+    REQUIRE(coarsest_stable_partition(ad, {5, 3, 5, 3, 5, 3})
+            == std::vector<size_t>({0, 1, 0, 1, 0, 1}));
+    REQUIRE(coarsest_stable_partition(ad, {0, 1, 2, 0, 1, 2})
+            == std::vector<size_t>({0, 1, 2, 0, 1, 2}));
+    REQUIRE(coarsest_stable_partition(ad, {1, 0, 0, 0, 0, 0})
+            == std::vector<size_t>({0, 1, 2, 3, 4, 5}));
+    // The parts are numbered in order of their least nodes
+    REQUIRE(coarsest_stable_partition(ad, {1, 0, 1, 0, 1, 0})
+            == std::vector<size_t>({0, 1, 0, 1, 0, 1}));
+    REQUIRE_THROWS_AS(coarsest_stable_partition(ad, {0, 1}),
+                      LibsemigroupsException);
+
+    auto mn = action_digraph_helper::minimise(ad, {0, 1, 0, 0, 1, 0});
+    REQUIRE(mn.number_of_nodes() == 3);
+    REQUIRE(mn.neighbor(0, 0) == 1);
+    REQUIRE(mn.neighbor(1, 0) == 2);
+    REQUIRE(mn.neighbor(2, 0) == 0);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("coarsest_stable_partition",
+                          "015",
+                          "undefined edges",
+                          "[quick]") {
+    using action_digraph_helper::coarsest_stable_partition;
+    ActionDigraph<size_t> ad = path(5);
+    REQUIRE(coarsest_stable_partition(ad)
+            == std::vector<size_t>({0, 1, 2, 3, 4}));
+    add_path(ad, 3);
+    add_path(ad, 5);
+    REQUIRE(coarsest_stable_partition(ad)
+            == std::vector<size_t>({0, 1, 2, 3, 4, 2, 3, 4, 0, 1, 2, 3, 4}));
+
+    auto mn = action_digraph_helper::minimise(ad);
+    REQUIRE(mn.number_of_nodes() == 5);
+    REQUIRE(mn.out_degree() == 1);
+    for (size_t v = 0; v < 4; ++v) {
+      REQUIRE(mn.neighbor(v, 0) == v + 1);
+    }
+    REQUIRE(mn.neighbor(4, 0) == UNDEFINED);
+    REQUIRE(action_digraph_helper::minimise(ActionDigraph<size_t>(0, 2))
+                .number_of_nodes()
+            == 0);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("quotient", "016", "exceptions", "[quick]") {
+    using action_digraph_helper::quotient;
+    ActionDigraph<size_t> ad(0, 1);
+    action_digraph_helper::add_cycle(ad, 4);
+    REQUIRE(quotient(ad, {0, 1, 0, 1}).number_of_nodes() == 2);
+    REQUIRE(quotient(ad, {0, 0, 0, 0}).number_of_nodes() == 1);
+    REQUIRE(quotient(ad, {0, 0, 0, 0}).neighbor(0, 0) == 0);
+    // Not compatible with the edges
+    REQUIRE_THROWS_AS(quotient(ad, {0, 0, 1, 1}), LibsemigroupsException);
+    // Wrong size
+    REQUIRE_THROWS_AS(quotient(ad, {0, 0, 0}), LibsemigroupsException);
+    // Parts not numbered 0, 1, ..., m - 1
+    REQUIRE_THROWS_AS(quotient(ad, {0, 2, 0, 2}), LibsemigroupsException);
+    REQUIRE_THROWS_AS(quotient(ad, {0, 4, 0, 4}), LibsemigroupsException);
+
+    ad = path(4);
+    REQUIRE_THROWS_AS(quotient(ad, {0, 1, 2, 2}), LibsemigroupsException);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("coarsest_stable_partition",
+                          "017",
+                          "random digraphs",
+                          "[quick]") {
+    std::mt19937 mt(1729);
+    for (size_t n : {2, 10, 50, 200}) {
+      for (size_t k : {2, 3}) {
+        // Digraphs with and without undefined edges
+        for (size_t m : {n * k / 2, n * k}) {
+          auto ad = ActionDigraph<size_t>::random(n, k, m, std::mt19937(mt()));
+          std::uniform_int_distribution<size_t> dist(0, 2);
+          std::vector<size_t>                   initial(n);
+          for (auto& x : initial) {
+            x = dist(mt);
+          }
+          auto part = action_digraph_helper::coarsest_stable_partition(
+              ad, initial);
+          REQUIRE(part == naive_partition(ad, initial));
+          REQUIRE_NOTHROW(action_digraph_helper::quotient(ad, part));
+          auto mn = action_digraph_helper::minimise(ad, initial);
+          REQUIRE(mn.number_of_nodes()
+                  == std::set<size_t>(part.cbegin(), part.cend()).size());
+        }
+      }
+    }
+  }
 }  // namespace libsemigroups
@@ -19,7 +19,10 @@
 #define CATCH_CONFIG_ENABLE_PAIR_STRINGMAKER
 
 #include <cstddef>        // for size_t
+#include <map>            // for map
+#include <random>         // for mt19937
 #include <stdexcept>      // for runtime_error
+#include <thread>         // for thread
 #include <unordered_set>  // for unordered_set
 #include <vector>         // for vector
 
@@ -1914,4 +1917,297 @@ namespace libsemigroups {
             == POSITIVE_INFINITY);
     REQUIRE(ad.number_of_paths(0, 1, 0, 10, algorithm::matrix) == 5);
   }
+
+  LIBSEMIGROUPS_TEST_CASE("ActionDigraph",
+                          "043",
+                          "visit_paths",
+                          "[quick]") {
+    using node_type = ActionDigraph<size_t>::node_type;
+    using algorithm = ActionDigraph<size_t>::algorithm;
+    ActionDigraph<size_t> ad;
+    ad.add_nodes(6);
+    ad.add_to_out_degree(2);
+
+    ad.add_edge(0, 1, 0);
+    ad.add_edge(0, 2, 1);
+    ad.add_edge(1, 3, 0);
+    ad.add_edge(1, 4, 1);
+    ad.add_edge(2, 4, 0);
+    ad.add_edge(2, 2, 1);
+    ad.add_edge(3, 1, 0);
+    ad.add_edge(3, 5, 1);
+    ad.add_edge(4, 5, 0);
+    ad.add_edge(4, 4, 1);
+    ad.add_edge(5, 4, 0);
+
+    size_t const N = 12;
+
+    std::vector<std::pair<word_type, node_type>> panilo;
+    ad.visit_paths(0, 0, N, [&panilo](word_type const& w, node_type n) {
+      panilo.emplace_back(w, n);
+      return true;
+    });
+    REQUIRE(panilo
+            == std::vector<std::pair<word_type, node_type>>(
+                ad.cbegin_panilo(0, 0, N), ad.cend_panilo()));
+
+    for (node_type target = 0; target < ad.number_of_nodes(); ++target) {
+      std::vector<word_type> pstilo;
+      ad.visit_paths(0, target, 2, N, [&pstilo, target](word_type const& w,
+                                                        node_type       n) {
+        REQUIRE(n == target);
+        pstilo.push_back(w);
+        return true;
+      });
+      REQUIRE(pstilo
+              == std::vector<word_type>(ad.cbegin_pstilo(0, target, 2, N),
+                                        ad.cend_pstilo()));
+      REQUIRE(ad.number_of_paths(0, target, 2, N, algorithm::dfs)
+              == pstilo.size());
+    }
+
+    // Stop early
+    size_t count = 0;
+    ad.visit_paths(0, 4, 0, N, [&count](word_type const&, node_type) {
+      return ++count < 10;
+    });
+    REQUIRE(count == 10);
+
+    count = 0;
+    ad.visit_paths(0, 0, 0, [&count](word_type const&, node_type) {
+      ++count;
+      return true;
+    });
+    REQUIRE(count == 0);
+
+    // No path from 4 to 0, or from 5 to 2
+    REQUIRE(ad.number_of_paths(4, 0, 0, N, algorithm::dfs) == 0);
+    REQUIRE(ad.number_of_paths(5, 2, 0, 4, algorithm::dfs) == 0);
+    REQUIRE(std::distance(ad.cbegin_pstilo(5, 5, 0, 4), ad.cend_pstilo())
+            == 3);
+
+    // The nodes that can reach 2 must be recomputed when edges are added
+    ad.add_edge(5, 2, 1);
+    REQUIRE(ad.number_of_paths(5, 2, 0, 4, algorithm::dfs) == 4);
+    REQUIRE(std::vector<word_type>(ad.cbegin_pstilo(5, 2, 0, 4),
+                                   ad.cend_pstilo())
+            == std::vector<word_type>({{0, 0, 1}, {1}, {1, 1}, {1, 1, 1}}));
+    REQUIRE_THROWS_AS(
+        ad.visit_paths(6, 0, N, [](word_type const&, node_type) {
+          return true;
+        }),
+        LibsemigroupsException);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("ActionDigraph",
+                          "044",
+                          "number_of_paths_modulo/exact",
+                          "[quick]") {
+    using algorithm = ActionDigraph<size_t>::algorithm;
+    // Compare with number_of_paths when there is no overflow
+    auto ad = ActionDigraph<size_t>::random(20, 3);
+    for (size_t s = 0; s < ad.number_of_nodes(); ++s) {
+      for (size_t max = 0; max < 12; ++max) {
+        uint64_t expected = ad.number_of_paths(s, 2, max, algorithm::matrix);
+        REQUIRE(ad.number_of_paths_modulo(s, 2, max, POSITIVE_INFINITY)
+                == expected);
+        REQUIRE(ad.number_of_paths_modulo(s, 2, max, 7) == expected % 7);
+        REQUIRE(ad.number_of_paths_exact(s, 2, max)
+                == std::to_string(expected));
+        expected = ad.number_of_paths(s, 5, 1, max, algorithm::matrix);
+        REQUIRE(ad.number_of_paths_modulo(s, 5, 1, max, 1000)
+                == expected % 1000);
+        REQUIRE(ad.number_of_paths_exact(s, 5, 1, max)
+                == std::to_string(expected));
+      }
+    }
+
+    // Counts exceeding 2 ^ 64
+    ad = ActionDigraph<size_t>(1, 2);
+    ad.add_edge(0, 0, 0);
+    ad.add_edge(0, 0, 1);
+    REQUIRE(ad.number_of_paths_exact(0, 0, 100)
+            == "1267650600228229401496703205375");
+    REQUIRE(ad.number_of_paths_exact(0, 0, 0, 100)
+            == "1267650600228229401496703205375");
+    REQUIRE(ad.number_of_paths_modulo(0, 0, 100, 1000000007) == 976371284);
+    REQUIRE(ad.number_of_paths_modulo(0, 0, 100, 1) == 0);
+    REQUIRE(ad.number_of_paths_modulo(0, 0, 100, 18446744073709551557ULL)
+            == 4054449127423);
+
+    ad.add_to_out_degree(1);
+    ad.add_edge(0, 0, 2);
+    REQUIRE(ad.number_of_paths_exact(0, 64, 200)
+            == "13280699443793738466939066101788981341461672632669724798728"
+               "7480867829403540504835254863424977360");
+    REQUIRE(ad.number_of_paths_modulo(0, 64, 200, 2305843009213693951ULL)
+            == 1610269054130583791);
+    REQUIRE(ad.number_of_paths_exact(0, 10, 10) == "0");
+    REQUIRE_THROWS_AS(ad.number_of_paths_exact(0, 0, POSITIVE_INFINITY),
+                      LibsemigroupsException);
+    REQUIRE_THROWS_AS(ad.number_of_paths_modulo(0, 0, 10, 0),
+                      LibsemigroupsException);
+    REQUIRE_THROWS_AS(ad.number_of_paths_modulo(1, 0, 10, 2),
+                      LibsemigroupsException);
+
+    // Acyclic
+    ad = ActionDigraph<size_t>(5, 2);
+    for (size_t i = 0; i < 4; ++i) {
+      ad.add_edge(i, i + 1, 0);
+      ad.add_edge(i, i + 1, 1);
+    }
+    REQUIRE(ad.number_of_paths_exact(0, 0, POSITIVE_INFINITY) == "31");
+    REQUIRE(ad.number_of_paths_exact(0, 4, 0, POSITIVE_INFINITY) == "16");
+    REQUIRE(ad.number_of_paths_modulo(0, 0, POSITIVE_INFINITY, 10) == 1);
+    REQUIRE(ad.number_of_paths_modulo(0, 3, 0, POSITIVE_INFINITY, 10) == 8);
+    REQUIRE_THROWS_AS(ad.number_of_paths_exact(0, 5, 0, 10),
+                      LibsemigroupsException);
+  }
+  LIBSEMIGROUPS_TEST_CASE("ActionDigraph", "045", "random_path", "[quick]") {
+    std::mt19937          mt(42);
+    ActionDigraph<size_t> ad(3, 2);
+    ad.add_edge(0, 1, 0);
+    ad.add_edge(0, 2, 1);
+    ad.add_edge(1, 0, 0);
+    ad.add_edge(1, 2, 1);
+    ad.add_edge(2, 2, 0);
+    // Every path of length 5 from 0 (to 2) is chosen with roughly equal
+    // frequency
+    std::map<word_type, size_t> freq, freq_to_2;
+    for (auto it = ad.cbegin_pislo(0, 5, 6); it != ad.cend_pislo(); ++it) {
+      freq.emplace(*it, 0);
+    }
+    for (auto it = ad.cbegin_pstislo(0, 2, 5, 6); it != ad.cend_pstislo();
+         ++it) {
+      freq_to_2.emplace(*it, 0);
+    }
+    REQUIRE(freq.size() == 6);
+    REQUIRE(freq_to_2.size() == 5);
+    for (size_t i = 0; i < 100 * freq.size(); ++i) {
+      freq.at(ad.random_path(0, 5, mt))++;
+    }
+    for (size_t i = 0; i < 100 * freq_to_2.size(); ++i) {
+      freq_to_2.at(ad.random_path(0, 2, 5, mt))++;
+    }
+    for (auto const& f : {freq, freq_to_2}) {
+      for (auto const& p : f) {
+        REQUIRE(p.second > 50);
+        REQUIRE(p.second < 150);
+      }
+    }
+
+    // More paths than fit into 64 bits
+    ad = ActionDigraph<size_t>(2, 2);
+    ad.add_edge(0, 0, 0);
+    ad.add_edge(0, 1, 1);
+    ad.add_edge(1, 0, 0);
+    ad.add_edge(1, 1, 1);
+    word_type w = ad.random_path(0, 1000, mt);
+    REQUIRE(w.size() == 1000);
+    REQUIRE(action_digraph_helper::follow_path(ad, 0, w) == w.back());
+    w = ad.random_path(0, 1, 1000, mt);
+    REQUIRE(w.size() == 1000);
+    REQUIRE(w.back() == 1);
+    REQUIRE(ad.random_path(0, 0, mt) == word_type({}));
+
+    // More paths than fit into a double
+    w = ad.random_path(0, 1, 10000, mt);
+    REQUIRE(w.size() == 10000);
+    REQUIRE(w.back() == 1);
+    REQUIRE_THROWS_AS(ad.random_path(2, 10, mt), LibsemigroupsException);
+    REQUIRE_THROWS_AS(ad.random_path(0, 1, 0, mt), LibsemigroupsException);
+    ad = ActionDigraph<size_t>(2, 1);
+    ad.add_edge(0, 1, 0);
+    REQUIRE(ad.random_path(0, 1, mt) == word_type({0}));
+    REQUIRE_THROWS_AS(ad.random_path(0, 2, mt), LibsemigroupsException);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("ActionDigraph",
+                          "046",
+                          "visit_paths in several threads",
+                          "[quick]") {
+    using algorithm = ActionDigraph<size_t>::algorithm;
+    using node_type = ActionDigraph<size_t>::node_type;
+    size_t const N  = 12;
+    auto         ad = ActionDigraph<size_t>::random(N, 2, std::mt19937(1));
+    std::vector<uint64_t> expected;
+    for (node_type target = 0; target < N; ++target) {
+      expected.push_back(ad.number_of_paths(0, target, 0, 8, algorithm::dfs));
+    }
+    // Const member functions must be safe to call concurrently.
+    ActionDigraph<size_t> const& cad = ad;
+    std::vector<std::vector<uint64_t>> found(4);
+    std::vector<std::thread>           threads;
+    for (size_t i = 0; i < found.size(); ++i) {
+      threads.emplace_back([&cad, &found, i, N]() {
+        for (node_type target = 0; target < N; ++target) {
+          uint64_t count = 0;
+          cad.visit_paths(
+              0, target, 0, 8, [&count](word_type const&, node_type) {
+                ++count;
+                return true;
+              });
+          found[i].push_back(count);
+        }
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    for (auto const& f : found) {
+      REQUIRE(f == expected);
+    }
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("ActionDigraph",
+                          "047",
+                          "path iterators agree with visit_paths",
+                          "[quick]") {
+    using node_type = ActionDigraph<size_t>::node_type;
+    size_t const N  = 10;
+    auto         ad = ActionDigraph<size_t>::random(N, 3, std::mt19937(2));
+
+    std::vector<word_type> expected;
+    ad.visit_paths(0, 0, 6, [&expected](word_type const& w, node_type) {
+      expected.push_back(w);
+      return true;
+    });
+    REQUIRE(std::vector<word_type>(ad.cbegin_pilo(0, 0, 6), ad.cend_pilo())
+            == expected);
+    std::sort(expected.begin(), expected.end(), ShortLexCompare<word_type>());
+    REQUIRE(std::vector<word_type>(ad.cbegin_pislo(0, 0, 6), ad.cend_pislo())
+            == expected);
+
+    for (node_type target = 0; target < N; ++target) {
+      expected.clear();
+      ad.visit_paths(
+          0, target, 2, 6, [&expected](word_type const& w, node_type) {
+            expected.push_back(w);
+            return true;
+          });
+      REQUIRE(std::vector<word_type>(ad.cbegin_pstilo(0, target, 2, 6),
+                                     ad.cend_pstilo())
+              == expected);
+      std::sort(
+          expected.begin(), expected.end(), ShortLexCompare<word_type>());
+      REQUIRE(std::vector<word_type>(ad.cbegin_pstislo(0, target, 2, 6),
+                                     ad.cend_pstislo())
+              == expected);
+    }
+
+    // The cached nodes that can reach a target are discarded when the
+    // digraph is modified.
+    ActionDigraph<size_t> ad2(4, 1);
+    ad2.add_edge(0, 1, 0);
+    ad2.add_edge(2, 3, 0);
+    ad2.add_edge(3, 2, 0);
+    REQUIRE(std::distance(ad2.cbegin_pstislo(0, 1), ad2.cend_pstislo())
+            == 1);
+    REQUIRE(ad2.cbegin_pstilo(2, 1) == ad2.cend_pstilo());
+    ad2.add_edge(1, 2, 0);
+    ad2.add_edge(3, 1, 0);
+    REQUIRE(std::vector<word_type>(ad2.cbegin_pstislo(2, 1, 0, 8),
+                                   ad2.cend_pstislo())
+            == std::vector<word_type>({{0, 0}, {0, 0, 0, 0, 0}}));
+  }
 }  // namespace libsemigroups
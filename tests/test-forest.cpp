@@ -16,6 +16,7 @@
 //
 
 #include <cstddef>  // for size_t
+#include <vector>   // for vector
 
 #include "catch.hpp"  // for REQUIRE, REQUIRE_NOTHROW, REQUIRE_THROWS_AS
 #include "libsemigroups/forest.hpp"  // for Forest
@@ -51,4 +52,79 @@ namespace libsemigroups {
     REQUIRE_NOTHROW(forest.add_nodes(10));
     REQUIRE(forest.number_of_nodes() == 10);
   }
+
+  LIBSEMIGROUPS_TEST_CASE("Forest",
+                          "002",
+                          "depth, ancestor, lowest_common_ancestor",
+                          "[quick]") {
+    // Two trees, one with root 0 and one with root 50, where the parent of
+    // i is i / 2 or 50 + (i - 50) / 3.
+    Forest forest(100);
+    for (size_t i = 1; i < 50; ++i) {
+      forest.set(i, i / 2, i % 2);
+    }
+    for (size_t i = 51; i < 100; ++i) {
+      forest.set(i, 50 + (i - 50) / 3, (i - 50) % 3);
+    }
+
+    std::vector<size_t>    depth;
+    std::vector<size_t>    lca;
+    std::vector<size_t>    anc;
+    std::vector<word_type> paths;
+    for (size_t i = 0; i < 100; ++i) {
+      depth.push_back(forest.depth(i));
+      paths.push_back(forest.path_to_root(i));
+      for (size_t k = 0; k < 8; ++k) {
+        anc.push_back(forest.ancestor(i, k));
+      }
+      for (size_t j = 0; j < 100; ++j) {
+        lca.push_back(forest.lowest_common_ancestor(i, j));
+      }
+    }
+    REQUIRE(depth[0] == 0);
+    REQUIRE(depth[37] == 6);
+    REQUIRE(depth[99] == 4);
+    REQUIRE(paths[37] == word_type({1, 0, 1, 0, 0, 1}));
+    REQUIRE(paths[0] == word_type({}));
+    REQUIRE(anc[37 * 8 + 0] == 37);
+    REQUIRE(anc[37 * 8 + 2] == 9);
+    REQUIRE(anc[37 * 8 + 6] == 0);
+    REQUIRE(anc[37 * 8 + 7] == UNDEFINED);
+    REQUIRE(lca[37 * 100 + 39] == 9);
+    REQUIRE(lca[37 * 100 + 4] == 4);
+    REQUIRE(lca[37 * 100 + 99] == UNDEFINED);
+    REQUIRE(lca[98 * 100 + 99] == 66);
+
+    REQUIRE(!forest.has_ancestor_table());
+    forest.init_ancestor_table();
+    REQUIRE(forest.has_ancestor_table());
+    word_type w;
+    for (size_t i = 0; i < 100; ++i) {
+      REQUIRE(forest.depth(i) == depth[i]);
+      forest.path_to_root(w, i);
+      REQUIRE(w == paths[i]);
+      for (size_t k = 0; k < 8; ++k) {
+        REQUIRE(forest.ancestor(i, k) == anc[i * 8 + k]);
+      }
+      for (size_t j = 0; j < 100; ++j) {
+        REQUIRE(forest.lowest_common_ancestor(i, j) == lca[i * 100 + j]);
+      }
+    }
+
+    forest.set(50, 0, 2);
+    REQUIRE(!forest.has_ancestor_table());
+    REQUIRE(forest.depth(99) == 5);
+    REQUIRE(forest.lowest_common_ancestor(37, 99) == 0);
+    forest.init_ancestor_table();
+    REQUIRE(forest.depth(99) == 5);
+    REQUIRE(forest.lowest_common_ancestor(37, 99) == 0);
+    REQUIRE(forest.path_to_root(99) == word_type({1, 1, 2, 1, 2}));
+
+    REQUIRE_THROWS_AS(forest.depth(100), LibsemigroupsException);
+    REQUIRE_THROWS_AS(forest.ancestor(100, 0), LibsemigroupsException);
+    REQUIRE_THROWS_AS(forest.lowest_common_ancestor(0, 100),
+                      LibsemigroupsException);
+    forest.set(0, 1, 0);
+    REQUIRE_THROWS_AS(forest.init_ancestor_table(), LibsemigroupsException);
+  }
 }  // namespace libsemigroups
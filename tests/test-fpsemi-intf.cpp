@@ -307,8 +307,14 @@ namespace libsemigroups {
       REQUIRE(fp->finished());
       REQUIRE(fp->started());
       // Add rule after finished
-      REQUIRE_THROWS_AS(fp->add_rule({0}, {1}), LibsemigroupsException);
-      REQUIRE_THROWS_AS(fp->add_rule({"a"}, {"b"}), LibsemigroupsException);
+      if (dynamic_cast<KnuthBendix*>(fp.get()) != nullptr) {
+        // KnuthBendix supports adding rules incrementally
+        REQUIRE_NOTHROW(fp->add_rule({0}, {1}));
+        REQUIRE(!fp->finished());
+      } else {
+        REQUIRE_THROWS_AS(fp->add_rule({0}, {1}), LibsemigroupsException);
+        REQUIRE_THROWS_AS(fp->add_rule({"a"}, {"b"}), LibsemigroupsException);
+      }
     }
 
     LIBSEMIGROUPS_TEST_CASE("FpSemigroupInterface",
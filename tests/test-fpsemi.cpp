@@ -981,4 +981,79 @@ namespace libsemigroups {
     S.set_identity("e");
     REQUIRE_THROWS_AS(S.set_inverses("bAae"), LibsemigroupsException);
   }
+
+  LIBSEMIGROUPS_TEST_CASE("FpSemigroup",
+                          "047",
+                          "plan_runners",
+                          "[fpsemigroup][quick]") {
+    auto rg = ReportGuard(REPORT);
+    using options = congruence::ToddCoxeter::options;
+    {
+      FpSemigroup S;
+      S.set_alphabet("abc");
+      S.add_rule("aa", "a");
+      REQUIRE(!S.plan_runners());
+      // With 1 thread only the first runner is run, which, without planning,
+      // is ToddCoxeter, and would never terminate.
+      S.plan_runners(true).max_threads(1);
+      REQUIRE(S.is_obviously_infinite());
+      S.run();
+      REQUIRE(S.finished());
+      REQUIRE(!S.has_todd_coxeter());
+      REQUIRE(S.has_knuth_bendix());
+      REQUIRE(S.equal_to("aaa", "a"));
+    }
+    {
+      FpSemigroup S;
+      S.set_alphabet("ab");
+      S.add_rule("aaa", "a");
+      S.add_rule("bb", "b");
+      S.add_rule("ab", "ba");
+      S.plan_runners(true).max_threads(1);
+      REQUIRE(S.size() == 5);
+      REQUIRE(S.has_todd_coxeter());
+      REQUIRE(S.todd_coxeter()->congruence().strategy()
+              == options::strategy::felsch);
+    }
+    {
+      FpSemigroup S;
+      S.set_alphabet("abce");
+      S.set_identity("e");
+      S.add_rule("aa", "e");
+      S.add_rule("bc", "e");
+      S.add_rule("bbb", "e");
+      S.add_rule("ababababababab", "e");
+      S.add_rule("abacabacabacabacabacabacabacabac", "e");
+      S.plan_runners(true).max_threads(1);
+      S.run_for(std::chrono::milliseconds(10));
+      REQUIRE(S.has_todd_coxeter());
+      REQUIRE(S.todd_coxeter()->congruence().strategy()
+              == options::strategy::hlt);
+    }
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("FpSemigroup",
+                          "048",
+                          "plan_runners before equal_to/normal_form",
+                          "[fpsemigroup][quick]") {
+    auto rg = ReportGuard(REPORT);
+    {
+      FpSemigroup S;
+      S.set_alphabet("abc");
+      S.add_rule("aa", "a");
+      S.plan_runners(true).max_threads(1);
+      REQUIRE(S.normal_form("aaab") == "ab");
+      REQUIRE(!S.has_todd_coxeter());
+      REQUIRE(S.has_knuth_bendix());
+    }
+    {
+      FpSemigroup S;
+      S.set_alphabet("abc");
+      S.add_rule("aa", "a");
+      S.plan_runners(true).max_threads(1);
+      REQUIRE(S.equal_to("aaa", "a"));
+      REQUIRE(!S.has_todd_coxeter());
+      REQUIRE(S.has_knuth_bendix());
+    }
+  }
 }  // namespace libsemigroups
@@ -0,0 +1,191 @@
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <cstddef>  // for size_t
+#include <vector>   // for vector
+
+#include "catch.hpp"      // for REQUIRE, REQUIRE_THROWS_AS
+#include "test-main.hpp"  // for LIBSEMIGROUPS_TEST_CASE
+
+#include "libsemigroups/bmat8.hpp"               // for BMat8
+#include "libsemigroups/exception.hpp"           // for LIBSEMIGROUPS_EXCEPTION
+#include "libsemigroups/froidure-pin-batch.hpp"  // for FroidurePinBatch
+#include "libsemigroups/froidure-pin.hpp"        // for FroidurePin
+#include "libsemigroups/report.hpp"              // for ReportGuard
+#include "libsemigroups/transf.hpp"              // for Transf<>
+
+namespace libsemigroups {
+  struct LibsemigroupsException;
+  constexpr bool REPORT = false;
+
+  namespace {
+    template <typename T>
+    void check_batch(FroidurePinBatch<T> const&  batch,
+                     std::vector<std::vector<T>> gens) {
+      auto rg = ReportGuard(REPORT);
+      REQUIRE(batch.finished());
+      REQUIRE(batch.number_of_generating_sets() == gens.size());
+      for (size_t i = 0; i < gens.size(); ++i) {
+        FroidurePin<T> S(gens[i]);
+        REQUIRE(batch.result(i).size == S.size());
+        REQUIRE(batch.result(i).number_of_rules == S.number_of_rules());
+        REQUIRE(batch.result(i).number_of_idempotents
+                == S.number_of_idempotents());
+      }
+    }
+
+    // Throws if the product is the zero matrix.
+    struct ThrowingProduct {
+      void operator()(BMat8&       xy,
+                      BMat8 const& x,
+                      BMat8 const& y,
+                      size_t = 0) const {
+        xy = x * y;
+        if (xy == BMat8(0)) {
+          LIBSEMIGROUPS_EXCEPTION("the product is zero");
+        }
+      }
+    };
+
+    struct ThrowingTraits : public FroidurePinTraits<BMat8> {
+      using Product = ThrowingProduct;
+    };
+  }  // namespace
+
+  LIBSEMIGROUPS_TEST_CASE("FroidurePinBatch",
+                          "000",
+                          "all 2-generated BMat8 of dimension 2",
+                          "[quick][froidure-pin-batch]") {
+    std::vector<BMat8> mats;
+    for (size_t i = 0; i < 16; ++i) {
+      mats.push_back(BMat8({{(i & 1) != 0, (i & 2) != 0},
+                            {(i & 4) != 0, (i & 8) != 0}}));
+    }
+    std::vector<std::vector<BMat8>> gens;
+    FroidurePinBatch<BMat8>         batch;
+    REQUIRE(batch.number_of_threads() == 1);
+    for (auto const& x : mats) {
+      for (auto const& y : mats) {
+        gens.push_back({x, y});
+        batch.add_generators(gens.back());
+      }
+    }
+    REQUIRE(!batch.finished());
+    batch.number_of_threads(4).run();
+    check_batch(batch, gens);
+
+    gens.push_back({BMat8({{0, 1}, {1, 0}}), BMat8({{1, 0}, {1, 1}})});
+    batch.add_generators(gens.back());
+    REQUIRE(!batch.finished());
+    batch.run();
+    check_batch(batch, gens);
+    REQUIRE(batch.result(256).size == 7);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("FroidurePinBatch",
+                          "001",
+                          "random BMat8, one and then several threads",
+                          "[quick][froidure-pin-batch]") {
+    std::vector<std::vector<BMat8>> gens;
+    FroidurePinBatch<BMat8>         batch;
+    for (size_t i = 0; i < 100; ++i) {
+      gens.push_back({BMat8::random(3), BMat8::random(3), BMat8::random(3)});
+      batch.add_generators(gens.back());
+    }
+    batch.run();
+    check_batch(batch, gens);
+    // Only the new generating sets are enumerated
+    for (size_t i = 0; i < 100; ++i) {
+      gens.push_back({BMat8::random(4), BMat8::random(4)});
+      batch.add_generators(gens.back());
+    }
+    REQUIRE(!batch.finished());
+    batch.number_of_threads(3).run();
+    check_batch(batch, gens);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("FroidurePinBatch",
+                          "002",
+                          "transformations with duplicate generators",
+                          "[quick][froidure-pin-batch]") {
+    std::vector<std::vector<Transf<>>> gens
+        = {{Transf<>({1, 0, 2, 3, 4, 5}),
+            Transf<>({0, 1, 2, 3, 4, 5}),
+            Transf<>({1, 2, 3, 4, 5, 0}),
+            Transf<>({1, 0, 2, 3, 4, 5}),
+            Transf<>({0, 0, 2, 3, 4, 5})},
+           {Transf<>({0, 1, 2, 3, 4, 5})},
+           {Transf<>({1, 2, 0}), Transf<>({0, 0, 1}), Transf<>({1, 2, 0})},
+           {Transf<>({0, 0, 0, 0}), Transf<>({1, 2, 3, 0})}};
+    FroidurePinBatch<Transf<>> batch;
+    for (auto const& x : gens) {
+      batch.add_generators(x.cbegin(), x.cend());
+    }
+    batch.number_of_threads(2).run();
+    check_batch(batch, gens);
+    REQUIRE(batch.result(0).size == 46656);
+    REQUIRE(batch.result(1).size == 1);
+    REQUIRE(batch.result(1).number_of_rules == 1);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("FroidurePinBatch",
+                          "003",
+                          "exceptions",
+                          "[quick][froidure-pin-batch]") {
+    FroidurePinBatch<Transf<>> batch;
+    REQUIRE_THROWS_AS(batch.number_of_threads(0), LibsemigroupsException);
+    REQUIRE_THROWS_AS(batch.add_generators({}), LibsemigroupsException);
+    REQUIRE_THROWS_AS(
+        batch.add_generators({Transf<>({0, 0}), Transf<>({0, 0, 1})}),
+        LibsemigroupsException);
+    REQUIRE(batch.number_of_generating_sets() == 0);
+    REQUIRE(batch.finished());
+    batch.add_generators({Transf<>({0, 0})});
+    REQUIRE_THROWS_AS(batch.result(0), LibsemigroupsException);
+    REQUIRE_THROWS_AS(batch.result(1), LibsemigroupsException);
+    batch.run();
+    REQUIRE(batch.result(0).size == 1);
+    REQUIRE(batch.result(0).number_of_idempotents == 1);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("FroidurePinBatch",
+                          "004",
+                          "exceptions thrown by the adapters",
+                          "[quick][froidure-pin-batch]") {
+    std::vector<BMat8> mats;
+    for (size_t i = 0; i < 16; ++i) {
+      mats.push_back(BMat8({{(i & 1) != 0, (i & 2) != 0},
+                            {(i & 4) != 0, (i & 8) != 0}}));
+    }
+    for (size_t nr_threads : {1, 4}) {
+      FroidurePinBatch<BMat8, ThrowingTraits> batch;
+      batch.add_generators({BMat8({{0, 1}, {1, 0}})});
+      batch.run();
+      REQUIRE(batch.finished());
+      for (auto const& x : mats) {
+        for (auto const& y : mats) {
+          batch.add_generators({x, y});
+        }
+      }
+      REQUIRE_THROWS_AS(batch.number_of_threads(nr_threads).run(),
+                        LibsemigroupsException);
+      REQUIRE(!batch.finished());
+      REQUIRE(batch.result(0).size == 2);
+      REQUIRE_THROWS_AS(batch.result(1), LibsemigroupsException);
+    }
+  }
+}  // namespace libsemigroups
@@ -2486,4 +2486,31 @@ namespace libsemigroups {
                       LibsemigroupsException);
   }
 
+  LIBSEMIGROUPS_TEST_CASE("FroidurePin<Transf<>>",
+                          "142",
+                          "memory_policy",
+                          "[quick][froidure-pin][transf]") {
+    auto                  rg = ReportGuard(REPORT);
+    FroidurePin<Transf<>> S;
+    S.add_generator(Transf<>({1, 0, 2, 3, 4, 5}));
+    S.add_generator(Transf<>({1, 2, 3, 4, 5, 0}));
+    S.add_generator(Transf<>({0, 0, 2, 3, 4, 5}));
+    FroidurePin<Transf<>> T(S);
+
+    REQUIRE(S.memory_policy() == memory_policy::standard);
+    S.memory_policy(memory_policy::huge_pages);
+    REQUIRE(S.memory_policy() == memory_policy::huge_pages);
+    S.enumerate(1000);
+    S.memory_policy(memory_policy::huge_pages_and_interleave);
+    REQUIRE(S.size() == 46656);
+    REQUIRE(S.memory_policy() == memory_policy::huge_pages_and_interleave);
+
+    REQUIRE(T.size() == 46656);
+    REQUIRE(S.right_cayley_graph() == T.right_cayley_graph());
+    REQUIRE(S.left_cayley_graph() == T.left_cayley_graph());
+    REQUIRE(S.number_of_rules() == T.number_of_rules());
+
+    FroidurePin<Transf<>> U(S);
+    REQUIRE(U.memory_policy() == memory_policy::huge_pages_and_interleave);
+  }
 }  // namespace libsemigroups
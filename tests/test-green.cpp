@@ -0,0 +1,154 @@
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>  // for is_sorted, sort
+#include <cstddef>    // for size_t
+#include <iterator>   // for distance
+#include <vector>     // for vector
+
+#include "catch.hpp"      // for REQUIRE, REQUIRE_THROWS_AS
+#include "test-main.hpp"  // for LIBSEMIGROUPS_TEST_CASE
+
+#include "libsemigroups/froidure-pin.hpp"  // for FroidurePin
+#include "libsemigroups/green.hpp"         // for Green
+#include "libsemigroups/report.hpp"        // for ReportGuard
+#include "libsemigroups/transf.hpp"        // for Transf<>
+
+namespace libsemigroups {
+  struct LibsemigroupsException;
+  constexpr bool REPORT = false;
+
+  namespace {
+    // Checks that the classes of G are consistent with each other.
+    void check_green(Green const& G) {
+      size_t total = 0;
+      for (size_t d = 0; d < G.number_of_d_classes(); ++d) {
+        REQUIRE(std::is_sorted(G.cbegin_d_class(d), G.cend_d_class(d)));
+        REQUIRE(size_t(std::distance(G.cbegin_d_class(d), G.cend_d_class(d)))
+                == G.size_d_class(d));
+        for (auto it = G.cbegin_d_class(d); it != G.cend_d_class(d); ++it) {
+          REQUIRE(G.d_class(*it) == d);
+        }
+        total += G.size_d_class(d);
+      }
+      REQUIRE(total == G.size());
+      total = 0;
+      for (size_t h = 0; h < G.number_of_h_classes(); ++h) {
+        auto first = *G.cbegin_h_class(h);
+        for (auto it = G.cbegin_h_class(h); it != G.cend_h_class(h); ++it) {
+          REQUIRE(G.h_class(*it) == h);
+          REQUIRE(G.r_class(*it) == G.r_class(first));
+          REQUIRE(G.l_class(*it) == G.l_class(first));
+        }
+        if (G.is_group_h_class(h)) {
+          REQUIRE(G.is_idempotent(G.idempotent_h_class(h)));
+          REQUIRE(G.h_class(G.idempotent_h_class(h)) == h);
+        }
+        total += G.size_h_class(h);
+      }
+      REQUIRE(total == G.size());
+    }
+  }  // namespace
+
+  LIBSEMIGROUPS_TEST_CASE("Green",
+                          "000",
+                          "full transformation monoid of degree 3",
+                          "[quick]") {
+    auto                  rg = ReportGuard(REPORT);
+    FroidurePin<Transf<>> S({Transf<>({1, 0, 2}),
+                             Transf<>({1, 2, 0}),
+                             Transf<>({0, 0, 2})});
+    Green                 G(S);
+    REQUIRE(G.size() == 27);
+    REQUIRE(G.number_of_d_classes() == 3);
+    REQUIRE(G.number_of_r_classes() == 5);
+    REQUIRE(G.number_of_l_classes() == 7);
+    REQUIRE(G.number_of_h_classes() == 13);
+    REQUIRE(G.number_of_idempotents() == 10);
+    check_green(G);
+
+    // The D-class of the generator {0, 0, 2} consists of the elements of
+    // rank 2.
+    size_t d = G.d_class(S.position(Transf<>({0, 0, 2})));
+    REQUIRE(G.size_d_class(d) == 18);
+    REQUIRE(G.number_of_r_classes_d_class(d) == 3);
+    REQUIRE(G.number_of_l_classes_d_class(d) == 3);
+    REQUIRE(G.number_of_idempotents_d_class(d) == 6);
+    REQUIRE(G.is_regular_d_class(d));
+    REQUIRE(G.d_class(S.position(Transf<>({1, 0, 2})))
+            == G.d_class(S.position(Transf<>({1, 2, 0}))));
+    REQUIRE(G.size_h_class(G.h_class(S.position(Transf<>({1, 0, 2})))) == 6);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Green",
+                          "001",
+                          "full transformation monoid of degree 4",
+                          "[quick]") {
+    auto                  rg = ReportGuard(REPORT);
+    FroidurePin<Transf<>> S({Transf<>({1, 0, 2, 3}),
+                             Transf<>({1, 2, 3, 0}),
+                             Transf<>({0, 0, 2, 3})});
+    Green                 G1(S, 1);
+    Green                 G2(S, 4);
+    for (auto const* G : {&G1, &G2}) {
+      REQUIRE(G->size() == 256);
+      REQUIRE(G->number_of_d_classes() == 4);
+      REQUIRE(G->number_of_r_classes() == 15);
+      REQUIRE(G->number_of_l_classes() == 15);
+      REQUIRE(G->number_of_h_classes() == 71);
+      REQUIRE(G->number_of_idempotents() == 41);
+      check_green(*G);
+    }
+    for (size_t i = 0; i < S.size(); ++i) {
+      REQUIRE(G1.r_class(i) == G2.r_class(i));
+      REQUIRE(G1.l_class(i) == G2.l_class(i));
+      REQUIRE(G1.d_class(i) == G2.d_class(i));
+      REQUIRE(G1.h_class(i) == G2.h_class(i));
+    }
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Green", "002", "non-regular elements", "[quick]") {
+    auto rg = ReportGuard(REPORT);
+    // {x, x ^ 2, x ^ 3} where x ^ 3 is a constant transformation.
+    FroidurePin<Transf<>> S({Transf<>({1, 2, 3, 3})});
+    Green                 G(S);
+    REQUIRE(G.size() == 3);
+    REQUIRE(G.number_of_d_classes() == 3);
+    REQUIRE(G.number_of_h_classes() == 3);
+    REQUIRE(G.number_of_idempotents() == 1);
+    REQUIRE(!G.is_regular_element(0));
+    REQUIRE(!G.is_regular_element(1));
+    REQUIRE(G.is_regular_element(2));
+    REQUIRE(!G.is_group_h_class(G.h_class(0)));
+    REQUIRE(G.idempotent_h_class(G.h_class(0)) == UNDEFINED);
+    REQUIRE(G.idempotent_h_class(G.h_class(2)) == 2);
+    check_green(G);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Green", "003", "exceptions", "[quick]") {
+    auto                  rg = ReportGuard(REPORT);
+    FroidurePin<Transf<>> S({Transf<>({1, 0, 2}), Transf<>({0, 0, 2})});
+    REQUIRE_THROWS_AS(Green(S, 0), LibsemigroupsException);
+    Green G(S);
+    REQUIRE_THROWS_AS(G.r_class(S.size()), LibsemigroupsException);
+    REQUIRE_THROWS_AS(G.d_class(S.size()), LibsemigroupsException);
+    REQUIRE_THROWS_AS(G.cbegin_d_class(G.number_of_d_classes()),
+                      LibsemigroupsException);
+    REQUIRE_THROWS_AS(G.size_h_class(G.number_of_h_classes()),
+                      LibsemigroupsException);
+  }
+}  // namespace libsemigroups
@@ -37,6 +37,8 @@
 
 // #define CATCH_CONFIG_ENABLE_PAIR_STRINGMAKER
 #include <iostream>  // for ostringstream
+#include <map>       // for map
+#include <random>    // for mt19937
 
 #include <string>  // for string
 #include <vector>  // for vector
@@ -1209,5 +1211,117 @@ namespace libsemigroups {
                                            "bba",
                                            "bbb"}));
     }
+
+    LIBSEMIGROUPS_TEST_CASE("KnuthBendix",
+                            "117",
+                            "(fpsemi) add_rule after run",
+                            "[knuth-bendix][fpsemigroup][fpsemi][quick]") {
+      auto        rg = ReportGuard(REPORT);
+      KnuthBendix kb;
+      kb.set_alphabet("Bab");
+      kb.add_rule("aa", "");
+      kb.add_rule("bB", "");
+      kb.add_rule("bbb", "");
+      kb.add_rule("ababab", "");
+
+      REQUIRE(!kb.confluent());
+      kb.run();
+      REQUIRE(kb.finished());
+      REQUIRE(kb.number_of_active_rules() == 11);
+      REQUIRE(kb.size() == 12);
+      REQUIRE(kb.gilman_digraph().number_of_nodes() != 0);
+
+      kb.add_rule("a", "b");
+      REQUIRE(kb.number_of_rules() == 5);
+      // Adding a rule does not change the number of active rules until
+      // *after* kb.run() is called again.
+      REQUIRE(kb.number_of_active_rules() == 11);
+      REQUIRE(!kb.finished());
+      REQUIRE(!kb.confluent());
+      REQUIRE(kb.size() == 1);
+      REQUIRE(kb.finished());
+      REQUIRE(kb.confluent());
+      REQUIRE(kb.active_rules()
+              == std::vector<rule_type>({{"B", ""}, {"a", ""}, {"b", "a"}}));
+      REQUIRE(kb.normal_form("abBaab") == "");
+      REQUIRE_THROWS_AS(kb.add_rule("c", "a"), LibsemigroupsException);
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("KnuthBendix",
+                            "118",
+                            "(fpsemi) add rules one at a time",
+                            "[knuth-bendix][fpsemigroup][fpsemi][quick]") {
+      auto rg = ReportGuard(REPORT);
+      // The symmetric group of degree 4 and some of its quotients, the rules
+      // are added one at a time and compared with a KnuthBendix where all the
+      // rules are added before running.
+      std::vector<rule_type> rules
+          = {{"aa", ""}, {"bbbb", ""}, {"ababab", ""}, {"bb", ""}, {"ab", "ba"}};
+      std::vector<uint64_t> sizes
+          = {POSITIVE_INFINITY, POSITIVE_INFINITY, 24, 6, 2};
+
+      KnuthBendix kb1;
+      kb1.set_alphabet("ab");
+      kb1.set_identity("");
+      for (size_t i = 0; i < rules.size(); ++i) {
+        kb1.add_rule(rules[i]);
+        KnuthBendix kb2;
+        kb2.set_alphabet("ab");
+        kb2.set_identity("");
+        for (size_t j = 0; j <= i; ++j) {
+          kb2.add_rule(rules[j]);
+        }
+        REQUIRE(kb1.size() == sizes[i]);
+        REQUIRE(kb2.size() == sizes[i]);
+        REQUIRE(kb1.active_rules() == kb2.active_rules());
+      }
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("KnuthBendix",
+                            "119",
+                            "random_normal_form",
+                            "[knuth-bendix][fpsemigroup][fpsemi][quick]") {
+      auto        rg = ReportGuard(REPORT);
+      KnuthBendix kb;
+      kb.set_alphabet("abc");
+      kb.add_rule("aa", "a");
+      kb.add_rule("ab", "ba");
+      kb.add_rule("cb", "bc");
+      REQUIRE(kb.size() == POSITIVE_INFINITY);
+      REQUIRE(kb.number_of_normal_forms(6, 7) == 52);
+
+      std::vector<std::string>      nfs(kb.cbegin_normal_forms(6, 7),
+                                   kb.cend_normal_forms());
+      std::mt19937                  mt(1);
+      std::map<std::string, size_t> freq;
+      for (size_t i = 0; i < 100 * nfs.size(); ++i) {
+        std::string w = kb.random_normal_form(6, mt);
+        REQUIRE(kb.normal_form(w) == w);
+        freq[w]++;
+      }
+      REQUIRE(freq.size() == nfs.size());
+      for (auto const& p : freq) {
+        REQUIRE(p.second > 50);
+        REQUIRE(p.second < 150);
+      }
+      // Too many normal forms to enumerate
+      REQUIRE(kb.random_normal_form(500, mt).size() == 500);
+      REQUIRE_THROWS_AS(kb.random_normal_form(0, mt), LibsemigroupsException);
+
+      // More normal forms of length 2000 than fit into a double
+      KnuthBendix kb3;
+      kb3.set_alphabet("abc");
+      kb3.add_rule("aa", "a");
+      std::string w = kb3.random_normal_form(2000, mt);
+      REQUIRE(w.size() == 2000);
+      REQUIRE(kb3.normal_form(w) == w);
+
+      KnuthBendix kb2;
+      kb2.set_alphabet("ab");
+      kb2.set_identity("");
+      kb2.add_rule("ab", "ba");
+      REQUIRE(kb2.random_normal_form(0, mt) == "");
+      REQUIRE(kb2.random_normal_form(2, mt).size() == 2);
+    }
   }  // namespace fpsemigroup
 }  // namespace libsemigroups
@@ -238,7 +238,10 @@ namespace libsemigroups {
       kb.add_pair({0, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0}, {0, 0});
 
       REQUIRE_NOTHROW(kb.knuth_bendix().froidure_pin());
-      REQUIRE_THROWS_AS(kb.add_pair({0}, {1}), LibsemigroupsException);
+      // The underlying fpsemigroup::KnuthBendix supports adding rules after it
+      // has been run.
+      REQUIRE_NOTHROW(kb.add_pair({0}, {1}));
+      REQUIRE(kb.number_of_classes() == 1);
     }
 
     LIBSEMIGROUPS_TEST_CASE(
@@ -16,13 +16,17 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <cstddef>  // for size_t
+#include <algorithm>  // for max_element, min_element
+#include <cstddef>    // for size_t
+#include <random>     // for mt19937
+#include <vector>     // for vector
 
 #include "catch.hpp"      // for REQUIRE
 #include "test-main.hpp"  // FOR LIBSEMIGROUPS_TEST_CASE
 
-#include "libsemigroups/konieczny.hpp"  // for Konieczny
-#include "libsemigroups/transf.hpp"     // for Transf<>
+#include "libsemigroups/froidure-pin.hpp"  // for FroidurePin
+#include "libsemigroups/konieczny.hpp"     // for Konieczny
+#include "libsemigroups/transf.hpp"        // for Transf<>
 
 namespace libsemigroups {
 
@@ -255,4 +259,60 @@ namespace libsemigroups {
                 0, 0, 0, 16, 2, 10, 2, 26, 1, 1, 5, 21, 3, 11, 7}));
     REQUIRE(K.size() == 23191071);
   }
+
+  LIBSEMIGROUPS_TEST_CASE("Konieczny",
+                          "040",
+                          "transformations: random_element",
+                          "[quick][transf]") {
+    auto rg      = ReportGuard(REPORT);
+    using Transf = LeastTransf<5>;
+    std::vector<Transf> gens
+        = {Transf({1, 2, 0, 3, 4}), Transf({0, 0, 2, 4, 3}),
+           Transf({0, 1, 2, 4, 4})};
+    Konieczny<Transf>   S(gens);
+    FroidurePin<Transf> T(gens);
+    REQUIRE(S.size() == T.size());
+
+    // Every element is chosen with roughly equal frequency
+    std::mt19937        mt(31);
+    std::vector<size_t> freq(T.size(), 0);
+    for (size_t i = 0; i < 100 * T.size(); ++i) {
+      auto x = S.random_element(mt);
+      REQUIRE(T.contains(x));
+      freq[T.position(x)]++;
+    }
+    REQUIRE(*std::min_element(freq.cbegin(), freq.cend()) > 50);
+    REQUIRE(*std::max_element(freq.cbegin(), freq.cend()) < 150);
+
+    Konieczny<Transf> U({Transf({1, 0, 2, 3, 4}),
+                         Transf({1, 2, 3, 4, 0}),
+                         Transf({0, 0, 2, 3, 4})});
+    for (size_t i = 0; i < 1000; ++i) {
+      REQUIRE(U.contains(U.random_element(mt)));
+    }
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Konieczny",
+                          "041",
+                          "transformations: random_element (no identity)",
+                          "[quick][transf]") {
+    auto rg      = ReportGuard(REPORT);
+    using Transf = LeastTransf<4>;
+    std::vector<Transf> gens = {Transf({1, 0, 2, 2}), Transf({0, 1, 1, 3})};
+    Konieczny<Transf>   S(gens);
+    FroidurePin<Transf> T(gens);
+    REQUIRE(S.size() == 11);
+    REQUIRE(T.size() == 11);
+    REQUIRE(!T.contains(Transf({0, 1, 2, 3})));
+
+    std::mt19937        mt(31);
+    std::vector<size_t> freq(T.size(), 0);
+    for (size_t i = 0; i < 100 * T.size(); ++i) {
+      auto x = S.random_element(mt);
+      REQUIRE(T.contains(x));
+      freq[T.position(x)]++;
+    }
+    REQUIRE(*std::min_element(freq.cbegin(), freq.cend()) > 50);
+    REQUIRE(*std::max_element(freq.cbegin(), freq.cend()) < 150);
+  }
 }  // namespace libsemigroups
@@ -18,9 +18,13 @@
 
 // The purpose of this file is to test the Race class.
 
+#include <atomic>   // for atomic
+#include <chrono>   // for milliseconds
 #include <cstddef>  // for size_t
+#include <thread>   // for sleep_for
 
 #include "catch.hpp"                    // for REQUIRE, REQUIRE_THROWS_AS
+#include "libsemigroups/constants.hpp"  // for LIMIT_MAX
 #include "libsemigroups/exception.hpp"  // for LibsemigroupsException (ptr o...
 #include "libsemigroups/race.hpp"       // for Race
 #include "libsemigroups/report.hpp"     // for ReportGuard
@@ -33,37 +37,108 @@ namespace libsemigroups {
   constexpr bool REPORT = false;
 
   namespace detail {
+    // The Runners in this file are in an unnamed namespace so that they do
+    // not clash with those of the same names in test-runner.cpp.
+    namespace {
+      class TestRunner1 : public Runner {
+       private:
+        void run_impl() override {
+          while (!stopped()) {
+          }
+        }
 
-    class TestRunner1 : public Runner {
-     private:
-      void run_impl() override {
-        while (!stopped()) {
+        bool finished_impl() const override {
+          return stopped();
         }
-      }
+      };
 
-      bool finished_impl() const override {
-        return stopped();
-      }
-    };
+      class TestRunner2 : public Runner {
+       private:
+        void run_impl() override {}
+        bool finished_impl() const override {
+          return true;
+        }
+      };
 
-    class TestRunner2 : public Runner {
-     private:
-      void run_impl() override {}
-      bool finished_impl() const override {
-        return true;
-      }
-    };
+      class TestRunner3 : public Runner {
+       private:
+        void run_impl() override {
+          std::this_thread::sleep_for(std::chrono::milliseconds(25));
+        }
 
-    class TestRunner3 : public Runner {
-     private:
-      void run_impl() override {
-        std::this_thread::sleep_for(std::chrono::milliseconds(25));
-      }
+        bool finished_impl() const override {
+          return started();
+        }
+      };
 
-      bool finished_impl() const override {
-        return started();
-      }
-    };
+      // Finishes, but not quickly
+      class SlowTestRunner : public Runner {
+       public:
+        SlowTestRunner() : Runner(), _done(false) {}
+
+       private:
+        void run_impl() override {
+          std::this_thread::sleep_for(std::chrono::milliseconds(25));
+          _done = true;
+        }
+
+        bool finished_impl() const override {
+          return _done;
+        }
+
+        std::atomic<bool> _done;
+      };
+
+      // Never finishes, but stops when asked to
+      class EndlessTestRunner : public Runner {
+       private:
+        void run_impl() override {
+          while (!stopped()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+        }
+
+        bool finished_impl() const override {
+          return false;
+        }
+      };
+
+      class ThrowingTestRunner : public Runner {
+       private:
+        void run_impl() override {
+          LIBSEMIGROUPS_EXCEPTION("this runner always throws");
+        }
+
+        bool finished_impl() const override {
+          return false;
+        }
+      };
+
+      // Finishes after the given number of steps of 1ms, and uses the given
+      // number of bytes more in every step.
+      class HungryTestRunner : public Runner {
+       public:
+        HungryTestRunner(size_t steps, size_t bytes)
+            : Runner(), _bytes(bytes), _step(0), _steps(steps) {}
+
+       private:
+        void run_impl() override {
+          while (!stopped() && _step < _steps) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++_step;
+            update_memory_usage(_step * _bytes);
+          }
+        }
+
+        bool finished_impl() const override {
+          return _step == _steps;
+        }
+
+        size_t              _bytes;
+        std::atomic<size_t> _step;
+        size_t              _steps;
+      };
+    }  // namespace
 
     LIBSEMIGROUPS_TEST_CASE("Race", "001", "run_for", "[quick]") {
       auto rg = ReportGuard(REPORT);
@@ -156,5 +231,98 @@ namespace libsemigroups {
       rc.run_for(std::chrono::milliseconds(10));
       REQUIRE(rc.winner() != nullptr);
     }
+
+    LIBSEMIGROUPS_TEST_CASE("Race", "009", "deterministic", "[quick]") {
+      auto rg = ReportGuard(REPORT);
+      for (size_t i = 0; i < 10; ++i) {
+        Race rc;
+        rc.max_threads(3).deterministic(true);
+        REQUIRE(rc.deterministic());
+        auto slow = std::make_shared<SlowTestRunner>();
+        rc.add_runner(std::make_shared<ThrowingTestRunner>());
+        rc.add_runner(slow);
+        rc.add_runner(std::make_shared<TestRunner2>());
+        REQUIRE(rc.winner() == slow);
+      }
+      Race rc;
+      rc.max_threads(2).deterministic(true);
+      auto slow = std::make_shared<SlowTestRunner>();
+      rc.add_runner(slow);
+      rc.add_runner(std::make_shared<TestRunner2>());
+      rc.run_until([&slow]() { return slow->finished(); },
+                   std::chrono::milliseconds(1));
+      REQUIRE(rc.winner() == slow);
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("Race", "010", "max_memory", "[quick]") {
+      auto rg = ReportGuard(REPORT);
+      Race rc;
+      REQUIRE(rc.max_memory() == static_cast<size_t>(LIMIT_MAX));
+      rc.max_threads(2).max_memory(size_t(10) << 20);
+      REQUIRE(rc.max_memory() == size_t(10) << 20);
+      // Without the limit on memory, hungry would win
+      auto hungry = std::make_shared<HungryTestRunner>(50, size_t(1) << 20);
+      auto modest = std::make_shared<HungryTestRunner>(100, size_t(1) << 10);
+      rc.add_runner(hungry);
+      rc.add_runner(modest);
+      REQUIRE(rc.winner() == modest);
+      REQUIRE(hungry->dead());
+      REQUIRE(hungry->memory_usage() < size_t(50) << 20);
+      REQUIRE(modest->memory_usage() == size_t(100) << 10);
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("Race",
+                            "011",
+                            "deterministic with an endless first runner",
+                            "[quick]") {
+      auto rg = ReportGuard(REPORT);
+      Race rc;
+      rc.max_threads(2).deterministic(true);
+      auto fast = std::make_shared<TestRunner2>();
+      rc.add_runner(std::make_shared<EndlessTestRunner>());
+      rc.add_runner(fast);
+      // rc.run() would never return, since the first runner never finishes,
+      // although the second does.
+      rc.run_for(std::chrono::milliseconds(10));
+      REQUIRE(fast->finished());
+      REQUIRE(!rc.finished());
+      REQUIRE(rc.number_runners() == 2);
+      // Once the race is no longer deterministic, the finished runner wins.
+      rc.deterministic(false);
+      REQUIRE(rc.winner() == fast);
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("Race",
+                            "012",
+                            "max_memory keeps killed runners",
+                            "[quick]") {
+      auto rg = ReportGuard(REPORT);
+      {
+        Race rc;
+        rc.max_threads(2).max_memory(size_t(10) << 20);
+        auto hungry = std::make_shared<HungryTestRunner>(1000, size_t(1) << 20);
+        auto endless = std::make_shared<EndlessTestRunner>();
+        rc.add_runner(hungry);
+        rc.add_runner(endless);
+        rc.run_for(std::chrono::milliseconds(100));
+        REQUIRE(!rc.finished());
+        REQUIRE(hungry->dead());
+        // The killed runner is still in the race
+        REQUIRE(rc.number_runners() == 2);
+        REQUIRE(rc.find_runner<HungryTestRunner>() == hungry);
+      }
+      {
+        // The first runner is never killed in deterministic mode, even though
+        // it uses the most memory.
+        Race rc;
+        rc.max_threads(2).max_memory(size_t(10) << 20).deterministic(true);
+        auto hungry = std::make_shared<HungryTestRunner>(50, size_t(1) << 20);
+        auto modest = std::make_shared<HungryTestRunner>(100, size_t(1) << 10);
+        rc.add_runner(hungry);
+        rc.add_runner(modest);
+        REQUIRE(rc.winner() == hungry);
+        REQUIRE(!hungry->dead());
+      }
+    }
   }  // namespace detail
 }  // namespace libsemigroups
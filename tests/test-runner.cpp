@@ -18,7 +18,9 @@
 
 // The purpose of this file is to test the Runner class.
 
+#include <chrono>   // for milliseconds, high_resolution_clock
 #include <cstddef>  // for size_t
+#include <thread>   // for thread
 
 #include "catch.hpp"                 // for REQUIRE, REQUIRE_NOTHROW
 #include "libsemigroups/report.hpp"  // for ReportGuard
@@ -56,6 +58,24 @@ namespace libsemigroups {
       }
     };
 
+    class TestRunner4 : public Runner {
+     public:
+      size_t number_of_reports = 0;
+
+     private:
+      void run_impl() override {
+        while (!stopped()) {
+          if (report()) {
+            ++number_of_reports;
+          }
+        }
+      }
+
+      bool finished_impl() const override {
+        return false;
+      }
+    };
+
     class TestRunner3 : public Runner {
      private:
       void run_impl() override {
@@ -215,5 +235,100 @@ namespace libsemigroups {
       REQUIRE(!tr.dead());
     }
 
+
+    LIBSEMIGROUPS_TEST_CASE("Runner",
+                            "010",
+                            "deadlines while running",
+                            "[quick][no-valgrind]") {
+      auto        rg = ReportGuard(REPORT);
+      TestRunner4 tr;
+      tr.report_every(std::chrono::milliseconds(5));
+      auto start = std::chrono::high_resolution_clock::now();
+      tr.run_for(std::chrono::milliseconds(50));
+      auto elapsed = std::chrono::high_resolution_clock::now() - start;
+      REQUIRE(elapsed >= std::chrono::milliseconds(50));
+      REQUIRE(elapsed < std::chrono::seconds(5));
+      REQUIRE(tr.timed_out());
+      REQUIRE(tr.number_of_reports > 0);
+      REQUIRE(tr.number_of_reports <= 10);
+
+      // Reports are not due while not running, unless enough time has elapsed
+      tr.report_every(std::chrono::seconds(10));
+      REQUIRE(!tr.report());
+      tr.run_for(std::chrono::nanoseconds(0));
+      REQUIRE(tr.timed_out());
+
+      // Several runners with different deadlines
+      TestRunner4 tr1, tr2;
+      std::thread t1([&tr1]() { tr1.run_for(std::chrono::milliseconds(20)); });
+      std::thread t2([&tr2]() { tr2.run_for(std::chrono::milliseconds(5)); });
+      t1.join();
+      t2.join();
+      REQUIRE(tr1.timed_out());
+      REQUIRE(tr2.timed_out());
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("Runner", "011", "pause and resume", "[quick]") {
+      auto        rg = ReportGuard(REPORT);
+      TestRunner2 tr;
+      REQUIRE(!tr.paused());
+      tr.pause();  // does nothing, since tr is not running
+      tr.run_for(std::chrono::milliseconds(10));
+      REQUIRE(!tr.paused());
+      REQUIRE(tr.timed_out());
+
+      std::thread t([&tr]() { tr.run(); });
+      while (!tr.running()) {
+      }
+      tr.pause();
+      t.join();
+      REQUIRE(tr.paused());
+      REQUIRE(tr.stopped());
+      REQUIRE(!tr.running());
+      REQUIRE(!tr.dead());
+      REQUIRE(!tr.timed_out());
+
+      // Resume in another thread, and then pause again
+      t = std::thread([&tr]() { tr.resume(); });
+      while (!tr.running()) {
+      }
+      tr.pause();
+      t.join();
+      REQUIRE(tr.paused());
+
+      // Resuming after pausing run_for runs for the remaining time
+      t = std::thread([&tr]() { tr.run_for(std::chrono::seconds(10)); });
+      while (!tr.running()) {
+      }
+      tr.pause();
+      t.join();
+      REQUIRE(tr.paused());
+      tr.report_every(std::chrono::seconds(10));
+      tr.kill();
+      REQUIRE(!tr.paused());
+      REQUIRE(tr.dead());
+      REQUIRE_NOTHROW(tr.resume());
+
+      TestRunner2 tr2;
+      t = std::thread([&tr2]() {
+        tr2.run_until([]() -> bool { return false; });
+      });
+      while (!tr2.running()) {
+      }
+      tr2.pause();
+      t.join();
+      REQUIRE(tr2.paused());
+      REQUIRE(!tr2.stopped_by_predicate());
+      REQUIRE_THROWS_AS(tr2.resume(), LibsemigroupsException);
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("Runner", "012", "progress", "[quick]") {
+      auto        rg = ReportGuard(REPORT);
+      TestRunner3 tr;
+      REQUIRE(tr.progress() == 0);
+      tr.run();
+      REQUIRE(tr.finished());
+      REQUIRE(tr.progress() == 1);
+    }
   }  // namespace detail
 }  // namespace libsemigroups
@@ -0,0 +1,233 @@
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>  // for sort
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint64_t
+#include <iterator>   // for distance
+#include <mutex>      // for mutex, lock_guard
+#include <set>        // for set
+#include <vector>     // for vector
+
+#include "catch.hpp"      // for REQUIRE, REQUIRE_THROWS_AS
+#include "test-main.hpp"  // for LIBSEMIGROUPS_TEST_CASE
+
+#include "libsemigroups/cong-intf.hpp"  // for congruence_kind
+#include "libsemigroups/report.hpp"     // for ReportGuard
+#include "libsemigroups/sims1.hpp"      // for Sims1
+
+namespace libsemigroups {
+  struct LibsemigroupsException;
+  constexpr bool REPORT = false;
+
+  congruence_kind constexpr left  = congruence_kind::left;
+  congruence_kind constexpr right = congruence_kind::right;
+
+  namespace {
+    using digraph_type = Sims1::digraph_type;
+
+    // Returns the rows of the digraph, so that digraphs can be compared.
+    std::vector<size_t> to_vector(digraph_type const& d) {
+      std::vector<size_t> result;
+      for (size_t s = 0; s < d.number_of_nodes(); ++s) {
+        for (size_t a = 0; a < d.out_degree(); ++a) {
+          result.push_back(d.neighbor(s, a));
+        }
+      }
+      return result;
+    }
+
+    std::set<std::vector<size_t>> all_digraphs(Sims1 const& S, size_t n) {
+      std::set<std::vector<size_t>> result;
+      std::mutex                    mtx;
+      size_t                        count = 0;
+      S.for_each(n, [&result, &mtx, &count](digraph_type const& d) {
+        std::lock_guard<std::mutex> lock(mtx);
+        result.insert(to_vector(d));
+        count++;
+      });
+      // Every congruence is found exactly once
+      REQUIRE(result.size() == count);
+      return result;
+    }
+
+    void symmetric_group_3(Sims1& S) {
+      S.set_number_of_generators(2);
+      S.add_pair({0, 0}, {});
+      S.add_pair({1, 1, 1}, {});
+      S.add_pair({0, 1, 0, 1}, {});
+    }
+
+    void symmetric_group_4(Sims1& S) {
+      S.set_number_of_generators(2);
+      S.add_pair({0, 0}, {});
+      S.add_pair({1, 1, 1, 1}, {});
+      S.add_pair({0, 1, 0, 1, 0, 1}, {});
+    }
+  }  // namespace
+
+  LIBSEMIGROUPS_TEST_CASE("Sims1", "000", "free monogenic monoid", "[quick]") {
+    auto  rg = ReportGuard(REPORT);
+    Sims1 S(right);
+    S.set_number_of_generators(1);
+    // The congruences of the free monogenic monoid with n classes are
+    // determined by their index and period, which sum to n.
+    for (size_t n = 1; n < 10; ++n) {
+      REQUIRE(S.number_of_congruences(n) == n * (n + 1) / 2);
+    }
+    REQUIRE(std::distance(S.cbegin(5), S.cend(5)) == 15);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Sims1", "001", "symmetric group S3", "[quick]") {
+    auto  rg = ReportGuard(REPORT);
+    Sims1 S(right);
+    symmetric_group_3(S);
+    // Right congruences of a finite group = subgroups
+    REQUIRE(S.number_of_congruences(6) == 6);
+    REQUIRE(S.number_of_congruences(3) == 5);
+    REQUIRE(S.number_of_congruences(1) == 1);
+
+    std::vector<size_t> sizes;
+    for (auto it = S.cbegin(6); it != S.cend(6); ++it) {
+      REQUIRE(it->validate());
+      sizes.push_back(it->number_of_nodes());
+    }
+    std::sort(sizes.begin(), sizes.end());
+    REQUIRE(sizes == std::vector<size_t>({1, 2, 3, 3, 3, 6}));
+
+    auto d = S.find_if(6, [](digraph_type const& dd) {
+      return dd.number_of_nodes() == 2;
+    });
+    REQUIRE(d.number_of_nodes() == 2);
+    d = S.find_if(6, [](digraph_type const& dd) {
+      return dd.number_of_nodes() == 4;
+    });
+    REQUIRE(d.number_of_nodes() == 0);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Sims1", "002", "symmetric group S4", "[quick]") {
+    auto  rg = ReportGuard(REPORT);
+    Sims1 S(right);
+    symmetric_group_4(S);
+    REQUIRE(S.number_of_congruences(24) == 30);
+    REQUIRE(S.number_of_congruences(6) == 16);
+
+    // The congruence with 24 classes is the trivial one.
+    auto d = S.find_if(24, [](digraph_type const& dd) {
+      return dd.number_of_nodes() == 24;
+    });
+    REQUIRE(d.number_of_nodes() == 24);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Sims1", "003", "parallel", "[quick]") {
+    auto  rg = ReportGuard(REPORT);
+    Sims1 S(right);
+    symmetric_group_4(S);
+    auto expected = all_digraphs(S, 24);
+    REQUIRE(expected.size() == 30);
+    for (size_t t = 2; t <= 4; ++t) {
+      S.number_of_threads(t);
+      REQUIRE(S.number_of_threads() == t);
+      REQUIRE(all_digraphs(S, 24) == expected);
+      REQUIRE(S.number_of_congruences(6) == 16);
+      auto d = S.find_if(24, [](digraph_type const& dd) {
+        return dd.number_of_nodes() == 8;
+      });
+      REQUIRE(d.number_of_nodes() == 8);
+    }
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Sims1", "004", "left congruences", "[quick]") {
+    auto  rg = ReportGuard(REPORT);
+    Sims1 L(left);
+    // The monoid <a, b | ab = a> has a right zero a, so its left and right
+    // congruences differ.
+    L.set_number_of_generators(2);
+    L.add_pair({0, 1}, {0});
+    Sims1 R(right);
+    R.set_number_of_generators(2);
+    R.add_pair({1, 0}, {0});
+    REQUIRE(L.kind() == left);
+    REQUIRE(L.number_of_generating_pairs() == 1);
+    for (size_t n = 1; n < 5; ++n) {
+      REQUIRE(all_digraphs(L, n) == all_digraphs(R, n));
+    }
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Sims1", "005", "exceptions", "[quick]") {
+    auto rg = ReportGuard(REPORT);
+    REQUIRE_THROWS_AS(Sims1(congruence_kind::twosided),
+                      LibsemigroupsException);
+    Sims1 S(right);
+    REQUIRE_THROWS_AS(S.add_pair({0}, {1}), LibsemigroupsException);
+    REQUIRE_THROWS_AS(S.number_of_congruences(2), LibsemigroupsException);
+    REQUIRE_THROWS_AS(S.set_number_of_generators(0), LibsemigroupsException);
+    S.set_number_of_generators(2);
+    REQUIRE_THROWS_AS(S.set_number_of_generators(3), LibsemigroupsException);
+    REQUIRE_THROWS_AS(S.add_pair({0}, {2}), LibsemigroupsException);
+    REQUIRE_THROWS_AS(S.number_of_congruences(0), LibsemigroupsException);
+    REQUIRE_THROWS_AS(S.number_of_threads(0), LibsemigroupsException);
+    S.add_pair({0}, {});
+    S.add_pair({1}, {});
+    REQUIRE(S.number_of_congruences(10) == 1);
+  }
+
+  LIBSEMIGROUPS_TEST_CASE("Sims1",
+                          "006",
+                          "deductions and iterator equality",
+                          "[quick]") {
+    auto  rg = ReportGuard(REPORT);
+    Sims1 S(right);
+    S.set_number_of_generators(2);
+    S.add_pair({0, 0, 0}, {0});
+    S.add_pair({1, 1}, {1});
+    S.add_pair({0, 1, 0, 1}, {0, 1});
+    std::vector<uint64_t> expected = {1, 8, 24, 58, 129, 268, 520, 958};
+    for (size_t n = 1; n <= expected.size(); ++n) {
+      REQUIRE(S.number_of_congruences(n) == expected[n - 1]);
+    }
+    for (auto it = S.cbegin(8); it != S.cend(8); ++it) {
+      REQUIRE(it->validate());
+    }
+    S.number_of_threads(4);
+    REQUIRE(S.number_of_congruences(8) == 958);
+
+    Sims1 T(left);
+    T.set_number_of_generators(3);
+    T.add_pair({0, 1}, {1, 0});
+    T.add_pair({2, 2}, {2});
+    T.add_pair({0, 2}, {2});
+    T.add_pair({1, 1, 1}, {});
+    expected = {1, 3, 17, 48, 131, 741, 2864};
+    for (size_t n = 1; n <= expected.size(); ++n) {
+      REQUIRE(T.number_of_congruences(n) == expected[n - 1]);
+    }
+
+    auto it = S.cbegin(8);
+    auto jt = it;
+    REQUIRE(it == jt);
+    REQUIRE(it == S.cbegin(8));
+    REQUIRE(it != S.cbegin(7));
+    REQUIRE(it != T.cbegin(8));
+    REQUIRE(it != S.cend(8));
+    ++jt;
+    REQUIRE(it != jt);
+    REQUIRE(it++ != jt);
+    REQUIRE(it == jt);
+    REQUIRE(to_vector(*it) == to_vector(*jt));
+  }
+}  // namespace libsemigroups
@@ -3524,4 +3524,247 @@ namespace libsemigroups {
                         LibsemigroupsException);
     }
   }  // namespace fpsemigroup
+
+  namespace congruence {
+    LIBSEMIGROUPS_TEST_CASE("ToddCoxeter",
+                            "099",
+                            "add_pair after enumeration (2-sided)",
+                            "[todd-coxeter][quick]") {
+      auto rg = ReportGuard(REPORT);
+
+      ToddCoxeter tc(twosided);
+      tc.set_number_of_generators(2);
+      tc.add_pair({0, 0, 0}, {0});
+      tc.add_pair({1, 1, 1, 1}, {1});
+      tc.add_pair({0, 1, 0, 1}, {0, 0});
+
+      TEST_HLT(tc);
+      TEST_FELSCH(tc);
+
+      REQUIRE(tc.number_of_classes() == 27);
+      REQUIRE(tc.finished());
+      tc.standardize(tc_order::shortlex);
+      REQUIRE(tc.is_standardized());
+
+      tc.add_pair({1, 1}, {0, 0});
+      REQUIRE(tc.finished());
+      REQUIRE(!tc.is_standardized());
+      REQUIRE(tc.complete());
+      REQUIRE(tc.compatible());
+
+      ToddCoxeter expected(twosided);
+      expected.set_number_of_generators(2);
+      expected.add_pair({0, 0, 0}, {0});
+      expected.add_pair({1, 1, 1, 1}, {1});
+      expected.add_pair({0, 1, 0, 1}, {0, 0});
+      expected.add_pair({1, 1}, {0, 0});
+
+      size_t const n = expected.number_of_classes();
+      REQUIRE(tc.number_of_classes() == n);
+      REQUIRE(std::vector<word_type>(tc.cbegin_normal_forms(),
+                                     tc.cend_normal_forms())
+              == std::vector<word_type>(expected.cbegin_normal_forms(),
+                                        expected.cend_normal_forms()));
+      REQUIRE(tc.is_standardized());
+      REQUIRE(tc.contains({1, 1, 0}, {0, 0, 0}));
+      REQUIRE(tc.quotient_froidure_pin()->size() == n);
+
+      tc.add_pair({0}, {1});
+      REQUIRE(tc.number_of_classes() == 1);
+      REQUIRE(tc.number_of_generating_pairs() == 5);
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("ToddCoxeter",
+                            "100",
+                            "add_pair after enumeration (left, FroidurePin)",
+                            "[todd-coxeter][quick]") {
+      auto rg = ReportGuard(REPORT);
+
+      using Transf = LeastTransf<5>;
+      FroidurePin<Transf> S({Transf({1, 3, 4, 2, 3}), Transf({3, 2, 1, 3, 3})});
+      REQUIRE(S.size() == 88);
+
+      word_type const u1 = S.factorisation(Transf({3, 4, 4, 4, 4}));
+      word_type const v1 = S.factorisation(Transf({3, 1, 3, 3, 3}));
+      word_type const u2 = S.factorisation(Transf({1, 3, 1, 3, 3}));
+      word_type const v2 = S.factorisation(Transf({4, 2, 4, 4, 2}));
+
+      ToddCoxeter tc(left, S);
+      tc.froidure_pin_policy(options::froidure_pin::use_cayley_graph);
+      tc.add_pair(u1, v1);
+      REQUIRE(tc.number_of_classes() == 69);
+
+      tc.add_pair(u2, v2);
+      REQUIRE(tc.finished());
+      REQUIRE(tc.complete());
+
+      ToddCoxeter expected(left, S);
+      expected.froidure_pin_policy(options::froidure_pin::use_cayley_graph);
+      expected.add_pair(u1, v1);
+      expected.add_pair(u2, v2);
+
+      REQUIRE(tc.number_of_classes() == expected.number_of_classes());
+      REQUIRE(tc.contains(u2, v2));
+      for (size_t i = 0; i < S.size(); ++i) {
+        for (size_t j = 0; j < S.size(); ++j) {
+          REQUIRE(tc.contains(S.factorisation(i), S.factorisation(j))
+                  == expected.contains(S.factorisation(i),
+                                       S.factorisation(j)));
+        }
+      }
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("ToddCoxeter",
+                            "101",
+                            "Cayley graph versus relations",
+                            "[todd-coxeter][quick]") {
+      auto rg = ReportGuard(REPORT);
+
+      using Transf = LeastTransf<5>;
+      FroidurePin<Transf> S({Transf({1, 3, 4, 2, 3}), Transf({3, 2, 1, 3, 3})});
+      REQUIRE(S.size() == 88);
+
+      word_type const u = S.factorisation(Transf({3, 4, 4, 4, 4}));
+      word_type const v = S.factorisation(Transf({3, 1, 3, 3, 3}));
+
+      for (auto knd : {left, right, twosided}) {
+        ToddCoxeter tc1(knd, S);
+        tc1.froidure_pin_policy(options::froidure_pin::use_cayley_graph);
+        tc1.add_pair(u, v);
+
+        ToddCoxeter tc2(knd, S);
+        tc2.froidure_pin_policy(options::froidure_pin::use_relations);
+        tc2.add_pair(u, v);
+
+        REQUIRE(tc1.number_of_classes() == tc2.number_of_classes());
+        REQUIRE(tc1.number_of_cosets_active()
+                == tc1.number_of_classes() + 1);
+        for (size_t i = 0; i < S.size(); ++i) {
+          REQUIRE(tc1.word_to_class_index(S.factorisation(i))
+                  == tc2.word_to_class_index(S.factorisation(i)));
+        }
+      }
+      ToddCoxeter tc(twosided, S);
+      REQUIRE(tc.number_of_classes() == 88);
+      REQUIRE(!tc.empty());
+      REQUIRE(!tc.contains({0}, {1}));
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("ToddCoxeter",
+                            "102",
+                            "memory_policy",
+                            "[todd-coxeter][quick]") {
+      auto rg = ReportGuard(REPORT);
+
+      ToddCoxeter tc(twosided);
+      REQUIRE(tc.memory_policy() == memory_policy::standard);
+      tc.memory_policy(memory_policy::huge_pages);
+      tc.set_number_of_generators(4);
+      REQUIRE(tc.memory_policy() == memory_policy::huge_pages);
+      tc.add_pair({0, 0}, {0});
+      tc.add_pair({1, 0}, {1});
+      tc.add_pair({0, 1}, {1});
+      tc.add_pair({2, 0}, {2});
+      tc.add_pair({0, 2}, {2});
+      tc.add_pair({3, 0}, {3});
+      tc.add_pair({0, 3}, {3});
+      tc.add_pair({1, 1}, {0});
+      tc.add_pair({2, 3}, {0});
+      tc.add_pair({2, 2, 2}, {0});
+      tc.add_pair({1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2}, {0});
+      tc.add_pair({1, 2, 1, 3, 1, 2, 1, 3, 1, 2, 1, 3, 1, 2, 1, 3,
+                   1, 2, 1, 3, 1, 2, 1, 3, 1, 2, 1, 3, 1, 2, 1, 3},
+                  {0});
+      tc.run_until([&tc]() { return tc.number_of_cosets_active() > 1000; });
+      tc.memory_policy(memory_policy::interleave);
+      REQUIRE(tc.memory_policy() == memory_policy::interleave);
+
+      REQUIRE(tc.number_of_classes() == 10752);
+      REQUIRE(tc.memory_policy() == memory_policy::interleave);
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("ToddCoxeter",
+                            "103",
+                            "seed",
+                            "[todd-coxeter][quick]") {
+      auto        rg = ReportGuard(REPORT);
+      fpsemigroup::ToddCoxeter G;
+      G.set_alphabet("abABe");
+      G.set_identity("e");
+      G.set_inverses("ABabe");
+      G.add_rule("aa", "e");
+      G.add_rule("bbb", "e");
+      G.add_rule("ababababab", "e");
+
+      ToddCoxeter H1(twosided, G);
+      H1.strategy(options::strategy::hlt).seed(1234);
+      REQUIRE(H1.seed() == 1234);
+      ToddCoxeter H2(H1);
+      REQUIRE(H2.seed() == 1234);
+
+      H1.random_shuffle_generating_pairs();
+      H2.random_shuffle_generating_pairs();
+      REQUIRE(H1.number_of_classes() == 60);
+      REQUIRE(H2.number_of_classes() == 60);
+      REQUIRE(H1.number_of_cosets_defined() == H2.number_of_cosets_defined());
+      REQUIRE(H1.number_of_cosets_killed() == H2.number_of_cosets_killed());
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("ToddCoxeter",
+                            "104",
+                            "memory_usage",
+                            "[todd-coxeter][quick]") {
+      auto                     rg = ReportGuard(REPORT);
+      fpsemigroup::ToddCoxeter G;
+      G.set_alphabet("abABe");
+      G.set_identity("e");
+      G.set_inverses("ABabe");
+      G.add_rule("aa", "e");
+      G.add_rule("bbb", "e");
+      G.add_rule("ababababab", "e");
+      REQUIRE(G.size() == 60);
+      REQUIRE(G.memory_usage() > 0);
+      REQUIRE(G.memory_usage() == G.congruence().memory_usage());
+
+      ToddCoxeter H(twosided, G);
+      H.strategy(options::strategy::hlt);
+      REQUIRE(H.memory_usage() == 0);
+      REQUIRE(H.number_of_classes() == 60);
+      size_t const before = H.memory_usage();
+      REQUIRE(before >= 61 * 5 * 3 * sizeof(size_t));
+      H.shrink_to_fit();
+      REQUIRE(H.memory_usage() <= before);
+      REQUIRE(H.memory_usage() == 61 * (5 * 3 + 3) * sizeof(size_t));
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("ToddCoxeter",
+                            "105",
+                            "Cayley graph stopped and resumed",
+                            "[todd-coxeter][quick]") {
+      auto rg = ReportGuard(REPORT);
+
+      using Transf = LeastTransf<5>;
+      FroidurePin<Transf> S({Transf({1, 3, 4, 2, 3}), Transf({3, 2, 1, 3, 3})});
+      REQUIRE(S.size() == 88);
+
+      word_type const u = S.factorisation(Transf({3, 4, 4, 4, 4}));
+      word_type const v = S.factorisation(Transf({3, 1, 3, 3, 3}));
+
+      ToddCoxeter tc(twosided, S);
+      tc.froidure_pin_policy(options::froidure_pin::use_cayley_graph);
+      tc.add_pair(u, v);
+      size_t calls = 0;
+      tc.run_until([&calls]() -> bool { return ++calls > 10; });
+      REQUIRE(calls > 10);
+      REQUIRE(!tc.finished());
+      REQUIRE(tc.stopped_by_predicate());
+      REQUIRE(tc.number_of_cosets_active() == 1);
+
+      ToddCoxeter tc2(twosided, S);
+      tc2.froidure_pin_policy(options::froidure_pin::use_relations);
+      tc2.add_pair(u, v);
+      REQUIRE(tc.number_of_classes() == tc2.number_of_classes());
+      REQUIRE(tc.finished());
+    }
+  }  // namespace congruence
 }  // namespace libsemigroups
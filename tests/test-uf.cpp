@@ -19,9 +19,11 @@
 // The purpose of this file is to test the UF class which describes a partition
 // of the set of integers {0, ..., n - 1 }
 
-#include <cstddef>  // for size_t
-#include <numeric>  // for iota
-#include <vector>   // vector
+#include <algorithm>  // for equal
+#include <cstddef>    // for size_t
+#include <numeric>    // for iota
+#include <utility>    // for pair
+#include <vector>     // vector
 
 #include "catch.hpp"             // for REQUIRE
 #include "libsemigroups/uf.hpp"  // Duf + Suf
@@ -610,5 +612,52 @@ namespace libsemigroups {
       uf1 = uf3;
       REQUIRE(uf2 == uf1);
     }
+
+    LIBSEMIGROUPS_TEST_CASE("Duf",
+                            "020",
+                            "unite_pairs + parallel compress",
+                            "[quick][no-valgrind]") {
+      size_t const                           N = 1 << 18;
+      std::vector<std::pair<size_t, size_t>> pairs;
+      for (size_t i = 0; i < N - 3; ++i) {
+        pairs.emplace_back(i + 3, i);
+      }
+      Duf<> uf1(N);
+      uf1.unite_pairs(pairs.cbegin(), pairs.cend());
+      Duf<> uf2(N);
+      uf2.unite_pairs(pairs.cbegin(), pairs.cend(), 4);
+      REQUIRE(uf1 == uf2);
+      REQUIRE(uf1.number_of_blocks() == 3);
+      REQUIRE(
+          std::equal(uf1.cbegin_data(), uf1.cend_data(), uf2.cbegin_data()));
+      for (size_t i = 0; i < N; ++i) {
+        // compressed
+        REQUIRE(*(uf2.cbegin_data() + *(uf2.cbegin_data() + i))
+                == *(uf2.cbegin_data() + i));
+      }
+      uf2.normalize();
+      REQUIRE(std::vector<size_t>(uf2.cbegin(), uf2.cend())
+              == std::vector<size_t>({0, 1, 2}));
+    }
+
+    LIBSEMIGROUPS_TEST_CASE("Suf", "021", "for_each_block", "[quick]") {
+      Suf<10> uf;
+      uf.unite(9, 4);
+      uf.unite(4, 2);
+      uf.unite(7, 1);
+      std::vector<std::vector<size_t>> blocks;
+      uf.for_each_block([&blocks](auto first, auto last) {
+        blocks.emplace_back(first, last);
+      });
+      REQUIRE(blocks
+              == std::vector<std::vector<size_t>>(
+                  {{0}, {1, 7}, {2, 4, 9}, {3}, {5}, {6}, {8}}));
+      REQUIRE(blocks.size() == uf.number_of_blocks());
+
+      Duf<>  empty;
+      size_t nr = 0;
+      empty.for_each_block([&nr](auto, auto) { ++nr; });
+      REQUIRE(nr == 0);
+    }
   }  // namespace detail
 }  // namespace libsemigroups